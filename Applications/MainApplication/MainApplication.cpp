@@ -4,6 +4,7 @@
 
 #include <QTimer>
 #include <QDir>
+#include <QStandardPaths>
 #include <QPluginLoader>
 #include <QCommandLineParser>
 
@@ -14,11 +15,13 @@
 #include <Core/Math/ColorPresets.hpp>
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/String/StringUtils.hpp>
 #include <Core/Utils/Version.hpp>
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Entity/Entity.hpp>
+#include <Engine/Assets/FileData.hpp>
 #include <Engine/Managers/SystemDisplay/SystemDisplay.hpp>
 
 #include <Engine/Renderer/Renderer.hpp>
@@ -130,6 +133,13 @@ namespace Ra
         m_engine.reset(Engine::RadiumEngine::createInstance());
         m_engine->initialize();
 
+        // Imported files are kept in a binary cache, so that the next loadings skip the importer.
+        const QString cacheDir = QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + "/Assets";
+        if ( QDir().mkpath( cacheDir ) )
+        {
+            Asset::FileData::setCacheDirectory( cacheDir.toStdString() );
+        }
+
         // Create main window.
         m_mainWindow.reset( new Gui::MainWindow );
         m_mainWindow->show();
@@ -150,8 +160,10 @@ namespace Ra
         CORE_ASSERT( m_viewer != nullptr, "GUI was not initialized" );
         CORE_ASSERT( m_viewer->context()->isValid(), "OpenGL was not initialized" );
 
-        // Create task queue with N-1 threads (we keep one for rendering).
+        // Create task queue with N-1 threads (the main thread joins the workers in waitForTasks()).
         m_taskQueue.reset( new Core::TaskQueue( std::thread::hardware_concurrency() - 1 ) );
+        // Data-parallel loops of the core algorithms also run on the task queue threads.
+        Core::setParallelForQueue( m_taskQueue.get() );
 
         createConnections();
 
@@ -285,13 +297,14 @@ namespace Ra
 
         // ----------
         // 3. Run the engine task queue.
+        // The tasks are kept in the queue and replayed every frame, the engine
+        // only generates them again when the systems changed.
         m_engine->getTasks( m_taskQueue.get(), dt );
 
         // Run one frame of tasks
         m_taskQueue->startTasks();
         m_taskQueue->waitForTasks();
         timerData.taskData = m_taskQueue->getTimerData();
-        m_taskQueue->flushTaskQueue();
 
         timerData.tasksEnd = Core::Timer::Clock::now();
 
@@ -362,6 +375,7 @@ namespace Ra
         emit stopping();
         m_mainWindow->cleanup();
         m_engine->cleanup();
+        Core::setParallelForQueue( nullptr );
     }
 
     bool BaseApplication::loadPlugins( const std::string& pluginsPath )
@@ -54,11 +54,10 @@ namespace
             // Starts the renderer
             _viewer.startRendering(dt);
 
-            // Collect and run tasks
+            // Collect and run tasks (tasks are kept in the queue from one frame to the next)
             _engine->getTasks(_task_queue.get(), dt);
             _task_queue->startTasks();
             _task_queue->waitForTasks();
-            _task_queue->flushTaskQueue();
 
             // Finish the frame
             _viewer.waitForRendering();
@@ -119,8 +118,8 @@ struct MinimalComponent : public Ra::Engine::Component
 
 };
 
-/// This system will be added to the engine. Every frame it will
-/// add a task to be executed, calling the spin function of the component.
+/// This system will be added to the engine. It adds a task executed
+/// every frame, calling the spin function of the component.
 class MinimalSystem : public Ra::Engine::System
 {
 public:
@@ -64,10 +64,10 @@ namespace AnimationPlugin
         // get the current pose from the animation
         if ( dt > 0 && m_animations.size() > 0)
         {
-            Ra::Core::Animation::Pose currentPose = m_animations[m_animationID].getPose(m_animationTime);
+            m_animations[m_animationID].getPose(m_animationTime, m_currentPose);
 
             // update the pose of the skeleton
-            m_skel.setPose(currentPose, Ra::Core::Animation::Handle::SpaceType::LOCAL);
+            m_skel.setPose(m_currentPose, Ra::Core::Animation::Handle::SpaceType::LOCAL);
         }
 
         // update the render objects
@@ -170,7 +170,7 @@ namespace AnimationPlugin
         std::set< Ra::Asset::Time > keyTime;
 
         for( uint n = 0; n < data.size(); ++n ) {
-            auto handleAnim = data[n]->getFrames();
+            const auto& handleAnim = data[n]->getFrames();
             for( uint i = 0; i < m_skel.size(); ++i ) {
                 for( uint j = 0; j < handleAnim.size(); ++j ) {
                     if( m_skel.getLabel( i ) == handleAnim[j].m_name ) {
@@ -184,16 +184,24 @@ namespace AnimationPlugin
             Ra::Asset::KeyPose keypose;
             Ra::Core::Animation::Pose pose = m_skel.m_pose;
 
-            m_animations.push_back( Ra::Core::Animation::Animation() );
+            Ra::Core::Animation::Animation animation;
             for( const auto& t : keyTime ) {
                 for( const auto& it : table ) {
                     //pose[it.second] = ( m_skel.m_graph.isRoot( it.second ) ) ? m_skel.m_pose[it.second] : handleAnim[it.first].m_anim.at( t );
                     pose[it.second] = handleAnim[it.first].m_anim.at( t );
                 }
-                m_animations.back().addKeyPose( pose, t );
+                animation.addKeyPose( pose, t );
                 keypose.insertKeyFrame( t, pose );
             }
 
+            // The clips are kept compressed, sampled at the time step of the asset.
+            Ra::Core::Animation::CompressedAnimation::Options options;
+            if( data[n]->getTimeStep() > 0 ) {
+                options.m_sampleRate = 1 / data[n]->getTimeStep();
+            }
+            m_animations.push_back( Ra::Core::Animation::CompressedAnimation() );
+            m_animations.back().compress( animation, options );
+
             m_dt.push_back( data[n]->getTimeStep() );
         }
         m_animationID = 0;
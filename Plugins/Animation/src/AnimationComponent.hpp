@@ -5,6 +5,7 @@
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/Skeleton.hpp>
 #include <Core/Animation/Animation.hpp>
+#include <Core/Animation/CompressedAnimation.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
 
 #include <Engine/Component/Component.hpp>
@@ -105,7 +106,7 @@ namespace AnimationPlugin
 
         Ra::Core::Animation::Skeleton m_skel; // Skeleton
         Ra::Core::Animation::RefPose m_refPose; // Ref pose in model space.
-        std::vector<Ra::Core::Animation::Animation> m_animations;
+        std::vector<Ra::Core::Animation::CompressedAnimation> m_animations;
         Ra::Core::Animation::WeightMatrix m_weights; // Skinning weights ( should go in skinning )
 
         std::vector<SkeletonBoneRenderObject*> m_boneDrawables ; // Vector of bone display objects
@@ -113,6 +114,7 @@ namespace AnimationPlugin
         uint   m_animationID;
         bool   m_animationTimeStep;
         Scalar m_animationTime;
+        Ra::Core::Animation::Pose m_currentPose; // Sampled pose, kept to avoid reallocations
         std::vector< Scalar > m_dt;
         Scalar m_speed;
         bool   m_slowMo;
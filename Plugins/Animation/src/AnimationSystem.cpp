@@ -21,22 +21,27 @@ namespace AnimationPlugin
         m_isPlaying = false;
         m_oneStep = false;
         m_xrayOn = true;
+        m_currentDelta = 0;
     }
 
     void AnimationSystem::generateTasks(Ra::Core::TaskQueue* taskQueue, const Ra::Engine::FrameInfo& frameInfo)
     {
-        const bool playFrame = m_isPlaying || m_oneStep;
-
-        Scalar currentDelta = playFrame ? frameInfo.m_dt : 0;
-
         for (auto compEntry : this->m_components)
         {
             AnimationComponent* component = static_cast<AnimationComponent*>(compEntry.second);
+            // The time step is read when the task runs, as the task is replayed every frame.
             Ra::Core::FunctionTask* task = new Ra::Core::FunctionTask(
-                    std::bind(&AnimationComponent::update, component, currentDelta),
-                    "Animator Task");
+                    std::bind(&AnimationComponent::update, component, std::cref(m_currentDelta)),
+                    "AnimatorTask");
             taskQueue->registerTask( task );
         }
+    }
+
+    void AnimationSystem::prepareFrame(const Ra::Engine::FrameInfo& frameInfo)
+    {
+        const bool playFrame = m_isPlaying || m_oneStep;
+
+        m_currentDelta = playFrame ? frameInfo.m_dt : 0;
 
         m_oneStep = false;
     }
@@ -18,6 +18,9 @@ namespace AnimationPlugin
         virtual void generateTasks( Ra::Core::TaskQueue* taskQueue,
                                     const Ra::Engine::FrameInfo& frameInfo ) override;
 
+        /// Compute the time step applied by the animation tasks of this frame.
+        virtual void prepareFrame( const Ra::Engine::FrameInfo& frameInfo ) override;
+
         /// Load a skeleton and an animation from a file.
         void handleAssetLoading( Ra::Engine::Entity* entity, const Ra::Asset::FileData* fileData) override;
 
@@ -45,6 +48,7 @@ namespace AnimationPlugin
         bool m_isPlaying; /// See if animation is playing or paused
         bool m_oneStep;   /// True if one step has been required to play.
         bool m_xrayOn;    /// True if we want to show xray-bones
+        Scalar m_currentDelta; /// Time step of the current frame (0 if paused).
     };
 }
 
@@ -31,6 +31,7 @@ namespace FancyMeshPlugin
 {
     FancyMeshComponent::FancyMeshComponent(const std::string& name , bool deformable)
         : Ra::Engine::Component( name  ) , m_deformable(deformable)
+        , m_bvhGeometryVersion( 0 ) , m_bvhDirty( true )
     {
     }
 
@@ -194,6 +195,9 @@ namespace FancyMeshPlugin
 
         Ra::Engine::Mesh& displayMesh = getDisplayMesh();
         displayMesh.loadGeometry( *meshptr );
+
+        std::lock_guard<std::mutex> lock( m_bvhMutex );
+        m_bvhDirty = true;
     }
 
     Ra::Core::Vector3Array* FancyMeshComponent::getVerticesRw()
@@ -211,6 +215,10 @@ namespace FancyMeshPlugin
     Ra::Core::VectorArray<Ra::Core::Triangle>* FancyMeshComponent::getTrianglesRw()
     {
         getDisplayMesh().setDirty( Ra::Engine::Mesh::INDEX);
+        {
+            std::lock_guard<std::mutex> lock( m_bvhMutex );
+            m_bvhDirty = true;
+        }
         return &(getDisplayMesh().getGeometry().m_triangles);
     }
 
@@ -221,13 +229,28 @@ namespace FancyMeshPlugin
 
     void FancyMeshComponent::rayCastQuery( const Ra::Core::Ray& r) const
     {
-        auto result  = Ra::Core::MeshUtils::castRay( getMesh(), r );
-        int tidx = result.m_hitTriangle;
-        if (tidx >= 0)
+        const Ra::Engine::Mesh& displayMesh = getDisplayMesh();
+        const TriangleMesh& mesh = displayMesh.getGeometry();
+
+        std::lock_guard<std::mutex> lock( m_bvhMutex );
+        if ( m_bvhDirty || m_bvh.getNumTriangles() != mesh.m_triangles.size() )
+        {
+            m_bvh.build( mesh );
+            m_bvhDirty = false;
+            m_bvhGeometryVersion = displayMesh.getGeometryVersion();
+        }
+        else if ( m_bvhGeometryVersion != displayMesh.getGeometryVersion() )
+        {
+            m_bvh.refit( mesh );
+            m_bvhGeometryVersion = displayMesh.getGeometryVersion();
+        }
+
+        Ra::Core::TriangleBVH::Hit hit;
+        if ( m_bvh.closestHit( mesh, r, hit ) )
         {
-            LOG(logINFO) << " Hit triangle " << tidx;
-            LOG(logINFO) << " Nearest vertex " << result.m_nearestVertex;
-            LOG(logINFO) << "Hit position : "<< r.pointAt( result.m_t ).transpose();
+            LOG(logINFO) << " Hit triangle " << hit.m_triangle;
+            LOG(logINFO) << " Nearest vertex " << Ra::Core::TriangleBVH::getNearestVertex( mesh, r, hit );
+            LOG(logINFO) << "Hit position : "<< r.pointAt( hit.m_t ).transpose();
         }
     }
 
@@ -3,8 +3,11 @@
 
 #include <FancyMeshPlugin.hpp>
 
+#include <mutex>
+
 #include <Core/Mesh/MeshTypes.hpp>
 #include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/TreeStructures/TriangleBVH.hpp>
 
 #include <Engine/Component/Component.hpp>
 
@@ -65,6 +68,13 @@ namespace FancyMeshPlugin
         Ra::Core::Index m_aabbIndex;
         std::string m_contentName;
         bool m_deformable;
+
+        // Triangle BVH of the display mesh used by ray casts. It is built by the first ray cast,
+        // refitted when the vertices changed since, and rebuilt when the triangles changed.
+        mutable Ra::Core::TriangleBVH m_bvh;
+        mutable uint m_bvhGeometryVersion;
+        mutable bool m_bvhDirty;
+        mutable std::mutex m_bvhMutex;
     };
 
 } // namespace FancyMeshPlugin
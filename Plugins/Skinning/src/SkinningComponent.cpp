@@ -1,11 +1,16 @@
  #include <SkinningComponent.hpp>
 
-#include <Core/Geometry/Normal/Normal.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Animation/Pose/PoseOperation.hpp>
 
 #include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
+#include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
 #include <Core/Animation/Skinning/RotationCenterSkinning.hpp>
 
+#include <Engine/Renderer/Mesh/Mesh.hpp>
+#include <Engine/Renderer/RenderObject/RenderObject.hpp>
+#include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
+
 using Ra::Core::Quaternion;
 using Ra::Core::DualQuaternion;
 
@@ -14,6 +19,7 @@ using Ra::Core::Animation::Skeleton;
 using Ra::Core::Animation::Pose;
 using Ra::Core::Animation::RefPose;
 using Ra::Core::Animation::WeightMatrix;
+using Ra::Core::Animation::DQList;
 
 typedef Ra::Core::Animation::Handle::SpaceType SpaceType;
 
@@ -24,6 +30,17 @@ using Ra::Engine::ComponentMessenger;
 namespace SkinningPlugin
 {
 
+namespace
+{
+    // Directory where the centers of rotation are cached (empty : no cache).
+    std::string g_corCacheDirectory;
+}
+
+void SkinningComponent::setCoRCacheDirectory( const std::string& directory )
+{
+    g_corCacheDirectory = directory;
+}
+
 void SkinningComponent::setupSkinning()
 {
     // get the current animation data.
@@ -31,6 +48,7 @@ void SkinningComponent::setupSkinning()
     bool hasWeights = ComponentMessenger::getInstance()->canGet<WeightMatrix>(getEntity(), m_contentsName);
     bool hasRefPose = ComponentMessenger::getInstance()->canGet<RefPose>(getEntity(), m_contentsName);
     bool hasMesh    = ComponentMessenger::getInstance()->canGet<TriangleMesh>(getEntity(), m_contentsName);
+    bool hasRO      = ComponentMessenger::getInstance()->canGet<Ra::Core::Index>(getEntity(), m_contentsName);
 
 
     if ( hasSkel && hasWeights && hasMesh && hasRefPose )
@@ -43,6 +61,13 @@ void SkinningComponent::setupSkinning()
         m_refData.m_referenceMesh   = ComponentMessenger::getInstance()->get<TriangleMesh>( getEntity(), m_contentsName );
         m_refData.m_refPose         = ComponentMessenger::getInstance()->get<RefPose> ( getEntity(), m_contentsName );
         m_refData.m_weights         = ComponentMessenger::getInstance()->get<WeightMatrix> ( getEntity(), m_contentsName );
+        Ra::Core::Animation::buildInfluenceTable( m_refData.m_weights, MaxInfluences, false, m_refData.m_influences );
+        m_normalUpdater.build( m_refData.m_referenceMesh.m_vertices.size(), m_refData.m_referenceMesh.m_triangles );
+
+        if ( hasRO )
+        {
+            m_renderObjectIndex = ComponentMessenger::getInstance()->get<Ra::Core::Index>( getEntity(), m_contentsName );
+        }
 
         m_frameData.m_previousPose = m_refData.m_refPose;
         m_frameData.m_doSkinning = false;
@@ -79,25 +104,28 @@ void SkinningComponent::skin()
     else
     {
         m_frameData.m_currentPose = skel->getPose(SpaceType::MODEL);
-        if ( !Ra::Core::Animation::areEqual( m_frameData.m_currentPose, m_frameData.m_previousPose))
+        if ( m_forceSkinning || !Ra::Core::Animation::areEqual( m_frameData.m_currentPose, m_frameData.m_previousPose))
         {
+            m_forceSkinning = false;
             m_frameData.m_doSkinning = true;
             m_frameData.m_refToCurrentRelPose = Ra::Core::Animation::relativePose(m_frameData.m_currentPose, m_refData.m_refPose);
             m_frameData.m_prevToCurrentRelPose = Ra::Core::Animation::relativePose(m_frameData.m_currentPose, m_frameData.m_previousPose);
 
+            // The per-vertex dual quaternions are only computed for components reading them.
+            const bool computeDQ = ComponentMessenger::getInstance()->hasConsumers<DQList>( getEntity(), m_contentsName );
+
             switch ( m_skinningType )
             {
             case LBS:
             {
-                Ra::Core::Animation::linearBlendSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_frameData.m_currentPos );
+                Ra::Core::Animation::linearBlendSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_influences, m_frameData.m_currentPos );
                 break;
             }
             case DQS:
             {
-                Ra::Core::AlignedStdVector< DualQuaternion > DQ;
-                //computeDQ( m_frameData.m_prevToCurrentRelPose, m_refData.m_weights, DQ );
-                Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_weights, DQ );
-                Ra::Core::Animation::dualQuaternionSkinning( m_refData.m_referenceMesh.m_vertices, DQ, m_frameData.m_currentPos );
+                Ra::Core::Animation::dualQuaternionSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose,
+                                                             m_refData.m_influences, m_frameData.m_currentPos,
+                                                             computeDQ ? &m_DQ : nullptr );
                 break;
             }
             case COR:
@@ -105,8 +133,22 @@ void SkinningComponent::skin()
                 Ra::Core::Animation::corSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_refData.m_CoR, m_frameData.m_currentPos );
                 break;
             }
+            case LBS_GPU:
+            {
+                // The palette is uploaded in endSkinning(). When the skeleton does not fit in the shader,
+                // the reference implementation skins the vertices on the CPU instead.
+                Ra::Core::Animation::computeGPUSkinningPalette( m_frameData.m_refToCurrentRelPose, m_palette );
+                if ( !m_gpuSkinning )
+                {
+                    Ra::Core::Animation::gpuSkinning( m_refData.m_referenceMesh.m_vertices, m_palette, m_gpuWeights, m_gpuIndices, m_frameData.m_currentPos );
+                }
+                break;
+            }
+            }
+            if ( computeDQ && m_skinningType != DQS )
+            {
+                Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_influences, m_DQ );
             }
-            Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_DQ );
         }
     }
 }
@@ -115,12 +157,20 @@ void SkinningComponent::endSkinning()
 {
     if (m_frameData.m_doSkinning)
     {
-        Ra::Core::Vector3Array& vertices = *(m_verticesWriter());
-        Ra::Core::Vector3Array& normals = *(m_normalsWriter());
+        if ( m_skinningType == LBS_GPU && m_gpuSkinning )
+        {
+            // The display mesh keeps its reference vertices.
+            setGPUSkinningParameters( true );
+        }
+        else
+        {
+            Ra::Core::Vector3Array& vertices = *(m_verticesWriter());
+            Ra::Core::Vector3Array& normals = *(m_normalsWriter());
 
-        vertices = m_frameData.m_currentPos;
+            vertices = m_frameData.m_currentPos;
 
-        Ra::Core::Geometry::uniformNormal( vertices, m_refData.m_referenceMesh.m_triangles, normals );
+            m_normalUpdater.compute( vertices, normals );
+        }
 
         std::swap( m_frameData.m_previousPose, m_frameData.m_currentPose );
         std::swap( m_frameData.m_previousPos, m_frameData.m_currentPos );
@@ -143,6 +193,12 @@ void SkinningComponent::endSkinning()
         m_frameData.m_currentPos    = m_refData.m_referenceMesh.m_vertices;
         m_frameData.m_previousPos   = m_refData.m_referenceMesh.m_vertices;
         m_frameData.m_currentNormal = m_refData.m_referenceMesh.m_normals;
+
+        if ( m_skinningType == LBS_GPU && m_gpuSkinning )
+        {
+            m_palette.assign( m_palette.size(), Ra::Core::Matrix4::Identity() );
+            setGPUSkinningParameters( true );
+        }
     }
 }
 
@@ -154,10 +210,8 @@ void SkinningComponent::handleWeightsLoading(const Ra::Asset::HandleData *data)
 
 void SkinningComponent::setupIO( const std::string& id )
 {
-    typedef Ra::Core::AlignedStdVector< Ra::Core::DualQuaternion > DualQuatVector;
-
-    ComponentMessenger::CallbackTypes<DualQuatVector>::Getter dqOut = std::bind( &SkinningComponent::getDQ, this );
-    ComponentMessenger::getInstance()->registerOutput<DualQuatVector>( getEntity(), this, id, dqOut);
+    ComponentMessenger::CallbackTypes<DQList>::Getter dqOut = std::bind( &SkinningComponent::getDQ, this );
+    ComponentMessenger::getInstance()->registerOutput<DQList>( getEntity(), this, id, dqOut);
 
     ComponentMessenger::CallbackTypes<RefData>::Getter refData = std::bind( &SkinningComponent::getRefData, this );
     ComponentMessenger::getInstance()->registerOutput<Ra::Core::Skinning::RefData>( getEntity(), this, id, refData);
@@ -168,25 +222,80 @@ void SkinningComponent::setupIO( const std::string& id )
 
 void SkinningComponent::setSkinningType( SkinningType type )
 {
+    if ( m_skinningType == LBS_GPU && type != LBS_GPU && m_gpuSkinning )
+    {
+        // The display mesh holds the reference vertices, which are skinned on the CPU again.
+        setGPUSkinningParameters( false );
+        m_gpuSkinning = false;
+    }
+
     m_skinningType = type;
     if ( m_isReady )
     {
+        m_forceSkinning = true;
         setupSkinningType( type );
     }
 }
 
+void SkinningComponent::setGPUSkinningParameters( bool enabled )
+{
+    std::shared_ptr<Ra::Engine::RenderObject> ro = getRoMgr()->getRenderObject( m_renderObjectIndex );
+    Ra::Engine::RenderParameters& params = ro->getRenderParameters();
+    params.updateParameter( "skinning.enabled", enabled ? 1 : 0 );
+
+    // The display mesh keeps its reference vertices : culling uses the union of the reference box
+    // moved by each bone, which contains every blend of these transforms.
+    Ra::Core::Aabb aabb;
+    if ( enabled )
+    {
+        params.updateParameter( "skinning.palette", m_palette );
+        if ( !m_refAabb.isEmpty() )
+        {
+            for ( const auto& m : m_palette )
+            {
+                for ( int i = 0; i < 8; ++i )
+                {
+                    aabb.extend( Ra::Core::Transform( m ) * m_refAabb.corner( (Ra::Core::Aabb::CornerType)i ) );
+                }
+            }
+        }
+    }
+    ro->setCustomAabb( aabb );
+}
+
 void SkinningComponent::setupSkinningType( SkinningType type )
 {
     CORE_ASSERT( m_isReady, "component is not ready" );
     switch ( type )
     {
     case LBS: break;
-    case DQS:
+    case DQS: break;
+    case LBS_GPU:
     {
-        if ( m_DQ.empty() )
+        if ( m_gpuWeights.empty() )
+        {
+            Ra::Core::Animation::packGPUSkinningWeights( m_refData.m_weights, m_gpuWeights, m_gpuIndices );
+        }
+
+        m_gpuSkinning = m_renderObjectIndex.isValid()
+                        && m_refData.m_skeleton.size() <= Ra::Core::Animation::GPUSkinningMaxBones;
+        if ( m_gpuSkinning )
+        {
+            // The influences are sent once, as vertex attributes, and the shader skins the reference vertices.
+            const std::shared_ptr<Ra::Engine::Mesh>& mesh = getRoMgr()->getRenderObject( m_renderObjectIndex )->getMesh();
+            mesh->addData( Ra::Engine::Mesh::VERTEX_WEIGHTS, m_gpuWeights );
+            mesh->addData( Ra::Engine::Mesh::VERTEX_WEIGHT_IDX, m_gpuIndices );
+
+            *(m_verticesWriter()) = m_refData.m_referenceMesh.m_vertices;
+            *(m_normalsWriter())  = m_refData.m_referenceMesh.m_normals;
+
+            m_palette.assign( m_refData.m_skeleton.size(), Ra::Core::Matrix4::Identity() );
+            m_refAabb = Ra::Core::MeshUtils::getAabb( m_refData.m_referenceMesh );
+            setGPUSkinningParameters( true );
+        }
+        else
         {
-            m_DQ.resize( m_refData.m_weights.rows(), DualQuaternion( Quaternion( 0.0, 0.0, 0.0, 0.0 ),
-                Quaternion( 0.0, 0.0, 0.0, 0.0 ) ) );
+            LOG( logWARNING ) << "Mesh " << m_contentsName << " can not be skinned on the GPU, using the CPU implementation.";
         }
         break;
     }
@@ -194,7 +303,7 @@ void SkinningComponent::setupSkinningType( SkinningType type )
     {
         if ( m_refData.m_CoR.empty() )
         {
-            Ra::Core::Animation::computeCoR( m_refData );
+            Ra::Core::Animation::computeCoRCached( m_refData, g_corCacheDirectory );
 /*
             for ( const auto& v :m_refData.m_CoR )
             {
@@ -8,6 +8,8 @@
 #include <Core/Animation/Handle/HandleWeight.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Skinning/SkinningData.hpp>
+#include <Core/Animation/Skinning/GPUSkinning.hpp>
+#include <Core/Geometry/Normal/NormalUpdater.hpp>
 
 #include <Engine/Assets/HandleData.hpp>
 #include <Engine/Component/Component.hpp>
@@ -24,13 +26,19 @@ namespace SkinningPlugin
         {
             LBS = 0, // Linear Blend Skinning
             DQS,     // Dual Quaternion Skinning
-            COR      // Center of Rotation skinning
+            COR,     // Center of Rotation skinning
+            LBS_GPU  // Linear Blend Skinning of the 4 largest influences, done by the vertex shader
         };
 
+        /// Maximum number of influences per vertex kept by the per-vertex skinning kernels.
+        static const uint MaxInfluences = 8;
+
         SkinningComponent( const std::string& name, SkinningType type = DQS)
             : Component(name),
             m_skinningType( type ),
-            m_isReady(false) {}
+            m_isReady(false),
+            m_forceSkinning(false),
+            m_gpuSkinning(false) {}
         virtual ~SkinningComponent() {}
 
         virtual void initialize() override { setupSkinning();}
@@ -39,6 +47,10 @@ namespace SkinningPlugin
         void endSkinning();
         void setupSkinning();
 
+        /// Sets the directory where the centers of rotation of COR skinning are cached
+        /// between runs. An empty string disables the cache.
+        static void setCoRCacheDirectory( const std::string& directory );
+
         void setSkinningType( SkinningType type  );
         inline SkinningType getSkinningType() const { return m_skinningType; }
 
@@ -47,12 +59,18 @@ namespace SkinningPlugin
 
         const Ra::Core::Skinning::RefData* getRefData() const { return &m_refData;}
         const Ra::Core::Skinning::FrameData* getFrameData() const { return &m_frameData;}
+        /// Per-vertex dual quaternions of the current pose. They are only updated while
+        /// a component is registered as a consumer of this output (see ComponentMessenger::registerConsumer()).
         const Ra::Core::AlignedStdVector< Ra::Core::DualQuaternion >* getDQ() const {return &m_DQ;}
 
     private:
         void setupIO(const std::string &id);
         void setupSkinningType( SkinningType type);
 
+        /// Sets the skinning uniforms of the display mesh. The bone palette is the only
+        /// data sent to the GPU at each frame in LBS_GPU mode.
+        void setGPUSkinningParameters( bool enabled );
+
     private:
 
             std::string m_contentsName;
@@ -66,10 +84,27 @@ namespace SkinningPlugin
             Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Vector3Array>::ReadWrite m_verticesWriter;
             Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Vector3Array>::ReadWrite m_normalsWriter;
 
+            // Render object of the skinned mesh, holding the uniforms of GPU skinning.
+            Ra::Core::Index m_renderObjectIndex;
+
+            // Vertex normals of the skinned mesh, recomputed in parallel after each skinning.
+            Ra::Core::Geometry::NormalUpdater m_normalUpdater;
+
             Ra::Core::AlignedStdVector< Ra::Core::DualQuaternion > m_DQ;
 
+            // Packed influences, uploaded once as the weight vertex attributes, and bone palette of LBS_GPU.
+            Ra::Core::Vector4Array m_gpuWeights;
+            Ra::Core::Vector4Array m_gpuIndices;
+            Ra::Core::Animation::BonePalette m_palette;
+            // Bounding box of the reference mesh, moved by the palette to bound the mesh skinned by the shader.
+            Ra::Core::Aabb m_refAabb;
+
             SkinningType m_skinningType;
             bool m_isReady;
+            // Skins the next frame even if the pose did not change (e.g. after a change of skinning type).
+            bool m_forceSkinning;
+            // True when LBS_GPU actually runs on the GPU (the skeleton fits in the shader palette).
+            bool m_gpuSkinning;
     };
 }
 
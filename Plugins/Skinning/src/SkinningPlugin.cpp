@@ -3,8 +3,12 @@
 #include <Engine/RadiumEngine.hpp>
 
 #include <SkinningSystem.hpp>
+#include <SkinningComponent.hpp>
 #include <GuiBase/SelectionManager/SelectionManager.hpp>
 
+#include <QDir>
+#include <QStandardPaths>
+
 namespace SkinningPlugin
 {
 
@@ -17,6 +21,13 @@ namespace SkinningPlugin
         m_system = new SkinningSystem;
         m_selectionManager = context.m_selectionManager;
         context.m_engine->registerSystem( "SkinningSystem", m_system );
+
+        // Centers of rotation are expensive to compute : keep them between runs.
+        const QString cacheDir = QStandardPaths::writableLocation( QStandardPaths::CacheLocation ) + "/CoR";
+        if ( QDir().mkpath( cacheDir ) )
+        {
+            SkinningComponent::setCoRCacheDirectory( cacheDir.toStdString() );
+        }
     }
 
     bool SkinningPluginC::doAddWidget( QString &name )
@@ -62,13 +73,14 @@ namespace SkinningPlugin
         m_current( nullptr )
     {
         m_skinningSelect = new QComboBox( this );
-        m_skinningSelect->setMaxVisibleItems( 3 );
-        m_skinningSelect->setMaxCount( 3 );
+        m_skinningSelect->setMaxVisibleItems( 4 );
+        m_skinningSelect->setMaxCount( 4 );
         m_skinningSelect->setDuplicatesEnabled( false );
         m_skinningSelect->setCurrentIndex( 1 );
 
         m_skinningSelect->insertItems( 0, QStringList()
-            << "Linear Blend Skinning" << "Dual Quaternion Skinning" << "Center of Rotation skinning" );
+            << "Linear Blend Skinning" << "Dual Quaternion Skinning" << "Center of Rotation skinning"
+            << "Linear Blend Skinning (GPU)" );
         m_skinningSelect->setEnabled( false );
 
         connect( m_skinningSelect,
@@ -96,7 +108,7 @@ namespace SkinningPlugin
     void SkinningWidget::onSkinningChanged( int newType )
     {
         CORE_ASSERT( m_current, "should be disabled" );
-        CORE_ASSERT( newType >= 0 && newType < 3, "Invalid Skinning Type" );
+        CORE_ASSERT( newType >= 0 && newType < 4, "Invalid Skinning Type" );
         m_current->setSkinningType( SkinningComponent::SkinningType( newType ) );
     }
 
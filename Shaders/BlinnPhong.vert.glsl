@@ -5,10 +5,13 @@ layout (location = 1) in vec3 in_normal;
 layout (location = 2) in vec3 in_tangent;
 layout (location = 3) in vec3 in_bitangent;
 layout (location = 4) in vec3 in_texcoord;
+layout (location = 6) in vec4 in_weights;
+layout (location = 7) in vec4 in_weightIdx;
 // TODO(Charly): Add other inputs
 
 uniform Transform transform;
 uniform Material material;
+uniform Skinning skinning;
 
 uniform mat4 uLightSpace;
 
@@ -20,12 +23,25 @@ layout (location = 4) out vec3 out_tangent;
 
 void main()
 {
+    vec3 position = in_position;
+    vec3 vertexNormal = in_normal;
+    if (skinning.enabled == 1)
+    {
+        // Linear blend of the 4 largest influences (see Core/Animation/Skinning/GPUSkinning.hpp).
+        mat4 skin = in_weights.x * skinning.palette[int(in_weightIdx.x)]
+                  + in_weights.y * skinning.palette[int(in_weightIdx.y)]
+                  + in_weights.z * skinning.palette[int(in_weightIdx.z)]
+                  + in_weights.w * skinning.palette[int(in_weightIdx.w)];
+        position = vec3(skin * vec4(in_position, 1.0));
+        vertexNormal = normalize(mat3(skin) * in_normal);
+    }
+
     mat4 mvp = transform.proj * transform.view * transform.model;
-    gl_Position = mvp * vec4(in_position, 1.0);
+    gl_Position = mvp * vec4(position, 1.0);
 
-    vec4 pos = transform.model * vec4(in_position, 1.0);
+    vec4 pos = transform.model * vec4(position, 1.0);
     pos /= pos.w;
-    vec3 normal = mat3(transform.worldNormal) * in_normal;
+    vec3 normal = mat3(transform.worldNormal) * vertexNormal;
 
     vec3 eye = -transform.view[3].xyz * mat3(transform.view);
 
@@ -0,0 +1,90 @@
+#include "Structs.glsl"
+
+// Lights binned in the clusters of the view frustum (see Engine/Renderer/Light/ClusteredLights.hpp).
+struct Clusters
+{
+    samplerBuffer lights;   // 4 texels per light
+    usamplerBuffer grid;    // Offset and count of each cluster in indices
+    usamplerBuffer indices;
+
+    int globalCount;        // Lights shaded by every fragment, before the binned ones
+
+    int tileX;
+    int tileY;
+    int sliceZ;
+    vec2 screen;
+    float zNear;
+    float sliceScale;
+};
+
+uniform Transform transform;
+uniform Material material;
+uniform Clusters clusters;
+
+out vec4 fragColor;
+
+layout (location = 0) in vec3 in_position;
+layout (location = 1) in vec3 in_normal;
+layout (location = 2) in vec3 in_texcoord;
+layout (location = 3) in vec3 in_eye;
+layout (location = 4) in vec3 in_tangent;
+
+// Filled for each light, and used by the lighting functions.
+Light light;
+
+#include "LightingFunctions.glsl"
+
+void fetchLight(int i)
+{
+    vec4 color       = texelFetch(clusters.lights, 4 * i);
+    vec4 position    = texelFetch(clusters.lights, 4 * i + 1);
+    vec4 direction   = texelFetch(clusters.lights, 4 * i + 2);
+    vec4 attenuation = texelFetch(clusters.lights, 4 * i + 3);
+
+    light.type  = int(color.w);
+    light.color = vec4(color.xyz, 1.0);
+
+    light.directional.direction = direction.xyz;
+
+    light.point.position = position.xyz;
+    light.point.attenuation = Attenuation(attenuation.x, attenuation.y, attenuation.z);
+
+    light.spot.position = position.xyz;
+    light.spot.direction = direction.xyz;
+    light.spot.attenuation = light.point.attenuation;
+    light.spot.innerAngle = position.w;
+    light.spot.outerAngle = direction.w;
+}
+
+int getCluster()
+{
+    float depth = -(transform.view * vec4(in_position, 1.0)).z;
+    int slice = int(log(max(depth, clusters.zNear) / clusters.zNear) * clusters.sliceScale);
+    ivec2 tile = ivec2(gl_FragCoord.xy / clusters.screen * vec2(clusters.tileX, clusters.tileY));
+
+    slice = clamp(slice, 0, clusters.sliceZ - 1);
+    tile = clamp(tile, ivec2(0), ivec2(clusters.tileX - 1, clusters.tileY - 1));
+    return tile.x + clusters.tileX * (tile.y + clusters.tileY * slice);
+}
+
+void main()
+{
+    if (toDiscard()) discard;
+
+    vec3 color = vec3(0.0);
+
+    for (int i = 0; i < clusters.globalCount; ++i)
+    {
+        fetchLight(i);
+        color += computeLighting();
+    }
+
+    uvec2 cluster = texelFetch(clusters.grid, getCluster()).xy;
+    for (uint i = 0u; i < cluster.y; ++i)
+    {
+        fetchLight(clusters.globalCount + int(texelFetch(clusters.indices, int(cluster.x + i)).x));
+        color += computeLighting();
+    }
+
+    fragColor = vec4(color, 1.0);
+}
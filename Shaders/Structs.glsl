@@ -9,6 +9,15 @@ struct Transform
     mat4 viewNormal;
 };
 
+// Must match Ra::Core::Animation::GPUSkinningMaxBones
+#define MAX_BONES 64
+
+struct Skinning
+{
+    int enabled;
+    mat4 palette[MAX_BONES];
+};
+
 struct Textures
 {
     int hasKd;
@@ -0,0 +1,176 @@
+#include <Core/Algorithm/HeatDiffusion/DiffusionContext.hpp>
+
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Algorithm {
+
+namespace {
+// Number of right-hand sides solved together by a task.
+enum { SolveBlockSize = 8 };
+
+// Right-hand sides solved together, stored row by row: the factor is read once for the whole block.
+typedef Eigen::Matrix< Scalar, Eigen::Dynamic, SolveBlockSize, Eigen::RowMajor > SolveBlock;
+
+// Solve L L^T X = X in place, where L is the compressed lower triangular factor, with its diagonal first in each column.
+void solveBlock( const Sparse& L, SolveBlock& X ) {
+    CORE_ASSERT( L.isCompressed(), "The factor should be compressed" );
+    typedef Eigen::Matrix< Scalar, 1, SolveBlockSize > Row;
+    typedef Eigen::Map< Row, Eigen::Unaligned > RowMap;
+    const uint    n     = L.cols();
+    const int*    outer = L.outerIndexPtr();
+    const int*    inner = L.innerIndexPtr();
+    const Scalar* value = L.valuePtr();
+    Scalar*       x     = X.data();
+    for( uint j = 0; j < n; ++j ) {
+        CORE_ASSERT( uint( inner[outer[j]] ) == j, "Missing diagonal" );
+        RowMap xj( x + j * SolveBlockSize );
+        xj /= value[outer[j]];
+        const Row r = xj;
+        for( int e = outer[j] + 1; e < outer[j + 1]; ++e ) {
+            RowMap( x + inner[e] * SolveBlockSize ) -= value[e] * r;
+        }
+    }
+    for( uint j = n; j-- > 0; ) {
+        Row r = Row::Zero();
+        for( int e = outer[j] + 1; e < outer[j + 1]; ++e ) {
+            r += value[e] * RowMap( x + inner[e] * SolveBlockSize );
+        }
+        RowMap xj( x + j * SolveBlockSize );
+        xj = ( xj - r ) / value[outer[j]];
+    }
+}
+}
+
+
+
+DiffusionContext::DiffusionContext() : m_analysisCount( 0 ), m_valid( false ) { }
+
+
+
+void DiffusionContext::buildSystem( const Geometry::AreaVector& A, const Time& t, const Geometry::LaplacianMatrix& L ) {
+    CORE_ASSERT( ( A.size() == L.rows() ) && ( L.rows() == L.cols() ), "Inconsistent sizes" );
+    m_area = A;
+    m_system = ( t * L ) + Geometry::diagonalMatrix( A );
+    m_system.makeCompressed();
+}
+
+
+
+bool DiffusionContext::hasAnalyzedPattern() const {
+    return ( ( m_analysisCount > 0 ) &&
+             ( m_outer.size() == uint( m_system.outerSize() + 1 ) ) &&
+             ( m_inner.size() == uint( m_system.nonZeros() ) ) &&
+             std::equal( m_outer.begin(), m_outer.end(), m_system.outerIndexPtr() ) &&
+             std::equal( m_inner.begin(), m_inner.end(), m_system.innerIndexPtr() ) );
+}
+
+
+
+bool DiffusionContext::compute( const Geometry::AreaVector& A, const Time& t, const Geometry::LaplacianMatrix& L ) {
+    buildSystem( A, t, L );
+    m_llt.analyzePattern( m_system );
+    m_outer.assign( m_system.outerIndexPtr(), m_system.outerIndexPtr() + m_system.outerSize() + 1 );
+    m_inner.assign( m_system.innerIndexPtr(), m_system.innerIndexPtr() + m_system.nonZeros() );
+    ++m_analysisCount;
+    m_llt.factorize( m_system );
+    m_valid = ( m_llt.info() == Eigen::Success );
+    return m_valid;
+}
+
+
+
+bool DiffusionContext::compute( const Geometry::AreaMatrix& A, const Time& t, const Geometry::LaplacianMatrix& L ) {
+    return compute( Geometry::AreaVector( A.diagonal() ), t, L );
+}
+
+
+
+bool DiffusionContext::refactorize( const Geometry::AreaVector& A, const Time& t, const Geometry::LaplacianMatrix& L ) {
+    buildSystem( A, t, L );
+    if( !hasAnalyzedPattern() ) {
+        return compute( A, t, L );
+    }
+    m_llt.factorize( m_system );
+    m_valid = ( m_llt.info() == Eigen::Success );
+    return m_valid;
+}
+
+
+
+bool DiffusionContext::isValid() const {
+    return m_valid;
+}
+
+
+
+uint DiffusionContext::size() const {
+    return m_system.rows();
+}
+
+
+
+uint DiffusionContext::getAnalysisCount() const {
+    return m_analysisCount;
+}
+
+
+
+void DiffusionContext::solve( const Delta& delta, Heat& u ) const {
+    CORE_ASSERT( m_valid, "The system is not factorized" );
+    const VectorN b = delta;
+    u.resize( size() );
+    u.getMap() = m_llt.solve( b ).transpose();
+}
+
+
+
+void DiffusionContext::solve( const MatrixN& B, MatrixN& U ) const {
+    CORE_ASSERT( m_valid, "The system is not factorized" );
+    CORE_ASSERT( B.rows() == size(), "Wrong number of rows" );
+    U.resize( B.rows(), B.cols() );
+    const uint blocks = ( B.cols() + SolveBlockSize - 1 ) / SolveBlockSize;
+    parallelFor( 0, blocks, 1, [&]( uint begin, uint end ) {
+        SolveBlock X( size(), int( SolveBlockSize ) );
+        for( uint b = begin; b < end; ++b ) {
+            // The last block is padded with zeros.
+            const uint first = b * SolveBlockSize;
+            const uint cols  = std::min( uint( SolveBlockSize ), uint( B.cols() ) - first );
+            X.leftCols( cols ) = m_llt.permutationP() * B.middleCols( first, cols );
+            X.rightCols( SolveBlockSize - cols ).setZero();
+            solveBlock( m_llt.matrixL().nestedExpression(), X );
+            U.middleCols( first, cols ) = m_llt.permutationPinv() * X.leftCols( cols );
+        }
+    } );
+}
+
+
+
+void DiffusionContext::heat( const Source& source, MatrixN& U ) const {
+    MatrixN B = MatrixN::Zero( size(), source.size() );
+    for( uint k = 0; k < source.size(); ++k ) {
+        B( source[k], k ) = 1.0;
+    }
+    solve( B, U );
+}
+
+
+
+void DiffusionContext::smooth( const VectorArray< Vector3 >& v, VectorArray< Vector3 >& p ) const {
+    CORE_ASSERT( v.size() == size(), "Wrong number of vertices" );
+    const MatrixN B = m_area.asDiagonal() * v.getMap().transpose();
+    MatrixN U;
+    solve( B, U );
+    p.resize( v.size() );
+    p.getMap() = U.transpose();
+}
+
+
+
+}
+}
+}
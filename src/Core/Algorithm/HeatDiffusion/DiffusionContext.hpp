@@ -0,0 +1,99 @@
+#ifndef DIFFUSION_CONTEXT
+#define DIFFUSION_CONTEXT
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <Core/Geometry/Area/Area.hpp>
+#include <Core/Geometry/Laplacian/Laplacian.hpp>
+
+#include <Core/Algorithm/Delta/Delta.hpp>
+#include <Core/Algorithm/HeatDiffusion/HeatDiffusion.hpp>
+
+#include <Eigen/SparseCholesky>
+
+namespace Ra {
+namespace Core {
+namespace Algorithm {
+
+/*
+* The class DiffusionContext solves the diffusion equation
+*       ( A + t * L )u = b
+* for many right-hand sides, keeping the factorization of ( A + t * L ) between the solves.
+* The symbolic analysis (fill-reducing ordering and elimination tree) only depends on the pattern of L:
+* when the weights, the areas or the time change, refactorize() only recomputes the numeric factorization.
+*
+* Besides the heat from sources, the same system gives the implicit (backward Euler) smoothing of a function f:
+*       ( A + t * L )f' = A * f
+* which is stable for any time step, as opposed to the iterations of laplacianSmoothing().
+*/
+/// WARNING: L must be a positive semi-definite matrix
+class RA_CORE_API DiffusionContext {
+public:
+    /// CONSTRUCTOR
+    DiffusionContext();
+
+    /// FACTORIZATION
+    // Analyze the pattern of ( A + t * L ) and factorize it. Return false if the factorization failed.
+    bool compute( const Geometry::AreaVector& A, const Time& t, const Geometry::LaplacianMatrix& L );
+    bool compute( const Geometry::AreaMatrix& A, const Time& t, const Geometry::LaplacianMatrix& L );
+
+    // Factorize ( A + t * L ) again, reusing the symbolic analysis if the pattern of the system did not change
+    // (e.g. new cotangent weights of a deformed mesh, see Geometry::OperatorPattern, or a new time).
+    // Return false if the factorization failed.
+    bool refactorize( const Geometry::AreaVector& A, const Time& t, const Geometry::LaplacianMatrix& L );
+
+    // Return true if the system was factorized successfully.
+    bool isValid() const;
+
+    // Return the number of unknowns.
+    uint size() const;
+
+    // Return the number of symbolic analyses done so far.
+    uint getAnalysisCount() const;
+
+    /// SOLVE
+    // Solve the system for the given right-hand side.
+    void solve( const Delta& delta, Heat& u ) const;
+
+    /*
+    * Solve the system for each column of B.
+    * The columns are solved by blocks, which read the factorization once, in parallel (see parallelFor()).
+    */
+    void solve( const MatrixN& B, MatrixN& U ) const;
+
+    /*
+    * Return in the k-th column of U the heat diffused from the source vertex source[k] (with a unit delta).
+    */
+    void heat( const Source& source, MatrixN& U ) const;
+
+    /*
+    * Return the positions after an implicit smoothing step of time t (see above).
+    */
+    void smooth( const VectorArray< Vector3 >& v, VectorArray< Vector3 >& p ) const;
+
+private:
+    // Build the system ( A + t * L ).
+    void buildSystem( const Geometry::AreaVector& A, const Time& t, const Geometry::LaplacianMatrix& L );
+
+    // Return true if the system has the same pattern as the analyzed one.
+    bool hasAnalyzedPattern() const;
+
+private:
+    Sparse                          m_system;
+    Geometry::AreaVector            m_area;
+    Eigen::SimplicialLLT< Sparse >  m_llt;
+
+    // Pattern of the analyzed system.
+    std::vector< int > m_outer;
+    std::vector< int > m_inner;
+
+    uint m_analysisCount;
+    bool m_valid;
+};
+
+}
+}
+}
+
+#endif // DIFFUSION_CONTEXT
@@ -1,5 +1,7 @@
 #include <Core/Algorithm/HeatDiffusion/HeatDiffusion.hpp>
 
+#include <Core/Algorithm/HeatDiffusion/DiffusionContext.hpp>
+
 namespace Ra {
 namespace Core {
 namespace Algorithm {
@@ -18,10 +20,9 @@ void heat( const Geometry::AreaMatrix&      A,
            const Geometry::LaplacianMatrix& L,
            Heat&                            u,
            const Delta&                     delta ) {
-    Eigen::SimplicialLLT< Sparse > llt;
-    llt.compute( ( A + ( t * L ) ) );
-    VectorN b = delta;
-    u.getMap() = llt.solve( b );
+    DiffusionContext context;
+    context.compute( A, t, L );
+    context.solve( delta, u );
 }
 
 
@@ -31,10 +32,7 @@ Heat heat( const Geometry::AreaMatrix&      A,
            const Geometry::LaplacianMatrix& L,
            const Delta&                     delta ) {
     Heat u( L.rows() );
-    Eigen::SimplicialLLT< Sparse > llt;
-    llt.compute( ( A + ( t * L ) ) );
-    VectorN b = delta;
-    u.getMap() = llt.solve( b );
+    heat( A, t, L, u, delta );
     return u;
 }
 
@@ -45,6 +45,7 @@ Time t( const Scalar& m, const Scalar& h );
 *       ( A + t * L )u = delta
 * where u is the unknown heating after a time t has passed.
 * The equation is solved using a LL^T decomposition.
+* To solve it repeatedly (e.g. for several sources), use a DiffusionContext, which keeps the decomposition.
 *
 * The definition was taken from:
 * "Geodesics in Heat: A New Approach to Computing Distance Based on Heat Flow"
@@ -36,6 +36,7 @@ void smartClamp( const BitSet& bit, const ScalarValue& value, ScalarValue& clamp
 /*
 * Return the new position of the vertices v_i given the LaplacianMatrix and a set of weight, after a user-defined number of iterations.
 * Within each iteration, the new position is evaluated as the weighted sum of the iteration i and iteration i-1.
+* For an implicit smoothing, stable with large steps, see DiffusionContext::smooth().
 */
 VectorArray< Vector3 > laplacianSmoothing( const VectorArray< Vector3 >& v, const Geometry::LaplacianMatrix& L, const ScalarValue& weight, const uint iteration );
 
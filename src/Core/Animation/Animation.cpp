@@ -1,6 +1,5 @@
 #include <Core/Animation/Animation.hpp>
 #include <algorithm>
-#include <Core/Animation/Pose/PoseOperation.hpp>
 #include <cmath>
 
 namespace Ra {
@@ -18,16 +17,22 @@ struct KeyPoseComparator
 void Animation::addKeyPose(const Pose& pose, Scalar timestamp)
 {
     m_keys.push_back(KeyPose(timestamp, pose));
+    m_times.push_back(timestamp);
+    pushKeyTransforms(pose);
 }
 
 void Animation::addKeyPose(const KeyPose& keyPose)
 {
-    m_keys.push_back(keyPose);
+    addKeyPose(keyPose.second, keyPose.first);
 }
 
 void Animation::clear()
 {
     m_keys.clear();
+    m_times.clear();
+    m_rotations.clear();
+    m_translations.clear();
+    m_poseSize = 0;
 }
 
 bool Animation::isEmpty() const
@@ -39,34 +44,114 @@ void Animation::normalize()
 {
     if (m_keys.size() == 0)
         return;
-    
+
     // sort the keys according to their timestamp
     sort(m_keys.begin(), m_keys.end(), KeyPoseComparator());
-    
+
+    // and the sampling data accordingly
+    m_times.clear();
+    m_rotations.clear();
+    m_translations.clear();
+    for (const auto& key : m_keys)
+    {
+        m_times.push_back(key.first);
+        pushKeyTransforms(key.second);
+    }
 }
 
 Pose Animation::getPose(Scalar timestamp) const
+{
+    CORE_ASSERT(!isEmpty(), "No key pose");
+    const Scalar time = getAnimationTime(timestamp);
+
+    if (m_keys.size() == 1 || time <= m_keys.front().first)
+        return m_keys.front().second;
+
+    Pose pose(m_poseSize);
+    interpolateKeys(findKey(time), time, pose);
+    return pose;
+}
+
+void Animation::getPose(Scalar timestamp, Cursor& cursor, Pose& pose) const
+{
+    CORE_ASSERT(!isEmpty(), "No key pose");
+    const Scalar time = getAnimationTime(timestamp);
+
+    if (m_keys.size() == 1 || time <= m_keys.front().first)
+    {
+        cursor.m_key = 0;
+        pose = m_keys.front().second;
+        return;
+    }
+
+    interpolateKeys(findKey(time, cursor), time, pose);
+}
+
+Scalar Animation::getAnimationTime(Scalar timestamp) const
 {
     Scalar duration = m_keys.back().first;
-    
+
     // ping pong: d - abs(mod(x, 2 * d) - d)
-    Scalar modifiedTime = duration - std::abs(fmod(timestamp, 2 * duration) - duration);
- 
-    if (modifiedTime <= m_keys.front().first)
-        return m_keys.front().second;
-    
-    for ( uint i = 0; i < m_keys.size() - 1; i++ )
+    return duration - std::abs(fmod(timestamp, 2 * duration) - duration);
+}
+
+uint Animation::findKey(Scalar time) const
+{
+    // The interval starts at the last key not after time, the last interval also contains the last key.
+    auto next = std::upper_bound(m_times.begin() + 1, m_times.end() - 1, time);
+    return uint(next - m_times.begin()) - 1;
+}
+
+uint Animation::findKey(Scalar time, Cursor& cursor) const
+{
+    const uint last = m_times.size() - 2;
+    uint i = std::min(cursor.m_key, last);
+
+    // Playback moves by less than a key in most cases : check the cached interval
+    // and its neighbours before searching the whole array.
+    if (time < m_times[i])
+    {
+        i = (i > 0 && time >= m_times[i - 1]) ? i - 1 : findKey(time);
+    }
+    else if (i < last && time >= m_times[i + 1])
+    {
+        i = (i + 1 == last || time < m_times[i + 2]) ? i + 1 : findKey(time);
+    }
+
+    cursor.m_key = i;
+    return i;
+}
+
+void Animation::interpolateKeys(uint i, Scalar time, Pose& pose) const
+{
+    const Scalar t0 = m_times[i];
+    const Scalar t1 = m_times[i + 1];
+    const Scalar t = (t1 > t0) ? std::min((time - t0) / (t1 - t0), Scalar(1)) : Scalar(0);
+
+    pose.resize(m_poseSize);
+    const Quaternion* rot0 = m_rotations.data() + i * m_poseSize;
+    const Quaternion* rot1 = rot0 + m_poseSize;
+    const Vector3* tr0 = m_translations.data() + i * m_poseSize;
+    const Vector3* tr1 = tr0 + m_poseSize;
+    for (uint k = 0; k < m_poseSize; ++k)
+    {
+        pose[k].linear() = rot0[k].slerp(t, rot1[k]).toRotationMatrix();
+        pose[k].translation() = (1 - t) * tr0[k] + t * tr1[k];
+    }
+}
+
+void Animation::pushKeyTransforms(const Pose& pose)
+{
+    if (m_times.size() == 1)
+        m_poseSize = pose.size();
+    CORE_ASSERT(pose.size() == m_poseSize, "Key poses should have the same size");
+
+    // Transform::rotation() is a polar decomposition : done once per key instead of once per sample.
+    for (const auto& transform : pose)
     {
-        if (modifiedTime >= m_keys[i].first && modifiedTime <= m_keys[i + 1].first)
-        {
-            const KeyPose& prev = m_keys[i];
-            const KeyPose& next = m_keys[i + 1];
-            Scalar t = (modifiedTime - prev.first) / (next.first - prev.first);
-            return Ra::Core::Animation::interpolatePoses(m_keys[i].second, m_keys[i + 1].second, t);
-        }
+        m_rotations.push_back(Quaternion(transform.rotation()));
+        m_translations.push_back(transform.translation());
     }
-    
-    return m_keys.back().second;
 }
 
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <utility>
 #include <Core/Animation/Pose/Pose.hpp>
+#include <Core/Containers/VectorArray.hpp>
 
 namespace Ra {
 namespace Core {
@@ -11,29 +12,71 @@ namespace Animation {
 
 typedef std::pair<Scalar, Pose> KeyPose;
 
-class RA_CORE_API Animation 
+class RA_CORE_API Animation
 {
 public:
+    // Playback position of one caller (e.g. one animated character) in the animation.
+    // Remembers the key interval of the last sample, so that the next one is found
+    // in constant time when the time moves forward or backward by less than a key.
+    struct Cursor
+    {
+        uint m_key = 0;
+    };
+
     // Add the key pose after the previous ones.
     // Call normalize after all the key poses have been added.
     // timestamp must be given in seconds.
     void addKeyPose(const Pose& pose, Scalar timestamp);
     void addKeyPose(const KeyPose& keyPose);
-    
+
     // Remove all the key poses.
     void clear();
-    
+
     bool isEmpty() const;
-    
+
     // Re-order the poses by chronological order.
     void normalize();
-    
+
     // Get the pose corresponding to the given timestamp.
     // timestamp must be given in seconds.
     Pose getPose(Scalar timestamp) const;
-    
+
+    // Same as getPose(timestamp), without allocation when pose already has the right size.
+    // The key interval is searched from the cursor, which is updated.
+    void getPose(Scalar timestamp, Cursor& cursor, Pose& pose) const;
+
+    // Number of key poses.
+    inline uint getKeySize() const { return m_times.size(); }
+
+    // Time of the last key pose, in seconds.
+    inline Scalar getDuration() const { return m_times.empty() ? 0 : m_times.back(); }
+
+    // Number of transforms of each key pose.
+    inline uint getPoseSize() const { return m_poseSize; }
+
+private:
+    // Time in [first key, last key] corresponding to timestamp (ping pong playback).
+    Scalar getAnimationTime(Scalar timestamp) const;
+
+    // Index i of the key interval [m_times[i], m_times[i + 1]] containing time.
+    uint findKey(Scalar time) const;
+    uint findKey(Scalar time, Cursor& cursor) const;
+
+    // Interpolates the transforms of keys i and i + 1.
+    void interpolateKeys(uint i, Scalar time, Pose& pose) const;
+
+    // Appends the decomposed transforms of a key pose.
+    void pushKeyTransforms(const Pose& pose);
+
 private:
     std::vector<KeyPose> m_keys;
+
+    // Sampling data, in the order of m_keys : key times, and for each key its rotations
+    // and translations (the transforms of key i start at i * m_poseSize).
+    std::vector<Scalar> m_times;
+    AlignedStdVector<Quaternion> m_rotations;
+    Vector3Array m_translations;
+    uint m_poseSize = 0;
 };
 
 }
@@ -0,0 +1,474 @@
+#include <Core/Animation/CompressedAnimation.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace {
+
+// The three smallest components of a unit quaternion are in [-QuatRange, QuatRange], quantized on 15 bits.
+const Scalar QuatRange = Scalar(0.70710678);
+const Scalar QuatStep = 2 * QuatRange / 32767;
+
+// Number of keys of a track of n samples keeping one sample every step (0 for a constant track).
+uint keyCount(uint n, uint step)
+{
+    return (step == 0 || n == 1) ? 1 : (n - 1 + step - 1) / step + 1;
+}
+
+// k for a step 2^k (0 for a constant track).
+uint stepShift(uint step)
+{
+    uint shift = 0;
+    while ((2u << shift) <= step)
+        ++shift;
+    return shift;
+}
+
+// Largest step 2^k for which the linear interpolation of the kept samples stays within
+// the tolerance of all the samples, 0 if the track is constant.
+template <typename Samples, typename Lerp, typename Distance>
+uint findStep(const Samples& samples, Scalar tolerance, const Lerp& lerp, const Distance& distance)
+{
+    const uint n = samples.size();
+    bool constant = true;
+    for (uint i = 1; i < n && constant; ++i)
+        constant = distance(samples[i], samples[0]) <= tolerance;
+    if (constant)
+        return 0;
+
+    auto fits = [&](uint step)
+    {
+        const uint count = keyCount(n, step);
+        for (uint i = 0; i < n; ++i)
+        {
+            const uint s0 = std::min(i / step, count - 2) * step;
+            const uint s1 = std::min(s0 + step, n - 1);
+            const Scalar w = Scalar(i - s0) / Scalar(s1 - s0);
+            if (distance(lerp(samples[s0], samples[s1], w), samples[i]) > tolerance)
+                return false;
+        }
+        return true;
+    };
+
+    uint best = 1;
+    for (uint step = 2; fits(step); step *= 2)
+    {
+        best = step;
+        if (step >= n - 1)
+            break;
+    }
+    return best;
+}
+
+// Normalized linear interpolation, in the hemisphere of q0.
+Quaternion nlerp(const Quaternion& q0, const Quaternion& q1, Scalar w)
+{
+    const Vector4 c1 = (q0.dot(q1) < 0) ? Vector4(-q1.coeffs()) : Vector4(q1.coeffs());
+    const Vector4 c = q0.coeffs() + w * (c1 - q0.coeffs());
+    return Quaternion(c.normalized());
+}
+
+Scalar angle(const Quaternion& q0, const Quaternion& q1)
+{
+    return 2 * std::acos(std::min(std::abs(q0.dot(q1)), Scalar(1)));
+}
+
+// Rotation and scale of a transform without shear (linear part = rotation * scale.asDiagonal()).
+// Cheaper than Transform::computeRotationScaling(), and without its iterative SVD.
+void decompose(const Transform& transform, Quaternion& rotation, Vector3& scale)
+{
+    Matrix3 linear = transform.linear();
+    scale = linear.colwise().norm().transpose();
+    for (uint c = 0; c < 3; ++c)
+    {
+        if (scale[c] > 0)
+            linear.col(c) /= scale[c];
+    }
+    if (linear.determinant() < 0)
+    {
+        scale[0] = -scale[0];
+        linear.col(0) = -linear.col(0);
+    }
+    rotation = Quaternion(linear);
+}
+
+// Smallest three encoding : the largest component is dropped (and made positive), its index is
+// stored in the top bits of the first two words.
+std::array<uint16_t, 3> encodeQuaternion(const Quaternion& q)
+{
+    const Vector4 c = q.normalized().coeffs();
+    uint largest;
+    c.cwiseAbs().maxCoeff(&largest);
+    const Scalar sign = (c[largest] < 0) ? -1 : 1;
+
+    std::array<uint16_t, 3> key;
+    uint k = 0;
+    for (uint i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        const Scalar u = std::round((sign * c[i] + QuatRange) / QuatStep);
+        key[k++] = uint16_t(std::max(Scalar(0), std::min(u, Scalar(32767))));
+    }
+    key[0] |= uint16_t((largest & 1) << 15);
+    key[1] |= uint16_t((largest >> 1) << 15);
+    return key;
+}
+
+}
+
+void CompressedAnimation::compress(const Animation& animation, const Options& options)
+{
+    clear();
+    if (animation.isEmpty())
+        return;
+
+    // The sample rate is adjusted so that the last sample is the last key.
+    const Scalar duration = animation.getDuration();
+    const uint n = (duration > 0) ? uint(std::ceil(duration * options.m_sampleRate)) + 1 : 1;
+    Options uniform = options;
+    if (n > 1)
+        uniform.m_sampleRate = (n - 1) / duration;
+
+    std::vector<Pose> samples(n);
+    Animation::Cursor cursor;
+    for (uint i = 0; i < n; ++i)
+        animation.getPose((n > 1) ? duration * i / (n - 1) : 0, cursor, samples[i]);
+    compress(samples, uniform);
+}
+
+void CompressedAnimation::compress(const std::vector<Pose>& samples, const Options& options)
+{
+    clear();
+    if (samples.empty())
+        return;
+
+    const uint n = samples.size();
+    const uint size = samples.front().size();
+    m_sampleSize = n;
+    m_sampleRate = options.m_sampleRate;
+    m_duration = (n - 1) / m_sampleRate;
+
+    AlignedStdVector<Quaternion> rotations(n);
+    Vector3Array translations(n);
+    Vector3Array scales(n);
+    for (uint b = 0; b < size; ++b)
+    {
+        for (uint i = 0; i < n; ++i)
+        {
+            CORE_ASSERT(samples[i].size() == size, "Samples should have the same size");
+            decompose(samples[i][b], rotations[i], scales[i]);
+            // Consecutive samples in the same hemisphere, for the interpolation.
+            if (i > 0 && rotations[i].dot(rotations[i - 1]) < 0)
+                rotations[i].coeffs() *= -1;
+            translations[i] = samples[i][b].translation();
+        }
+        pushRotationTrack(rotations, options.m_rotationTolerance);
+        pushVectorTrack(translations, options.m_translationTolerance, m_translationTracks, m_translationKeys);
+        pushVectorTrack(scales, options.m_scaleTolerance, m_scaleTracks, m_scaleKeys);
+    }
+}
+
+void CompressedAnimation::clear()
+{
+    m_rotationTracks.clear();
+    m_translationTracks.clear();
+    m_scaleTracks.clear();
+    m_rotationKeys.clear();
+    m_translationKeys.clear();
+    m_scaleKeys.clear();
+    m_sampleSize = 0;
+    m_sampleRate = 0;
+    m_duration = 0;
+}
+
+bool CompressedAnimation::isEmpty() const
+{
+    return m_sampleSize == 0;
+}
+
+void CompressedAnimation::getPose(Scalar timestamp, Pose& pose) const
+{
+    CORE_ASSERT(!isEmpty(), "No sample");
+    Scalar f = 0;
+    if (m_duration > 0)
+    {
+        // ping pong: d - abs(mod(x, 2 * d) - d)
+        const Scalar time = m_duration - std::abs(std::fmod(timestamp, 2 * m_duration) - m_duration);
+        f = std::max(Scalar(0), std::min(time * m_sampleRate, Scalar(m_sampleSize - 1)));
+    }
+    decodePose(f, pose);
+}
+
+CompressedAnimation::ErrorReport CompressedAnimation::computeError(const std::vector<Pose>& samples) const
+{
+    CORE_ASSERT(samples.size() == m_sampleSize, "Samples should be the compressed ones");
+    ErrorReport error;
+    Pose pose;
+    for (uint i = 0; i < samples.size(); ++i)
+    {
+        decodePose(Scalar(i), pose);
+        for (uint b = 0; b < pose.size(); ++b)
+        {
+            Quaternion rotation;
+            Quaternion decodedRotation;
+            Vector3 scale;
+            Vector3 decodedScale;
+            decompose(samples[i][b], rotation, scale);
+            decompose(pose[b], decodedRotation, decodedScale);
+            error.m_rotation = std::max(error.m_rotation, angle(decodedRotation, rotation));
+            error.m_translation = std::max(error.m_translation,
+                                           (pose[b].translation() - samples[i][b].translation()).norm());
+            error.m_scale = std::max(error.m_scale, (decodedScale - scale).norm());
+        }
+    }
+    return error;
+}
+
+uint CompressedAnimation::getConstantTrackSize() const
+{
+    uint count = 0;
+    for (const auto& track : m_rotationTracks)
+        count += (track.m_count == 1);
+    for (const auto& track : m_translationTracks)
+        count += (track.m_count == 1);
+    for (const auto& track : m_scaleTracks)
+        count += (track.m_count == 1);
+    return count;
+}
+
+size_t CompressedAnimation::getMemorySize() const
+{
+    return sizeof(Track) * m_rotationTracks.size()
+         + sizeof(VectorTrack) * (m_translationTracks.size() + m_scaleTracks.size())
+         + sizeof(Key) * (m_rotationKeys.size() + m_translationKeys.size() + m_scaleKeys.size());
+}
+
+uint CompressedAnimation::findKey(const Track& track, Scalar f, Scalar& weight) const
+{
+    if (track.m_count == 1)
+    {
+        weight = 0;
+        return track.m_offset;
+    }
+    const uint j = std::min(uint(f) >> track.m_shift, track.m_count - 2);
+    const uint s0 = j << track.m_shift;
+    const uint s1 = std::min(s0 + (1u << track.m_shift), m_sampleSize - 1);
+    weight = (f - s0) / Scalar(s1 - s0);
+    return track.m_offset + j;
+}
+
+void CompressedAnimation::pushRotationTrack(const AlignedStdVector<Quaternion>& samples, Scalar tolerance)
+{
+    const uint n = samples.size();
+    const uint step = findStep(samples, tolerance, nlerp, angle);
+
+    Track track;
+    track.m_offset = m_rotationKeys.size();
+    track.m_count = keyCount(n, step);
+    track.m_shift = stepShift(step);
+    for (uint j = 0; j < track.m_count; ++j)
+        m_rotationKeys.push_back(encodeQuaternion(samples[std::min(j * step, n - 1)]));
+    m_rotationTracks.push_back(track);
+}
+
+void CompressedAnimation::pushVectorTrack(const Vector3Array& samples, Scalar tolerance,
+                                          std::vector<VectorTrack>& tracks, std::vector<Key>& keys)
+{
+    const uint n = samples.size();
+    const uint step = findStep(samples, tolerance,
+                               [](const Vector3& v0, const Vector3& v1, Scalar w) { return Vector3(v0 + w * (v1 - v0)); },
+                               [](const Vector3& v0, const Vector3& v1) { return (v1 - v0).norm(); });
+
+    VectorTrack track;
+    track.m_offset = keys.size();
+    track.m_count = keyCount(n, step);
+    track.m_shift = stepShift(step);
+
+    // Range of the kept samples.
+    Vector3 max = samples[0];
+    track.m_min = samples[0];
+    for (uint j = 1; j < track.m_count; ++j)
+    {
+        track.m_min = track.m_min.cwiseMin(samples[std::min(j * step, n - 1)]);
+        max = max.cwiseMax(samples[std::min(j * step, n - 1)]);
+    }
+    track.m_scale = (max - track.m_min) / 65535;
+
+    for (uint j = 0; j < track.m_count; ++j)
+    {
+        const Vector3& v = samples[std::min(j * step, n - 1)];
+        Key key;
+        for (uint c = 0; c < 3; ++c)
+        {
+            const Scalar u = (track.m_scale[c] > 0) ? std::round((v[c] - track.m_min[c]) / track.m_scale[c]) : 0;
+            key[c] = uint16_t(std::max(Scalar(0), std::min(u, Scalar(65535))));
+        }
+        keys.push_back(key);
+    }
+    tracks.push_back(track);
+}
+
+// Keys of a block of bones, and decoded values, component by component.
+struct CompressedAnimation::DecodeBlock
+{
+    enum { Size = 16 };
+
+    // Gathered keys.
+    Scalar m_weight[Size];
+    Scalar m_key0[3][Size];
+    Scalar m_key1[3][Size];
+    Scalar m_largest0[Size]; // Index of the dropped component of a rotation key.
+    Scalar m_largest1[Size];
+    Scalar m_min[3][Size];   // Range of a vector track.
+    Scalar m_scale[3][Size];
+
+    // Decoded values.
+    Scalar m_rotation[4][Size]; // x, y, z, w.
+    Scalar m_vector[3][Size];
+    Scalar m_linear[9][Size];   // Rotation * scale, column major.
+};
+
+void CompressedAnimation::decodePose(Scalar f, Pose& pose) const
+{
+    const uint size = getPoseSize();
+    pose.resize(size);
+
+    // The arithmetic loops run over the whole block, so that they have a constant trip count :
+    // the block is zero initialized, the lanes past the last bone are computed and ignored.
+    DecodeBlock block = DecodeBlock();
+    for (uint begin = 0; begin < size; begin += DecodeBlock::Size)
+    {
+        const uint count = std::min(uint(DecodeBlock::Size), size - begin);
+        decodeRotations(begin, count, f, block);
+        decodeVectors(m_scaleTracks, m_scaleKeys, begin, count, f, block);
+        for (uint j = 0; j < DecodeBlock::Size; ++j)
+        {
+            const Scalar x = block.m_rotation[0][j];
+            const Scalar y = block.m_rotation[1][j];
+            const Scalar z = block.m_rotation[2][j];
+            const Scalar w = block.m_rotation[3][j];
+            const Scalar sx = block.m_vector[0][j];
+            const Scalar sy = block.m_vector[1][j];
+            const Scalar sz = block.m_vector[2][j];
+            block.m_linear[0][j] = (1 - 2 * (y * y + z * z)) * sx;
+            block.m_linear[1][j] = 2 * (x * y + z * w) * sx;
+            block.m_linear[2][j] = 2 * (x * z - y * w) * sx;
+            block.m_linear[3][j] = 2 * (x * y - z * w) * sy;
+            block.m_linear[4][j] = (1 - 2 * (x * x + z * z)) * sy;
+            block.m_linear[5][j] = 2 * (y * z + x * w) * sy;
+            block.m_linear[6][j] = 2 * (x * z + y * w) * sz;
+            block.m_linear[7][j] = 2 * (y * z - x * w) * sz;
+            block.m_linear[8][j] = (1 - 2 * (x * x + y * y)) * sz;
+        }
+        for (uint j = 0; j < count; ++j)
+        {
+            Scalar* m = pose[begin + j].data();
+            m[0] = block.m_linear[0][j];
+            m[1] = block.m_linear[1][j];
+            m[2] = block.m_linear[2][j];
+            m[4] = block.m_linear[3][j];
+            m[5] = block.m_linear[4][j];
+            m[6] = block.m_linear[5][j];
+            m[8] = block.m_linear[6][j];
+            m[9] = block.m_linear[7][j];
+            m[10] = block.m_linear[8][j];
+        }
+        decodeVectors(m_translationTracks, m_translationKeys, begin, count, f, block);
+        for (uint j = 0; j < count; ++j)
+            pose[begin + j].translation() = Vector3(block.m_vector[0][j], block.m_vector[1][j], block.m_vector[2][j]);
+    }
+}
+
+void CompressedAnimation::decodeRotations(uint begin, uint count, Scalar f, DecodeBlock& block) const
+{
+    // Gather the keys. Without weight, the second key is the first one.
+    for (uint j = 0; j < count; ++j)
+    {
+        Scalar w;
+        const uint k = findKey(m_rotationTracks[begin + j], f, w);
+        const Key& key0 = m_rotationKeys[k];
+        const Key& key1 = m_rotationKeys[k + (w > 0)];
+        block.m_weight[j] = w;
+        block.m_largest0[j] = Scalar((key0[0] >> 15) | ((key0[1] >> 15) << 1));
+        block.m_largest1[j] = Scalar((key1[0] >> 15) | ((key1[1] >> 15) << 1));
+        for (uint c = 0; c < 3; ++c)
+        {
+            block.m_key0[c][j] = key0[c] & 0x7FFF;
+            block.m_key1[c][j] = key1[c] & 0x7FFF;
+        }
+    }
+
+    // Smallest three components, largest one, and normalized interpolation of the two keys.
+    for (uint j = 0; j < DecodeBlock::Size; ++j)
+    {
+        const Scalar a0 = block.m_key0[0][j] * QuatStep - QuatRange;
+        const Scalar b0 = block.m_key0[1][j] * QuatStep - QuatRange;
+        const Scalar c0 = block.m_key0[2][j] * QuatStep - QuatRange;
+        const Scalar l0 = std::sqrt(std::max(Scalar(0), 1 - a0 * a0 - b0 * b0 - c0 * c0));
+        const Scalar i0 = block.m_largest0[j];
+        const Scalar x0 = (i0 == 0) ? l0 : a0;
+        const Scalar y0 = (i0 == 1) ? l0 : ((i0 > 1) ? b0 : a0);
+        const Scalar z0 = (i0 == 2) ? l0 : ((i0 > 2) ? c0 : b0);
+        const Scalar w0 = (i0 == 3) ? l0 : c0;
+
+        const Scalar a1 = block.m_key1[0][j] * QuatStep - QuatRange;
+        const Scalar b1 = block.m_key1[1][j] * QuatStep - QuatRange;
+        const Scalar c1 = block.m_key1[2][j] * QuatStep - QuatRange;
+        const Scalar l1 = std::sqrt(std::max(Scalar(0), 1 - a1 * a1 - b1 * b1 - c1 * c1));
+        const Scalar i1 = block.m_largest1[j];
+        const Scalar x1 = (i1 == 0) ? l1 : a1;
+        const Scalar y1 = (i1 == 1) ? l1 : ((i1 > 1) ? b1 : a1);
+        const Scalar z1 = (i1 == 2) ? l1 : ((i1 > 2) ? c1 : b1);
+        const Scalar w1 = (i1 == 3) ? l1 : c1;
+
+        const Scalar dot = x0 * x1 + y0 * y1 + z0 * z1 + w0 * w1;
+        const Scalar t1 = (dot < 0) ? -block.m_weight[j] : block.m_weight[j];
+        const Scalar t0 = 1 - block.m_weight[j];
+        const Scalar x = t0 * x0 + t1 * x1;
+        const Scalar y = t0 * y0 + t1 * y1;
+        const Scalar z = t0 * z0 + t1 * z1;
+        const Scalar w = t0 * w0 + t1 * w1;
+        const Scalar invNorm = 1 / std::sqrt(x * x + y * y + z * z + w * w);
+        block.m_rotation[0][j] = x * invNorm;
+        block.m_rotation[1][j] = y * invNorm;
+        block.m_rotation[2][j] = z * invNorm;
+        block.m_rotation[3][j] = w * invNorm;
+    }
+}
+
+void CompressedAnimation::decodeVectors(const std::vector<VectorTrack>& tracks, const std::vector<Key>& keys,
+                                        uint begin, uint count, Scalar f, DecodeBlock& block) const
+{
+    for (uint j = 0; j < count; ++j)
+    {
+        const VectorTrack& track = tracks[begin + j];
+        Scalar w;
+        const uint k = findKey(track, f, w);
+        const Key& key0 = keys[k];
+        const Key& key1 = keys[k + (w > 0)];
+        block.m_weight[j] = w;
+        for (uint c = 0; c < 3; ++c)
+        {
+            block.m_key0[c][j] = key0[c];
+            block.m_key1[c][j] = key1[c];
+            block.m_min[c][j] = track.m_min[c];
+            block.m_scale[c][j] = track.m_scale[c];
+        }
+    }
+    for (uint c = 0; c < 3; ++c)
+    {
+        for (uint j = 0; j < DecodeBlock::Size; ++j)
+        {
+            const Scalar u = block.m_key0[c][j] + block.m_weight[j] * (block.m_key1[c][j] - block.m_key0[c][j]);
+            block.m_vector[c][j] = block.m_min[c][j] + block.m_scale[c][j] * u;
+        }
+    }
+}
+
+}
+}
+}
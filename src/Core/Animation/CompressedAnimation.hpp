@@ -0,0 +1,125 @@
+#ifndef COMPRESSED_ANIMATION_HPP
+#define COMPRESSED_ANIMATION_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <Core/Animation/Animation.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+// Compact version of an animation, sampled uniformly in time.
+//
+// Each bone has three tracks (rotation, translation and scale), and each track keeps
+// one sample every 2^k samples, the largest step for which the linear interpolation of the
+// kept samples stays within the tolerance of the channel. A constant track keeps a single sample.
+// Rotations are quantized on 48 bits (smallest three components), translations and scales on
+// 3 x 16 bits over the range of their track.
+// The transforms are expected without shear (rotation and scale only, besides the translation).
+class RA_CORE_API CompressedAnimation
+{
+public:
+    struct Options
+    {
+        Options() : m_sampleRate(30), m_rotationTolerance(1e-3f), m_translationTolerance(1e-3f), m_scaleTolerance(1e-3f) {}
+
+        Scalar m_sampleRate;            // Samples per second.
+        Scalar m_rotationTolerance;     // Radians.
+        Scalar m_translationTolerance;  // Model units.
+        Scalar m_scaleTolerance;
+    };
+
+    // Largest errors of the decoded samples.
+    struct ErrorReport
+    {
+        Scalar m_rotation = 0;     // Angle in radians.
+        Scalar m_translation = 0;
+        Scalar m_scale = 0;
+    };
+
+    // Sample the animation at options.m_sampleRate, from 0 to its last key, and compress the samples.
+    void compress(const Animation& animation, const Options& options = Options());
+
+    // Compress poses sampled uniformly at options.m_sampleRate from time 0.
+    void compress(const std::vector<Pose>& samples, const Options& options = Options());
+
+    void clear();
+
+    bool isEmpty() const;
+
+    // Get the pose corresponding to the given timestamp (in seconds), with the same ping pong
+    // playback as Animation::getPose(). Does not allocate when pose already has the right size.
+    void getPose(Scalar timestamp, Pose& pose) const;
+
+    // Compare the decoded poses with the samples given to compress().
+    ErrorReport computeError(const std::vector<Pose>& samples) const;
+
+    // Number of transforms of each pose.
+    inline uint getPoseSize() const { return m_rotationTracks.size(); }
+
+    // Number of samples of the animation.
+    inline uint getSampleSize() const { return m_sampleSize; }
+
+    // Time of the last sample, in seconds.
+    inline Scalar getDuration() const { return m_duration; }
+
+    // Number of tracks with a single sample.
+    uint getConstantTrackSize() const;
+
+    // Size of the compressed data, in bytes.
+    size_t getMemorySize() const;
+
+private:
+    // Kept samples of a track : samples 0, s, 2 * s, ... and the last one, with s = 2^m_shift.
+    struct Track
+    {
+        uint m_offset; // First key in the key array.
+        uint m_count;  // Number of keys.
+        uint m_shift;
+    };
+
+    // Track of 3d vectors, quantized as m_min + u * m_scale with u in [0, 65535].
+    struct VectorTrack : Track
+    {
+        Vector3 m_min;
+        Vector3 m_scale;
+    };
+
+    typedef std::array<uint16_t, 3> Key;
+
+    // Keys of a track around sample position f : first key and interpolation weight of the next one.
+    uint findKey(const Track& track, Scalar f, Scalar& weight) const;
+
+    void pushRotationTrack(const AlignedStdVector<Quaternion>& samples, Scalar tolerance);
+    void pushVectorTrack(const Vector3Array& samples, Scalar tolerance,
+                         std::vector<VectorTrack>& tracks, std::vector<Key>& keys);
+
+    // Pose at sample position f, in [0, m_sampleSize - 1].
+    // The bones are decoded by blocks, component by component, so that the loops vectorize.
+    struct DecodeBlock;
+    void decodePose(Scalar f, Pose& pose) const;
+    void decodeRotations(uint begin, uint count, Scalar f, DecodeBlock& block) const;
+    void decodeVectors(const std::vector<VectorTrack>& tracks, const std::vector<Key>& keys,
+                       uint begin, uint count, Scalar f, DecodeBlock& block) const;
+
+private:
+    std::vector<Track> m_rotationTracks;
+    std::vector<VectorTrack> m_translationTracks;
+    std::vector<VectorTrack> m_scaleTracks;
+
+    std::vector<Key> m_rotationKeys;
+    std::vector<Key> m_translationKeys;
+    std::vector<Key> m_scaleKeys;
+
+    uint m_sampleSize = 0;
+    Scalar m_sampleRate = 0;
+    Scalar m_duration = 0;
+};
+
+}
+}
+}
+
+#endif // COMPRESSED_ANIMATION_HPP
@@ -0,0 +1,135 @@
+#include <Core/Animation/Handle/ForwardKinematics.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/// CONSTRUCTOR
+ForwardKinematics::ForwardKinematics() : m_order(), m_parent() { }
+
+ForwardKinematics::ForwardKinematics( const Graph::AdjacencyList& graph ) : m_order(), m_parent() {
+    build( graph );
+}
+
+/// HIERARCHY
+void ForwardKinematics::build( const Graph::AdjacencyList& graph ) {
+    const uint n = graph.size();
+    m_order.clear();
+    m_order.reserve( n );
+    m_parent.clear();
+    m_parent.reserve( n );
+
+    // Breadth first: the bones are sorted by level, and the children of a bone are next to each other.
+    for( uint i = 0; i < n; ++i ) {
+        if( graph.isRoot( i ) ) {
+            m_order.push_back( i );
+            m_parent.push_back( -1 );
+        }
+    }
+    for( uint k = 0; k < m_order.size(); ++k ) {
+        const uint i = m_order[k];
+        for( const auto& child : graph.m_child[i] ) {
+            m_order.push_back( child );
+            m_parent.push_back( i );
+        }
+    }
+    CORE_ASSERT( ( m_order.size() == n ), "The graph should be a forest" );
+}
+
+void ForwardKinematics::clear() {
+    m_order.clear();
+    m_parent.clear();
+}
+
+/// POSE
+void ForwardKinematics::computeModelPose( const Pose& local, Pose& model ) const {
+    CORE_ASSERT( ( local.size() == size() ), "Size mismatching" );
+    model.resize( local.size() );
+    for( uint k = 0; k < m_order.size(); ++k ) {
+        const uint i = m_order[k];
+        const int  p = m_parent[k];
+        if( p < 0 ) {
+            model[i] = local[i];
+        } else {
+            // Same as model[p] * local[i], without the products with the last row.
+            model[i].linear().noalias()      = model[p].linear() * local[i].linear();
+            model[i].translation().noalias() = model[p].linear() * local[i].translation();
+            model[i].translation()          += model[p].translation();
+        }
+    }
+}
+
+void ForwardKinematics::computeLocalPose( const Pose& model, Pose& local ) const {
+    CORE_ASSERT( ( model.size() == size() ), "Size mismatching" );
+    local.resize( model.size() );
+    Transform parentInverse;
+    int last = -1;
+    for( uint k = 0; k < m_order.size(); ++k ) {
+        const uint i = m_order[k];
+        const int  p = m_parent[k];
+        if( p < 0 ) {
+            local[i] = model[i];
+        } else {
+            // Siblings are next to each other: the parent is inverted once for all of them.
+            if( p != last ) {
+                parentInverse.linear()      = model[p].linear().inverse();
+                parentInverse.translation() = -parentInverse.linear() * model[p].translation();
+                last = p;
+            }
+            local[i].linear().noalias()      = parentInverse.linear() * model[i].linear();
+            local[i].translation().noalias() = parentInverse.linear() * model[i].translation();
+            local[i].translation()          += parentInverse.translation();
+        }
+    }
+}
+
+void ForwardKinematics::computeModelPoses( const PoseArrays& local, PoseArrays& model ) const {
+    const uint n = size();
+    CORE_ASSERT( ( n != 0 ) && ( local.size() % n == 0 ), "Size mismatching" );
+    model.resize( local.size() );
+
+    parallelFor( 0, local.size() / n, 0, [&]( uint begin, uint end ) {
+        for( uint s = begin; s < end; ++s ) {
+            const Matrix3* localLinear = local.m_linear.data() + s * n;
+            const Vector3* localTr     = local.m_translation.data() + s * n;
+            Matrix3*       linear      = model.m_linear.data() + s * n;
+            Vector3*       tr          = model.m_translation.data() + s * n;
+            for( uint k = 0; k < n; ++k ) {
+                const uint i = m_order[k];
+                const int  p = m_parent[k];
+                if( p < 0 ) {
+                    linear[i] = localLinear[i];
+                    tr[i]     = localTr[i];
+                } else {
+                    linear[i].noalias() = linear[p] * localLinear[i];
+                    tr[i]               = linear[p] * localTr[i] + tr[p];
+                }
+            }
+        }
+    } );
+}
+
+/// CONVERSION
+void ForwardKinematics::setPose( const Pose& pose, const uint k, PoseArrays& arrays ) const {
+    const uint n = size();
+    CORE_ASSERT( ( pose.size() == n ) && ( ( k + 1 ) * n <= arrays.size() ), "Size mismatching" );
+    for( uint i = 0; i < n; ++i ) {
+        arrays.m_linear[k * n + i]      = pose[i].linear();
+        arrays.m_translation[k * n + i] = pose[i].translation();
+    }
+}
+
+void ForwardKinematics::getPose( const PoseArrays& arrays, const uint k, Pose& pose ) const {
+    const uint n = size();
+    CORE_ASSERT( ( ( k + 1 ) * n <= arrays.size() ), "Size mismatching" );
+    pose.resize( n );
+    for( uint i = 0; i < n; ++i ) {
+        pose[i].linear()      = arrays.m_linear[k * n + i];
+        pose[i].translation() = arrays.m_translation[k * n + i];
+    }
+}
+
+} // namespace Animation
+} // Namespace Core
+} // Namespace Ra
@@ -0,0 +1,98 @@
+#ifndef FORWARD_KINEMATICS_H
+#define FORWARD_KINEMATICS_H
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Animation/Pose/Pose.hpp>
+#include <Core/Utils/Graph/AdjacencyList.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/**
+* Transforms of the bones of several skeletons with the same hierarchy, stored by component.
+* The transform of bone i of skeleton k is at index k * size + i, where size is the number of bones.
+*
+* The linear part holds the rotation and the scale of the transform: composing the full linear
+* parts gives the same result as the Transform product, even with non-uniform scales.
+*/
+struct PoseArrays {
+    AlignedStdVector< Matrix3 > m_linear;
+    Vector3Array                m_translation;
+
+    inline uint size() const {
+        return m_translation.size();
+    }
+
+    inline void resize( const uint n ) {
+        m_linear.resize( n );
+        m_translation.resize( n );
+    }
+};
+
+/**
+* The ForwardKinematics class computes the model space pose of a skeleton from its local space pose,
+* and the converse.
+*
+* The hierarchy is flattened once into the list of the bones sorted by level ( roots first ), with
+* the parent of each bone: the model pose is then computed in one linear pass, each bone after its parent,
+* as model[i] = model[parent[i]] * local[i].
+*/
+class RA_CORE_API ForwardKinematics {
+public:
+    /// CONSTRUCTOR
+    ForwardKinematics();
+    ForwardKinematics( const Graph::AdjacencyList& graph );
+
+    /// HIERARCHY
+    void build( const Graph::AdjacencyList& graph ); // Flatten the hierarchy of graph.
+    void clear();
+
+    /// SIZE
+    inline uint size() const {
+        return m_order.size();
+    }
+
+    /// QUERY
+    inline const std::vector< uint >& getOrder() const { // Return the bones sorted by level.
+        return m_order;
+    }
+
+    inline const std::vector< int >& getParent() const { // Return the parent of each bone of getOrder(), -1 for a root.
+        return m_parent;
+    }
+
+    /// POSE
+    // Compute the model space pose from the local space pose.
+    void computeModelPose( const Pose& local, Pose& model ) const;
+
+    // Compute the local space pose from the model space pose. Each bone with children is inverted once.
+    void computeLocalPose( const Pose& model, Pose& local ) const;
+
+    /*
+    * Compute the model space poses of all the skeletons of local, in parallel (see parallelFor()).
+    * model is resized to the size of local.
+    */
+    void computeModelPoses( const PoseArrays& local, PoseArrays& model ) const;
+
+    /// CONVERSION
+    // Copy the pose to the k-th skeleton of arrays, which must hold at least k + 1 skeletons.
+    void setPose( const Pose& pose, const uint k, PoseArrays& arrays ) const;
+
+    // Copy the k-th skeleton of arrays to the pose.
+    void getPose( const PoseArrays& arrays, const uint k, Pose& pose ) const;
+
+private:
+    /// VARIABLE
+    std::vector< uint > m_order;  // Bones sorted by level.
+    std::vector< int >  m_parent; // Parent of m_order[i], -1 for a root.
+};
+
+} // namespace Animation
+} // Namespace Core
+} // Namespace Ra
+
+#endif // FORWARD_KINEMATICS_H
@@ -6,9 +6,9 @@ namespace Core {
 namespace Animation {
 
 /// CONSTRUCTOR
-Skeleton::Skeleton() : PointCloud(), m_graph(), m_modelSpace() { }
+Skeleton::Skeleton() : PointCloud(), m_graph(), m_modelSpace(), m_kinematics(), m_kinematicsVersion( uint( -1 ) ) { }
 
-Skeleton::Skeleton( const uint n ) : PointCloud( n ), m_graph( n ), m_modelSpace( n ) { }
+Skeleton::Skeleton( const uint n ) : PointCloud( n ), m_graph( n ), m_modelSpace( n ), m_kinematics(), m_kinematicsVersion( uint( -1 ) ) { }
 
 /// DESTRUCTOR
 Skeleton::~Skeleton() { }
@@ -68,27 +68,13 @@ void Skeleton::setPose( const Pose& pose, const SpaceType MODE ) {
     switch( MODE ) {
     case SpaceType::LOCAL: {
         m_pose = pose;
-        m_modelSpace.resize( m_pose.size() );
-        for( uint i = 0; i < m_graph.size(); ++i ) {
-            if( m_graph.isRoot( i ) ) {
-                m_modelSpace[i] = m_pose[i];
-            }
-            for( const auto& child : m_graph.m_child[i] ) {
-                m_modelSpace[child] = m_modelSpace[i] * m_pose[child];
-            }
-        }
+        updateKinematics();
+        m_kinematics.computeModelPose( m_pose, m_modelSpace );
     } break;
     case SpaceType::MODEL: {
         m_modelSpace = pose;
-        m_pose.resize( m_modelSpace.size() );
-        for( uint i = 0; i < m_graph.size(); ++i ) {
-            if( m_graph.isRoot( i ) ) {
-                m_pose[i] = m_modelSpace[i];
-            }
-            for( const auto& child : m_graph.m_child[i] ) {
-                m_pose[child] = m_modelSpace[i].inverse() * m_modelSpace[child];
-            }
-        }
+        updateKinematics();
+        m_kinematics.computeLocalPose( m_modelSpace, m_pose );
     } break;
     default: {
         CORE_ASSERT( false, "Should not get here");
@@ -163,6 +149,14 @@ void Skeleton::setTransform( const uint i, const Transform& T, const SpaceType M
 }
 
 
+/// KINEMATICS
+void Skeleton::updateKinematics() {
+    if( m_kinematicsVersion != m_graph.getVersion() ) {
+        m_kinematics.build( m_graph );
+        m_kinematicsVersion = m_graph.getVersion();
+    }
+}
+
 void Skeleton::getBonePoints( const uint i, Vector3& startOut, Vector3& endOut) const
 {
     // Check bone index is valid
@@ -3,6 +3,7 @@
 
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Animation/Handle/PointCloud.hpp>
+#include <Core/Animation/Handle/ForwardKinematics.hpp>
 #include <Core/Utils/Graph/AdjacencyList.hpp>
 
 namespace Ra {
@@ -45,8 +46,13 @@ public:
     Graph::AdjacencyList m_graph; // The adjacency list.
 
 protected:
+    /// KINEMATICS
+    void updateKinematics(); // Flatten m_graph again if its version changed.
+
     /// VARIABLE
     ModelPose m_modelSpace;
+    ForwardKinematics m_kinematics; // Flattened m_graph, built by the first setPose.
+    uint m_kinematicsVersion;       // Version of m_graph m_kinematics was built from.
 };
 
 } // namespace Animation
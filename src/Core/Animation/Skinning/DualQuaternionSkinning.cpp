@@ -1,8 +1,47 @@
 #include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
 
+#include <algorithm>
+
+#include <Core/Tasks/ParallelFor.hpp>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
+
+namespace {
+    // Converts the pose to dual quaternions.
+    void poseToDQ( const Pose& pose, DQList& poseDQ ) {
+        poseDQ.resize( pose.size() );
+        for( uint j = 0; j < pose.size(); ++j ) {
+            poseDQ[j] = DualQuaternion( pose[j] );
+        }
+    }
+
+    // Number of vertices blended before being transformed, so that their dual quaternions stay in cache.
+    const uint BlockSize = 256;
+
+    // Writes to DQ[0 .. end - begin) the normalized blends of the dual quaternions of the vertices [begin, end).
+    // Each blend sums the influences in the order of the table, with signs chosen w.r.t. the first (largest) one.
+    void blendDQ( uint begin, uint end, const InfluenceTable& influences, const DQList& poseDQ, DualQuaternion* DQ ) {
+        const uint width = influences.m_width;
+        for( uint i = begin; i < end; ++i ) {
+            const uint*   h = &influences.m_handles[i * width];
+            const Scalar* w = &influences.m_weights[i * width];
+            const Quaternion& pivot = poseDQ[h[0]].getQ0();
+            // Unused slots have a zero weight and can be blended like the others.
+            DualQuaternion dq = poseDQ[h[0]] * w[0];
+            for( uint k = 1; k < width; ++k ) {
+                const DualQuaternion& q = poseDQ[h[k]];
+                dq += q * ( w[k] * Ra::Core::Math::signNZ( q.getQ0().dot( pivot ) ) );
+            }
+            DQ[i - begin] = dq;
+        }
+        for( uint i = 0; i < end - begin; ++i ) {
+            DQ[i].normalize();
+        }
+    }
+}
+
 void computeDQ( const Pose& pose, const WeightMatrix& weight, DQList& DQ ) {
     CORE_ASSERT( ( pose.size() == weight.cols() ), "pose/weight size mismatch." );
     DQ.clear();
@@ -22,23 +61,8 @@ void computeDQ( const Pose& pose, const WeightMatrix& weight, DQList& DQ ) {
         const int nonZero = weight.col( j ).nonZeros();
 
         WeightMatrix::InnerIterator it0( weight, j );
-#if defined CORE_USE_OMP
-        omp_set_dynamic(0);
-        #pragma omp parallel for schedule( static ) num_threads(4)
-#endif
-        // This for loop is here just because OpenMP wants classic for loops.
-        // Since we cannot iterate directly through the non-zero elements using the InnerIterator,
-        // we initialize an InnerIterator to the first element and then we increase it nz times.
-        /*
-        * This crappy piece of code was done in order to avoid the critical section
-        *           DQ[i] += wq;
-        *
-        * that was occurring when parallelizing the main for loop.
-        *
-        * NOTE: this could be definitely improved by using std::thread
-        */
-        // Loop through all vertices vi who depend on Tj
 
+        // Loop through all vertices vi who depend on Tj
         for( int nz = 0; nz < nonZero; ++nz ) {
             WeightMatrix::InnerIterator itn = it0 + Eigen::Index(nz);
             const uint   i  = itn.row();
@@ -53,13 +77,11 @@ void computeDQ( const Pose& pose, const WeightMatrix& weight, DQList& DQ ) {
     }
 
     // Normalize all dual quats.
-#if defined CORE_USE_OMP
-    omp_set_dynamic(0);
-    #pragma omp parallel for schedule( static ) num_threads(4)
-#endif
-    for( int i = 0; i < int(DQ.size()) ; ++i) {
-        DQ[i].normalize();
-    }
+    parallelFor( 0, DQ.size(), 0, [&DQ]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            DQ[i].normalize();
+        }
+    } );
 }
 
 // alternate naive version, for reference purposes.
@@ -107,14 +129,50 @@ void dualQuaternionSkinning( const Vector3Array& input, const DQList& DQ, Vector
     const uint size = input.size();
     CORE_ASSERT( ( size == DQ.size() ), "input/DQ size mismatch." );
     output.resize( size );
-#if defined CORE_USE_OMP
-    omp_set_dynamic(0);
-    #pragma omp parallel for schedule( static ) num_threads(4)
-#endif
-    for( int i = 0; i < int(size); ++i ) {
-        output[i] = DQ[i].transform( input[i] );
+    parallelFor( 0, size, 0, [&]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            output[i] = DQ[i].transform( input[i] );
+        }
+    } );
+}
+
+void computeDQ( const Pose& pose, const InfluenceTable& influences, DQList& DQ ) {
+    CORE_ASSERT( ( influences.m_width > 0 ), "Vertices have no influence." );
+    DQList poseDQ;
+    poseToDQ( pose, poseDQ );
+    DQ.resize( influences.m_numVertices );
+
+    parallelFor( 0, DQ.size(), 0, [&]( uint begin, uint end ) {
+        blendDQ( begin, end, influences, poseDQ, &DQ[begin] );
+    } );
+}
+
+void dualQuaternionSkinning( const Vector3Array& input, const Pose& pose, const InfluenceTable& influences,
+                             Vector3Array& output, DQList* DQ ) {
+    const uint size = input.size();
+    CORE_ASSERT( ( size == influences.m_numVertices ), "input/influences size mismatch." );
+    CORE_ASSERT( ( influences.m_width > 0 ), "Vertices have no influence." );
+    DQList poseDQ;
+    poseToDQ( pose, poseDQ );
+    output.resize( size );
+    if( DQ != nullptr ) {
+        DQ->resize( size );
     }
+
+    parallelFor( 0, size, 0, [&]( uint begin, uint end ) {
+        // Blending and transforming by blocks pipelines better than doing both per vertex.
+        DQList block( DQ != nullptr ? 0 : BlockSize );
+        for( uint blockBegin = begin; blockBegin < end; blockBegin += BlockSize ) {
+            const uint blockEnd = std::min( blockBegin + BlockSize, end );
+            DualQuaternion* blended = ( DQ != nullptr ) ? &( *DQ )[blockBegin] : block.data();
+            blendDQ( blockBegin, blockEnd, influences, poseDQ, blended );
+            for( uint i = blockBegin; i < blockEnd; ++i ) {
+                output[i] = blended[i - blockBegin].transform( input[i] );
+            }
+        }
+    } );
 }
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
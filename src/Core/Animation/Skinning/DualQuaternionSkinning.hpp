@@ -6,6 +6,7 @@
 #include <Core/Math/DualQuaternion.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
 
 namespace Ra {
 namespace Core {
@@ -30,6 +31,24 @@ void RA_CORE_API computeDQ_naive( const Pose& pose, const WeightMatrix& weight,
 */
 void RA_CORE_API dualQuaternionSkinning( const Vector3Array& input, const DQList& DQ, Vector3Array& output );
 
+/*
+* Per-vertex version of computeDQ : the dual quaternions of the influences of each vertex are blended
+* in the order of the table, their sign being chosen w.r.t. the first (largest) influence.
+*
+* WARNING : in Debug the function will assert if the table is empty. In Release will simply crash.
+*/
+void RA_CORE_API computeDQ( const Pose& pose, const InfluenceTable& influences, DQList& DQ );
+
+/*
+* Blends, normalizes and applies the dual quaternions of each vertex in a single parallel pass over the vertices.
+* The blended dual quaternions are also written to DQ when it is not null.
+*
+* WARNING : in Debug the function will assert if input and influences size mismatch or if the table is empty.
+* In Release will simply crash.
+*/
+void RA_CORE_API dualQuaternionSkinning( const Vector3Array& input, const Pose& pose, const InfluenceTable& influences,
+                                         Vector3Array& output, DQList* DQ = nullptr );
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
@@ -0,0 +1,56 @@
+#include <Core/Animation/Skinning/GPUSkinning.hpp>
+
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+void packGPUSkinningWeights( const WeightMatrix& weight, Vector4Array& weights, Vector4Array& indices ) {
+    InfluenceTable table;
+    buildInfluenceTable( weight, GPUSkinningWidth, true, table );
+
+    const uint size = table.m_numVertices;
+    weights.clear();
+    indices.clear();
+    weights.resize( size, Vector4::Zero() );
+    indices.resize( size, Vector4::Zero() );
+    for( uint i = 0; i < size; ++i ) {
+        for( uint k = 0; k < table.m_width; ++k ) {
+            weights[i][k] = table.weight( i, k );
+            indices[i][k] = Scalar( table.handle( i, k ) );
+        }
+    }
+}
+
+bool computeGPUSkinningPalette( const Pose& pose, BonePalette& palette ) {
+    palette.resize( pose.size() );
+    for( uint j = 0; j < pose.size(); ++j ) {
+        palette[j] = pose[j].matrix();
+    }
+    return pose.size() <= GPUSkinningMaxBones;
+}
+
+void gpuSkinning( const Vector3Array& inMesh, const BonePalette& palette,
+                  const Vector4Array& weights, const Vector4Array& indices,
+                  Vector3Array& outMesh ) {
+    const uint size = inMesh.size();
+    CORE_ASSERT( ( size == weights.size() ) && ( size == indices.size() ), "inMesh/weights size mismatch." );
+    CORE_ASSERT( !palette.empty(), "Empty bone palette." );
+    outMesh.resize( size );
+    parallelFor( 0, size, 0, [&]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            // Same blend as the vertex shader : unused slots have a zero weight and point to the first bone.
+            Matrix4 m = weights[i][0] * palette[uint( indices[i][0] )];
+            for( uint k = 1; k < GPUSkinningWidth; ++k ) {
+                m += weights[i][k] * palette[uint( indices[i][k] )];
+            }
+            outMesh[i] = ( m * inMesh[i].homogeneous() ).head< 3 >();
+        }
+    } );
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
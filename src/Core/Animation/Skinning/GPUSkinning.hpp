@@ -0,0 +1,55 @@
+#ifndef RADIUMENGINE_GPU_SKINNING_HPP
+#define RADIUMENGINE_GPU_SKINNING_HPP
+
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Animation/Pose/Pose.hpp>
+#include <Core/Animation/Handle/HandleWeight.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/*
+* Compact skinning format read by the skinning vertex shader : each vertex has (at most) four influences,
+* stored as two vec4 vertex attributes, and the shader blends the 4x4 matrices of a palette uploaded once per frame.
+* The functions below only prepare and consume the CPU side of these streams and do not need an OpenGL context.
+*/
+
+/// Number of influences per vertex in the compact format.
+static const uint GPUSkinningWidth = 4;
+
+/// Size of the bone palette declared in the skinning shader. Skeletons with more bones can not be skinned on the GPU.
+static const uint GPUSkinningMaxBones = 64;
+
+typedef AlignedStdVector< Matrix4 > BonePalette;
+
+/*
+* Packs the four largest weights of each vertex, scaled to sum to 1, and the indices of their handles.
+* Slots are sorted by decreasing weight ; unused slots have a zero weight and the index 0.
+* Indices are stored as floating point values, as they are sent to the GPU as a regular vertex attribute.
+*/
+void RA_CORE_API packGPUSkinningWeights( const WeightMatrix& weight, Vector4Array& weights, Vector4Array& indices );
+
+/*
+* Fills the palette with the matrices of the given pose. Returns false when the pose has more than
+* GPUSkinningMaxBones transforms : the palette can then not be uploaded to the shader, but gpuSkinning still works.
+*/
+bool RA_CORE_API computeGPUSkinningPalette( const Pose& pose, BonePalette& palette );
+
+/*
+* Reference implementation of the skinning shader : each vertex is transformed by the blend of the palette
+* matrices given by its packed weights and indices. It is also used as the CPU fallback of GPU skinning.
+*
+* WARNING : in Debug the function will assert if inMesh, weights and indices size mismatch. In Release will simply crash.
+*/
+void RA_CORE_API gpuSkinning( const Vector3Array& inMesh, const BonePalette& palette,
+                              const Vector4Array& weights, const Vector4Array& indices,
+                              Vector3Array& outMesh );
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_GPU_SKINNING_HPP
@@ -0,0 +1,82 @@
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <Core/Tasks/ParallelFor.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace {
+    typedef Eigen::SparseMatrix< Scalar, Eigen::RowMajor > RowWeightMatrix;
+}
+
+uint getMaxInfluences( const WeightMatrix& weight ) {
+    // Count the non-zeros of each row with one pass on the column-major storage.
+    std::vector< uint > count( weight.rows(), 0 );
+    for( int k = 0; k < weight.outerSize(); ++k ) {
+        for( WeightMatrix::InnerIterator it( weight, k ); it; ++it ) {
+            if( it.value() != 0 ) {
+                ++count[it.row()];
+            }
+        }
+    }
+    return count.empty() ? 0 : *std::max_element( count.begin(), count.end() );
+}
+
+void buildInfluenceTable( const WeightMatrix& weight, uint maxWidth, bool normalize, InfluenceTable& table ) {
+    const uint width = std::min( maxWidth, getMaxInfluences( weight ) );
+    table.m_width       = width;
+    table.m_numVertices = weight.rows();
+    table.m_handles.assign( table.m_numVertices * width, 0 );
+    table.m_weights.assign( table.m_numVertices * width, 0 );
+
+    if( width == 0 ) {
+        return;
+    }
+
+    const RowWeightMatrix rows = weight;
+    parallelFor( 0, table.m_numVertices, 0, [&]( uint begin, uint end ) {
+        std::vector< std::pair< Scalar, uint > > influences;
+        for( uint i = begin; i < end; ++i ) {
+            influences.clear();
+            Scalar total = 0;
+            for( RowWeightMatrix::InnerIterator it( rows, i ); it; ++it ) {
+                if( it.value() != 0 ) {
+                    influences.push_back( std::make_pair( it.value(), uint( it.col() ) ) );
+                    total += it.value();
+                }
+            }
+
+            // Largest weights first, ties broken by handle index so that the order only depends on the weights.
+            std::sort( influences.begin(), influences.end(),
+                       []( const std::pair< Scalar, uint >& a, const std::pair< Scalar, uint >& b ) {
+                           return ( a.first > b.first ) || ( a.first == b.first && a.second < b.second );
+                       } );
+
+            const uint kept = std::min( width, uint( influences.size() ) );
+            Scalar keptTotal = 0;
+            for( uint k = 0; k < kept; ++k ) {
+                keptTotal += influences[k].first;
+            }
+
+            Scalar scale = 1;
+            if( normalize && keptTotal != 0 ) {
+                scale = 1 / keptTotal;
+            } else if( kept < influences.size() && keptTotal != 0 ) {
+                scale = total / keptTotal;
+            }
+
+            for( uint k = 0; k < kept; ++k ) {
+                table.m_handles[i * width + k] = influences[k].second;
+                table.m_weights[i * width + k] = influences[k].first * scale;
+            }
+        }
+    } );
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,53 @@
+#ifndef RADIUMENGINE_INFLUENCE_TABLE_HPP
+#define RADIUMENGINE_INFLUENCE_TABLE_HPP
+
+#include <vector>
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Animation/Handle/HandleWeight.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/*
+* Fixed-width, row-major copy of a WeightMatrix, read by the per-vertex skinning kernels.
+* The influences of vertex i are stored in the slots [ i * m_width, ( i + 1 ) * m_width ),
+* sorted by decreasing weight (ties by increasing handle index).
+* Unused slots hold the handle 0 with a zero weight, and are always at the end of a row.
+*/
+struct InfluenceTable {
+    /// Number of slots per vertex.
+    uint m_width = 0;
+
+    /// Number of vertices (rows of the weight matrix).
+    uint m_numVertices = 0;
+
+    /// Handle index of each slot.
+    std::vector< uint > m_handles;
+
+    /// Weight of each slot.
+    std::vector< Scalar > m_weights;
+
+    inline uint handle( uint vertex, uint slot ) const { return m_handles[vertex * m_width + slot]; }
+    inline Scalar weight( uint vertex, uint slot ) const { return m_weights[vertex * m_width + slot]; }
+};
+
+/*
+* Return the highest number of non-zero weights of a vertex.
+*/
+uint RA_CORE_API getMaxInfluences( const WeightMatrix& weight );
+
+/*
+* Fill table from the given weights, using min( maxWidth, getMaxInfluences( weight ) ) slots per vertex.
+* Vertices having more influences than that keep their largest ones, which are then scaled to sum to the
+* original total weight of the vertex. If normalize is true, the weights of each vertex are then scaled
+* to sum to 1 (vertices without any influence are left untouched).
+*/
+void RA_CORE_API buildInfluenceTable( const WeightMatrix& weight, uint maxWidth, bool normalize, InfluenceTable& table );
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_INFLUENCE_TABLE_HPP
@@ -1,16 +1,44 @@
 #include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
 
+#include <algorithm>
+
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+namespace {
+    // Affine part of a transform, stored as a fixed-size vectorizable 3x4 matrix.
+    typedef Eigen::Matrix< Scalar, 3, 4 > BoneMatrix;
+
+    // Skins the vertices [begin, end). A compile-time width lets the compiler unroll the blending loop;
+    // unused slots have a zero weight and can be blended like the others.
+    template < uint Width >
+    void blendVertices( uint begin, uint end, uint width, const uint* handles, const Scalar* weights,
+                        const AlignedStdVector< BoneMatrix >& palette,
+                        const Vector3Array& inMesh, Vector3Array& outMesh ) {
+        const uint w = ( Width == 0 ) ? width : Width;
+        for( uint i = begin; i < end; ++i ) {
+            const uint*   h  = handles + i * w;
+            const Scalar* wi = weights + i * w;
+            BoneMatrix m = wi[0] * palette[h[0]];
+            for( uint k = 1; k < w; ++k ) {
+                m += wi[k] * palette[h[k]];
+            }
+            outMesh[i] = m.leftCols< 3 >() * inMesh[i] + m.col( 3 );
+        }
+    }
+}
+
 void linearBlendSkinning( const Vector3Array&  inMesh,
                              const Pose&          pose,
                              const WeightMatrix&  weight,
                              Vector3Array&        outMesh ) {
     outMesh.clear();
     outMesh.resize( inMesh.size(), Vector3::Zero() );
-#pragma omp parallel for
+    // Not parallel : two handles influencing the same vertex would write it concurrently.
     for( int k = 0; k < weight.outerSize(); ++k ) {
         for( WeightMatrix::InnerIterator it( weight, k ); it; ++it ) {
             const uint   i = it.row();
@@ -21,7 +49,39 @@ void linearBlendSkinning( const Vector3Array&  inMesh,
     }
 }
 
+void linearBlendSkinning( const Vector3Array&    inMesh,
+                          const Pose&            pose,
+                          const InfluenceTable&  influences,
+                          Vector3Array&          outMesh ) {
+    const uint size  = inMesh.size();
+    const uint width = influences.m_width;
+    CORE_ASSERT( ( size == influences.m_numVertices ), "inMesh/influences size mismatch." );
+    outMesh.resize( size );
+
+    if( width == 0 ) {
+        std::fill( outMesh.begin(), outMesh.end(), Vector3::Zero() );
+        return;
+    }
+
+    AlignedStdVector< BoneMatrix > palette( pose.size() );
+    for( uint j = 0; j < pose.size(); ++j ) {
+        palette[j] = pose[j].affine();
+    }
+
+    const uint*   handles = influences.m_handles.data();
+    const Scalar* weights = influences.m_weights.data();
+    parallelFor( 0, size, 0, [&]( uint begin, uint end ) {
+        switch( width ) {
+        case 1: blendVertices< 1 >( begin, end, width, handles, weights, palette, inMesh, outMesh ); break;
+        case 2: blendVertices< 2 >( begin, end, width, handles, weights, palette, inMesh, outMesh ); break;
+        case 3: blendVertices< 3 >( begin, end, width, handles, weights, palette, inMesh, outMesh ); break;
+        case 4: blendVertices< 4 >( begin, end, width, handles, weights, palette, inMesh, outMesh ); break;
+        case 8: blendVertices< 8 >( begin, end, width, handles, weights, palette, inMesh, outMesh ); break;
+        default: blendVertices< 0 >( begin, end, width, handles, weights, palette, inMesh, outMesh ); break;
+        }
+    } );
+}
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
-
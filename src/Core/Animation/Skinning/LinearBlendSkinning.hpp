@@ -5,19 +5,34 @@
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
 
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+/*
+* Reference implementation, walking the sparse weight matrix one handle at a time.
+*/
 void RA_CORE_API linearBlendSkinning( const Vector3Array&  inMesh,
                              const Pose&          pose,
                              const WeightMatrix&  weight,
                              Vector3Array&        outMesh );
 
+/*
+* Per-vertex implementation : the 3x4 matrices of the influences of each vertex are blended in the order
+* of the table, then applied to the vertex. Vertices are processed independently in parallel batches, so
+* the result does not depend on the number of threads.
+*
+* WARNING : in Debug the function will assert if inMesh and influences size mismatch. In Release will simply crash.
+*/
+void RA_CORE_API linearBlendSkinning( const Vector3Array&    inMesh,
+                                      const Pose&            pose,
+                                      const InfluenceTable&  influences,
+                                      Vector3Array&          outMesh );
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
 
 #endif // RADIUMENGINE_LINEAR_BLENDING_SKINNING_HPP
-
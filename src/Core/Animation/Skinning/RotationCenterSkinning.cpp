@@ -1,11 +1,168 @@
 #include <Core/Animation/Skinning/RotationCenterSkinning.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Utils/File/CORFileManager.hpp>
+
 namespace Ra
 {
     namespace Core
     {
         namespace Animation
         {
+            namespace
+            {
+                // Weights are stored as row major because we query the per-vertex weights.
+                typedef Eigen::SparseMatrix<Scalar, Eigen::RowMajor> RowWeightMatrix;
+
+                // (handle, weight) pairs of the non-zero weights of a vertex or a triangle, sorted by handle.
+                typedef std::vector<std::pair<uint, Scalar>> CompactWeights;
+
+                CompactWeights toCompactWeights(const Eigen::SparseVector<Scalar>& row)
+                {
+                    CompactWeights result;
+                    for (Eigen::SparseVector<Scalar>::InnerIterator it(row); it; ++it)
+                    {
+                        if (it.value() != 0)
+                        {
+                            result.push_back(std::make_pair(uint(it.index()), it.value()));
+                        }
+                    }
+                    return result;
+                }
+
+                inline Scalar coeff(const CompactWeights& w, uint handle)
+                {
+                    auto it = std::lower_bound(w.begin(), w.end(), std::make_pair(handle, Scalar(0)),
+                                               [](const std::pair<uint, Scalar>& a, const std::pair<uint, Scalar>& b)
+                                               {
+                                                   return a.first < b.first;
+                                               });
+                    return (it != w.end() && it->first == handle) ? it->second : Scalar(0);
+                }
+
+                // Same as weightSimilarity(), on compact weights.
+                Scalar compactWeightSimilarity(const CompactWeights& v1w, const CompactWeights& v2w, Scalar sigmaSq)
+                {
+                    Scalar result = 0;
+                    for (const auto& w1 : v1w)
+                    {
+                        const uint j = w1.first;
+                        const Scalar W1j = w1.second;
+                        const Scalar W2j = coeff(v2w, j);
+                        if (W2j > 0)
+                        {
+                            for (const auto& w2 : v2w)
+                            {
+                                const uint k = w2.first;
+                                const Scalar W1k = coeff(v1w, k);
+                                const Scalar W2k = w2.second;
+                                if (j != k && W1k > 0)
+                                {
+                                    const Scalar diff = std::exp(-Math::ipow<2>((W1j * W2k) - (W1k * W2j)) / (sigmaSq));
+                                    result += W1j * W1k * W2j * W2k * diff;
+                                }
+                            }
+                        }
+                    }
+                    return result;
+                }
+
+                // First step of the CoR computation : subdivide the original mesh by repeated edge-split,
+                // so that adjacent vertices weights are distant of at most `weightEpsilon`.
+                // New vertices created by the edge splitting and their new weights are computed
+                // and appended to the existing vertices.
+                void subdivideMesh(const Skinning::RefData& data, Scalar weightEpsilon,
+                                   TriangleMesh& subdividedMesh, RowWeightMatrix& subdividedWeights)
+                {
+                    Scalar maxWeightDistance = 0.f;
+                    subdividedMesh = data.m_referenceMesh;
+                    subdividedWeights = data.m_weights;
+
+                    // Convert the mesh to DCEL for easy processing.
+                    Dcel dcel;
+                    if (!convert(subdividedMesh, dcel))
+                    {
+                        LOG(logWARNING) << "Mesh too large to be subdivided";
+                        return;
+                    }
+
+                    do
+                    {
+                        maxWeightDistance = 0;
+
+                        // Stores the edges to split
+                        std::vector<Index> edgesToSplit;
+
+                        // Compute all weights distances for all edges.
+                        for (const auto& edge : dcel.m_fulledge)
+                        {
+                            Vertex_ptr v1 = edge->V(0);
+                            Vertex_ptr v2 = edge->V(1);
+
+                            Scalar weightDistance = (subdividedWeights.row(v1->idx)
+                                                     - subdividedWeights.row(v2->idx)).norm();
+
+                            maxWeightDistance = std::max(maxWeightDistance, weightDistance);
+                            if (weightDistance > weightEpsilon)
+                            {
+                                edgesToSplit.push_back(edge->idx);
+                            }
+                        }
+
+                        LOG(logDEBUG) << "Max weight distance is " << maxWeightDistance;
+
+                        // We found some edges over the limit, so we split them.
+                        if (!edgesToSplit.empty())
+                        {
+                            LOG(logDEBUG) << "Splitting " << edgesToSplit.size() << " edges";
+                            int startIndex = subdividedWeights.rows();
+                            int numCols = subdividedWeights.cols();
+
+                            RowWeightMatrix newWeights(startIndex + edgesToSplit.size(), numCols);
+
+                            newWeights.topRows(startIndex) = subdividedWeights;
+                            subdividedWeights = newWeights;
+
+                            int i = 0;
+
+                            // Split ALL the edges !
+                            for (const auto& edge : edgesToSplit)
+                            {
+                                int V1Idx = dcel.m_fulledge[edge]->V(0)->idx;
+                                int V2Idx = dcel.m_fulledge[edge]->V(1)->idx;
+
+                                DcelOperations::splitEdge(dcel, edge, 0.5f);
+                                subdividedWeights.row(startIndex + i) =
+                                        0.5f * (subdividedWeights.row(V1Idx) + subdividedWeights.row(V2Idx));
+                                ++i;
+                            }
+
+                        }
+                        edgesToSplit.clear();
+
+                    } while (maxWeightDistance > weightEpsilon);
+
+                    // get the subdivided mesh back into mesh form.
+                    convert(dcel, subdividedMesh);
+
+                    CORE_ASSERT(subdividedMesh.m_vertices.size() == subdividedWeights.rows(),
+                                "Weights and vertices don't match");
+                }
+
+                // FNV-1a hash of a memory block, stable across platforms and runs.
+                inline void hashBytes(uint64_t& hash, const void* data, std::size_t size)
+                {
+                    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        hash = (hash ^ bytes[i]) * 1099511628211ull;
+                    }
+                }
+            }
 
             Scalar weightSimilarity(const Eigen::SparseVector<Scalar>& v1w,
                                     const Eigen::SparseVector<Scalar>& v2w, Scalar sigma)
@@ -45,84 +202,134 @@ namespace Ra
                 LOG(logDEBUG) << "Precomputing CoRs";
 
                 // First step : subdivide the original mesh until weights are sufficiently close enough.
-                Scalar maxWeightDistance = 0.f;
-                TriangleMesh subdividedMesh = dataInOut.m_referenceMesh;
-
-                // Store the weights as row major here because we are going to query the per-vertex weights.
-                Eigen::SparseMatrix<Scalar, Eigen::RowMajor> subdividedWeights = dataInOut.m_weights;
-
-                // Convert the mesh to DCEL for easy processing.
-                Dcel dcel;
-                convert(subdividedMesh, dcel);
+                TriangleMesh subdividedMesh;
+                RowWeightMatrix subdividedWeights;
+                subdivideMesh(dataInOut, weightEpsilon, subdividedMesh, subdividedWeights);
+
+                // Second step : evaluate the integrals over the triangles for all vertices.
+                // The weights, area and centroid of each triangle are computed once.
+                const uint nTris = subdividedMesh.m_triangles.size();
+                std::vector<CompactWeights> triWeights(nTris);
+                std::vector<Scalar> triAreas(nTris);
+                Vector3Array triCentroids(nTris);
+                parallelFor(0, nTris, 0, [&](uint begin, uint end)
+                {
+                    for (uint t = begin; t < end; ++t)
+                    {
+                        const Triangle& tri = subdividedMesh.m_triangles[t];
+                        std::array<Vector3, 3> triVerts;
+                        MeshUtils::getTriangleVertices(subdividedMesh, t, triVerts);
+                        const Eigen::SparseVector<Scalar> triWeight =
+                            (1/3.f)*
+                            (  subdividedWeights.row( tri[0] )
+                             + subdividedWeights.row( tri[1] )
+                             + subdividedWeights.row( tri[2] ));
+                        triWeights[t] = toCompactWeights(triWeight);
+                        triAreas[t] = MeshUtils::getTriangleArea(subdividedMesh, t);
+                        triCentroids[t] = (triVerts[0] + triVerts[1] + triVerts[2]) / 3.f;
+                    }
+                });
 
-                // The mesh will be subdivided by repeated edge-split, so that adjacent vertices
-                // weights are distant of at most `weightEpsilon`.
-                // New vertices created by the edge splitting and their new weights are computed
-                // and appended to the existing vertices.
-                do
+                // The similarity of a vertex and a triangle is zero unless they share at least two
+                // influences. The vertices are clustered by their set of influences, and each cluster
+                // only visits the triangles sharing two of them.
+                std::vector<std::vector<uint>> handleTriangles(subdividedWeights.cols());
+                for (uint t = 0; t < nTris; ++t)
                 {
-                    maxWeightDistance = 0;
+                    for (const auto& w : triWeights[t])
+                    {
+                        handleTriangles[w.first].push_back(t);
+                    }
+                }
 
-                    // Stores the edges to split
-                    std::vector<Index> edgesToSplit;
+                const uint nVerts = dataInOut.m_referenceMesh.m_vertices.size();
+                std::vector<CompactWeights> vertWeights(nVerts);
+                std::vector<uint> vertCluster(nVerts);
+                std::vector<std::vector<uint>> clusterSupports;
+                std::map<std::vector<uint>, uint> supportToCluster;
+                for (uint i = 0; i < nVerts; ++i)
+                {
+                    // Check that the first vertices of the subdivided mesh have not changed.
+                    CORE_ASSERT(subdividedMesh.m_vertices[i] == dataInOut.m_referenceMesh.m_vertices[i],
+                                "Inconsistency in the meshes");
 
-                    // Compute all weights distances for all edges.
-                    for (const auto& edge : dcel.m_fulledge)
+                    vertWeights[i] = toCompactWeights(subdividedWeights.row(i));
+                    std::vector<uint> support;
+                    for (const auto& w : vertWeights[i])
                     {
-                        Vertex_ptr v1 = edge->V(0);
-                        Vertex_ptr v2 = edge->V(1);
-
-                        Scalar weightDistance = (subdividedWeights.row(v1->idx)
-                                                 - subdividedWeights.row(v2->idx)).norm();
+                        support.push_back(w.first);
+                    }
+                    auto inserted = supportToCluster.insert(std::make_pair(support, uint(clusterSupports.size())));
+                    if (inserted.second)
+                    {
+                        clusterSupports.push_back(support);
+                    }
+                    vertCluster[i] = inserted.first->second;
+                }
 
-                        maxWeightDistance = std::max(maxWeightDistance, weightDistance);
-                        if (weightDistance > weightEpsilon)
+                std::vector<std::vector<uint>> clusterTriangles(clusterSupports.size());
+                parallelFor(0, clusterSupports.size(), 1, [&](uint begin, uint end)
+                {
+                    std::vector<uint> sharedCount(nTris, 0);
+                    for (uint c = begin; c < end; ++c)
+                    {
+                        std::vector<uint>& triangles = clusterTriangles[c];
+                        for (uint h : clusterSupports[c])
                         {
-                            edgesToSplit.push_back(edge->idx);
+                            for (uint t : handleTriangles[h])
+                            {
+                                if (++sharedCount[t] == 2)
+                                {
+                                    triangles.push_back(t);
+                                }
+                            }
                         }
+                        for (uint h : clusterSupports[c])
+                        {
+                            for (uint t : handleTriangles[h])
+                            {
+                                sharedCount[t] = 0;
+                            }
+                        }
+                        // Same summation order as iterating over all the triangles.
+                        std::sort(triangles.begin(), triangles.end());
                     }
+                });
 
-                    LOG(logDEBUG) << "Max weight distance is " << maxWeightDistance;
+                LOG(logDEBUG) << nVerts << " vertices in " << clusterSupports.size() << " clusters";
 
-                    // We found some edges over the limit, so we split them.
-                    if (!edgesToSplit.empty())
+                const Scalar sigmaSq = sigma * sigma;
+                dataInOut.m_CoR.clear();
+                dataInOut.m_CoR.resize(nVerts);
+                parallelFor(0, nVerts, 0, [&](uint begin, uint end)
+                {
+                    for (uint i = begin; i < end; ++i)
                     {
-                        LOG(logDEBUG) << "Splitting " << edgesToSplit.size() << " edges";
-                        int startIndex = subdividedWeights.rows();
-                        int numCols = subdividedWeights.cols();
-
-                        Eigen::SparseMatrix<Scalar, Eigen::RowMajor> newWeights(startIndex + edgesToSplit.size(),
-                                                                                numCols);
-
-                        newWeights.topRows(startIndex) = subdividedWeights;
-                        subdividedWeights = newWeights;
-
-                        int i = 0;
-
-                        // Split ALL the edges !
-                        for (const auto& edge : edgesToSplit)
+                        Vector3 cor(0, 0, 0);
+                        Scalar sumweight = 0;
+                        for (uint t : clusterTriangles[vertCluster[i]])
                         {
-                            int V1Idx = dcel.m_fulledge[edge]->V(0)->idx;
-                            int V2Idx = dcel.m_fulledge[edge]->V(1)->idx;
-
-                            DcelOperations::splitEdge(dcel, edge, 0.5f);
-                            subdividedWeights.row(startIndex + i) =
-                                    0.5f * (subdividedWeights.row(V1Idx) + subdividedWeights.row(V2Idx));
-                            ++i;
+                            const Scalar s = compactWeightSimilarity(vertWeights[i], triWeights[t], sigmaSq);
+                            cor += s * triAreas[t] * triCentroids[t];
+                            sumweight += s * triAreas[t];
                         }
 
+                        // Avoid division by 0
+                        dataInOut.m_CoR[i] = (sumweight > 0) ? Vector3((1.f / sumweight) * cor) : Vector3::Zero();
                     }
-                    edgesToSplit.clear();
+                });
+            }
 
-                } while (maxWeightDistance > weightEpsilon);
+            void computeCoR_naive(Skinning::RefData& dataInOut, Scalar sigma, Scalar weightEpsilon)
+            {
+                LOG(logDEBUG) << "Precomputing CoRs";
 
-                // get the subdivided mesh back into mesh form.
-                convert(dcel, subdividedMesh);
+                // First step : subdivide the original mesh until weights are sufficiently close enough.
+                TriangleMesh subdividedMesh;
+                RowWeightMatrix subdividedWeights;
+                subdivideMesh(dataInOut, weightEpsilon, subdividedMesh, subdividedWeights);
 
                 // Second step : evaluate the integrals over all triangles for all vertices.
-                CORE_ASSERT(subdividedMesh.m_vertices.size() == subdividedWeights.rows(),
-                            "Weights and vertices don't match");
-
                 dataInOut.m_CoR.clear();
                 dataInOut.m_CoR.reserve(dataInOut.m_referenceMesh.m_vertices.size());
 
@@ -149,7 +356,7 @@ namespace Ra
                         MeshUtils::getTriangleVertices(subdividedMesh, t, triVerts);
 
                         const Scalar area = MeshUtils::getTriangleArea(subdividedMesh, t);
-                        const Eigen::SparseVector<Scalar> triWeight = 
+                        const Eigen::SparseVector<Scalar> triWeight =
                            (1/3.f)*
                             (  subdividedWeights.row( tri[0] )
                              + subdividedWeights.row( tri[1] )
@@ -181,7 +388,78 @@ namespace Ra
                 }
             }
 
-            void corSkinning(const Vector3Array& input, const Animation::Pose& pose, const Animation::WeightMatrix& weight,
+            uint64_t hashCoRInput(const Skinning::RefData& data, Scalar sigma, Scalar weightEpsilon)
+            {
+                uint64_t hash = 14695981039346656037ull;
+                hashBytes(hash, &sigma, sizeof(sigma));
+                hashBytes(hash, &weightEpsilon, sizeof(weightEpsilon));
+
+                const TriangleMesh& mesh = data.m_referenceMesh;
+                const uint64_t sizes[3] = { mesh.m_vertices.size(), mesh.m_triangles.size(), uint64_t(data.m_weights.cols()) };
+                hashBytes(hash, sizes, sizeof(sizes));
+                for (const auto& v : mesh.m_vertices)
+                {
+                    const Scalar p[3] = { v.x(), v.y(), v.z() };
+                    hashBytes(hash, p, sizeof(p));
+                }
+                for (const auto& t : mesh.m_triangles)
+                {
+                    const uint idx[3] = { uint(t[0]), uint(t[1]), uint(t[2]) };
+                    hashBytes(hash, idx, sizeof(idx));
+                }
+
+                // Hash the non-zero weights in a canonical (column-major) order.
+                for (int k = 0; k < data.m_weights.outerSize(); ++k)
+                {
+                    for (WeightMatrix::InnerIterator it(data.m_weights, k); it; ++it)
+                    {
+                        if (it.value() != 0)
+                        {
+                            const uint idx[2] = { uint(it.row()), uint(it.col()) };
+                            const Scalar w = it.value();
+                            hashBytes(hash, idx, sizeof(idx));
+                            hashBytes(hash, &w, sizeof(w));
+                        }
+                    }
+                }
+                return hash;
+            }
+
+            bool computeCoRCached(Skinning::RefData& dataInOut, const std::string& cacheDirectory,
+                                  Scalar sigma, Scalar weightEpsilon)
+            {
+                if (cacheDirectory.empty())
+                {
+                    computeCoR(dataInOut, sigma, weightEpsilon);
+                    return false;
+                }
+
+                const uint64_t key = hashCoRInput(dataInOut, sigma, weightEpsilon);
+                char keyString[17];
+                std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(key));
+                const std::string filename = cacheDirectory + "/" + keyString;
+
+                CORFileManager manager;
+                KeyedCoR cached;
+                if (manager.load(filename, cached) && cached.m_key == key
+                    && cached.m_CoR.size() == dataInOut.m_referenceMesh.m_vertices.size())
+                {
+                    LOG(logDEBUG) << "CoRs loaded from " << filename;
+                    dataInOut.m_CoR = cached.m_CoR;
+                    return true;
+                }
+
+                computeCoR(dataInOut, sigma, weightEpsilon);
+                cached.m_key = key;
+                cached.m_CoR = dataInOut.m_CoR;
+                if (!manager.save(filename, cached))
+                {
+                    LOG(logWARNING) << "Could not write the CoR cache file " << filename;
+                }
+                return false;
+            }
+
+            void corSkinning(const Vector3Array& input, const Pose& pose, const WeightMatrix& weight,
                              const Vector3Array& CoR, Vector3Array& output)
             {
                 const uint size = input.size();
@@ -205,4 +483,3 @@ namespace Ra
         }// ns Animation
     } // ns Core
 }// ns Ra
-
@@ -4,6 +4,8 @@
 #include <Core/RaCore.hpp>
 
 #include <array>
+#include <cstdint>
+#include <string>
 
 #include <Core/Index/IndexMap.hpp>
 #include <Core/Log/Log.hpp>
@@ -33,11 +35,24 @@ namespace Ra {
                                     Scalar sigma = 0.1f);
 
             /// Compute the optimal center of rotations (1 per vertex) based on weight similarity.
+            /// Each vertex only visits the triangles sharing at least two of its influences, in parallel.
             void RA_CORE_API computeCoR(Skinning::RefData& dataInOut, Scalar sigma = 0.1f, Scalar weightEpsilon = 0.1f);
 
+            /// Same result as computeCoR(), iterating over all the triangles for each vertex (for reference purposes).
+            void RA_CORE_API computeCoR_naive(Skinning::RefData& dataInOut, Scalar sigma = 0.1f, Scalar weightEpsilon = 0.1f);
+
+            /// Returns a hash of the reference mesh, the weights and the parameters used by computeCoR().
+            uint64_t RA_CORE_API hashCoRInput(const Skinning::RefData& data, Scalar sigma = 0.1f, Scalar weightEpsilon = 0.1f);
+
+            /// Same as computeCoR(), but first tries to load the centers of rotation from a file of cacheDirectory
+            /// named after hashCoRInput(), and writes this file when they had to be computed.
+            /// An empty cacheDirectory disables the cache. Returns true if the centers were loaded from the cache.
+            bool RA_CORE_API computeCoRCached(Skinning::RefData& dataInOut, const std::string& cacheDirectory,
+                                              Scalar sigma = 0.1f, Scalar weightEpsilon = 0.1f);
+
             /// Skin the vertices with the optimal centers of rotation.
-            void RA_CORE_API corSkinning(const Vector3Array& input, const Animation::Pose& pose,
-                                         const Animation::WeightMatrix& weight, const Vector3Array& CoR, Vector3Array& output);
+            void RA_CORE_API corSkinning(const Vector3Array& input, const Pose& pose,
+                                         const WeightMatrix& weight, const Vector3Array& CoR, Vector3Array& output);
 
 
         }
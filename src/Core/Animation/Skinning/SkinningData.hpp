@@ -6,6 +6,7 @@
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/Skeleton.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
 
 namespace Ra
 {
@@ -29,6 +30,9 @@ namespace Skinning
         /// Skinning weights.
         Ra::Core::Animation::WeightMatrix m_weights;
 
+        /// Skinning weights as a fixed-width table, for the per-vertex skinning kernels.
+        Ra::Core::Animation::InfluenceTable m_influences;
+
         /// Optionnal centers of rotations for CoR skinning
         Ra::Core::Vector3Array m_CoR;
     };
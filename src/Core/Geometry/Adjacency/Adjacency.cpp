@@ -1,5 +1,7 @@
 #include <Core/Geometry/Adjacency/Adjacency.hpp>
 
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
+
 namespace Ra {
 namespace Core {
 namespace Geometry {
@@ -14,91 +16,64 @@ namespace Geometry {
 // //////////////// //
 
 AdjacencyMatrix uniformAdjacency( const uint point_size, const VectorArray< Triangle >& T ) {
-    AdjacencyMatrix A( point_size, point_size );
-    for( const auto& t : T ) {
-        uint i = t( 0 );
-        uint j = t( 1 );
-        uint k = t( 2 );
-        A.coeffRef( i, j ) = 1;
-        A.coeffRef( j, k ) = 1;
-        A.coeffRef( k, i ) = 1;
-    }
+    AdjacencyMatrix A;
+    assembleUniqueFromTriplets( point_size, point_size, T.size(), 3, [&T]( uint n, SparseTriplet* t ) {
+        const uint i = T[n]( 0 );
+        const uint j = T[n]( 1 );
+        const uint k = T[n]( 2 );
+        t[0] = SparseTriplet( i, j, 1 );
+        t[1] = SparseTriplet( j, k, 1 );
+        t[2] = SparseTriplet( k, i, 1 );
+    }, A );
     return A;
 }
 
 
 
 AdjacencyMatrix uniformAdjacency( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    AdjacencyMatrix A( p.size(), p.size() );
-    for( const auto& t : T ) {
-        uint i = t( 0 );
-        uint j = t( 1 );
-        uint k = t( 2 );
-        A.coeffRef( i, j ) = 1;
-        A.coeffRef( j, k ) = 1;
-        A.coeffRef( k, i ) = 1;
-    }
-    return A;
+    return uniformAdjacency( p.size(), T );
 }
 
 
 
 void uniformAdjacency( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, AdjacencyMatrix& Adj ) {
-    Adj.resize( p.size(), p.size() );
-#pragma omp parallel for
-    for( int n = 0; n < int(T.size()); ++n ) {
-        const Triangle& t = T[n];
-        const uint i = t( 0 );
-        const uint j = t( 1 );
-        const uint k = t( 2 );
-#pragma omp critical
-        {
-            Adj.coeffRef( i, j ) = 1;
-            Adj.coeffRef( j, k ) = 1;
-            Adj.coeffRef( k, i ) = 1;
-        }
-    }
+    Adj = uniformAdjacency( p.size(), T );
 }
 
 
 
 TVAdj triangleUniformAdjacency( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    const uint p_size = p.size();
-    const uint t_size = T.size();
-    TVAdj A( t_size, p_size );
-    for( uint t = 0; t < t_size; ++t ) {
-        const uint i = T[t]( 0 );
-        const uint j = T[t]( 1 );
-        const uint k = T[t]( 2 );
-        A.coeffRef( t, i ) = 1;
-        A.coeffRef( t, j ) = 1;
-        A.coeffRef( t, k ) = 1;
-    }
+    TVAdj A;
+    assembleUniqueFromTriplets( T.size(), p.size(), T.size(), 3, [&T]( uint n, SparseTriplet* t ) {
+        for( uint c = 0; c < 3; ++c ) {
+            t[c] = SparseTriplet( n, T[n]( c ), 1 );
+        }
+    }, A );
     return A;
 }
 
 
 
 AdjacencyMatrix cotangentWeightAdjacency( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    AdjacencyMatrix A( p.size(), p.size() );
-    for( const auto& t : T ) {
-        uint i = t( 0 );
-        uint j = t( 1 );
-        uint k = t( 2 );
-        Vector3 IJ = p[j] - p[i];
-        Vector3 JK = p[k] - p[j];
-        Vector3 KI = p[i] - p[k];
-        Scalar cotI = Vector::cotan( IJ, ( -KI ).eval() );
-        Scalar cotJ = Vector::cotan( JK, ( -IJ ).eval() );
-        Scalar cotK = Vector::cotan( KI, ( -JK ).eval() );
-        A.coeffRef( i, j ) += cotK;
-        A.coeffRef( j, i ) += cotK;
-        A.coeffRef( j, k ) += cotI;
-        A.coeffRef( k, j ) += cotI;
-        A.coeffRef( k, i ) += cotJ;
-        A.coeffRef( i, k ) += cotJ;
-    }
-    return ( 0.5 * A );
+    AdjacencyMatrix A;
+    assembleFromTriplets( p.size(), p.size(), T.size(), 6, [&p, &T]( uint n, SparseTriplet* t ) {
+        const uint i = T[n]( 0 );
+        const uint j = T[n]( 1 );
+        const uint k = T[n]( 2 );
+        const Vector3 IJ = p[j] - p[i];
+        const Vector3 JK = p[k] - p[j];
+        const Vector3 KI = p[i] - p[k];
+        const Scalar cotI = 0.5 * Vector::cotan( IJ, ( -KI ).eval() );
+        const Scalar cotJ = 0.5 * Vector::cotan( JK, ( -IJ ).eval() );
+        const Scalar cotK = 0.5 * Vector::cotan( KI, ( -JK ).eval() );
+        t[0] = SparseTriplet( i, j, cotK );
+        t[1] = SparseTriplet( j, i, cotK );
+        t[2] = SparseTriplet( j, k, cotI );
+        t[3] = SparseTriplet( k, j, cotI );
+        t[4] = SparseTriplet( k, i, cotJ );
+        t[5] = SparseTriplet( i, k, cotJ );
+    }, A );
+    return A;
 }
 
 
@@ -107,13 +82,14 @@ AdjacencyMatrix cotangentWeightAdjacency( const VectorArray< Vector3 >& p, const
 // DEGREE MATRIX //
 // ///////////// //
 
+DegreeVector adjacencyDegreeVector( const AdjacencyMatrix& A ) {
+    return ( A * VectorN::Ones( A.cols() ) );
+}
+
+
+
 DegreeMatrix adjacencyDegree( const AdjacencyMatrix& A ) {
-    DegreeMatrix D( A.rows(), A.cols() );
-    D.reserve( A.rows() );
-    for( int i = 0; i < D.diagonal().size(); ++i ) {
-        D.coeffRef( i, i ) = A.row( i ).sum();
-    }
-    return D;
+    return diagonalMatrix( adjacencyDegreeVector( A ) );
 }
 
 
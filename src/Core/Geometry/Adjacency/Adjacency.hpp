@@ -37,6 +37,8 @@ typedef AdjacencyMatrix TVAdj;
 * The function defined over the edges is:
 *       f( i, j ) = 1 , if exist the edge from i to j
 *       f( i, j ) = 0 , otherwise
+*
+* The matrices of this file are assembled from triplet lists filled in parallel.
 */
 RA_CORE_API AdjacencyMatrix uniformAdjacency( const uint point_size, const VectorArray< Triangle >& T );
 
@@ -93,6 +95,11 @@ typedef Diagonal DegreeMatrix;
 
 
 
+// Defining the DegreeVector as the diagonal of a DegreeMatrix.
+typedef VectorN DegreeVector;
+
+
+
 /*
 * Return the DegreeMatrix of the given AdjacencyMatrix A.
 */
@@ -100,6 +107,13 @@ RA_CORE_API DegreeMatrix adjacencyDegree( const AdjacencyMatrix& A ) ;
 
 
 
+/*
+* Return the DegreeVector of the given AdjacencyMatrix A, i.e. the sums of its rows.
+*/
+RA_CORE_API DegreeVector adjacencyDegreeVector( const AdjacencyMatrix& A ) ;
+
+
+
 ////////////////
 /// ONE RING ///
 ////////////////
@@ -3,6 +3,10 @@
 #include <Core/Index/CircularIndex.hpp>
 
 #include <Core/Geometry/Triangle/TriangleOperation.hpp>
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <vector>
 
 namespace Ra {
 namespace Core {
@@ -14,80 +18,72 @@ namespace Geometry {
 /// GLOBAL MATRIX ///
 /////////////////////
 
-AreaMatrix oneRingArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    AreaMatrix A( p.size(), p.size() );
-    A.reserve( p.size() );
-    for( const auto& t : T ) {
-        uint i = t( 0 );
-        uint j = t( 1 );
-        uint k = t( 2 );
-        Scalar area = triangleArea( p[i], p[j], p[k] );
-        A.coeffRef( i, i ) += area;
-        A.coeffRef( j, j ) += area;
-        A.coeffRef( k, k ) += area;
+AreaVector oneRingAreaVector( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
+    // The areas are computed in parallel, then summed on the vertices.
+    std::vector< Scalar > area( T.size() );
+    parallelFor( 0, T.size(), 0, [&]( uint begin, uint end ) {
+        for( uint n = begin; n < end; ++n ) {
+            area[n] = triangleArea( p[T[n]( 0 )], p[T[n]( 1 )], p[T[n]( 2 )] );
+        }
+    } );
+    AreaVector A = AreaVector::Zero( p.size() );
+    for( uint n = 0; n < T.size(); ++n ) {
+        A[T[n]( 0 )] += area[n];
+        A[T[n]( 1 )] += area[n];
+        A[T[n]( 2 )] += area[n];
     }
     return A;
 }
 
 
 
+AreaMatrix oneRingArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
+    return diagonalMatrix( oneRingAreaVector( p, T ) );
+}
+
+
+
 void oneRingArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, AreaMatrix& A ) {
-    A.resize( p.size(), p.size() );
-    A.reserve( p.size() );
-#pragma omp parallel for
-    for( int n = 0; n < int(T.size()); ++n ) {
-        const Triangle& t = T[n];
-        const uint i = t( 0 );
-        const uint j = t( 1 );
-        const uint k = t( 2 );
-        const Scalar area = triangleArea( p[i], p[j], p[k] );
-#pragma omp critical
-        {
-            A.coeffRef( i, i ) += area;
-            A.coeffRef( j, j ) += area;
-            A.coeffRef( k, k ) += area;
-        }
-    }
+    A = oneRingArea( p, T );
+}
+
+
+
+AreaVector barycentricAreaVector( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
+    return ( ( 1.0f / 3.0f ) * oneRingAreaVector( p, T ) );
 }
 
 
 
 AreaMatrix barycentricArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    return ( ( 1.0f / 3.0f ) * oneRingArea( p, T ) );
+    return diagonalMatrix( barycentricAreaVector( p, T ) );
 }
 
 
 
 void barycentricArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, AreaMatrix& A ) {
-    oneRingArea( p, T, A );
-    const uint size = p.size();
-#pragma omp parallel for
-    for( int i = 0; i < int(size); ++i ) {
-        A.coeffRef( i, i ) /= 3.0;
-    }
+    A = barycentricArea( p, T );
 }
 
 
 
 AreaMatrix voronoiArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    AreaMatrix A( p.size(), p.size() );
-    A.reserve( p.size() );
+    AreaVector A = AreaVector::Zero( p.size() );
     for( const auto& t : T ) {
         uint i = t( 0 );
         uint j = t( 1 );
         uint k = t( 2 );
-        A.coeffRef( i, i ) += Vector::cotan( ( p[i] - p[k] ), ( p[j] - p[k] ) ) * ( p[i] - p[j] ).squaredNorm();
-        A.coeffRef( j, j ) += Vector::cotan( ( p[j] - p[i] ), ( p[k] - p[i] ) ) * ( p[j] - p[k] ).squaredNorm();
-        A.coeffRef( k, k ) += Vector::cotan( ( p[k] - p[j] ), ( p[i] - p[j] ) ) * ( p[k] - p[i] ).squaredNorm();
+        A[i] += Vector::cotan( ( p[i] - p[k] ), ( p[j] - p[k] ) ) * ( p[i] - p[j] ).squaredNorm();
+        A[j] += Vector::cotan( ( p[j] - p[i] ), ( p[k] - p[i] ) ) * ( p[j] - p[k] ).squaredNorm();
+        A[k] += Vector::cotan( ( p[k] - p[j] ), ( p[i] - p[j] ) ) * ( p[k] - p[i] ).squaredNorm();
     }
-    return ( ( 1.0 / 8.0 ) * A );
+    return diagonalMatrix( ( 1.0 / 8.0 ) * A );
 }
 
 
 
 AreaMatrix mixedArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    AreaMatrix A( p.size(), p.size() );
-    A.reserve( p.size() );
+    AreaVector A = AreaVector::Zero( p.size() );
     for( const auto& t : T ) {
         uint i = t( 0 );
         uint j = t( 1 );
@@ -102,33 +98,33 @@ AreaMatrix mixedArea( const VectorArray< Vector3 >& p, const VectorArray< Triang
             Scalar cotI = Vector::cotan( ij, ( -ki ).eval() );
             Scalar cotJ = Vector::cotan( jk, ( -ij ).eval() );
             Scalar cotK = Vector::cotan( ki, ( -jk ).eval() );
-            A.coeffRef( i, i ) += ( 1.0 / 8.0 ) * ( ( KI * cotJ ) + ( IJ * cotK ) );
-            A.coeffRef( j, j ) += ( 1.0 / 8.0 ) * ( ( IJ * cotK ) + ( JK * cotI ) );
-            A.coeffRef( k, k ) += ( 1.0 / 8.0 ) * ( ( JK * cotI ) + ( KI * cotJ ) );
+            A[i] += ( 1.0 / 8.0 ) * ( ( KI * cotJ ) + ( IJ * cotK ) );
+            A[j] += ( 1.0 / 8.0 ) * ( ( IJ * cotK ) + ( JK * cotI ) );
+            A[k] += ( 1.0 / 8.0 ) * ( ( JK * cotI ) + ( KI * cotJ ) );
 
         } else {
             Scalar area = triangleArea( p[i], p[j], p[k] );
             if( ( ( ( p[j] - p[i] ).normalized() ).dot( ( p[k] - p[i] ).normalized() ) ) < 0.0  ) {
                 /* obtuse at i */
-                A.coeffRef( i, i ) += area / 2.0;
-                A.coeffRef( j, j ) += area / 4.0;
-                A.coeffRef( k, k ) += area / 4.0;
+                A[i] += area / 2.0;
+                A[j] += area / 4.0;
+                A[k] += area / 4.0;
             } else {
                 if( ( ( ( p[k] - p[j] ).normalized() ).dot( ( p[i] - p[j] ).normalized() ) ) < 0.0  ) {
                     /* obtuse at j */
-                    A.coeffRef( i, i ) += area / 4.0;
-                    A.coeffRef( j, j ) += area / 2.0;
-                    A.coeffRef( k, k ) += area / 4.0;
+                    A[i] += area / 4.0;
+                    A[j] += area / 2.0;
+                    A[k] += area / 4.0;
                 } else {
                     /* obtuse at k */
-                    A.coeffRef( i, i ) += area / 4.0;
-                    A.coeffRef( j, j ) += area / 4.0;
-                    A.coeffRef( k, k ) += area / 2.0;
+                    A[i] += area / 4.0;
+                    A[j] += area / 4.0;
+                    A[k] += area / 2.0;
                 }
             }
         }
     }
-    return A;
+    return diagonalMatrix( A );
 }
 
 
@@ -22,6 +22,9 @@ namespace Geometry {
 // where Pi is the i-th point of the mesh.
 typedef Diagonal AreaMatrix;
 
+// Defining the AreaVector as the diagonal of an AreaMatrix.
+typedef VectorN AreaVector;
+
 
 /*
 * Return the AreaMatrix for the given set of points and triangles.
@@ -47,6 +50,13 @@ AreaMatrix RA_CORE_API oneRingArea( const VectorArray< Vector3 >& p, const Vecto
 void RA_CORE_API oneRingArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, AreaMatrix& A );
 
 
+/*
+* Return the AreaVector for the given set of points and triangles, i.e. the diagonal of oneRingArea( p, T ).
+* The triangle areas are computed in parallel.
+*/
+AreaVector RA_CORE_API oneRingAreaVector( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T );
+
+
 
 /*
 * Return the AreaMatrix for the given set of points and triangles.
@@ -72,6 +82,12 @@ AreaMatrix RA_CORE_API barycentricArea( const VectorArray< Vector3 >& p, const V
 void RA_CORE_API barycentricArea( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, AreaMatrix& A );
 
 
+/*
+* Return the AreaVector for the given set of points and triangles, i.e. the diagonal of barycentricArea( p, T ).
+*/
+AreaVector RA_CORE_API barycentricAreaVector( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T );
+
+
 
 /*
 * Return the AreaMatrix for the given set of points and triangles.
@@ -1,6 +1,7 @@
 #include <Core/Geometry/Laplacian/Laplacian.hpp>
 
 #include <Core/Index/CircularIndex.hpp>
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
 
 namespace Ra {
 namespace Core {
@@ -50,28 +51,28 @@ LaplacianMatrix powerLaplacian( const LaplacianMatrix& L, const uint k ) {
 
 
 LaplacianMatrix cotangentWeightLaplacian( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
-    LaplacianMatrix L( p.size(), p.size() );
-    for( const auto& t : T ) {
-        uint i = t( 0 );
-        uint j = t( 1 );
-        uint k = t( 2 );
-        Vector3 IJ = p[j] - p[i];
-        Vector3 JK = p[k] - p[j];
-        Vector3 KI = p[i] - p[k];
-        Scalar cotI = Vector::cotan( IJ, ( -KI ).eval() );
-        Scalar cotJ = Vector::cotan( JK, ( -IJ ).eval() );
-        Scalar cotK = Vector::cotan( KI, ( -JK ).eval() );
-        L.coeffRef( i, j ) -= cotK;
-        L.coeffRef( j, i ) -= cotK;
-        L.coeffRef( j, k ) -= cotI;
-        L.coeffRef( k, j ) -= cotI;
-        L.coeffRef( k, i ) -= cotJ;
-        L.coeffRef( i, k ) -= cotJ;
-        L.coeffRef( i, i ) += cotJ + cotK;
-        L.coeffRef( j, j ) += cotI + cotK;
-        L.coeffRef( k, k ) += cotI + cotJ;
-    }
-    return ( 0.5 * L );
+    LaplacianMatrix L;
+    assembleFromTriplets( p.size(), p.size(), T.size(), 9, [&p, &T]( uint n, SparseTriplet* t ) {
+        const uint i = T[n]( 0 );
+        const uint j = T[n]( 1 );
+        const uint k = T[n]( 2 );
+        const Vector3 IJ = p[j] - p[i];
+        const Vector3 JK = p[k] - p[j];
+        const Vector3 KI = p[i] - p[k];
+        const Scalar cotI = 0.5 * Vector::cotan( IJ, ( -KI ).eval() );
+        const Scalar cotJ = 0.5 * Vector::cotan( JK, ( -IJ ).eval() );
+        const Scalar cotK = 0.5 * Vector::cotan( KI, ( -JK ).eval() );
+        t[0] = SparseTriplet( i, j, -cotK );
+        t[1] = SparseTriplet( j, i, -cotK );
+        t[2] = SparseTriplet( j, k, -cotI );
+        t[3] = SparseTriplet( k, j, -cotI );
+        t[4] = SparseTriplet( k, i, -cotJ );
+        t[5] = SparseTriplet( i, k, -cotJ );
+        t[6] = SparseTriplet( i, i, cotJ + cotK );
+        t[7] = SparseTriplet( j, j, cotI + cotK );
+        t[8] = SparseTriplet( k, k, cotI + cotJ );
+    }, L );
+    return L;
 }
 
 
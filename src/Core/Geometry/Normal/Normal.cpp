@@ -4,6 +4,7 @@
 #include <Core/Geometry/Triangle/TriangleOperation.hpp>
 
 #include <Core/Time/Timer.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 
 namespace Ra {
 namespace Core {
@@ -35,12 +36,13 @@ void uniformNormal( const VectorArray< Vector3 >& p, const VectorArray< Triangle
         normal[k] += triN;
 //}
     }
-//#pragma omp parallel for
-    for( uint i = 0; i < N; ++i ) {
-        if( !normal[i].isApprox( Vector3::Zero() ) ) {
-            normal[i].normalize();
+    parallelFor( 0, N, 0, [&normal]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            if( !normal[i].isApprox( Vector3::Zero() ) ) {
+                normal[i].normalize();
+            }
         }
-    }
+    } );
 }
 
 
@@ -21,6 +21,8 @@ namespace Geometry {
 *       sum( normal( face_j ) ) / || sum( normal( face_j ) ) ||
 *
 * where normal( face_j ) is the normalized normal of face_j belonging to v_i one-ring.
+*
+* To compute the normals of a deforming mesh repeatedly, in parallel, use a NormalUpdater.
 */
 void RA_CORE_API uniformNormal( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, VectorArray< Vector3 >& normal );
 
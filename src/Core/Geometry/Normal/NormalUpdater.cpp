@@ -0,0 +1,166 @@
+#include <Core/Geometry/Normal/NormalUpdater.hpp>
+
+#include <Core/Geometry/Triangle/TriangleOperation.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+
+
+NormalUpdater::NormalUpdater( const Weighting weighting ) : m_weighting( weighting ) { }
+
+
+
+void NormalUpdater::build( const uint point_size, const VectorArray< Triangle >& T ) {
+    m_triangles = T;
+
+    // Counting sort of the corners by vertex, which keeps each vertex corners in the triangles order.
+    m_cornerStart.assign( point_size + 1, 0 );
+    for( const auto& t : T ) {
+        ++m_cornerStart[t( 0 ) + 1];
+        ++m_cornerStart[t( 1 ) + 1];
+        ++m_cornerStart[t( 2 ) + 1];
+    }
+    for( uint i = 0; i < point_size; ++i ) {
+        m_cornerStart[i + 1] += m_cornerStart[i];
+    }
+    m_face.resize( 3 * T.size() );
+    m_corner.resize( 3 * T.size() );
+    std::vector< uint > next( m_cornerStart.begin(), m_cornerStart.end() - 1 );
+    for( uint t = 0; t < T.size(); ++t ) {
+        for( uint c = 0; c < 3; ++c ) {
+            const uint k = next[T[t]( c )]++;
+            m_face[k]   = t;
+            m_corner[k] = 3 * t + c;
+        }
+    }
+}
+
+
+
+bool NormalUpdater::isValid( const uint point_size, const VectorArray< Triangle >& T ) const {
+    return ( ( getPointSize() == point_size ) && ( T.size() == m_triangles.size() ) &&
+             std::equal( T.begin(), T.end(), m_triangles.begin() ) );
+}
+
+
+
+void NormalUpdater::clear() {
+    m_triangles.clear();
+    m_cornerStart.clear();
+    m_face.clear();
+    m_corner.clear();
+}
+
+
+
+Vector3 NormalUpdater::faceNormal( const VectorArray< Vector3 >& p, const uint t, Scalar* angle ) const {
+    const Triangle& T = m_triangles[t];
+    const Vector3 triN = triangleNormal( p[T( 0 )], p[T( 1 )], p[T( 2 )] );
+    switch( m_weighting ) {
+    case UNIFORM:
+        return ( triN.allFinite() ? triN : Vector3::Zero() );
+    case ANGLE:
+        for( uint c = 0; c < 3; ++c ) {
+            const Vector3& v = p[T( c )];
+            angle[c] = Vector::angle( ( p[T( ( c + 1 ) % 3 )] - v ), ( p[T( ( c + 2 ) % 3 )] - v ) );
+        }
+        return triN;
+    case AREA:
+        return ( triangleArea( p[T( 0 )], p[T( 1 )], p[T( 2 )] ) * triN );
+    }
+    return Vector3::Zero();
+}
+
+
+
+void NormalUpdater::compute( const VectorArray< Vector3 >& p, VectorArray< Vector3 >& normal ) const {
+    CORE_ASSERT( p.size() == getPointSize(), "The table was built for another mesh" );
+    // Each triangle computes its normal (and its angles), then each vertex sums the ones of its corners.
+    const bool angles = ( m_weighting == ANGLE );
+    std::vector< Vector3 > face( m_triangles.size() );
+    std::vector< Scalar >  angle( angles ? m_corner.size() : 0 );
+    parallelFor( 0, m_triangles.size(), 0, [&]( uint begin, uint end ) {
+        for( uint t = begin; t < end; ++t ) {
+            face[t] = faceNormal( p, t, angles ? &angle[3 * t] : nullptr );
+        }
+    } );
+    normal.resize( p.size() );
+    parallelFor( 0, p.size(), 0, [&]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            Vector3 n = Vector3::Zero();
+            if( angles ) {
+                for( uint k = m_cornerStart[i]; k < m_cornerStart[i + 1]; ++k ) {
+                    n += angle[m_corner[k]] * face[m_face[k]];
+                }
+            } else {
+                for( uint k = m_cornerStart[i]; k < m_cornerStart[i + 1]; ++k ) {
+                    n += face[m_face[k]];
+                }
+            }
+            if( !n.isApprox( Vector3::Zero() ) ) {
+                n.normalize();
+            }
+            normal[i] = n;
+        }
+    } );
+}
+
+
+
+void NormalUpdater::update( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, VectorArray< Vector3 >& normal ) {
+    if( !isValid( p.size(), T ) ) {
+        build( p.size(), T );
+    }
+    compute( p, normal );
+}
+
+
+
+void NormalUpdater::getAffectedVertices( const std::vector< uint >& moved, std::vector< uint >& affected ) const {
+    const uint first = affected.size();
+    for( const uint i : moved ) {
+        for( uint n = m_cornerStart[i]; n < m_cornerStart[i + 1]; ++n ) {
+            const Triangle& t = m_triangles[m_face[n]];
+            affected.push_back( t( 0 ) );
+            affected.push_back( t( 1 ) );
+            affected.push_back( t( 2 ) );
+        }
+    }
+    std::sort( affected.begin() + first, affected.end() );
+    affected.erase( std::unique( affected.begin() + first, affected.end() ), affected.end() );
+}
+
+
+
+void NormalUpdater::compute( const VectorArray< Vector3 >& p, const std::vector< uint >& moved, VectorArray< Vector3 >& normal ) const {
+    CORE_ASSERT( ( p.size() == getPointSize() ) && ( normal.size() == p.size() ), "The table was built for another mesh" );
+    std::vector< uint > affected;
+    getAffectedVertices( moved, affected );
+    // Each affected vertex computes the corners of its own triangles, which is cheaper than a pass over all the triangles.
+    parallelFor( 0, affected.size(), 0, [&]( uint begin, uint end ) {
+        for( uint n = begin; n < end; ++n ) {
+            const uint i = affected[n];
+            Vector3 normalI = Vector3::Zero();
+            for( uint k = m_cornerStart[i]; k < m_cornerStart[i + 1]; ++k ) {
+                Scalar angle[3];
+                const Vector3 face = faceNormal( p, m_face[k], angle );
+                normalI += ( m_weighting == ANGLE ) ? ( angle[m_corner[k] % 3] * face ).eval() : face;
+            }
+            if( !normalI.isApprox( Vector3::Zero() ) ) {
+                normalI.normalize();
+            }
+            normal[i] = normalI;
+        }
+    } );
+}
+
+
+
+}
+}
+}
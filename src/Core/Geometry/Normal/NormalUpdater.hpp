@@ -0,0 +1,87 @@
+#ifndef NORMAL_UPDATER_DEFINITION
+#define NORMAL_UPDATER_DEFINITION
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Mesh/MeshTypes.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/*
+* The class NormalUpdater computes the vertex normals of a deforming mesh, with the same definitions as
+* uniformNormal, angleWeightedNormal and areaWeightedNormal.
+*
+* It stores once per topology the incident triangle corners of each vertex, as a compressed table.
+* The triangles compute their weighted normals, then each vertex sums the ones of its own corners,
+* both in parallel without any synchronization. The normals can also be updated only around a set of moved vertices
+* (e.g. sculpting or partial deformation).
+*/
+class RA_CORE_API NormalUpdater {
+public:
+    // Weight of the normal of a triangle in the normal of its vertices.
+    enum Weighting {
+        UNIFORM = 0, // See uniformNormal.
+        ANGLE,       // See angleWeightedNormal.
+        AREA         // See areaWeightedNormal.
+    };
+
+    /// CONSTRUCTOR
+    NormalUpdater( const Weighting weighting = UNIFORM );
+
+    /// WEIGHTING
+    inline Weighting getWeighting() const { return m_weighting; }
+    inline void setWeighting( const Weighting weighting ) { m_weighting = weighting; }
+
+    /// TOPOLOGY
+    // Build the table of the incident corners of each vertex.
+    void build( const uint point_size, const VectorArray< Triangle >& T );
+
+    // Return true if the table was built for the given number of points and triangles.
+    bool isValid( const uint point_size, const VectorArray< Triangle >& T ) const;
+
+    void clear();
+
+    inline uint getPointSize() const { return m_cornerStart.empty() ? 0 : m_cornerStart.size() - 1; }
+
+    /// NORMALS
+    // Compute the normals of all the vertices, for the triangles the table was built with.
+    void compute( const VectorArray< Vector3 >& p, VectorArray< Vector3 >& normal ) const;
+
+    // Same as above, rebuilding the table first if the topology changed.
+    void update( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T, VectorArray< Vector3 >& normal );
+
+    /*
+    * Update the normals of the vertices whose normal depends on the moved vertices,
+    * i.e. the vertices of the triangles incident to a moved vertex. The other normals are left unchanged.
+    */
+    void compute( const VectorArray< Vector3 >& p, const std::vector< uint >& moved, VectorArray< Vector3 >& normal ) const;
+
+    // Append to affected the vertices whose normal depends on the moved vertices (see above), without duplicates.
+    void getAffectedVertices( const std::vector< uint >& moved, std::vector< uint >& affected ) const;
+
+private:
+    // Return the weighted normal of triangle t. With the ANGLE weighting, the normal is not weighted
+    // and the angles at its three corners are written in angle.
+    Vector3 faceNormal( const VectorArray< Vector3 >& p, const uint t, Scalar* angle ) const;
+
+private:
+    Weighting m_weighting;
+
+    VectorArray< Triangle > m_triangles;
+
+    // Incident triangles t and corners ( 3 * t + c ) of the i-th vertex,
+    // in m_face and m_corner at [ m_cornerStart[i], m_cornerStart[i+1] ).
+    std::vector< uint > m_cornerStart;
+    std::vector< uint > m_face;
+    std::vector< uint > m_corner;
+};
+
+}
+}
+}
+
+#endif // NORMAL_UPDATER_DEFINITION
@@ -0,0 +1,153 @@
+#include <Core/Geometry/Operator/OperatorPattern.hpp>
+
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+
+
+OperatorPattern::OperatorPattern() : m_pointSize( 0 ) { }
+
+
+
+void OperatorPattern::build( const uint point_size, const VectorArray< Triangle >& T ) {
+    m_pointSize = point_size;
+    m_triangles = T;
+
+    // Each triangle ( i, j, k ) gives 12 ( entry, corner ) pairs: the corner opposite to an edge
+    // contributes to its two entries, and the two other corners of a vertex to its diagonal entry.
+    // The pairs are sorted in the order of the compressed column-major storage.
+    std::vector< std::pair< uint64_t, uint > > pairs( 12 * T.size() );
+    auto key = []( uint row, uint col ) { return ( uint64_t( col ) << 32 ) | row; };
+    parallelFor( 0, T.size(), 0, [&]( uint begin, uint end ) {
+        for( uint n = begin; n < end; ++n ) {
+            std::pair< uint64_t, uint >* e = &pairs[12 * n];
+            for( uint c = 0; c < 3; ++c ) {
+                const uint i = T[n]( c );
+                const uint j = T[n]( ( c + 1 ) % 3 );
+                const uint k = T[n]( ( c + 2 ) % 3 );
+                // Edge jk is opposite to i.
+                e[4 * c + 0] = std::make_pair( key( j, k ), 3 * n + c );
+                e[4 * c + 1] = std::make_pair( key( k, j ), 3 * n + c );
+                // Diagonal of i.
+                e[4 * c + 2] = std::make_pair( key( i, i ), 3 * n + ( c + 1 ) % 3 );
+                e[4 * c + 3] = std::make_pair( key( i, i ), 3 * n + ( c + 2 ) % 3 );
+            }
+        }
+    } );
+    std::sort( pairs.begin(), pairs.end() );
+
+    TripletList laplacian;
+    TripletList adjacency;
+    m_cornerStart.clear();
+    m_corner.resize( pairs.size() );
+    m_adjacencyEntry.clear();
+    for( uint n = 0; n < pairs.size(); ++n ) {
+        m_corner[n] = pairs[n].second;
+        if( n == 0 || pairs[n].first != pairs[n - 1].first ) {
+            const uint row = uint( pairs[n].first & 0xFFFFFFFF );
+            const uint col = uint( pairs[n].first >> 32 );
+            if( row != col ) {
+                m_adjacencyEntry.push_back( m_cornerStart.size() );
+                adjacency.push_back( SparseTriplet( row, col, 0 ) );
+            }
+            m_cornerStart.push_back( n );
+            laplacian.push_back( SparseTriplet( row, col, 0 ) );
+        }
+    }
+    m_cornerStart.push_back( pairs.size() );
+
+    m_laplacian.resize( point_size, point_size );
+    m_laplacian.setFromTriplets( laplacian.begin(), laplacian.end() );
+    m_adjacency.resize( point_size, point_size );
+    m_adjacency.setFromTriplets( adjacency.begin(), adjacency.end() );
+    CORE_ASSERT( m_laplacian.nonZeros() + 1 == Eigen::Index( m_cornerStart.size() ), "Inconsistent pattern" );
+}
+
+
+
+bool OperatorPattern::isValid( const uint point_size, const VectorArray< Triangle >& T ) const {
+    return ( ( point_size == m_pointSize ) && ( T.size() == m_triangles.size() ) &&
+             std::equal( T.begin(), T.end(), m_triangles.begin() ) );
+}
+
+
+
+void OperatorPattern::clear() {
+    m_pointSize = 0;
+    m_triangles.clear();
+    m_laplacian.resize( 0, 0 );
+    m_adjacency.resize( 0, 0 );
+    m_cornerStart.clear();
+    m_corner.clear();
+    m_adjacencyEntry.clear();
+    m_cotan.clear();
+}
+
+
+
+void OperatorPattern::updateLaplacian( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
+    if( !isValid( p.size(), T ) ) {
+        build( p.size(), T );
+    }
+
+    m_cotan.resize( 3 * T.size() );
+    parallelFor( 0, T.size(), 0, [&]( uint begin, uint end ) {
+        for( uint n = begin; n < end; ++n ) {
+            for( uint c = 0; c < 3; ++c ) {
+                const Vector3& v = p[T[n]( c )];
+                const Vector3& a = p[T[n]( ( c + 1 ) % 3 )];
+                const Vector3& b = p[T[n]( ( c + 2 ) % 3 )];
+                m_cotan[3 * n + c] = 0.5 * Vector::cotan( ( a - v ).eval(), ( b - v ).eval() );
+            }
+        }
+    } );
+
+    // Off-diagonal entries are minus the sum of the opposite cotangents, diagonal entries the sum of the adjacent ones.
+    const int*  outer = m_laplacian.outerIndexPtr();
+    const int*  inner = m_laplacian.innerIndexPtr();
+    Scalar*     value = m_laplacian.valuePtr();
+    parallelFor( 0, m_laplacian.outerSize(), 0, [&]( uint begin, uint end ) {
+        for( uint col = begin; col < end; ++col ) {
+            for( int e = outer[col]; e < outer[col + 1]; ++e ) {
+                Scalar sum = 0;
+                for( uint n = m_cornerStart[e]; n < m_cornerStart[e + 1]; ++n ) {
+                    sum += m_cotan[m_corner[n]];
+                }
+                value[e] = ( uint( inner[e] ) == col ) ? sum : -sum;
+            }
+        }
+    } );
+}
+
+
+
+const LaplacianMatrix& OperatorPattern::cotangentWeightLaplacian( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
+    updateLaplacian( p, T );
+    return m_laplacian;
+}
+
+
+
+const AdjacencyMatrix& OperatorPattern::cotangentWeightAdjacency( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T ) {
+    updateLaplacian( p, T );
+    const Scalar* laplacian = m_laplacian.valuePtr();
+    Scalar*       adjacency = m_adjacency.valuePtr();
+    parallelFor( 0, m_adjacencyEntry.size(), 0, [&]( uint begin, uint end ) {
+        for( uint e = begin; e < end; ++e ) {
+            adjacency[e] = -laplacian[m_adjacencyEntry[e]];
+        }
+    } );
+    return m_adjacency;
+}
+
+
+
+}
+}
+}
@@ -0,0 +1,80 @@
+#ifndef OPERATOR_PATTERN_DEFINITION
+#define OPERATOR_PATTERN_DEFINITION
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Mesh/MeshTypes.hpp>
+
+#include <Core/Geometry/Adjacency/Adjacency.hpp>
+#include <Core/Geometry/Laplacian/Laplacian.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/*
+* The class OperatorPattern stores the sparsity pattern of the cotangent weight operators of a triangle mesh,
+* which only depends on its topology.
+* Once built, the operators of the deformed versions of the mesh are computed by only rewriting the values of
+* the cached matrices: each non-zero entry sums the cotangents of the triangle corners it depends on, in parallel.
+* The pattern is rebuilt when the topology changes.
+*/
+class RA_CORE_API OperatorPattern {
+public:
+    /// CONSTRUCTOR
+    OperatorPattern();
+
+    /// PATTERN
+    // Build the pattern for the given number of points and triangles.
+    void build( const uint point_size, const VectorArray< Triangle >& T );
+
+    // Return true if the pattern was built for the given number of points and triangles.
+    bool isValid( const uint point_size, const VectorArray< Triangle >& T ) const;
+
+    void clear();
+
+    /// OPERATORS
+    /*
+    * Return the same matrix as Geometry::cotangentWeightLaplacian( p, T ).
+    * The reference stays valid until the next call of a function of the pattern.
+    */
+    const LaplacianMatrix& cotangentWeightLaplacian( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T );
+
+    /*
+    * Return the same matrix as Geometry::cotangentWeightAdjacency( p, T ).
+    * The reference stays valid until the next call of a function of the pattern.
+    */
+    const AdjacencyMatrix& cotangentWeightAdjacency( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T );
+
+private:
+    // Rebuild the pattern if needed, and compute the values of the Laplacian.
+    void updateLaplacian( const VectorArray< Vector3 >& p, const VectorArray< Triangle >& T );
+
+private:
+    // Topology of the pattern.
+    uint                    m_pointSize;
+    VectorArray< Triangle > m_triangles;
+
+    // Matrices with the pattern of the operators.
+    LaplacianMatrix m_laplacian;
+    AdjacencyMatrix m_adjacency;
+
+    // Corners of the triangles ( 3 * t + c ) contributing to each non-zero entry of the Laplacian:
+    // m_corner[ m_cornerStart[e], m_cornerStart[e+1] ) for the e-th entry.
+    std::vector< uint > m_cornerStart;
+    std::vector< uint > m_corner;
+
+    // Entry of the Laplacian of each non-zero entry of the adjacency matrix.
+    std::vector< uint > m_adjacencyEntry;
+
+    // Half cotangent of the angle at each triangle corner.
+    std::vector< Scalar > m_cotan;
+};
+
+}
+}
+}
+
+#endif // OPERATOR_PATTERN_DEFINITION
@@ -0,0 +1,89 @@
+#ifndef TRIPLET_ASSEMBLY_DEFINITION
+#define TRIPLET_ASSEMBLY_DEFINITION
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace Geometry {
+
+/////////////////////
+/// TRIPLET LISTS ///
+/////////////////////
+
+typedef Eigen::Triplet< Scalar > SparseTriplet;
+typedef std::vector< SparseTriplet > TripletList;
+
+
+
+/*
+* Return the list of the triplets given by f( n, t ) for each item n in [ 0, item_size ),
+* where t points to the triplet_per_item triplets of the item, which must all be written.
+* Items are processed in parallel (see parallelFor()), each one writing in its own range of the list.
+*/
+template < typename Func >
+inline TripletList itemTriplets( const uint item_size, const uint triplet_per_item, const Func& f ) {
+    TripletList triplets( item_size * triplet_per_item );
+    parallelFor( 0, item_size, 0, [&]( uint begin, uint end ) {
+        for( uint n = begin; n < end; ++n ) {
+            f( n, &triplets[n * triplet_per_item] );
+        }
+    } );
+    return triplets;
+}
+
+
+
+/*
+* Fill M (of size rows x cols) from the triplets of each item (see itemTriplets()).
+* Duplicated entries are summed.
+*/
+template < typename Func >
+inline void assembleFromTriplets( const uint rows, const uint cols, const uint item_size, const uint triplet_per_item,
+                                  const Func& f, Sparse& M ) {
+    const TripletList triplets = itemTriplets( item_size, triplet_per_item, f );
+    M.resize( rows, cols );
+    M.setFromTriplets( triplets.begin(), triplets.end() );
+}
+
+
+
+/*
+* Same as above, except that duplicated entries keep the value of the first one
+* (e.g. for operators defined as "1 if exist the edge").
+*/
+template < typename Func >
+inline void assembleUniqueFromTriplets( const uint rows, const uint cols, const uint item_size, const uint triplet_per_item,
+                                        const Func& f, Sparse& M ) {
+    const TripletList triplets = itemTriplets( item_size, triplet_per_item, f );
+    M.resize( rows, cols );
+    M.setFromTriplets( triplets.begin(), triplets.end(), []( const Scalar& a, const Scalar& ) { return a; } );
+}
+
+
+
+/////////////////////////
+/// DIAGONAL MATRICES ///
+/////////////////////////
+
+/*
+* Return the sparse diagonal matrix whose diagonal is d.
+*/
+inline Sparse diagonalMatrix( const VectorN& d ) {
+    Sparse D( d.size(), d.size() );
+    D.setIdentity();
+    // A compressed identity stores exactly its diagonal, column by column.
+    D.coeffs() = d;
+    return D;
+}
+
+
+
+}
+}
+}
+
+#endif // TRIPLET_ASSEMBLY_DEFINITION
@@ -13,7 +13,11 @@ namespace Ra
         {
         public:
             /// CONSTRUCTOR
+            /// An index built from a value alone has no generation : an IndexMap accepts it for the
+            /// object currently stored at this value. The indices given by an IndexMap carry the
+            /// generation of their slot, which detects them when stale.
             Index( const int i = s_invalid );
+            Index( const int i, const uint generation );
             Index( const Index& i );
 
             /// DESTRUCTOR
@@ -41,6 +45,10 @@ namespace Ra
             inline int  getValue() const;
             inline void setValue( const int i );
 
+            /// GENERATION
+            inline bool hasGeneration() const;
+            inline uint getGeneration() const;
+
             /// OPERATOR
             inline Index& operator= ( const Index& id );
             inline Index& operator++();
@@ -144,11 +152,13 @@ namespace Ra
 
         protected:
             /// VARIABLE
-            int m_idx;
+            int  m_idx;
+            uint m_generation;
 
         private:
             /// CONSTANT
             static const int s_invalid = -1;
+            static const uint s_noGeneration = uint( -1 );
             static const int s_maxIdx = std::numeric_limits<int>::max();
         };
 
@@ -6,17 +6,26 @@ namespace Ra
         inline Index::Index( const int i )
         {
             m_idx = ( i < 0 ) ? s_invalid : i;
+            m_generation = s_noGeneration;
+        }
+
+        inline Index::Index( const int i, const uint generation )
+        {
+            m_idx = ( i < 0 ) ? s_invalid : i;
+            m_generation = generation;
         }
         
         inline Index::Index( const Index& i )
         {
             m_idx = i.m_idx;
+            m_generation = i.m_generation;
         }
 
         /// COPY
         inline void Index::copy( const Index& id )
         {
             m_idx = id.m_idx;
+            m_generation = id.m_generation;
         }
 
         /// VALID
@@ -33,6 +42,7 @@ namespace Ra
         inline void  Index::setInvalid()
         {
             m_idx = s_invalid;
+            m_generation = s_noGeneration;
         }
 
         /// INDEX
@@ -43,17 +53,30 @@ namespace Ra
         inline void Index::setValue( const int i )
         {
             m_idx = ( i < 0 ) ? s_invalid : i;
+            m_generation = s_noGeneration;
+        }
+
+        /// GENERATION
+        inline bool Index::hasGeneration() const
+        {
+            return ( m_generation != s_noGeneration );
+        }
+        inline uint Index::getGeneration() const
+        {
+            return m_generation;
         }
 
         /// OPERATOR
         inline Index& Index::operator= ( const Index& id )
         {
             m_idx = id.m_idx;
+            m_generation = id.m_generation;
             return *this;
         }
         inline Index& Index::operator++()
         {
             m_idx++;
+            m_generation = s_noGeneration;
             return *this;
         }
         inline Index& Index::operator--()
@@ -62,6 +85,7 @@ namespace Ra
             {
                 m_idx--;
             }
+            m_generation = s_noGeneration;
             return *this;
         }
 
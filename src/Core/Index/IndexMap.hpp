@@ -3,7 +3,9 @@
 
 #include <Core/RaCore.hpp>
 #include <deque>
+#include <vector>
 #include <algorithm>
+#include <limits>
 #include <assert.h>
 
 #include <Core/Index/Index.hpp>
@@ -14,9 +16,17 @@ namespace Core {
 /*
 * The class IndexMap define a map where a object is coupled with a index.
 * The index is unique, it is assigned to a object when it's inserted and is kept until the object is removed.
-* After a removal, the index becomes free again.
-* A object will be given the first free index available.
-* If no free indices are available, the object will not be inserted and the IndexMap is considered full.
+*
+* The map is a slot map : objects are stored contiguously (the i-th object is m_data[i]), and each index
+* refers to a slot of a sparse table storing the position of its object. Removing an object moves the last
+* one in its place, so the order of the objects changes, but their indices do not.
+* The value of an index is its slot, and the index carries the generation of this slot, which is
+* incremented when its object is removed : the freed slot is reused by the next insertion, while the
+* indices of the removed object are detected as stale. Indices built from a value alone (e.g. an id read
+* back from the GPU) have no generation and refer to the object currently in the slot.
+* Until an object is removed, the indices are 0, 1, 2... in insertion order.
+* Insertion, removal and access by index are in constant time.
+* If no free slots are available, the object will not be inserted and the IndexMap is considered full.
 */
 template <typename T>
 class IndexMap {
@@ -76,7 +86,7 @@ public:
     inline bool  empty() const;                             // Return true if the IndexMap is empty.
     inline bool  full()  const;                             // Return true if the IndexMap cannot contain more objects.
     inline bool  contain( const Index& idx ) const;         // Return true if the IndexMap contains a object with the given index.
-    inline bool  compact() const;                           // Return true if the indices in the map are all consecutive.
+    inline bool  compact() const;                           // Return true if the slots in the map are all used.
     inline Index index( const uint i ) const;               // Return the i-th index. Return an invalid index if i is out of bound.
     inline bool  index( const uint i, Index& idx ) const;   // Return the i-th index. Return false if i is out of bound.
 
@@ -105,28 +115,46 @@ public:
     inline ConstIterator cbegin() const;                    // Return a const iterator to the first object in the IndexMap.
     inline ConstIterator   cend() const;                    // Return a const iterator to the end of the object list in the IndexMap.
 
+    /// ===============================================================================
+    /// CONSTANT
+    /// ===============================================================================
+    static const uint MaxSlots      = uint( std::numeric_limits< int >::max() ); // Maximum number of objects.
+    static const uint MaxGeneration = uint( -2 );                   // Slots are not reused after this generation.
+
 protected:
     /// ===============================================================================
     /// VARIABLE
     /// ===============================================================================
     std::deque< T >     m_data;                             // Objects in the IndexMap
-    std::deque< Index > m_index;                            // Indices in the IndexMap
+    std::deque< Index > m_index;                            // Indices in the IndexMap, m_index[i] is the index of m_data[i]
 
 private:
+    /// ===============================================================================
+    /// SLOT
+    /// ===============================================================================
+    struct Slot {
+        uint m_position;                                    // Position of the object in m_data, InvalidPosition if the slot is free.
+        uint m_generation;                                  // Generation of the indices of this slot.
+    };
+    static const uint InvalidPosition = uint( -1 );
+
+    inline bool find( const Index& idx, uint& position ) const; // Return false if the index is not in the map, its position otherwise.
+
     /// ===============================================================================
     /// PUSH
     /// ===============================================================================
-    inline void push_free_index( const Index& idx );        // Push a new free index in the list of the free indices.
+    inline void push_free_index( const Index& idx );        // Free the slot of a removed index.
 
     /// ===============================================================================
     /// POP
     /// ===============================================================================
-    inline bool pop_free_index( Index& idx );               // Pop a free index from the list of free indices. Return false if no free indices are available.
+    inline bool pop_free_index( Index& idx );               // Pop a free slot and return its index. Return false if no free slots are available.
 
     /// ===============================================================================
     /// VARIABLE
     /// ===============================================================================
-    std::deque< Index > m_free;                             // List of available free indices.
+    std::vector< Slot > m_slot;                             // Slots of the indices.
+    std::vector< uint > m_free;                             // List of available free slots.
 };
 
 } // namespace Core
@@ -12,7 +12,8 @@ template < typename T >
 IndexMap< T >::IndexMap() :
     m_data(),
     m_index(),
-    m_free( 1, Index( 0 ) ) { }
+    m_slot(),
+    m_free() { }
 
 
 
@@ -20,6 +21,7 @@ template < typename T >
 IndexMap< T >::IndexMap( const IndexMap& id_map ) :
     m_data( id_map.m_data ),
     m_index( id_map.m_index ),
+    m_slot( id_map.m_slot ),
     m_free( id_map.m_free ) { }
 
 
@@ -44,15 +46,7 @@ IndexMap< T >::~IndexMap() { }
 template < typename T >
 inline Index IndexMap< T >::insert( const T& obj ) {
     Index idx;
-    if( pop_free_index( idx ) ) {
-        typename std::deque< Index >::iterator it = std::lower_bound( m_index.begin(), m_index.end(), idx );
-        if( it == m_index.end() ) {
-            m_data.insert( m_data.end(), obj );
-        } else {
-            m_data.insert( ( m_data.begin() + ( it - m_index.begin() ) ), obj );
-        }
-        m_index.insert( it, idx );
-    }
+    insert( obj, idx );
     return idx;
 }
 
@@ -64,13 +58,9 @@ inline bool IndexMap< T >::insert( const T& obj,
     if( !pop_free_index( idx ) ) {
         return false;
     }
-    typename std::deque< Index >::iterator it = std::lower_bound( m_index.begin(), m_index.end(), idx );
-    if( it == m_index.end() ) {
-        m_data.insert( m_data.end(), obj );
-    } else {
-        m_data.insert( ( m_data.begin() + ( it - m_index.begin() ) ), obj );
-    }
-    m_index.insert( it, idx );
+    m_slot[ uint( idx.getValue() ) ].m_position = m_data.size();
+    m_data.push_back( obj );
+    m_index.push_back( idx );
     return true;
 }
 
@@ -84,14 +74,11 @@ inline bool IndexMap< T >::insert( const T& obj,
 /// ===============================================================================
 template < typename T >
 inline bool IndexMap< T >::remove( const Index& idx ) {
-    typename std::deque< Index >::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    if( it == m_index.end() ) {
+    uint i;
+    if( !find( idx, i ) ) {
         return false;
     }
-    m_data.erase( m_data.begin() + ( it - m_index.begin() ) );
-    m_index.erase( it );
-    push_free_index( idx );
-    return true;
+    return remove( i );
 }
 
 
@@ -102,8 +89,15 @@ inline bool IndexMap< T >::remove( const uint i ) {
         return false;
     }
     push_free_index( m_index[i] );
-    m_data.erase( m_data.begin() + i );
-    m_index.erase( m_index.begin() + i );
+    // Move the last object in the hole.
+    const uint last = m_data.size() - 1;
+    if( i != last ) {
+        m_data[i]  = std::move( m_data[last] );
+        m_index[i] = m_index[last];
+        m_slot[ uint( m_index[i].getValue() ) ].m_position = i;
+    }
+    m_data.pop_back();
+    m_index.pop_back();
     return true;
 }
 
@@ -117,9 +111,10 @@ inline bool IndexMap< T >::remove( const uint i ) {
 /// ===============================================================================
 template < typename T >
 inline T IndexMap< T >::at( const Index& idx ) const {
-    typename std::deque< Index >::const_iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    CORE_ASSERT( it != m_index.end(), "Index not found" );
-    return m_data.at( it - m_index.begin() );
+    uint i = InvalidPosition;
+    ON_DEBUG( bool found = ) find( idx, i );
+    CORE_ASSERT( found, "Index not found" );
+    return m_data.at( i );
 }
 
 
@@ -135,11 +130,11 @@ inline T IndexMap< T >::at( const uint i ) const {
 template < typename T >
 inline bool IndexMap< T >::at( const Index& idx,
                                T&           obj ) const {
-    typename std::deque< Index >::const_iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    if( it == m_index.end() ) {
+    uint i;
+    if( !find( idx, i ) ) {
         return false;
     }
-    obj = m_data.at( it - m_index.begin() );
+    obj = m_data[i];
     return true;
 }
 
@@ -159,9 +154,10 @@ inline bool IndexMap< T >::at( const uint i,
 
 template < typename T >
 inline T& IndexMap< T >::access( const Index& idx ) {
-    typename std::deque< Index >::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    CORE_ASSERT( ( it != m_index.end() ), "Index not found" );
-    return m_data[ it - m_index.begin()  ];
+    uint i = InvalidPosition;
+    ON_DEBUG( bool found = ) find( idx, i );
+    CORE_ASSERT( found, "Index not found" );
+    return m_data[i];
 }
 
 
@@ -177,14 +173,11 @@ inline T& IndexMap< T >::access( const uint i ) {
 template < typename T >
 inline bool IndexMap< T >::access( const Index& idx,
                                    T&           obj ) {
-    if( m_data.empty() ) {
+    uint i;
+    if( !find( idx, i ) ) {
         return false;
     }
-    typename std::deque< Index >::iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    if( it == m_index.end() ) {
-        return false;
-    }
-    obj = m_data[ it - m_index.begin() ];
+    obj = m_data[i];
     return true;
 }
 
@@ -219,8 +212,8 @@ template < typename T >
 inline void IndexMap< T >::clear() {
     m_index.clear();
     m_data.clear();
+    m_slot.clear();
     m_free.clear();
-    m_free.push_back( Index( 0 ) );
 }
 
 
@@ -240,24 +233,22 @@ inline bool IndexMap< T >::empty() const {
 
 template < typename T >
 inline bool IndexMap< T >::full() const {
-    return m_free.empty();
+    return m_free.empty() && ( m_slot.size() == MaxSlots );
 }
 
 
 
 template < typename T >
 inline bool IndexMap< T >::contain( const Index& idx ) const {
-    typename std::deque< Index >::const_iterator it = std::find( m_index.begin(), m_index.end(), idx );
-    return !( it == m_index.end() );
+    uint i;
+    return find( idx, i );
 }
 
 
 
 template < typename T >
 inline bool IndexMap< T >::compact() const {
-    size_t front = m_free.front();
-    bool result = (front > m_data.size());
-    return result;;
+    return ( m_slot.size() == m_data.size() );
 }
 
 
@@ -395,16 +386,42 @@ inline typename IndexMap< T >::ConstIterator IndexMap< T >::cend() const {
 
 
 
+/// ===============================================================================
+/// FIND
+/// ===============================================================================
+template < typename T >
+inline bool IndexMap< T >::find( const Index& idx, uint& position ) const {
+    if( idx.isInvalid() ) {
+        return false;
+    }
+    const uint slot = uint( idx.getValue() );
+    if( slot >= m_slot.size() ) {
+        return false;
+    }
+    if( idx.hasGeneration() && ( m_slot[slot].m_generation != idx.getGeneration() ) ) {
+        return false;
+    }
+    position = m_slot[slot].m_position;
+    return ( position != InvalidPosition );
+}
+
+
+
+
+
+
 /// ===============================================================================
 /// PUSH
 /// ===============================================================================
 template < typename T >
 inline void IndexMap< T >::push_free_index( const Index& idx ) {
-    std::deque<Index>::iterator free_it = std::lower_bound( m_free.begin(), m_free.end(), idx );
-    m_free.insert( free_it, idx );
-    if( m_data.empty() ) {
-        m_free.clear();
-        m_free.push_back( Index( 0 ) );
+    const uint slot = uint( idx.getValue() );
+    m_slot[slot].m_position = InvalidPosition;
+    // The next index of this slot will differ from the removed one. Slots whose generations are
+    // exhausted are not reused, so that stale indices are never mistaken for new ones.
+    if( m_slot[slot].m_generation < MaxGeneration ) {
+        ++m_slot[slot].m_generation;
+        m_free.push_back( slot );
     }
 }
 
@@ -418,20 +435,21 @@ inline void IndexMap< T >::push_free_index( const Index& idx ) {
 /// ===============================================================================
 template < typename T >
 inline bool IndexMap< T >::pop_free_index( Index& idx ) {
-    if( m_free.empty() ) {
+    uint slot;
+    if( !m_free.empty() ) {
+        slot = m_free.back();
+        m_free.pop_back();
+    } else if( m_slot.size() < MaxSlots ) {
+        slot = m_slot.size();
+        Slot s;
+        s.m_position   = InvalidPosition;
+        s.m_generation = 0;
+        m_slot.push_back( s );
+    } else {
         idx = Index::INVALID_IDX();
         return false;
     }
-    idx = m_free.front();
-    m_free.pop_front();
-    if( m_free.empty() ) {
-        Index next = idx + 1;
-        if( next.isValid() ) {
-            if( uint( next.getValue() ) > m_data.size() ) {
-                m_free.push_back( next );
-            }
-        }
-    }
+    idx = Index( int( slot ), m_slot[slot].m_generation );
     return true;
 }
 
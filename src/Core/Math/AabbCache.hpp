@@ -0,0 +1,73 @@
+#ifndef RADIUM_AABB_CACHE_HPP_
+#define RADIUM_AABB_CACHE_HPP_
+
+#include <Core/RaCore.hpp>
+
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Caches the local and world bounding boxes of an object whose geometry and transform
+        /// change much less often than its box is queried.
+        /// Changes are tracked with versions given by the caller, which must differ whenever the
+        /// geometry (local version) or the transform (transform version) changed.
+        /// Querying an up to date box does not lock: the box is copied under a sequence counter
+        /// and the copy is rejected if an update ran meanwhile, in which case the caller falls back
+        /// to its lock. Updates must be serialized by the caller.
+        class AabbCache
+        {
+        public:
+            /// Packs two version counters in one version, e.g. the version of a mesh and
+            /// the number of times the mesh was replaced.
+            static inline std::uint64_t makeVersion( uint high, uint low );
+
+            /// Transforms a box in O(1) : the new half extents are the old ones multiplied by
+            /// the absolute value of the linear part of the transform.
+            static inline Aabb transformAabb( const Aabb& aabb, const Transform& transform );
+
+            /// Initializes an empty and outdated cache.
+            AabbCache();
+            AabbCache( const AabbCache& other ) = delete;
+            AabbCache& operator=( const AabbCache& other ) = delete;
+
+            /// Returns true and sets aabb to the world box if it is up to date. Returns false if the
+            /// box is outdated or is being updated.
+            inline bool getAabb( std::uint64_t localVersion, std::uint64_t transformVersion, Aabb& aabb ) const;
+
+            /// Returns true if the local box is up to date.
+            inline bool isLocalValid( std::uint64_t localVersion ) const;
+
+            inline const Aabb& getLocalAabb() const;
+
+            /// Sets the local box. The world box becomes outdated.
+            inline void setLocalAabb( const Aabb& aabb, std::uint64_t localVersion );
+
+            /// Recomputes the world box from the local box and returns it.
+            inline Aabb update( const Transform& transform, std::uint64_t transformVersion );
+
+        private:
+            static const std::uint64_t Invalid = std::uint64_t( -1 );
+
+            Aabb m_localAabb;
+            // World box min and max, atomic so that a reader racing with update() reads stale
+            // values rather than undefined ones.
+            std::atomic<Scalar> m_aabb[6];
+
+            std::atomic<std::uint64_t> m_localVersion;
+            // Versions the world box was computed with.
+            std::atomic<std::uint64_t> m_aabbLocalVersion;
+            std::atomic<std::uint64_t> m_aabbTransformVersion;
+            // Odd while the world box is being written.
+            std::atomic<std::uint64_t> m_sequence;
+        };
+    }
+}
+
+#include <Core/Math/AabbCache.inl>
+
+#endif // RADIUM_AABB_CACHE_HPP_
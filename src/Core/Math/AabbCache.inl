@@ -0,0 +1,95 @@
+#include "AabbCache.hpp"
+
+namespace Ra
+{
+    namespace Core
+    {
+        inline std::uint64_t AabbCache::makeVersion( uint high, uint low )
+        {
+            return ( std::uint64_t( high ) << 32 ) | std::uint64_t( low );
+        }
+
+        inline Aabb AabbCache::transformAabb( const Aabb& aabb, const Transform& transform )
+        {
+            if ( aabb.isEmpty() )
+            {
+                return Aabb();
+            }
+            const Vector3 center = transform * aabb.center();
+            const Vector3 half = transform.linear().cwiseAbs() * ( Scalar( 0.5 ) * aabb.sizes() );
+            return Aabb( center - half, center + half );
+        }
+
+        inline AabbCache::AabbCache()
+            : m_localAabb()
+            , m_localVersion( Invalid )
+            , m_aabbLocalVersion( Invalid )
+            , m_aabbTransformVersion( Invalid )
+            , m_sequence( 0 )
+        {
+            for ( auto& bound : m_aabb )
+            {
+                bound.store( 0, std::memory_order_relaxed );
+            }
+        }
+
+        inline bool AabbCache::getAabb( std::uint64_t localVersion, std::uint64_t transformVersion, Aabb& aabb ) const
+        {
+            const std::uint64_t sequence = m_sequence.load( std::memory_order_acquire );
+            if ( ( sequence & 1 ) != 0 || localVersion == Invalid || transformVersion == Invalid ||
+                 m_aabbLocalVersion.load( std::memory_order_relaxed ) != localVersion ||
+                 m_aabbTransformVersion.load( std::memory_order_relaxed ) != transformVersion )
+            {
+                return false;
+            }
+            Vector3 min, max;
+            for ( uint i = 0; i < 3; ++i )
+            {
+                min[i] = m_aabb[i].load( std::memory_order_relaxed );
+                max[i] = m_aabb[i + 3].load( std::memory_order_relaxed );
+            }
+            // The copy is only valid if no update started meanwhile.
+            std::atomic_thread_fence( std::memory_order_acquire );
+            if ( m_sequence.load( std::memory_order_relaxed ) != sequence )
+            {
+                return false;
+            }
+            aabb = Aabb( min, max );
+            return true;
+        }
+
+        inline bool AabbCache::isLocalValid( std::uint64_t localVersion ) const
+        {
+            return localVersion != Invalid && m_localVersion.load( std::memory_order_acquire ) == localVersion;
+        }
+
+        inline const Aabb& AabbCache::getLocalAabb() const
+        {
+            return m_localAabb;
+        }
+
+        inline void AabbCache::setLocalAabb( const Aabb& aabb, std::uint64_t localVersion )
+        {
+            m_aabbLocalVersion.store( Invalid, std::memory_order_release );
+            m_localAabb = aabb;
+            m_localVersion.store( localVersion, std::memory_order_release );
+        }
+
+        inline Aabb AabbCache::update( const Transform& transform, std::uint64_t transformVersion )
+        {
+            const Aabb aabb = transformAabb( m_localAabb, transform );
+            const std::uint64_t sequence = m_sequence.load( std::memory_order_relaxed );
+            m_sequence.store( sequence + 1, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release );
+            for ( uint i = 0; i < 3; ++i )
+            {
+                m_aabb[i].store( aabb.min()[i], std::memory_order_relaxed );
+                m_aabb[i + 3].store( aabb.max()[i], std::memory_order_relaxed );
+            }
+            m_aabbTransformVersion.store( transformVersion, std::memory_order_relaxed );
+            m_aabbLocalVersion.store( m_localVersion.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+            m_sequence.store( sequence + 2, std::memory_order_release );
+            return aabb;
+        }
+    }
+}
@@ -36,7 +36,7 @@ namespace Ra
             inline bool vsTriangle( const Ray& r, const Core::Vector3 a, const Core::Vector3& b, const Core::Vector3& c,
                             std::vector<Scalar>& hitsOut);
 
-            // FIXME(Charly): Not efficient, intersecting against a kd-tree would be ways faster.
+            /// Tests every triangle of the mesh. Use a TriangleBVH to cast many rays against large meshes.
             inline bool vsTriangleMesh(const Ray& r, const TriangleMesh& mesh, std::vector<Scalar>& hitsOut, std::vector<Triangle>& trianglesIdxOut);
         }
     }
@@ -3,10 +3,13 @@
 #include <utility>
 #include <set>
 #include <map>
+#include <algorithm>
+#include <cstring>
 
 #include <Core/Math/Math.hpp>
 #include <Core/Math/RayCast.hpp>
 #include <Core/String/StringUtils.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 
 namespace Ra
 {
@@ -37,45 +40,221 @@ namespace Ra
             }
 
 
+            namespace
+            {
+                // Mixes the bits of a 64 bits value (splitmix64 finalizer).
+                inline uint64_t mixBits( uint64_t x )
+                {
+                    x ^= x >> 30;
+                    x *= 0xbf58476d1ce4e5b9ULL;
+                    x ^= x >> 27;
+                    x *= 0x94d049bb133111ebULL;
+                    x ^= x >> 31;
+                    return x;
+                }
+
+                // Key of a grid cell. Different cells may have the same key, they are then
+                // looked up together, which only costs a few more distance tests.
+                inline uint64_t cellKey( int64_t x, int64_t y, int64_t z )
+                {
+                    return mixBits( uint64_t( x ) + mixBits( uint64_t( y ) + mixBits( uint64_t( z ) ) ) );
+                }
+
+                // Key of an exact position (-0 and +0 have the same key).
+                inline uint64_t positionKey( const Vector3& p )
+                {
+                    uint64_t key = 0;
+                    for ( uint k = 0; k < 3; ++k )
+                    {
+                        const Scalar c = p[k] + Scalar( 0 );
+                        uint64_t bits = 0;
+                        std::memcpy( &bits, &c, sizeof( Scalar ) );
+                        key = mixBits( key + bits );
+                    }
+                    return key;
+                }
+
+                // Open addressing table from a key to the first entry with this key in an array sorted by keys.
+                class KeyTable
+                {
+                public:
+                    KeyTable( const std::vector<std::pair<uint64_t, uint>>& sorted ) : m_sorted( sorted )
+                    {
+                        uint numKeys = 0;
+                        for ( uint i = 0; i < sorted.size(); ++i )
+                        {
+                            numKeys += ( i == 0 || sorted[i].first != sorted[i - 1].first ) ? 1 : 0;
+                        }
+                        uint capacity = 1;
+                        while ( capacity < 2 * numKeys )
+                        {
+                            capacity *= 2;
+                        }
+                        m_mask = capacity - 1;
+                        m_table.resize( capacity, uint( Empty ) );
+                        for ( uint i = 0; i < sorted.size(); ++i )
+                        {
+                            if ( i == 0 || sorted[i].first != sorted[i - 1].first )
+                            {
+                                uint h = uint( sorted[i].first ) & m_mask;
+                                while ( m_table[h] != Empty )
+                                {
+                                    h = ( h + 1 ) & m_mask;
+                                }
+                                m_table[h] = i;
+                            }
+                        }
+                    }
+
+                    // Returns the position of the first entry with the given key, or Empty.
+                    inline uint find( uint64_t key ) const
+                    {
+                        uint h = uint( key ) & m_mask;
+                        while ( m_table[h] != Empty && m_sorted[m_table[h]].first != key )
+                        {
+                            h = ( h + 1 ) & m_mask;
+                        }
+                        return m_table[h];
+                    }
+
+                    static const uint Empty = uint( -1 );
+
+                private:
+                    const std::vector<std::pair<uint64_t, uint>>& m_sorted;
+                    std::vector<uint> m_table;
+                    uint m_mask;
+                };
+            }
+
             bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap )
             {
-                bool hasDuplicates = false;
-                duplicatesMap.clear();
+                return findDuplicates( mesh, duplicatesMap, DuplicatesOptions() );
+            }
+
+            bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap,
+                                 const DuplicatesOptions& options )
+            {
                 const uint numVerts = mesh.m_vertices.size();
-                duplicatesMap.resize( numVerts,VertexIdx(-1) );
+                duplicatesMap.clear();
+                duplicatesMap.resize( numVerts, VertexIdx( -1 ) );
 
-                VectorArray<Vector3>::const_iterator vertPos;
-                VectorArray<Vector3>::const_iterator duplicatePos;
-                for ( uint i = 0; i < numVerts; ++i )
+                CORE_ASSERT( !options.m_compareNormals || mesh.m_normals.size() == numVerts, "Missing normals" );
+                CORE_ASSERT( !options.m_texCoords || options.m_texCoords->size() == numVerts, "Missing texture coordinates" );
+
+                const bool exact = !( options.m_epsilon > 0 );
+                const Scalar epsSq = options.m_epsilon * options.m_epsilon;
+                const Scalar attribEpsSq = options.m_attribEpsilon * options.m_attribEpsilon;
+                // Points closer than epsilon are in the same cell or in adjacent ones.
+                const Scalar invCellSize = exact ? Scalar( 0 ) : 1 / ( 2 * options.m_epsilon );
+                auto cellOf = [invCellSize]( Scalar x ) { return int64_t( std::floor( x * invCellSize ) ); };
+
+                // Vertices sorted by key, and by index for each key.
+                std::vector<std::pair<uint64_t, uint>> sorted( numVerts );
+                parallelFor( 0, numVerts, 0, [&]( uint begin, uint end )
+                {
+                    for ( uint i = begin; i < end; ++i )
+                    {
+                        const Vector3& p = mesh.m_vertices[i];
+                        sorted[i].first = exact ? positionKey( p ) : cellKey( cellOf( p.x() ), cellOf( p.y() ), cellOf( p.z() ) );
+                        sorted[i].second = i;
+                    }
+                } );
+                std::sort( sorted.begin(), sorted.end() );
+                const KeyTable table( sorted );
+
+                auto isDuplicate = [&]( uint i, uint j )
+                {
+                    return ( mesh.m_vertices[i] - mesh.m_vertices[j] ).squaredNorm() <= epsSq
+                           && ( !options.m_compareNormals
+                                || ( mesh.m_normals[i] - mesh.m_normals[j] ).squaredNorm() <= attribEpsSq )
+                           && ( !options.m_texCoords
+                                || ( ( *options.m_texCoords )[i] - ( *options.m_texCoords )[j] ).squaredNorm() <= attribEpsSq );
+                };
+
+                // Finds the first vertex with the given key (before the current match) which is a duplicate of i.
+                auto searchKey = [&]( uint i, uint64_t key, uint& match )
+                {
+                    uint pos = table.find( key );
+                    if ( pos == KeyTable::Empty )
+                    {
+                        return;
+                    }
+                    for ( ; pos < numVerts && sorted[pos].first == key && sorted[pos].second < match; ++pos )
+                    {
+                        if ( isDuplicate( i, sorted[pos].second ) )
+                        {
+                            match = sorted[pos].second;
+                            return;
+                        }
+                    }
+                };
+
+                parallelFor( 0, numVerts, 0, [&]( uint begin, uint end )
                 {
-                    // We look if we have previously seen the same vertex before in the array.
-                    const Vector3& vertex = mesh.m_vertices[i];
-                    vertPos = mesh.m_vertices.cbegin() + i;
-                    duplicatePos = std::find( mesh.m_vertices.cbegin(), vertPos, vertex );
+                    for ( uint i = begin; i < end; ++i )
+                    {
+                        const Vector3& p = mesh.m_vertices[i];
+                        uint match = i;
+                        if ( exact )
+                        {
+                            searchKey( i, positionKey( p ), match );
+                        }
+                        else
+                        {
+                            // The cells covering [p - epsilon, p + epsilon] : 1 or 2 per axis.
+                            const Vector3 lo = p - Vector3::Constant( options.m_epsilon );
+                            const Vector3 hi = p + Vector3::Constant( options.m_epsilon );
+                            for ( int64_t x = cellOf( lo.x() ); x <= cellOf( hi.x() ); ++x )
+                            {
+                                for ( int64_t y = cellOf( lo.y() ); y <= cellOf( hi.y() ); ++y )
+                                {
+                                    for ( int64_t z = cellOf( lo.z() ); z <= cellOf( hi.z() ); ++z )
+                                    {
+                                        searchKey( i, cellKey( x, y, z ), match );
+                                    }
+                                }
+                            }
+                        }
+                        duplicatesMap[i] = match;
+                    }
+                } );
 
-                    // The number in duplicates_map will be 'i' if no duplicates are found
-                    // up to v_i, or the index of the first vertex equal to v_i.
-                    duplicatesMap[i] = ( duplicatePos - mesh.m_vertices.cbegin() );
+                // Follow the matches, so that every vertex maps to a vertex which maps to itself.
+                bool hasDuplicates = false;
+                for ( uint i = 0; i < numVerts; ++i )
+                {
+                    duplicatesMap[i] = duplicatesMap[duplicatesMap[i]];
                     CORE_ASSERT( duplicatesMap[i] <= i, " Invalid vertex indices" );
                     hasDuplicates = ( hasDuplicates || duplicatesMap[i] != i );
                 }
                 return hasDuplicates;
             }
 
-            void removeDuplicates(TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap)
+            void removeDuplicates( TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap )
+            {
+                removeDuplicates( mesh, vertexMap, DuplicatesOptions() );
+            }
+
+            void removeDuplicates( TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap,
+                                   const DuplicatesOptions& options )
             {
                 std::vector<VertexIdx> duplicatesMap;
-                findDuplicates(mesh, duplicatesMap);
+                findDuplicates( mesh, duplicatesMap, options );
 
+                const bool hasNormals = ( mesh.m_normals.size() == mesh.m_vertices.size() );
                 std::vector<VertexIdx> newIndices(mesh.m_vertices.size(), VertexIdx(-1));
                 Vector3Array uniqueVertices;
+                Vector3Array uniqueNormals;
                 for (uint i = 0; i < mesh.m_vertices.size(); i++)
                 {
                     if (duplicatesMap[i] == i)
                     {
                         newIndices[i] = uniqueVertices.size();
                         uniqueVertices.push_back(mesh.m_vertices[i]);
-
+                        if ( hasNormals )
+                        {
+                            uniqueNormals.push_back( mesh.m_normals[i] );
+                        }
                     }
                 }
 
@@ -94,6 +273,10 @@ namespace Ra
                     vertexMap[i] = newIndices[duplicatesMap[i]];
 
                 mesh.m_vertices = uniqueVertices;
+                if ( hasNormals )
+                {
+                    mesh.m_normals = uniqueNormals;
+                }
             }
 
             RayCastResult castRay(const TriangleMesh &mesh, const Ray &ray)
@@ -125,6 +308,7 @@ namespace Ra
                         Scalar dSq = (v[i] - ray.pointAt(minT)).squaredNorm();
                         if (dSq < minDist)
                         {
+                            minDist = dSq;
                             result.m_nearestVertex = mesh.m_triangles[result.m_hitTriangle][i];
                         }
                     }
@@ -35,11 +35,35 @@ namespace Ra
             /// Automatically compute normals for each vertex by averaging connected triangle normals.
             RA_CORE_API void getAutoNormals( TriangleMesh& mesh, VectorArray<Vector3>& normalsOut );
 
+            /// Tolerances of the vertex welding functions.
+            struct DuplicatesOptions
+            {
+                /// Vertices closer than this distance are duplicates. With 0, positions must be equal.
+                Scalar m_epsilon = 0;
+                /// If true, the normals of the mesh must also be closer than m_attribEpsilon.
+                bool m_compareNormals = false;
+                /// Optional per-vertex texture coordinates, which must also be closer than m_attribEpsilon.
+                const Vector3Array* m_texCoords = nullptr;
+                Scalar m_attribEpsilon = 0;
+            };
+
             /// Finds the duplicate vertices in a mesh, returning an array indicating for each vertex where to find the
-            /// first occurrence.
+            /// first occurrence. Returns true if there are duplicates.
             RA_CORE_API bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap );
 
-            RA_CORE_API void removeDuplicates(TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap);
+            /// Same as above, with tolerances. Each vertex is matched with the first vertex in the given tolerances,
+            /// and the matches are then followed, so that each entry of duplicatesMap maps to itself.
+            /// Vertices are hashed in a grid of cells of twice the tolerance, and matched in parallel,
+            /// which takes linear time.
+            RA_CORE_API bool findDuplicates( const TriangleMesh& mesh, std::vector<VertexIdx>& duplicatesMap,
+                                             const DuplicatesOptions& options );
+
+            /// Removes the duplicate vertices (and their normals) of a mesh. vertexMap gives the new index of each
+            /// former vertex.
+            RA_CORE_API void removeDuplicates( TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap );
+
+            RA_CORE_API void removeDuplicates( TriangleMesh& mesh, std::vector<VertexIdx>& vertexMap,
+                                               const DuplicatesOptions& options );
 
             struct RayCastResult { int m_hitTriangle; int m_nearestVertex; Scalar m_t; };
 
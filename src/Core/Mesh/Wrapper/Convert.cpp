@@ -35,7 +35,7 @@ bool Twin::operator< ( const Twin& twin ) const {
 
 
 
-void convert( const TriangleMesh& mesh, Dcel& dcel ) {
+bool convert( const TriangleMesh& mesh, Dcel& dcel ) {
     dcel.clear();
     // Create vertices
     for( unsigned int i = 0; i < mesh.m_vertices.size(); ++i ) {
@@ -43,8 +43,10 @@ void convert( const TriangleMesh& mesh, Dcel& dcel ) {
         Vector3 n = mesh.m_normals.at( i );
         Vertex_ptr v = std::shared_ptr< Vertex >( new Vertex( p, n ) );
         CORE_ASSERT( ( v != nullptr ), "Vertex_ptr == nullptr" );
-        ON_DEBUG( bool result = ) dcel.m_vertex.insert( v, v->idx );
-        CORE_ASSERT(result , "Vertex not inserted" );
+        if( !dcel.m_vertex.insert( v, v->idx ) ) {
+            dcel.clear();
+            return false;
+        }
     }
     /// TWIN DATA
     std::map< Twin, Index > he_table;
@@ -59,7 +61,10 @@ void convert( const TriangleMesh& mesh, Dcel& dcel ) {
         // Create the face
         Face_ptr f = Ra::Core::make_shared< Face >( he[0] );
         CORE_ASSERT( ( f != nullptr ), "Face_ptr == nullptr" );
-        CORE_ASSERT( dcel.m_face.insert( f, f->idx ), "Face not inserted" );
+        if( !dcel.m_face.insert( f, f->idx ) ) {
+            dcel.clear();
+            return false;
+        }
         // Create the connections
         for( uint i = 0; i < 3; ++i ) {
 
@@ -71,8 +76,10 @@ void convert( const TriangleMesh& mesh, Dcel& dcel ) {
             he[i]->setNext( he[( i + 1 ) % 3] );
             he[i]->setPrev( he[( i + 2 ) % 3] );
             he[i]->setF( f );
-            ON_DEBUG( bool result = ) dcel.m_halfedge.insert( he[i], he[i]->idx );
-            CORE_ASSERT( result, "HalfEdge not inserted" );
+            if( !dcel.m_halfedge.insert( he[i], he[i]->idx ) ) {
+                dcel.clear();
+                return false;
+            }
             /// TWIN SEARCH
             Twin twin( t[i], t[( i + 1 ) % 3]);
             // Search the right twin
@@ -90,14 +97,17 @@ void convert( const TriangleMesh& mesh, Dcel& dcel ) {
                 // Create the fulledge
                 FullEdge_ptr fe = std::shared_ptr< FullEdge >( new FullEdge( he[i] ) );
                 CORE_ASSERT( ( fe != nullptr ), "FullEdge_ptr == nullptr" );
-                ON_DEBUG( bool result =) dcel.m_fulledge.insert( fe, fe->idx );
-                CORE_ASSERT(result,  "FullEdge not inserted" );
+                if( !dcel.m_fulledge.insert( fe, fe->idx ) ) {
+                    dcel.clear();
+                    return false;
+                }
                 he[i]->setFE( fe );
                 he[i]->Twin()->setFE( fe );
                 he_table.erase( it );
             }
         }
     }
+    return true;
 }
 
 
@@ -21,7 +21,8 @@ struct Twin {
     uint m_id[2];
 };
 
-RA_CORE_API void convert( const TriangleMesh& mesh, Dcel& dcel );
+// Return false, with an empty dcel, if the mesh has more elements than the Dcel can index.
+RA_CORE_API bool convert( const TriangleMesh& mesh, Dcel& dcel );
 RA_CORE_API void convert( const Dcel& dcel, TriangleMesh& mesh );
 
 
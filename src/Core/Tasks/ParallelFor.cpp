@@ -0,0 +1,39 @@
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <atomic>
+
+#include <Core/Tasks/TaskQueue.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            std::atomic<TaskQueue*> g_parallelForQueue( nullptr );
+        }
+
+        void setParallelForQueue( TaskQueue* queue )
+        {
+            g_parallelForQueue = queue;
+        }
+
+        TaskQueue* getParallelForQueue()
+        {
+            return g_parallelForQueue;
+        }
+
+        void parallelFor( uint begin, uint end, uint grain, const std::function<void( uint, uint )>& f )
+        {
+            TaskQueue* queue = g_parallelForQueue;
+            if ( queue != nullptr )
+            {
+                queue->parallelFor( begin, end, grain, f );
+            }
+            else if ( begin < end )
+            {
+                f( begin, end );
+            }
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef RADIUMENGINE_PARALLEL_FOR_HPP_
+#define RADIUMENGINE_PARALLEL_FOR_HPP_
+
+#include <Core/RaCore.hpp>
+#include <functional>
+
+namespace Ra
+{
+    namespace Core
+    {
+        class TaskQueue;
+    }
+}
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Sets the task queue whose threads run the parallelFor() loops (nullptr to unset).
+        /// The application owning the task queue should set it at startup and unset it before
+        /// destroying the queue.
+        RA_CORE_API void setParallelForQueue( TaskQueue* queue );
+
+        /// Returns the task queue running the parallelFor() loops, or nullptr if none is set.
+        RA_CORE_API TaskQueue* getParallelForQueue();
+
+        /// Calls f( chunkBegin, chunkEnd ) on sub-ranges of [begin, end) covering the whole range.
+        /// The chunks are processed in parallel by the parallelFor queue (see TaskQueue::parallelFor()),
+        /// or by the calling thread in one call if no queue is set.
+        /// Use a grain of 0 to let the task queue choose the chunks size.
+        RA_CORE_API void parallelFor( uint begin, uint end, uint grain,
+                                      const std::function<void( uint, uint )>& f );
+    }
+}
+
+#endif // RADIUMENGINE_PARALLEL_FOR_HPP_
@@ -10,10 +10,26 @@ namespace Ra
     namespace Core
     {
 
-        TaskQueue::TaskQueue( uint numThreads )
-            : m_processingTasks( 0 ), m_shuttingDown( false )
+        TaskQueue::TaskQueue( uint numThreads, Scheduling scheduling )
+            : m_processingTasks( 0 )
+            , m_queuedTasks( 0 )
+            , m_unfinishedTasks( 0 )
+            , m_numParallelJobs( 0 )
+            , m_numSpawnedTasks( 0 )
+            , m_scheduling( scheduling )
+            , m_graphChanged( false )
+            , m_shuttingDown( false )
         {
             CORE_ASSERT( numThreads > 0, " You need at least one thread" );
+            if ( m_scheduling == Scheduling::WorkStealing )
+            {
+                // One queue per worker, plus one for the thread calling waitForTasks().
+                m_workerQueues.reserve( numThreads + 1 );
+                for ( uint i = 0 ; i < numThreads + 1; ++i )
+                {
+                    m_workerQueues.emplace_back( new WorkerQueue );
+                }
+            }
             m_workerThreads.reserve( numThreads );
             for ( uint i = 0 ; i < numThreads; ++i )
             {
@@ -24,7 +40,11 @@ namespace Ra
         TaskQueue::~TaskQueue()
         {
             flushTaskQueue();
-            m_shuttingDown = true;
+            CORE_ASSERT( m_spawnedTasks.empty(), "You have spawned tasks still queued" );
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                m_shuttingDown = true;
+            }
             m_threadNotifier.notify_all();
             for ( auto& t :  m_workerThreads )
             {
@@ -36,13 +56,14 @@ namespace Ra
         {
             m_tasks.emplace_back( std::unique_ptr<Task> ( task ) );
             m_dependencies.push_back( std::vector<TaskId>() );
-            m_remainingDependencies.push_back( 0 );
+            m_predecessorCounts.push_back( 0 );
             TimerData tdata;
             tdata.taskName = task->getName();
             m_timerData.push_back( tdata );
+            m_graphChanged = true;
 
             CORE_ASSERT( m_tasks.size() == m_dependencies.size(), "Inconsistent task list" );
-            CORE_ASSERT( m_tasks.size() == m_remainingDependencies.size(), "Inconsistent task list" );
+            CORE_ASSERT( m_tasks.size() == m_predecessorCounts.size(), "Inconsistent task list" );
             CORE_ASSERT( m_tasks.size() == m_timerData.size(), "Inconsistent task list" );
             return TaskId( m_tasks.size() - 1 );
         }
@@ -56,7 +77,8 @@ namespace Ra
             CORE_ASSERT( std::find( m_dependencies[predecessor].begin(), m_dependencies[predecessor].end(), successor ) == m_dependencies[predecessor].end(), "Cannot add a dependency twice" );
 
             m_dependencies[predecessor].push_back( successor );
-            ++m_remainingDependencies[successor];
+            ++m_predecessorCounts[successor];
+            m_graphChanged = true;
         }
 
         bool TaskQueue::addDependency(const std::string &predecessors, TaskQueue::TaskId successor)
@@ -90,11 +112,13 @@ namespace Ra
         void TaskQueue::addPendingDependency(const std::string &predecessors, TaskQueue::TaskId successor)
         {
             m_pendingDepsSucc.push_back(std::make_pair(predecessors, successor));
+            m_graphChanged = true;
         }
 
         void TaskQueue::addPendingDependency( TaskId predecessor, const std::string& successors)
         {
             m_pendingDepsPre.push_back(std::make_pair(predecessor, successors));
+            m_graphChanged = true;
         }
 
         void TaskQueue::resolveDependencies()
@@ -117,7 +141,7 @@ namespace Ra
 
         void TaskQueue::queueTask( TaskQueue::TaskId task )
         {
-            CORE_ASSERT( m_remainingDependencies[task] == 0, " Task has unsatisfied dependencies" );
+            CORE_ASSERT( m_pendingDependencies[task] == 0, " Task has unsatisfied dependencies" );
             m_taskQueue.push_front( task );
         }
 
@@ -157,7 +181,7 @@ namespace Ra
 #endif
         }
 
-        void TaskQueue::startTasks()
+        void TaskQueue::compileTaskGraph()
         {
             // Add pending dependencies.
             resolveDependencies();
@@ -165,10 +189,53 @@ namespace Ra
             // Do a debug check
             detectCycles();
 
+            const uint numTasks = m_tasks.size();
+            m_pendingDependencies.reset( new std::atomic<uint>[numTasks] );
+
+            m_initialTasks.clear();
+            for ( uint t = 0; t < numTasks; ++t )
+            {
+                if ( m_predecessorCounts[t] == 0 )
+                {
+                    m_initialTasks.push_back( t );
+                }
+            }
+            m_graphChanged = false;
+        }
+
+        void TaskQueue::startTasks()
+        {
+            // The dependencies are only resolved when the graph changed since the last run.
+            if ( m_graphChanged )
+            {
+                compileTaskGraph();
+            }
+
+            // Reset the dependency counters.
+            const uint numTasks = m_tasks.size();
+            for ( uint t = 0; t < numTasks; ++t )
+            {
+                m_pendingDependencies[t] = m_predecessorCounts[t];
+            }
+
+            if ( m_scheduling == Scheduling::WorkStealing )
+            {
+                m_unfinishedTasks = numTasks;
+
+                // Spread the tasks with no dependencies over all the worker queues.
+                const uint numQueues = m_workerQueues.size();
+                for ( uint i = 0; i < m_initialTasks.size(); ++i )
+                {
+                    pushLocalTask( i % numQueues, m_initialTasks[i] );
+                }
+                notifyNewTasks( m_initialTasks.size() );
+                return;
+            }
+
             // Enqueue all tasks with no dependencies.
-            for ( uint t = 0; t < m_tasks.size(); ++t )
             {
-                if ( m_remainingDependencies[t] == 0 )
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                for ( auto t : m_initialTasks )
                 {
                     queueTask( t );
                 }
@@ -180,16 +247,65 @@ namespace Ra
 
         void TaskQueue::waitForTasks()
         {
-            bool isFinished = false;
-            while ( !isFinished )
+            // The calling thread takes part in the work until all tasks are finished,
+            // and sleeps when there is nothing left for it to do.
+            if ( m_scheduling == Scheduling::WorkStealing )
             {
-                // TODO : use a notifier for task queue empty.
-                m_taskQueueMutex.lock();
-                isFinished = ( m_taskQueue.empty() && m_processingTasks == 0 );
-                m_taskQueueMutex.unlock();
-                if ( !isFinished )
+                const uint id = m_workerThreads.size();
+                while ( true )
+                {
+                    if ( runParallelWork() )
+                    {
+                        continue;
+                    }
+
+                    TaskId task = popOrStealTask( id );
+                    if ( task != InvalidTaskId )
+                    {
+                        runWorkStealingTask( id, task );
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                    m_threadNotifier.wait( lock, [this]()
+                    {
+                        return m_unfinishedTasks == 0 || m_queuedTasks > 0 || hasParallelWork();
+                    } );
+                    if ( m_unfinishedTasks == 0 )
+                    {
+                        return;
+                    }
+                }
+            }
+
+            while ( true )
+            {
+                if ( runParallelWork() )
+                {
+                    continue;
+                }
+
+                TaskId task = InvalidTaskId;
+                {
+                    std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                    m_threadNotifier.wait( lock, [this]()
+                    {
+                        return !m_taskQueue.empty() || m_processingTasks == 0 || hasParallelWork();
+                    } );
+                    if ( !m_taskQueue.empty() )
+                    {
+                        task = popSharedQueueTask();
+                    }
+                    else if ( m_processingTasks == 0 )
+                    {
+                        // No task left in the queue and none in process : we are done.
+                        return;
+                    }
+                }
+                if ( task != InvalidTaskId )
                 {
-                    std::this_thread::yield();
+                    processTask( task );
+                    finishSharedQueueTask( task );
                 }
             }
         }
@@ -203,16 +319,106 @@ namespace Ra
         {
             CORE_ASSERT( m_processingTasks == 0, "You have tasks still in process" );
             CORE_ASSERT( m_taskQueue.empty(), " You have unprocessed tasks " );
+            CORE_ASSERT( m_unfinishedTasks == 0, " You have unprocessed tasks " );
+            m_pendingDependencies.reset();
+            m_initialTasks.clear();
             m_tasks.clear();
             m_dependencies.clear();
             m_timerData.clear();
-            m_remainingDependencies.clear();
+            m_predecessorCounts.clear();
+            m_pendingDepsPre.clear();
+            m_pendingDepsSucc.clear();
+            m_graphChanged = false;
+        }
+
+        uint TaskQueue::getNumTasks() const
+        {
+            return m_tasks.size();
+        }
+
+        uint TaskQueue::getNumThreads() const
+        {
+            return m_workerThreads.size();
+        }
+
+        TaskQueue::Scheduling TaskQueue::getScheduling() const
+        {
+            return m_scheduling;
+        }
+
+        void TaskQueue::processTask( TaskQueue::TaskId task )
+        {
+            m_timerData[task].start = Timer::Clock::now();
+            m_tasks[task]->process();
+            m_timerData[task].end = Timer::Clock::now();
         }
 
         void TaskQueue::runThread( uint id )
+        {
+            if ( m_scheduling == Scheduling::WorkStealing )
+            {
+                runWorkStealingThread( id );
+            }
+            else
+            {
+                runSharedQueueThread( id );
+            }
+        }
+
+        TaskQueue::TaskId TaskQueue::popSharedQueueTask()
+        {
+            TaskId task = m_taskQueue.back();
+            m_taskQueue.pop_back();
+            ++m_processingTasks;
+            CORE_ASSERT( task != InvalidTaskId && task < m_tasks.size(), "Invalid task" );
+            return task;
+        }
+
+        void TaskQueue::finishSharedQueueTask( TaskQueue::TaskId task )
+        {
+            // Critical section : mark task as finished and en-queue dependencies.
+            uint newTasks = 0;
+            bool isFinished = false;
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                for ( auto t : m_dependencies[task] )
+                {
+                    CORE_ASSERT( m_pendingDependencies[t] > 0, "Inconsistency in dependencies" );
+                    if ( --m_pendingDependencies[t] == 0 )
+                    {
+                        queueTask( t );
+                        ++newTasks;
+                    }
+                }
+                --m_processingTasks;
+                isFinished = ( m_taskQueue.empty() && m_processingTasks == 0 );
+            }
+
+            if ( isFinished )
+            {
+                // Wake up the thread waiting for the tasks completion.
+                m_threadNotifier.notify_all();
+            }
+            else
+            {
+                // If we added new tasks, we wake up threads to execute them.
+                for ( uint i = 0; i < newTasks; ++i )
+                {
+                    m_threadNotifier.notify_one();
+                }
+            }
+        }
+
+        void TaskQueue::runSharedQueueThread( uint id )
         {
             while ( true )
             {
+                // Parallel loop chunks and spawned tasks come first, as they are blocking a running task.
+                if ( runParallelWork() )
+                {
+                    continue;
+                }
+
                 TaskId task = InvalidTaskId;
 
                 // Acquire mutex.
@@ -220,11 +426,10 @@ namespace Ra
                     std::unique_lock<std::mutex> lock( m_taskQueueMutex );
 
                     // Wait for a new task
-                    // TODO : use the second form of wait()
-                    while ( !m_shuttingDown && m_taskQueue.empty() )
+                    m_threadNotifier.wait( lock, [this]()
                     {
-                        m_threadNotifier.wait( lock );
-                    }
+                        return m_shuttingDown || !m_taskQueue.empty() || hasParallelWork();
+                    } );
                     // If the task queue is shutting down we quit, releasing
                     // the lock.
                     if ( m_shuttingDown )
@@ -232,43 +437,348 @@ namespace Ra
                         return;
                     }
 
+                    // Go back to the parallel loops first.
+                    if ( m_taskQueue.empty() )
+                    {
+                        continue;
+                    }
+
                     // If we are here it means we got a task
-                    task = m_taskQueue.back();
-                    m_taskQueue.pop_back();
-                    ++m_processingTasks;
-                    CORE_ASSERT( task != InvalidTaskId && task < m_tasks.size(), "Invalid task" );
+                    task = popSharedQueueTask();
                 }
                 // Release mutex.
 
                 // Run task
-                m_timerData[task].start = Timer::Clock::now();
-                m_tasks[task]->process();
-                m_timerData[task].end = Timer::Clock::now();
+                processTask( task );
+                finishSharedQueueTask( task );
+            } // End of while(true)
+        }
+
+        void TaskQueue::pushLocalTask( uint id, TaskQueue::TaskId task )
+        {
+            // The counter is incremented first so that it never underestimates the number
+            // of tasks available in the queues.
+            ++m_queuedTasks;
+            WorkerQueue& queue = *m_workerQueues[id];
+            std::unique_lock<std::mutex> lock( queue.m_mutex );
+            queue.m_tasks.push_back( task );
+        }
+
+        TaskQueue::TaskId TaskQueue::popOrStealTask( uint id )
+        {
+            TaskId task = InvalidTaskId;
+
+            // Take the most recent task of our own queue.
+            {
+                WorkerQueue& queue = *m_workerQueues[id];
+                std::unique_lock<std::mutex> lock( queue.m_mutex );
+                if ( !queue.m_tasks.empty() )
+                {
+                    task = queue.m_tasks.back();
+                    queue.m_tasks.pop_back();
+                }
+            }
 
-                // Critical section : mark task as finished and en-queue dependencies.
-                uint newTasks = 0;
+            // Otherwise steal the oldest task of another thread.
+            const uint numQueues = m_workerQueues.size();
+            for ( uint i = 1; i < numQueues && task == InvalidTaskId; ++i )
+            {
+                WorkerQueue& victim = *m_workerQueues[( id + i ) % numQueues];
+                std::unique_lock<std::mutex> lock( victim.m_mutex );
+                if ( !victim.m_tasks.empty() )
                 {
+                    task = victim.m_tasks.front();
+                    victim.m_tasks.pop_front();
+                }
+            }
+
+            if ( task != InvalidTaskId )
+            {
+                --m_queuedTasks;
+            }
+            return task;
+        }
+
+        void TaskQueue::notifyNewTasks( uint numTasks )
+        {
+            if ( numTasks == 0 )
+            {
+                return;
+            }
+            // Taking the lock guarantees that a thread which saw no queued task
+            // is already waiting on the notifier, so the wake up cannot be lost.
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            }
+            if ( numTasks == 1 )
+            {
+                m_threadNotifier.notify_one();
+            }
+            else
+            {
+                m_threadNotifier.notify_all();
+            }
+        }
+
+        void TaskQueue::runWorkStealingThread( uint id )
+        {
+            while ( true )
+            {
+                // Parallel loop chunks and spawned tasks come first, as they are blocking a running task.
+                if ( runParallelWork() )
+                {
+                    continue;
+                }
+
+                TaskId task = popOrStealTask( id );
+
+                if ( task == InvalidTaskId )
+                {
+                    // Nothing to do : sleep until new tasks are queued.
                     std::unique_lock<std::mutex> lock( m_taskQueueMutex );
-                    for ( auto t : m_dependencies[task] )
+                    m_threadNotifier.wait( lock, [this]()
+                    {
+                        return m_shuttingDown || m_queuedTasks > 0 || hasParallelWork();
+                    } );
+                    if ( m_shuttingDown )
                     {
-                        uint& nDepends = m_remainingDependencies[t];
-                        CORE_ASSERT( nDepends > 0, "Inconsistency in dependencies" );
-                        --nDepends;
-                        if ( nDepends == 0 )
-                        {
-                            queueTask( t );
-                            ++newTasks;
-                        }
-                        // TODO :Easy optimization : grab one of the new task and process it immediately.
+                        return;
                     }
-                    --m_processingTasks;
+                    continue;
                 }
-                // If we added new tasks, we wake up one thread to execute it.
-                if ( newTasks > 0 )
+
+                runWorkStealingTask( id, task );
+            } // End of while(true)
+        }
+
+        void TaskQueue::runWorkStealingTask( uint id, TaskQueue::TaskId task )
+        {
+            CORE_ASSERT( task < m_tasks.size(), "Invalid task" );
+            processTask( task );
+
+            // Successors made ready by this task go to our own queue, so that the
+            // last one pushed is the next task run by this thread.
+            uint newTasks = 0;
+            for ( auto t : m_dependencies[task] )
+            {
+                CORE_ASSERT( m_pendingDependencies[t] > 0, "Inconsistency in dependencies" );
+                if ( --m_pendingDependencies[t] == 0 )
                 {
-                    m_threadNotifier.notify_one();
+                    pushLocalTask( id, t );
+                    ++newTasks;
                 }
-            } // End of while(true)
+            }
+
+            // This thread will pick one of the new tasks, other threads may take the rest.
+            if ( newTasks > 1 )
+            {
+                notifyNewTasks( newTasks - 1 );
+            }
+
+            if ( --m_unfinishedTasks == 0 )
+            {
+                // Wake up the thread waiting for the tasks completion.
+                {
+                    std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                }
+                m_threadNotifier.notify_all();
+            }
+        }
+
+        void TaskQueue::parallelFor( uint begin, uint end, uint grain, const std::function<void( uint, uint )>& f )
+        {
+            if ( end <= begin )
+            {
+                return;
+            }
+
+            const uint size = end - begin;
+            if ( grain == 0 )
+            {
+                // A few chunks per thread (including the calling one) to balance the load.
+                const uint numChunks = 4 * ( m_workerThreads.size() + 1 );
+                grain = ( size + numChunks - 1 ) / numChunks;
+            }
+
+            ParallelJob job;
+            job.m_func = &f;
+            job.m_begin = begin;
+            job.m_end = end;
+            job.m_grain = grain;
+            job.m_numChunks = ( size + grain - 1 ) / grain;
+            job.m_nextChunk = 0;
+            job.m_doneChunks = 0;
+
+            // Not worth sharing.
+            if ( job.m_numChunks == 1 )
+            {
+                f( begin, end );
+                return;
+            }
+
+            // Publish the job and wake up the sleeping threads.
+            {
+                std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                m_parallelJobs.push_back( &job );
+                ++m_numParallelJobs;
+            }
+            m_parallelJobsNotifier.notify_all();
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            }
+            m_threadNotifier.notify_all();
+
+            // Process our own chunks.
+            while ( runParallelChunk( &job ) )
+            {
+            }
+
+            // Wait for the chunks processed by other threads, helping with other
+            // parallel loops (e.g. nested ones) in the meantime, and sleeping when
+            // there are none.
+            while ( job.m_doneChunks < job.m_numChunks )
+            {
+                if ( runParallelWork() )
+                {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                m_parallelJobsNotifier.wait( lock, [this, &job]()
+                {
+                    return job.m_doneChunks == job.m_numChunks || hasParallelWork();
+                } );
+            }
+        }
+
+        bool TaskQueue::runParallelChunk( TaskQueue::ParallelJob* job )
+        {
+            if ( job == nullptr && m_numParallelJobs == 0 )
+            {
+                return false;
+            }
+
+            uint chunk = 0;
+            {
+                std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                if ( job == nullptr )
+                {
+                    if ( m_parallelJobs.empty() )
+                    {
+                        return false;
+                    }
+                    // Most recent jobs first : they are likely nested in older ones.
+                    job = m_parallelJobs.back();
+                }
+                else if ( job->m_nextChunk == job->m_numChunks )
+                {
+                    return false;
+                }
+
+                // Claim a chunk. The job is unlisted as soon as its last chunk is claimed,
+                // as it is then only waiting for its chunks to be processed.
+                chunk = job->m_nextChunk++;
+                if ( job->m_nextChunk == job->m_numChunks )
+                {
+                    m_parallelJobs.erase( std::find( m_parallelJobs.begin(), m_parallelJobs.end(), job ) );
+                    --m_numParallelJobs;
+                }
+            }
+
+            const uint chunkBegin = job->m_begin + chunk * job->m_grain;
+            const uint chunkEnd = std::min( chunkBegin + job->m_grain, job->m_end );
+            ( *job->m_func )( chunkBegin, chunkEnd );
+
+            // The job may be destroyed by its owner as soon as this is done, so it
+            // is not accessed after.
+            const uint numChunks = job->m_numChunks;
+            if ( ++job->m_doneChunks == numChunks )
+            {
+                // Taking the lock guarantees that the owner is either sleeping or
+                // about to see the job done.
+                {
+                    std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                }
+                m_parallelJobsNotifier.notify_all();
+            }
+            return true;
+        }
+
+        void TaskQueue::spawnTask( Task* task, TaskGroup& group )
+        {
+            CORE_ASSERT( task != nullptr, "Invalid task" );
+            ++group.m_pendingTasks;
+            {
+                std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                m_spawnedTasks.push_back( SpawnedTask{ std::unique_ptr<Task>( task ), &group } );
+                ++m_numSpawnedTasks;
+            }
+            m_parallelJobsNotifier.notify_one();
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            }
+            m_threadNotifier.notify_one();
+        }
+
+        void TaskQueue::waitForGroup( TaskGroup& group )
+        {
+            // Help with the spawned tasks (ours or not) and the parallel loops, and
+            // sleep when there are none.
+            while ( group.m_pendingTasks > 0 )
+            {
+                if ( runParallelWork() )
+                {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                m_parallelJobsNotifier.wait( lock, [this, &group]()
+                {
+                    return group.m_pendingTasks == 0 || hasParallelWork();
+                } );
+            }
+        }
+
+        bool TaskQueue::runSpawnedTask()
+        {
+            if ( m_numSpawnedTasks == 0 )
+            {
+                return false;
+            }
+
+            SpawnedTask spawned;
+            {
+                std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                if ( m_spawnedTasks.empty() )
+                {
+                    return false;
+                }
+                // Most recent tasks first : they are likely spawned by the tasks being waited for.
+                spawned = std::move( m_spawnedTasks.back() );
+                m_spawnedTasks.pop_back();
+                --m_numSpawnedTasks;
+            }
+
+            spawned.m_task->process();
+            spawned.m_task.reset();
+
+            // The group may be destroyed by its owner as soon as this is done.
+            if ( --spawned.m_group->m_pendingTasks == 0 )
+            {
+                {
+                    std::unique_lock<std::mutex> lock( m_parallelJobsMutex );
+                }
+                m_parallelJobsNotifier.notify_all();
+            }
+            return true;
+        }
+
+        bool TaskQueue::runParallelWork()
+        {
+            return runParallelChunk( nullptr ) || runSpawnedTask();
+        }
+
+        bool TaskQueue::hasParallelWork() const
+        {
+            return m_numParallelJobs > 0 || m_numSpawnedTasks > 0;
         }
     }
 }
@@ -6,10 +6,12 @@
 #include <memory>
 #include <vector>
 #include <deque>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <string>
 #include <condition_variable>
+#include <functional>
 
 #include <Core/Time/Timer.hpp>
 
@@ -31,6 +33,12 @@ namespace Ra
         /// Task are allowed to have dependencies. A task will be executed only when all its dependencies
         /// are satisfied, i.e. all dependant tasks are finished.
         /// Note that most functions are not thread safe and must not be called when the task queue is running.
+        /// Tasks are kept after they have run : calling startTasks() again replays the same task graph
+        /// without resolving the dependencies again, until new tasks or dependencies are added or
+        /// flushTaskQueue() is called.
+        /// Two scheduling strategies are available (see Scheduling). They only differ in the way
+        /// ready tasks are dispatched to the threads : the task registration and dependency API is the same.
+        /// A running task can split its work with parallelFor(), or with spawnTask() and waitForGroup().
         class RA_CORE_API TaskQueue
         {
         public:
@@ -38,6 +46,32 @@ namespace Ra
             typedef uint TaskId;
             enum { InvalidTaskId = TaskId( -1 ) };
 
+            /// Strategy used to dispatch the ready tasks to the worker threads.
+            enum class Scheduling
+            {
+                /// All threads pop tasks from a single queue protected by a global mutex.
+                SharedQueue,
+                /// Each thread owns a queue : it pops its own tasks in LIFO order and steals
+                /// the oldest tasks of the other threads when it runs out of work.
+                /// Tasks made ready by a finishing task are pushed on the local queue, so that
+                /// they are likely to run next on the same thread.
+                WorkStealing
+            };
+
+            /// Counts the tasks spawned in a group which are not finished yet (see spawnTask()).
+            class TaskGroup
+            {
+            public:
+                TaskGroup() : m_pendingTasks( 0 ) {}
+                ~TaskGroup() { CORE_ASSERT( m_pendingTasks == 0, "Task group destroyed before its tasks are done" ); }
+                TaskGroup( const TaskGroup& other ) = delete;
+                TaskGroup& operator=( const TaskGroup& other ) = delete;
+
+            private:
+                friend class TaskQueue;
+                std::atomic<uint> m_pendingTasks;
+            };
+
             /// Record of a task's start and end time.
             struct TimerData
             {
@@ -49,7 +83,7 @@ namespace Ra
         public:
 
             /// Constructor. Initializes the thread pools with numThreads threads.
-            TaskQueue( uint numThreads );
+            explicit TaskQueue( uint numThreads, Scheduling scheduling = Scheduling::SharedQueue );
 
             /// Destructor. Waits for all the threads and safely deletes them.
             ~TaskQueue();
@@ -83,9 +117,13 @@ namespace Ra
 
             /// Launches the execution of all the threads in the task queue.
             /// No more tasks should be added at this point.
+            /// If the task graph did not change since the last call, only the dependency
+            /// counters are reset : no allocation nor name resolution is done.
             void startTasks();
 
             /// Blocks until all tasks and dependencies are finished.
+            /// The calling thread runs tasks too while waiting, and sleeps (instead of
+            /// spinning) when no task is available.
             void waitForTasks();
 
             /// Access the data from the last frame execution after processTaskQueue();
@@ -94,11 +132,122 @@ namespace Ra
             /// Erases all tasks. Will assert if tasks are unprocessed.
             void flushTaskQueue();
 
+            /// Returns the number of registered tasks.
+            uint getNumTasks() const;
+
+            /// Returns the number of worker threads.
+            uint getNumThreads() const;
+
+            //
+            // Data-parallel loops
+            //
+
+            /// Calls f( chunkBegin, chunkEnd ) on sub-ranges of [begin, end) of grain indices (the last
+            /// one may be smaller), in parallel on the worker threads, and returns when all are done.
+            /// If grain is 0 it is chosen to give a few chunks per thread.
+            /// This function is thread safe : it can be called from a running task (or from a chunk of
+            /// another parallel loop). The calling thread processes chunks too and never blocks on
+            /// chunks that are not being processed, so nested calls do not deadlock. Once all the
+            /// chunks are claimed, it helps with other loops, and sleeps when there are none.
+            void parallelFor( uint begin, uint end, uint grain, const std::function<void( uint, uint )>& f );
+
+            //
+            // Nested tasks
+            //
+
+            /// Queues a task in group, to be run once as soon as a thread is available.
+            /// Unlike registerTask(), this function is thread safe and the task is not part of the task
+            /// graph (no dependencies nor timings) : it is meant to be called from a running task to
+            /// split its work. The task queue assumes ownership of the task.
+            void spawnTask( Task* task, TaskGroup& group );
+
+            /// Returns when all the tasks spawned in group are done. The calling thread runs spawned
+            /// tasks and parallel loop chunks while waiting, and sleeps when there are none, so a
+            /// running task can wait for the tasks it spawned without deadlock.
+            void waitForGroup( TaskGroup& group );
+
+            /// Returns the scheduling strategy chosen at construction.
+            Scheduling getScheduling() const;
+
+        private:
+            /// A data-parallel loop shared with the other threads.
+            struct ParallelJob
+            {
+                const std::function<void( uint, uint )>* m_func;
+                uint m_begin;
+                uint m_end;
+                uint m_grain;
+                uint m_numChunks;
+                /// Next chunk to process. Protected by m_parallelJobsMutex.
+                uint m_nextChunk;
+                /// Number of chunks processed. The job is over when it reaches m_numChunks.
+                std::atomic<uint> m_doneChunks;
+            };
+
+            /// A task queued by spawnTask().
+            struct SpawnedTask
+            {
+                std::unique_ptr<Task> m_task;
+                TaskGroup* m_group;
+            };
+
+            /// Queue owned by one thread in work-stealing mode. The owner pushes and pops
+            /// at the back, other threads steal from the front.
+            struct WorkerQueue
+            {
+                std::deque<TaskId> m_tasks;
+                std::mutex m_mutex;
+            };
+
         private:
 
             /// Function called by a new thread.
             void runThread( uint id );
 
+            /// Main loop of a thread in the shared queue mode.
+            void runSharedQueueThread( uint id );
+
+            /// Shared queue mode : pops a task from the queue. The mutex must be held.
+            TaskId popSharedQueueTask();
+
+            /// Shared queue mode : marks a task as finished, queues its ready successors
+            /// and wakes up the threads accordingly.
+            void finishSharedQueueTask( TaskId task );
+
+            /// Main loop of a thread in the work-stealing mode.
+            void runWorkStealingThread( uint id );
+
+            /// Runs a task and records its timings.
+            void processTask( TaskId task );
+
+            /// Work-stealing mode : runs a task on the given thread and pushes its ready
+            /// successors on the thread's queue.
+            void runWorkStealingTask( uint id, TaskId task );
+
+            /// Work-stealing mode : pushes a ready task on the queue of the given thread.
+            void pushLocalTask( uint id, TaskId task );
+
+            /// Work-stealing mode : pops a task from the queue of the given thread, or steals
+            /// one from another thread. Returns InvalidTaskId if no task was found.
+            TaskId popOrStealTask( uint id );
+
+            /// Work-stealing mode : wakes up sleeping threads for numTasks new tasks.
+            void notifyNewTasks( uint numTasks );
+
+            /// Processes one chunk of the given parallel job, or of the most recent parallel job
+            /// if job is nullptr. Returns false if there was no chunk left to process.
+            bool runParallelChunk( ParallelJob* job );
+
+            /// Runs the most recently spawned task. Returns false if there was none.
+            bool runSpawnedTask();
+
+            /// Processes a chunk of a parallel loop, or else a spawned task. Returns false if
+            /// there was none.
+            bool runParallelWork();
+
+            /// Returns true if there are parallel loop chunks or spawned tasks waiting for a thread.
+            bool hasParallelWork() const;
+
             /// Puts the task on the queue to be executed. A task can only be queued if it has
             /// no dependencies.
             void queueTask( TaskId task );
@@ -110,6 +259,10 @@ namespace Ra
             /// Resolves the pending named dependencies. Will assert if dependencies don't resolve.
             void resolveDependencies();
 
+            /// Resolves the dependencies and caches what is needed to start the tasks
+            /// (initial tasks, dependency counters storage).
+            void compileTaskGraph();
+
         private:
 
             /// Threads working on tasks.
@@ -123,6 +276,11 @@ namespace Ra
             std::vector<std::pair<TaskId,std::string>> m_pendingDepsPre;
             std::vector<std::pair<std::string,TaskId>> m_pendingDepsSucc;
 
+            /// Number of tasks each task depends on.
+            std::vector<uint> m_predecessorCounts;
+            /// Tasks with no dependencies, queued first when the tasks are started.
+            std::vector<TaskId> m_initialTasks;
+
             /// Stores the timings of each frame after execution.
             std::vector<TimerData> m_timerData;
 
@@ -130,16 +288,51 @@ namespace Ra
             // mutex protected variables.
             //
 
-            /// Number of tasks each task is waiting on.
-            std::vector<uint> m_remainingDependencies;
+            /// Number of tasks each task is waiting on, reset from m_predecessorCounts
+            /// when the tasks are started.
+            std::unique_ptr<std::atomic<uint>[]> m_pendingDependencies;
             /// Queue holding the pending tasks.
             std::deque<TaskId> m_taskQueue;
             /// Number of tasks currently being processed.
             uint m_processingTasks;
 
+            //
+            // work-stealing mode variables.
+            //
+
+            /// One queue per worker thread, plus one for the thread waiting for the tasks.
+            std::vector<std::unique_ptr<WorkerQueue>> m_workerQueues;
+            /// Number of tasks pushed on the worker queues and not yet popped.
+            std::atomic<uint> m_queuedTasks;
+            /// Number of tasks started but not yet finished.
+            std::atomic<uint> m_unfinishedTasks;
+
+            //
+            // parallel loops variables.
+            //
+
+            /// Parallel jobs which still have chunks to be processed.
+            std::vector<ParallelJob*> m_parallelJobs;
+            /// Size of m_parallelJobs, readable without locking.
+            std::atomic<uint> m_numParallelJobs;
+            /// Spawned tasks waiting for a thread.
+            std::vector<SpawnedTask> m_spawnedTasks;
+            /// Size of m_spawnedTasks, readable without locking.
+            std::atomic<uint> m_numSpawnedTasks;
+            /// Mutex protecting the parallel jobs list, the jobs next chunk and the spawned tasks.
+            std::mutex m_parallelJobsMutex;
+            /// Variable on which threads waiting for the chunks of their parallel job, or for a task
+            /// group, sleep. Notified when parallel work is published and when a job or a group is done.
+            std::condition_variable m_parallelJobsNotifier;
+
+            /// Scheduling strategy.
+            const Scheduling m_scheduling;
+            /// True when tasks or dependencies were added since the graph was last compiled.
+            bool m_graphChanged;
             /// Flag to signal threads to quit.
             bool m_shuttingDown;
-            /// Variable on which threads wait for new tasks.
+            /// Variable on which threads wait for new tasks, and on which the thread waiting
+            /// for the tasks is notified of their completion.
             std::condition_variable m_threadNotifier;
             /// Global mutex over thread-sensitive variables.
             std::mutex m_taskQueueMutex;
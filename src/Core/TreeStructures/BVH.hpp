@@ -1,11 +1,11 @@
- 
 #ifndef RADIUMENGINE_BVH_HPP
 #define RADIUMENGINE_BVH_HPP
 
 #include <Core/RaCore.hpp>
 
-#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Math/Frustum.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
 
 #include <vector>
 #include <memory>
@@ -16,47 +16,35 @@ namespace Ra
 {
     namespace Core
     {
-        /// This class stores a 3-dimensional hierarchy of meshes of arbitrary type.
-        /// Built on a binary tree
+        /// This class stores a 3-dimensional hierarchy of objects of arbitrary type,
+        /// which only have to provide an Aabb getAabb() const method.
+        /// The tree is built top-down with a binned surface area heuristic, and stored
+        /// as a flat array of nodes in depth-first order (children after their parent).
         template <typename T>
         class BVH
         {
-            class Node {
-            public:
-                inline Node( const std::shared_ptr<T>& t );
-
-                inline Node( const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r );
-
-                inline std::shared_ptr<Node> getLeftChild() const;
-                inline std::shared_ptr<Node> getRightChild() const;
-
-                inline Aabb getAabb() const
-                {
-                    return m_aabb;
-                }
-
-                inline std::shared_ptr<T> getData()
-                {
-                    return m_data;
-                }
-
-                inline bool isFinal() const
-                {
-                    return m_children.empty();
-                }
-
-            protected:
-                Aabb m_aabb ;
-                std::vector<std::shared_ptr<Node>> m_children ;
-
-                std::shared_ptr<T> m_data;
-            };
-
         public:
-            // public types and constants.
-            typedef std::shared_ptr<Node> NodePtr;
+            /// Node of the tree (32 bytes when Scalar is float).
+            /// The two children of an inner node are stored next to each other.
+            struct Node
+            {
+                Vector3 m_min;
+                /// Number of leaves of a leaf node, 0 for an inner node.
+                uint m_count;
+                Vector3 m_max;
+                /// Leaf node : position of its first leaf in getLeafOrder().
+                /// Inner node : index of its left child, the right one is m_index + 1.
+                uint m_index;
+
+                inline bool isLeaf() const { return m_count > 0; }
+                inline Aabb getAabb() const { return Aabb( m_min, m_max ); }
+            };
+#ifndef CORE_USE_DOUBLE
+            static_assert( sizeof( Node ) == 32, "BVH nodes should fit in 32 bytes" );
+#endif
 
-            typedef Node * Nodep;
+            /// Maximum number of leaves in a leaf node.
+            static const uint MaxLeafSize = 4;
 
         public:
             RA_CORE_ALIGNED_NEW
@@ -66,26 +54,63 @@ namespace Ra
             inline BVH( const BVH& other ) = default;
             inline BVH& operator= ( const BVH& other ) = default;
 
+            /// Adds a leaf. The tree is rebuilt by the next update().
             inline void insertLeaf(const std::shared_ptr<T>& t);
 
-            //TODO removeLeaf()
+            /// Removes a leaf, returns false if it is not in the tree. The tree is rebuilt by the next update().
+            inline bool removeLeaf(const std::shared_ptr<T>& t);
 
             inline void clear();
 
+            /// Rebuilds the tree if leaves were added or removed since the last build.
             inline void update();
 
-            inline void buildBottomUpSlow();
+            /// Builds the tree from the current bounding boxes of the leaves. Large trees
+            /// are built in parallel (see parallelFor()), the result does not depend on the threads.
+            inline void build();
+
+            /// Updates the boxes of the tree to the current bounding boxes of the leaves (e.g. after
+            /// they moved) without changing its structure. Rebuilds the tree if it is not up to date.
+            inline void refit();
+
+            /// Appends the leaves whose bounding box intersects the frustum to objects.
+            /// Each box is tested with its p-vertex and n-vertex against the planes
+            /// it is not yet known to be inside.
+            inline void getInFrustum(std::vector<std::shared_ptr<T>> & objects, const Frustum & frustum) const;
+
+            /// Number of leaves.
+            inline uint size() const { return m_leaves.size(); }
+
+            inline const std::vector<std::shared_ptr<T>>& getLeaves() const { return m_leaves; }
 
-            //TODO void buildBottomUpFast();
+            /// Bounding box of all the leaves, as of the last build or refit.
+            inline Aabb getAabb() const;
 
-            //TODO void buildTopDown();
+            inline const std::vector<Node>& getNodes() const { return m_nodes; }
 
-            void getInFrustumSlow(std::vector<std::shared_ptr<T>> & objects, const Frustum & frustum) const;
+            /// Indices of the leaves, in the order of the leaf nodes.
+            inline const std::vector<uint>& getLeafOrder() const { return m_order; }
+
+        private:
+            // Leaves of a subtree built in a separate task.
+            struct Subtree
+            {
+                uint m_node;
+                uint m_begin;
+                uint m_end;
+            };
+
+            inline void buildNode( std::vector<Node>& nodes, uint nodeIdx, uint begin, uint end,
+                                   uint depth, std::vector<Subtree>* deferred );
 
         protected:
-            std::vector<NodePtr> m_leaves;
-            NodePtr m_root;
-            Aabb m_root_aabb;
+            std::vector<std::shared_ptr<T>> m_leaves;
+
+            // Build data : leaves boxes and centers, leaves order and nodes.
+            AlignedStdVector<Aabb> m_leafAabbs;
+            std::vector<Vector3> m_centroids;
+            std::vector<uint> m_order;
+            std::vector<Node> m_nodes;
 
             bool m_upToDate;
         };
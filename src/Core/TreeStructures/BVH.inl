@@ -1,178 +1,373 @@
 #include <Core/TreeStructures/BVH.hpp>
-#include <Core/Mesh/MeshUtils.hpp>
 
-#include <iostream>
+#include <algorithm>
+#include <limits>
 
-#include <Core/Math/ColorPresets.hpp>
-#include <Engine/Renderer/RenderObject/Primitives/DrawPrimitives.hpp>
-#include <Engine/Renderer/RenderObject/RenderObject.hpp>
-#include <Engine/Renderer/Renderers/DebugRender.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 
 namespace Ra
 {
     namespace Core
     {
+        namespace BVHInternal
+        {
+            // Number of bins along the split axis.
+            static const uint NumBins = 16;
 
-        template <typename T>
-        inline BVH<T>::Node::Node(const std::shared_ptr<T>& t)
-            :m_aabb(t->getAabb()), m_data(t)
-        {}
+            // Nodes with at most this number of leaves become leaf nodes when splitting does not reduce the SAH cost.
+            static const uint MaxSAHLeafSize = 16;
 
-        template <typename T>
-        inline BVH<T>::Node::Node( const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r )
-            :m_aabb(l->m_aabb.merged(r->m_aabb))
-        {
-            m_children.push_back(l);
-            m_children.push_back(r);
-        }
+            // Nodes at this depth are built as independent tasks.
+            static const uint TaskDepth = 5;
 
-        template <typename T>
-        inline typename BVH<T>::NodePtr BVH<T>::Node::getLeftChild() const
-        {
-            if (!isFinal())
-                return m_children[0];
-            else
-                return nullptr;
-        }
+            // Trees with less leaves are built by the calling thread.
+            static const uint MinParallelLeaves = 1024;
 
-        template <typename T>
-        inline typename BVH<T>::NodePtr BVH<T>::Node::getRightChild() const
-        {
-            if (!isFinal())
-                return m_children[1];
-            else
-                return nullptr;
+            // Half surface area of a box, 0 for an empty one.
+            inline Scalar halfArea( const Aabb& aabb )
+            {
+                if ( aabb.isEmpty() )
+                {
+                    return 0;
+                }
+                const Vector3 d = aabb.sizes();
+                return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+            }
         }
 
-
         template <typename T>
         inline BVH<T>::BVH()
-            :m_root(nullptr), m_root_aabb(), m_upToDate(true)
+            : m_upToDate(true)
         {}
 
         template <typename T>
         inline void BVH<T>::insertLeaf(const std::shared_ptr<T>& t)
         {
-            m_leaves.push_back(std::shared_ptr<Node>(new Node(t)));
-            m_root_aabb.extend(t->getAabb());
+            m_leaves.push_back(t);
+            m_upToDate = false ;
+        }
 
+        template <typename T>
+        inline bool BVH<T>::removeLeaf(const std::shared_ptr<T>& t)
+        {
+            auto it = std::find(m_leaves.begin(), m_leaves.end(), t);
+            if (it == m_leaves.end())
+            {
+                return false;
+            }
+            // Order does not matter : swap with the last one.
+            std::swap(*it, m_leaves.back());
+            m_leaves.pop_back();
             m_upToDate = false ;
+            return true;
         }
 
         template <typename T>
         inline void BVH<T>::clear()
         {
-            //TODO Clear tree
-
             m_leaves.clear();
-            m_root = nullptr;
-            m_root_aabb = Aabb();
+            m_leafAabbs.clear();
+            m_centroids.clear();
+            m_order.clear();
+            m_nodes.clear();
 
-            //m_upToDate = true ;
+            m_upToDate = true ;
         }
 
         template <typename T>
         inline void BVH<T>::update()
         {
             if (!m_upToDate)
-                buildBottomUpSlow();
+                build();
         }
 
         template <typename T>
-        inline void BVH<T>::buildBottomUpSlow()
+        inline Aabb BVH<T>::getAabb() const
         {
-            /*if (m_root != nullptr)
-                clear();*/
+            return m_nodes.empty() ? Aabb() : m_nodes[0].getAabb();
+        }
 
-            // We start from known leaves, bottom up
-            std::vector<NodePtr> toMerge(m_leaves);
+        template <typename T>
+        inline void BVH<T>::build()
+        {
+            const uint size = m_leaves.size();
+            m_leafAabbs.resize(size);
+            m_centroids.resize(size);
+            m_order.resize(size);
+            m_nodes.clear();
+            m_upToDate = true ;
 
-            // As long as there are several leaves to merge
-            while (toMerge.size() > 2) {
-                Scalar low = m_root_aabb.isEmpty() ? 0 : m_root_aabb.volume();
-                typename std::vector<NodePtr>::iterator l_min, r_min;
-                Aabb merge;
+            if (size == 0)
+            {
+                return;
+            }
+
+            parallelFor(0, size, 0, [this](uint begin, uint end)
+            {
+                for (uint i = begin; i < end; ++i)
+                {
+                    m_leafAabbs[i] = m_leaves[i]->getAabb();
+                    m_centroids[i] = m_leafAabbs[i].isEmpty() ? Vector3::Zero().eval() : m_leafAabbs[i].center().eval();
+                    m_order[i] = i;
+                }
+            });
+
+            // The top of the tree is split by the calling thread. Its subtrees are then built in
+            // separate node arrays, which are appended to the tree.
+            m_nodes.reserve(2 * size);
+            m_nodes.resize(1);
+            std::vector<Subtree> deferred;
+            const bool parallel = size >= BVHInternal::MinParallelLeaves;
+            buildNode(m_nodes, 0, 0, size, 0, parallel ? &deferred : nullptr);
+
+            std::vector<std::vector<Node>> subtrees(deferred.size());
+            parallelFor(0, deferred.size(), 1, [&](uint begin, uint end)
+            {
+                for (uint i = begin; i < end; ++i)
+                {
+                    subtrees[i].reserve(2 * (deferred[i].m_end - deferred[i].m_begin));
+                    subtrees[i].resize(1);
+                    buildNode(subtrees[i], 0, deferred[i].m_begin, deferred[i].m_end, BVHInternal::TaskDepth, nullptr);
+                }
+            });
 
-                for (typename std::vector<NodePtr>::iterator it = toMerge.begin(); it != toMerge.end(); ++it)
+            for (uint i = 0; i < deferred.size(); ++i)
+            {
+                // Local node k > 0 goes to base + k - 1, the local root replaces the deferred node.
+                const uint base = m_nodes.size();
+                for (uint k = 0; k < subtrees[i].size(); ++k)
                 {
-                    for (typename std::vector<NodePtr>::iterator it2 = (it+1); it2 != toMerge.end(); ++it2)
+                    Node node = subtrees[i][k];
+                    if (!node.isLeaf())
                     {
-                        // Find the merger with smallest volume
-                        merge = it->get()->getAabb().merged(it2->get()->getAabb());
-                        if (merge.volume() < low)
-                        {
-                            low = merge.volume();
-                            l_min = it;
-                            r_min = it2;
-                        }
+                        node.m_index += base - 1;
+                    }
+                    if (k == 0)
+                    {
+                        m_nodes[deferred[i].m_node] = node;
+                    }
+                    else
+                    {
+                        m_nodes.push_back(node);
                     }
                 }
+            }
+        }
 
-                NodePtr l_node(*l_min), r_node(*r_min);
+        template <typename T>
+        inline void BVH<T>::buildNode( std::vector<Node>& nodes, uint nodeIdx, uint begin, uint end,
+                                       uint depth, std::vector<Subtree>* deferred )
+        {
+            if (deferred != nullptr && depth == BVHInternal::TaskDepth)
+            {
+                Subtree subtree;
+                subtree.m_node = nodeIdx;
+                subtree.m_begin = begin;
+                subtree.m_end = end;
+                deferred->push_back(subtree);
+                return;
+            }
 
-                // Remove nodes going to be merged
-                toMerge.erase(r_min);
-                toMerge.erase(l_min);
-                // Add the merger
-                toMerge.push_back(std::shared_ptr<Node>(new Node(l_node, r_node)));
+            const uint count = end - begin;
+            Aabb aabb;
+            Aabb centroids;
+            for (uint i = begin; i < end; ++i)
+            {
+                aabb.extend(m_leafAabbs[m_order[i]]);
+                centroids.extend(m_centroids[m_order[i]]);
             }
+            nodes[nodeIdx].m_min = aabb.min();
+            nodes[nodeIdx].m_max = aabb.max();
+            nodes[nodeIdx].m_count = count;
+            nodes[nodeIdx].m_index = begin;
 
-            // Final node (the root) is the merger of last two nodes
-            m_root = std::shared_ptr<Node>(new Node(toMerge[0], toMerge[1]));
+            if (count <= MaxLeafSize)
+            {
+                return;
+            }
 
-            m_upToDate = true ;
-        }
+            int axis;
+            const Vector3 extent = centroids.sizes();
+            extent.maxCoeff(&axis);
+
+            uint mid = begin + count / 2;
+            if (extent[axis] > 0)
+            {
+                // Bin the centroids along the axis, and find the split with the smallest SAH cost.
+                const uint numBins = BVHInternal::NumBins;
+                const Scalar scale = Scalar(numBins) * (1 - Scalar(1e-5)) / extent[axis];
+                const Scalar origin = centroids.min()[axis];
+                auto binOf = [&](uint leaf)
+                {
+                    return std::min(uint((m_centroids[leaf][axis] - origin) * scale), numBins - 1);
+                };
 
+                uint binCounts[numBins] = { 0 };
+                Aabb binAabbs[numBins];
+                for (uint i = begin; i < end; ++i)
+                {
+                    const uint b = binOf(m_order[i]);
+                    ++binCounts[b];
+                    binAabbs[b].extend(m_leafAabbs[m_order[i]]);
+                }
 
-        // Dummy function to transform Vector3 to Vector4
-        inline Vector4 fromV3(Vector3 v, int x) {
-            return Vector4(v(0), v(1), v(2), x) ;
+                // rightCost[b] is the cost of the bins [b+1, numBins).
+                Scalar rightCost[numBins];
+                Aabb right;
+                uint rightCount = 0;
+                for (uint b = numBins - 1; b > 0; --b)
+                {
+                    right.extend(binAabbs[b]);
+                    rightCount += binCounts[b];
+                    rightCost[b - 1] = BVHInternal::halfArea(right) * rightCount;
+                }
+
+                Scalar bestCost = std::numeric_limits<Scalar>::max();
+                uint bestBin = 0;
+                Aabb left;
+                uint leftCount = 0;
+                for (uint b = 0; b < numBins - 1; ++b)
+                {
+                    left.extend(binAabbs[b]);
+                    leftCount += binCounts[b];
+                    const Scalar cost = BVHInternal::halfArea(left) * leftCount + rightCost[b];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestBin = b;
+                    }
+                }
+
+                if (count <= BVHInternal::MaxSAHLeafSize && bestCost >= BVHInternal::halfArea(aabb) * count)
+                {
+                    return;
+                }
+
+                auto split = std::partition(m_order.begin() + begin, m_order.begin() + end,
+                                            [&](uint leaf) { return binOf(leaf) <= bestBin; });
+                mid = uint(split - m_order.begin());
+            }
+
+            // Degenerated splits (e.g. all the centers are the same) : split in two halves along the axis.
+            if (mid == begin || mid == end)
+            {
+                mid = begin + count / 2;
+                std::nth_element(m_order.begin() + begin, m_order.begin() + mid, m_order.begin() + end,
+                                 [&](uint a, uint b) { return m_centroids[a][axis] < m_centroids[b][axis]; });
+            }
+
+            const uint left = nodes.size();
+            nodes.resize(left + 2);
+            nodes[nodeIdx].m_count = 0;
+            nodes[nodeIdx].m_index = left;
+
+            buildNode(nodes, left, begin, mid, depth + 1, deferred);
+            buildNode(nodes, left + 1, mid, end, depth + 1, deferred);
         }
 
         template <typename T>
-        inline void BVH<T>::getInFrustumSlow(std::vector<std::shared_ptr<T>> & objects, const Frustum & frustum) const
+        inline void BVH<T>::refit()
         {
+            if (!m_upToDate)
+            {
+                build();
+                return;
+            }
 
-            if (m_root)
+            parallelFor(0, m_leaves.size(), 0, [this](uint begin, uint end)
             {
-                std::vector<NodePtr> toCheck;
-                toCheck.push_back(m_root);
+                for (uint i = begin; i < end; ++i)
+                {
+                    m_leafAabbs[i] = m_leaves[i]->getAabb();
+                }
+            });
 
-                while (!toCheck.empty())
+            // Children are stored after their parent.
+            for (uint k = m_nodes.size(); k-- > 0; )
+            {
+                Node& node = m_nodes[k];
+                Aabb aabb;
+                if (node.isLeaf())
                 {
-                    NodePtr current = toCheck.back() ;
-                    toCheck.pop_back();
+                    for (uint i = node.m_index; i < node.m_index + node.m_count; ++i)
+                    {
+                        aabb.extend(m_leafAabbs[m_order[i]]);
+                    }
+                }
+                else
+                {
+                    aabb = m_nodes[node.m_index].getAabb().merged(m_nodes[node.m_index + 1].getAabb());
+                }
+                node.m_min = aabb.min();
+                node.m_max = aabb.max();
+            }
+        }
 
-                    if (current->isFinal())
-                        objects.push_back(current->getData());
-                    else
+        template <typename T>
+        inline void BVH<T>::getInFrustum(std::vector<std::shared_ptr<T>> & objects, const Frustum & frustum) const
+        {
+            if (m_nodes.empty())
+            {
+                return;
+            }
+
+            // Classifies a box w.r.t. the planes of mask. Returns false if it is outside one of them,
+            // otherwise removes from mask the planes it is fully inside of.
+            auto classify = [&frustum](const Vector3& min, const Vector3& max, uint& mask)
+            {
+                for (uint i = 0; i < 6; ++i)
+                {
+                    if (mask & (1u << i))
                     {
-                        // If BBOX cuts the frustum, add child in toCheck list
-                        bool isIn = true;
-                        for (uint i=0; i<6 && isIn; ++i)
+                        const Vector4& plane = frustum.m_planes[i];
+                        const Vector3 n = plane.head<3>();
+                        // p-vertex : the corner the furthest along the plane normal, n-vertex : the opposite one.
+                        const Vector3 p = (n.array() >= 0).select(max, min);
+                        if (n.dot(p) + plane.w() < 0)
+                        {
+                            return false;
+                        }
+                        const Vector3 q = (n.array() >= 0).select(min, max);
+                        if (n.dot(q) + plane.w() >= 0)
                         {
-                            Vector4 plane = frustum.getPlane(i);
-                            Aabb aabb = current->getAabb();
-
-                            // If the BBOX is fully outside (at least) one plane, it is not in
-                            if ((plane.dot(fromV3(aabb.corner(Aabb::BottomLeftFloor), 1))    < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::BottomRightFloor), 1))   < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopLeftFloor), 1))       < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopRightFloor), 1))      < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::BottomLeftCeil), 1))     < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::BottomRightCeil), 1))    < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopLeftCeil), 1))        < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopRightCeil), 1))       < 0.f) )
-                                    isIn = false ;
+                            mask &= ~(1u << i);
                         }
+                    }
+                }
+                return true;
+            };
+
+            std::vector<std::pair<uint, uint>> toCheck;
+            toCheck.push_back(std::make_pair(0u, 0x3Fu));
+            while (!toCheck.empty())
+            {
+                const uint nodeIdx = toCheck.back().first;
+                uint mask = toCheck.back().second;
+                toCheck.pop_back();
 
-                        if (isIn)
+                const Node& node = m_nodes[nodeIdx];
+                if (mask != 0 && !classify(node.m_min, node.m_max, mask))
+                {
+                    continue;
+                }
+
+                if (node.isLeaf())
+                {
+                    for (uint i = node.m_index; i < node.m_index + node.m_count; ++i)
+                    {
+                        const uint leaf = m_order[i];
+                        uint leafMask = mask;
+                        if (leafMask == 0 || classify(m_leafAabbs[leaf].min(), m_leafAabbs[leaf].max(), leafMask))
                         {
-                            toCheck.push_back(current->getLeftChild());
-                            toCheck.push_back(current->getRightChild());
+                            objects.push_back(m_leaves[leaf]);
                         }
                     }
                 }
+                else
+                {
+                    toCheck.push_back(std::make_pair(node.m_index + 1, mask));
+                    toCheck.push_back(std::make_pair(node.m_index, mask));
+                }
             }
         }
     }
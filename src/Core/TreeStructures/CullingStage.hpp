@@ -0,0 +1,76 @@
+#ifndef RADIUMENGINE_CULLING_STAGE_HPP
+#define RADIUMENGINE_CULLING_STAGE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <Core/Math/Frustum.hpp>
+#include <Core/TreeStructures/BVH.hpp>
+
+#include <vector>
+#include <memory>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Frustum culling stage of a render queue : keeps a BVH over a set of objects
+        /// (which provide an Aabb getAabb() const method, expected to be cheap, e.g. cached)
+        /// and returns the ones which may be visible from a given frustum.
+        /// When disabled, all the objects are returned.
+        template <typename T>
+        class CullingStage
+        {
+        public:
+            /// Counts of the last call to cull().
+            struct Stats
+            {
+                uint m_numObjects = 0;
+                uint m_numVisible = 0;
+                uint m_numCulled = 0;
+            };
+
+        public:
+            RA_CORE_ALIGNED_NEW
+
+            inline CullingStage() : m_enabled( true ) {}
+
+            inline void setEnabled( bool enabled ) { m_enabled = enabled; }
+            inline bool isEnabled() const { return m_enabled; }
+
+            inline void addObject( const std::shared_ptr<T>& object ) { m_bvh.insertLeaf( object ); }
+            inline bool removeObject( const std::shared_ptr<T>& object ) { return m_bvh.removeLeaf( object ); }
+            inline void clear() { m_bvh.clear(); }
+
+            inline uint size() const { return m_bvh.size(); }
+
+            /// Appends the objects which may be visible to visible. The tree is rebuilt if objects were
+            /// added or removed since the last call, otherwise it is refitted to the current object boxes.
+            inline void cull( const Frustum& frustum, std::vector<std::shared_ptr<T>>& visible )
+            {
+                const uint before = visible.size();
+                if ( m_enabled )
+                {
+                    m_bvh.refit();
+                    m_bvh.getInFrustum( visible, frustum );
+                }
+                else
+                {
+                    visible.insert( visible.end(), m_bvh.getLeaves().begin(), m_bvh.getLeaves().end() );
+                }
+
+                m_stats.m_numObjects = m_bvh.size();
+                m_stats.m_numVisible = visible.size() - before;
+                m_stats.m_numCulled = m_stats.m_numObjects - m_stats.m_numVisible;
+            }
+
+            inline const Stats& getStats() const { return m_stats; }
+
+        private:
+            BVH<T> m_bvh;
+            Stats m_stats;
+            bool m_enabled;
+        };
+    }
+}
+
+#endif //RADIUMENGINE_CULLING_STAGE_HPP
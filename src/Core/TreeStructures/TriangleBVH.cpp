@@ -0,0 +1,376 @@
+#include <Core/TreeStructures/TriangleBVH.hpp>
+
+#include <algorithm>
+
+#include <Core/Tasks/ParallelFor.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            // Number of bins along the split axis.
+            const uint NumBins = 16;
+
+            // Nodes with at most this number of triangles become leaf nodes when splitting does not reduce the SAH cost.
+            const uint MaxSAHLeafSize = 8;
+
+            // From this depth on, nodes are split in two halves instead of using the SAH, which bounds
+            // the depth of the tree by MaxSAHDepth + 32.
+            const uint MaxSAHDepth = 64;
+
+            // Size of the traversal stack, which holds at most one node per level of the tree.
+            const uint StackSize = 128;
+
+            // Half surface area of a box, 0 for an empty one.
+            inline Scalar halfArea( const Aabb& aabb )
+            {
+                if ( aabb.isEmpty() )
+                {
+                    return 0;
+                }
+                const Vector3 d = aabb.sizes();
+                return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+            }
+
+            // Slab test of a ray against a box. Returns the entry parameter in tEntry if the box is
+            // hit in [0, tMax].
+            inline bool vsBox( const Vector3& origin, const Vector3& invDir, const Vector3& min, const Vector3& max,
+                               Scalar tMax, Scalar& tEntry )
+            {
+                const Vector3 t0 = ( min - origin ).cwiseProduct( invDir );
+                const Vector3 t1 = ( max - origin ).cwiseProduct( invDir );
+                const Scalar tNear = std::max( t0.cwiseMin( t1 ).maxCoeff(), Scalar( 0 ) );
+                const Scalar tFar = std::min( t0.cwiseMax( t1 ).minCoeff(), tMax );
+                tEntry = tNear;
+                return tNear <= tFar;
+            }
+
+            // Two-sided ray / triangle test (Moller-Trumbore). On a hit in [0, tMax], returns the
+            // ray parameter and the barycentric coordinates of b and c.
+            inline bool vsTriangle( const Ray& ray, const Vector3& a, const Vector3& b, const Vector3& c,
+                                    Scalar tMax, Scalar& t, Scalar& u, Scalar& v )
+            {
+                const Vector3 ab = b - a;
+                const Vector3 ac = c - a;
+                const Vector3 p = ray.direction().cross( ac );
+                const Scalar det = ab.dot( p );
+                if ( det == 0 )
+                {
+                    // Ray parallel to the triangle, or degenerate triangle.
+                    return false;
+                }
+                const Scalar invDet = 1 / det;
+
+                const Vector3 s = ray.origin() - a;
+                u = s.dot( p ) * invDet;
+                if ( u < 0 || u > 1 )
+                {
+                    return false;
+                }
+
+                const Vector3 q = s.cross( ab );
+                v = ray.direction().dot( q ) * invDet;
+                if ( v < 0 || u + v > 1 )
+                {
+                    return false;
+                }
+
+                t = ac.dot( q ) * invDet;
+                return t >= 0 && t <= tMax;
+            }
+        }
+
+        void TriangleBVH::clear()
+        {
+            m_nodes.clear();
+            m_order.clear();
+        }
+
+        void TriangleBVH::build( const TriangleMesh& mesh )
+        {
+            const uint size = mesh.m_triangles.size();
+            m_order.resize( size );
+            m_nodes.clear();
+            if ( size == 0 )
+            {
+                return;
+            }
+
+            AlignedStdVector<Aabb> aabbs( size );
+            std::vector<Vector3> centroids( size );
+            parallelFor( 0, size, 0, [&]( uint begin, uint end )
+            {
+                for ( uint i = begin; i < end; ++i )
+                {
+                    const Triangle& tri = mesh.m_triangles[i];
+                    Aabb aabb( mesh.m_vertices[tri[0]], mesh.m_vertices[tri[0]] );
+                    aabb.extend( mesh.m_vertices[tri[1]] );
+                    aabb.extend( mesh.m_vertices[tri[2]] );
+                    aabbs[i] = aabb;
+                    centroids[i] = aabb.center();
+                    m_order[i] = i;
+                }
+            } );
+
+            m_nodes.reserve( 2 * ( size / MaxLeafSize + 1 ) );
+            m_nodes.resize( 1 );
+            buildNode( 0, 0, size, 0, aabbs, centroids );
+        }
+
+        void TriangleBVH::buildNode( uint nodeIdx, uint begin, uint end, uint depth,
+                                     const AlignedStdVector<Aabb>& aabbs, const std::vector<Vector3>& centroids )
+        {
+            const uint count = end - begin;
+            Aabb aabb;
+            Aabb centroidsAabb;
+            for ( uint i = begin; i < end; ++i )
+            {
+                aabb.extend( aabbs[m_order[i]] );
+                centroidsAabb.extend( centroids[m_order[i]] );
+            }
+            m_nodes[nodeIdx].m_min = aabb.min();
+            m_nodes[nodeIdx].m_max = aabb.max();
+            m_nodes[nodeIdx].m_count = count;
+            m_nodes[nodeIdx].m_index = begin;
+
+            if ( count <= MaxLeafSize )
+            {
+                return;
+            }
+
+            int axis;
+            const Vector3 extent = centroidsAabb.sizes();
+            extent.maxCoeff( &axis );
+
+            uint mid = begin + count / 2;
+            if ( extent[axis] > 0 && depth < MaxSAHDepth )
+            {
+                // Bin the centroids along the axis, and find the split with the smallest SAH cost.
+                const Scalar scale = Scalar( NumBins ) * ( 1 - Scalar( 1e-5 ) ) / extent[axis];
+                const Scalar origin = centroidsAabb.min()[axis];
+                auto binOf = [&]( uint tri )
+                {
+                    return std::min( uint( ( centroids[tri][axis] - origin ) * scale ), NumBins - 1 );
+                };
+
+                uint binCounts[NumBins] = { 0 };
+                Aabb binAabbs[NumBins];
+                for ( uint i = begin; i < end; ++i )
+                {
+                    const uint b = binOf( m_order[i] );
+                    ++binCounts[b];
+                    binAabbs[b].extend( aabbs[m_order[i]] );
+                }
+
+                // rightCost[b] is the cost of the bins [b+1, NumBins).
+                Scalar rightCost[NumBins];
+                Aabb right;
+                uint rightCount = 0;
+                for ( uint b = NumBins - 1; b > 0; --b )
+                {
+                    right.extend( binAabbs[b] );
+                    rightCount += binCounts[b];
+                    rightCost[b - 1] = halfArea( right ) * rightCount;
+                }
+
+                Scalar bestCost = std::numeric_limits<Scalar>::max();
+                uint bestBin = 0;
+                Aabb left;
+                uint leftCount = 0;
+                for ( uint b = 0; b < NumBins - 1; ++b )
+                {
+                    left.extend( binAabbs[b] );
+                    leftCount += binCounts[b];
+                    const Scalar cost = halfArea( left ) * leftCount + rightCost[b];
+                    if ( cost < bestCost )
+                    {
+                        bestCost = cost;
+                        bestBin = b;
+                    }
+                }
+
+                if ( count <= MaxSAHLeafSize && bestCost >= halfArea( aabb ) * count )
+                {
+                    return;
+                }
+
+                auto split = std::partition( m_order.begin() + begin, m_order.begin() + end,
+                                             [&]( uint tri ) { return binOf( tri ) <= bestBin; } );
+                mid = uint( split - m_order.begin() );
+            }
+
+            // Degenerated splits (e.g. all the centers are the same) or deep nodes : split in two halves along the axis.
+            if ( mid == begin || mid == end || depth >= MaxSAHDepth )
+            {
+                mid = begin + count / 2;
+                std::nth_element( m_order.begin() + begin, m_order.begin() + mid, m_order.begin() + end,
+                                  [&]( uint a, uint b ) { return centroids[a][axis] < centroids[b][axis]; } );
+            }
+
+            const uint left = m_nodes.size();
+            m_nodes.resize( left + 2 );
+            m_nodes[nodeIdx].m_count = 0;
+            m_nodes[nodeIdx].m_index = left;
+
+            buildNode( left, begin, mid, depth + 1, aabbs, centroids );
+            buildNode( left + 1, mid, end, depth + 1, aabbs, centroids );
+        }
+
+        void TriangleBVH::computeLeafAabb( const TriangleMesh& mesh, Node& node ) const
+        {
+            Aabb aabb;
+            for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i )
+            {
+                const Triangle& tri = mesh.m_triangles[m_order[i]];
+                aabb.extend( mesh.m_vertices[tri[0]] );
+                aabb.extend( mesh.m_vertices[tri[1]] );
+                aabb.extend( mesh.m_vertices[tri[2]] );
+            }
+            node.m_min = aabb.min();
+            node.m_max = aabb.max();
+        }
+
+        void TriangleBVH::refit( const TriangleMesh& mesh )
+        {
+            CORE_ASSERT( mesh.m_triangles.size() == m_order.size(), "Mesh does not match the tree" );
+
+            // Leaves are independent, inner nodes are then updated from their children,
+            // which are stored after them.
+            parallelFor( 0, m_nodes.size(), 0, [&]( uint begin, uint end )
+            {
+                for ( uint k = begin; k < end; ++k )
+                {
+                    if ( m_nodes[k].isLeaf() )
+                    {
+                        computeLeafAabb( mesh, m_nodes[k] );
+                    }
+                }
+            } );
+
+            for ( uint k = m_nodes.size(); k-- > 0; )
+            {
+                Node& node = m_nodes[k];
+                if ( !node.isLeaf() )
+                {
+                    node.m_min = m_nodes[node.m_index].m_min.cwiseMin( m_nodes[node.m_index + 1].m_min );
+                    node.m_max = m_nodes[node.m_index].m_max.cwiseMax( m_nodes[node.m_index + 1].m_max );
+                }
+            }
+        }
+
+        bool TriangleBVH::closestHit( const TriangleMesh& mesh, const Ray& ray, Hit& hitOut, Scalar tMax ) const
+        {
+            return traverse<false>( mesh, ray, hitOut, tMax );
+        }
+
+        bool TriangleBVH::anyHit( const TriangleMesh& mesh, const Ray& ray, Hit& hitOut, Scalar tMax ) const
+        {
+            return traverse<true>( mesh, ray, hitOut, tMax );
+        }
+
+        uint TriangleBVH::getNearestVertex( const TriangleMesh& mesh, const Ray& ray, const Hit& hit )
+        {
+            CORE_ASSERT( hit.m_triangle >= 0, "No hit" );
+            const Triangle& triangle = mesh.m_triangles[hit.m_triangle];
+            const Vector3 point = ray.pointAt( hit.m_t );
+            uint nearest = 0;
+            Scalar minDist = ( mesh.m_vertices[triangle[0]] - point ).squaredNorm();
+            for ( uint i = 1; i < 3; ++i )
+            {
+                const Scalar dist = ( mesh.m_vertices[triangle[i]] - point ).squaredNorm();
+                if ( dist < minDist )
+                {
+                    minDist = dist;
+                    nearest = i;
+                }
+            }
+            return triangle[nearest];
+        }
+
+        template <bool AnyHit>
+        bool TriangleBVH::traverse( const TriangleMesh& mesh, const Ray& ray, Hit& hitOut, Scalar tMax ) const
+        {
+            CORE_ASSERT( mesh.m_triangles.size() == m_order.size(), "Mesh does not match the tree" );
+
+            hitOut = Hit();
+            Scalar entry;
+            const Vector3& origin = ray.origin();
+            const Vector3 invDir = ray.direction().cwiseInverse();
+            if ( m_nodes.empty() || !vsBox( origin, invDir, m_nodes[0].m_min, m_nodes[0].m_max, tMax, entry ) )
+            {
+                return false;
+            }
+
+            // Nodes to visit, with the ray parameter where the ray enters them.
+            std::pair<uint, Scalar> stack[StackSize];
+            uint stackSize = 0;
+            stack[stackSize++] = std::make_pair( 0u, entry );
+            while ( stackSize > 0 )
+            {
+                --stackSize;
+                if ( stack[stackSize].second > tMax )
+                {
+                    // A closer hit was found since this node was pushed.
+                    continue;
+                }
+                const Node& node = m_nodes[stack[stackSize].first];
+
+                if ( node.isLeaf() )
+                {
+                    for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i )
+                    {
+                        const Triangle& tri = mesh.m_triangles[m_order[i]];
+                        Scalar t, u, v;
+                        if ( vsTriangle( ray, mesh.m_vertices[tri[0]], mesh.m_vertices[tri[1]], mesh.m_vertices[tri[2]],
+                                         tMax, t, u, v ) )
+                        {
+                            tMax = t;
+                            hitOut.m_triangle = int( m_order[i] );
+                            hitOut.m_t = t;
+                            hitOut.m_barycentrics = Vector3( 1 - u - v, u, v );
+                            if ( AnyHit )
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    // Visit the nearest child first.
+                    const Node& left = m_nodes[node.m_index];
+                    const Node& right = m_nodes[node.m_index + 1];
+                    Scalar leftEntry, rightEntry;
+                    const bool hitLeft = vsBox( origin, invDir, left.m_min, left.m_max, tMax, leftEntry );
+                    const bool hitRight = vsBox( origin, invDir, right.m_min, right.m_max, tMax, rightEntry );
+                    CORE_ASSERT( stackSize + 2 <= StackSize, "BVH is too deep" );
+                    if ( hitLeft && hitRight )
+                    {
+                        if ( leftEntry <= rightEntry )
+                        {
+                            stack[stackSize++] = std::make_pair( node.m_index + 1, rightEntry );
+                            stack[stackSize++] = std::make_pair( node.m_index, leftEntry );
+                        }
+                        else
+                        {
+                            stack[stackSize++] = std::make_pair( node.m_index, leftEntry );
+                            stack[stackSize++] = std::make_pair( node.m_index + 1, rightEntry );
+                        }
+                    }
+                    else if ( hitLeft )
+                    {
+                        stack[stackSize++] = std::make_pair( node.m_index, leftEntry );
+                    }
+                    else if ( hitRight )
+                    {
+                        stack[stackSize++] = std::make_pair( node.m_index + 1, rightEntry );
+                    }
+                }
+            }
+
+            return hitOut.m_triangle >= 0;
+        }
+    }
+}
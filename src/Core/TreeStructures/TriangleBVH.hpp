@@ -0,0 +1,109 @@
+#ifndef RADIUMENGINE_TRIANGLE_BVH_HPP
+#define RADIUMENGINE_TRIANGLE_BVH_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Math/Ray.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Bounding volume hierarchy over the triangles of a TriangleMesh, used to cast rays
+        /// (e.g. picking) without testing every triangle. The tree only stores triangle indices :
+        /// the mesh is given to each function, and must be the one the tree was built from.
+        /// When the vertices move (e.g. skinning), refit() updates the boxes without rebuilding the tree.
+        class RA_CORE_API TriangleBVH
+        {
+        public:
+            /// Node of the tree, same layout as BVH::Node (32 bytes when Scalar is float).
+            struct Node
+            {
+                Vector3 m_min;
+                /// Number of triangles of a leaf node, 0 for an inner node.
+                uint m_count;
+                Vector3 m_max;
+                /// Leaf node : position of its first triangle in getTriangleOrder().
+                /// Inner node : index of its left child, the right one is m_index + 1.
+                uint m_index;
+
+                inline bool isLeaf() const { return m_count > 0; }
+                inline Aabb getAabb() const { return Aabb( m_min, m_max ); }
+            };
+
+            /// Result of a ray cast.
+            struct Hit
+            {
+                /// Index of the hit triangle, -1 if there was no hit.
+                int m_triangle = -1;
+                /// Ray parameter of the hit point.
+                Scalar m_t = std::numeric_limits<Scalar>::max();
+                /// Weights of the three vertices of the triangle at the hit point.
+                Vector3 m_barycentrics = Vector3::Zero();
+            };
+
+            /// Maximum number of triangles in a leaf node.
+            static const uint MaxLeafSize = 4;
+
+        public:
+            RA_CORE_ALIGNED_NEW
+
+            TriangleBVH() {}
+
+            /// Builds the tree with a binned surface area heuristic.
+            void build( const TriangleMesh& mesh );
+
+            /// Updates the boxes to the current vertex positions, keeping the structure of the tree.
+            /// The mesh must have the same triangles as when the tree was built.
+            void refit( const TriangleMesh& mesh );
+
+            void clear();
+
+            /// Returns the hit with the smallest ray parameter in [0, tMax].
+            /// Triangles are two-sided. Returns false if there is no such hit.
+            bool closestHit( const TriangleMesh& mesh, const Ray& ray, Hit& hitOut,
+                             Scalar tMax = std::numeric_limits<Scalar>::max() ) const;
+
+            /// Returns the first hit found with a ray parameter in [0, tMax] (e.g. for occlusion queries).
+            bool anyHit( const TriangleMesh& mesh, const Ray& ray, Hit& hitOut,
+                         Scalar tMax = std::numeric_limits<Scalar>::max() ) const;
+
+            /// Returns the vertex of the hit triangle nearest to the hit point (e.g. for picking).
+            /// This is not always the vertex with the largest barycentric weight, e.g. on obtuse triangles.
+            static uint getNearestVertex( const TriangleMesh& mesh, const Ray& ray, const Hit& hit );
+
+            /// Number of triangles the tree was built with.
+            inline uint getNumTriangles() const { return m_order.size(); }
+
+            inline bool isEmpty() const { return m_nodes.empty(); }
+
+            inline Aabb getAabb() const { return m_nodes.empty() ? Aabb() : m_nodes[0].getAabb(); }
+
+            inline const std::vector<Node>& getNodes() const { return m_nodes; }
+
+            /// Triangle indices, in the order of the leaf nodes.
+            inline const std::vector<uint>& getTriangleOrder() const { return m_order; }
+
+        private:
+            template <bool AnyHit>
+            bool traverse( const TriangleMesh& mesh, const Ray& ray, Hit& hitOut, Scalar tMax ) const;
+
+            void buildNode( uint nodeIdx, uint begin, uint end, uint depth,
+                            const AlignedStdVector<Aabb>& aabbs, const std::vector<Vector3>& centroids );
+
+            void computeLeafAabb( const TriangleMesh& mesh, Node& node ) const;
+
+        private:
+            std::vector<Node> m_nodes;
+            std::vector<uint> m_order;
+        };
+    }
+}
+
+#endif //RADIUMENGINE_TRIANGLE_BVH_HPP
@@ -0,0 +1,91 @@
+#include <Core/Utils/DirtyRanges.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+DirtyRanges::DirtyRanges() : m_range(), m_size( 0 ) { }
+
+
+
+/// ===============================================================================
+/// DIRTY
+/// ===============================================================================
+void DirtyRanges::add( const uint begin, const uint end ) {
+    if( begin >= end ) {
+        return;
+    }
+
+    // Insert the range in order, then merge it with the ranges it overlaps or touches.
+    uint i = 0;
+    while( i < m_size && m_range[i].m_begin < begin ) {
+        ++i;
+    }
+    for( uint j = m_size; j > i; --j ) {
+        m_range[j] = m_range[j - 1];
+    }
+    m_range[i] = Range { begin, end };
+    ++m_size;
+
+    uint last = 0;
+    for( uint j = 1; j < m_size; ++j ) {
+        if( m_range[j].m_begin <= m_range[last].m_end ) {
+            m_range[last].m_end = std::max( m_range[last].m_end, m_range[j].m_end );
+        } else {
+            m_range[++last] = m_range[j];
+        }
+    }
+    m_size = last + 1;
+
+    // Too many ranges : merge the closest ones.
+    if( m_size > MaxRanges ) {
+        uint closest = 0;
+        for( uint j = 1; j + 1 < m_size; ++j ) {
+            if( m_range[j + 1].m_begin - m_range[j].m_end <
+                m_range[closest + 1].m_begin - m_range[closest].m_end ) {
+                closest = j;
+            }
+        }
+        m_range[closest].m_end = m_range[closest + 1].m_end;
+        for( uint j = closest + 1; j + 1 < m_size; ++j ) {
+            m_range[j] = m_range[j + 1];
+        }
+        --m_size;
+    }
+}
+
+void DirtyRanges::clear() {
+    m_size = 0;
+}
+
+void DirtyRanges::clamp( const uint size ) {
+    uint last = 0;
+    for( uint j = 0; j < m_size; ++j ) {
+        if( m_range[j].m_begin < size ) {
+            m_range[last++] = Range { m_range[j].m_begin, std::min( m_range[j].m_end, size ) };
+        }
+    }
+    m_size = last;
+}
+
+
+
+/// ===============================================================================
+/// QUERY
+/// ===============================================================================
+uint DirtyRanges::getElementSize() const {
+    uint size = 0;
+    for( uint j = 0; j < m_size; ++j ) {
+        size += m_range[j].m_end - m_range[j].m_begin;
+    }
+    return size;
+}
+
+
+
+} // namespace Core
+} // namespace Ra
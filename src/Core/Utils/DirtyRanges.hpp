@@ -0,0 +1,74 @@
+#ifndef RADIUMENGINE_DIRTY_RANGES_HPP
+#define RADIUMENGINE_DIRTY_RANGES_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <array>
+
+namespace Ra {
+namespace Core {
+
+/*
+* The class DirtyRanges tracks the elements of an array modified since its last upload, as a few sorted and disjoint
+* ranges [begin, end). Overlapping or adjacent ranges are merged. When there are more than MaxRanges ranges, the two
+* ranges separated by the smallest gap are merged, so that an upload stays a few calls at the cost of re-sending the
+* elements in between.
+*/
+class RA_CORE_API DirtyRanges {
+public:
+    /// RANGE
+    static const uint MaxRanges = 4;
+
+    struct Range {
+        uint m_begin;
+        uint m_end;
+    };
+
+    /// CONSTRUCTOR
+    DirtyRanges();
+
+    /// DIRTY
+    // Mark the elements [begin, end).
+    void add( const uint begin, const uint end );
+
+    // Mark the whole array, whatever its size.
+    inline void addAll() {
+        add( 0, uint( -1 ) );
+    }
+
+    void clear();
+
+    // Restrict the ranges to the elements of an array of the given size.
+    void clamp( const uint size );
+
+    /// QUERY
+    inline bool isEmpty() const {
+        return ( m_size == 0 );
+    }
+
+    inline uint size() const {
+        return m_size;
+    }
+
+    inline const Range& operator[]( const uint i ) const {
+        return m_range[i];
+    }
+
+    // Whether all the elements of an array of the given size are marked.
+    inline bool isAll( const uint size ) const {
+        return ( m_size == 1 && m_range[0].m_begin == 0 && m_range[0].m_end >= size );
+    }
+
+    // Number of marked elements.
+    uint getElementSize() const;
+
+private:
+    /// VARIABLE
+    std::array< Range, MaxRanges + 1 > m_range;
+    uint                               m_size;
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_DIRTY_RANGES_HPP
@@ -0,0 +1,118 @@
+#include <Core/Utils/DrawList.hpp>
+
+#include <algorithm>
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// KEY
+/// ===============================================================================
+uint64_t DrawList::makeKey( const uint pass, const uint shader, const uint material, const uint mesh,
+                            const Scalar depth ) {
+    CORE_ASSERT( pass < ( 1u << PassBits ) && shader < ( 1u << ShaderBits ) &&
+                 material < ( 1u << MaterialBits ) && mesh < ( 1u << MeshBits ), "Draw key field overflow" );
+    const Scalar d = std::min( std::max( depth, Scalar( 0 ) ), Scalar( 1 ) );
+    const uint64_t z = uint64_t( d * Scalar( ( 1u << DepthBits ) - 1 ) );
+    return ( uint64_t( pass )     << ( ShaderBits + MaterialBits + MeshBits + DepthBits ) ) |
+           ( uint64_t( shader )   << ( MaterialBits + MeshBits + DepthBits ) ) |
+           ( uint64_t( material ) << ( MeshBits + DepthBits ) ) |
+           ( uint64_t( mesh )     << DepthBits ) |
+           z;
+}
+
+
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+DrawList::DrawList() : m_draw(), m_buffer() { }
+
+
+
+/// ===============================================================================
+/// LIST
+/// ===============================================================================
+void DrawList::clear() {
+    m_draw.clear();
+}
+
+void DrawList::reserve( const uint size ) {
+    m_draw.reserve( size );
+    m_buffer.reserve( size );
+}
+
+void DrawList::sort() {
+    const uint n = m_draw.size();
+
+    // Least significant digit radix sort, on bytes. The histograms of the 8 bytes are built in one pass,
+    // and the bytes equal for all the keys are skipped.
+    uint count[8][256] = {};
+    for( const auto& draw : m_draw ) {
+        for( uint b = 0; b < 8; ++b ) {
+            ++count[b][( draw.m_key >> ( 8 * b ) ) & 0xff];
+        }
+    }
+    m_buffer.resize( n );
+    for( uint b = 0; b < 8; ++b ) {
+        if( n == 0 || count[b][( m_draw[0].m_key >> ( 8 * b ) ) & 0xff] == n ) {
+            continue;
+        }
+        uint offset[256];
+        uint sum = 0;
+        for( uint i = 0; i < 256; ++i ) {
+            offset[i] = sum;
+            sum      += count[b][i];
+        }
+        for( const auto& draw : m_draw ) {
+            m_buffer[offset[( draw.m_key >> ( 8 * b ) ) & 0xff]++] = draw;
+        }
+        std::swap( m_draw, m_buffer );
+    }
+
+    // State changes.
+    for( uint i = 0; i < n; ++i ) {
+        if( i == 0 ) {
+            m_draw[i].m_change = CHANGE_PASS | CHANGE_SHADER | CHANGE_MATERIAL | CHANGE_MESH;
+            continue;
+        }
+        const uint64_t prev = m_draw[i - 1].m_key;
+        const uint64_t next = m_draw[i].m_key;
+        uint change = 0;
+        if( getPass( prev ) != getPass( next ) ) {
+            change |= CHANGE_PASS | CHANGE_SHADER | CHANGE_MATERIAL | CHANGE_MESH;
+        }
+        if( getShader( prev ) != getShader( next ) ) {
+            change |= CHANGE_SHADER | CHANGE_MATERIAL | CHANGE_MESH;
+        }
+        if( getMaterial( prev ) != getMaterial( next ) ) {
+            change |= CHANGE_MATERIAL;
+        }
+        if( getMesh( prev ) != getMesh( next ) ) {
+            change |= CHANGE_MESH;
+        }
+        m_draw[i].m_change = change;
+    }
+}
+
+
+
+/// ===============================================================================
+/// QUERY
+/// ===============================================================================
+DrawList::Statistics DrawList::getStatistics() const {
+    Statistics stat;
+    stat.m_draw      = m_draw.size();
+    stat.m_naiveBind = 3 * stat.m_draw;
+    for( const auto& draw : m_draw ) {
+        stat.m_bind += ( ( draw.m_change & CHANGE_SHADER ) != 0 ) +
+                       ( ( draw.m_change & CHANGE_MATERIAL ) != 0 ) +
+                       ( ( draw.m_change & CHANGE_MESH ) != 0 );
+    }
+    return stat;
+}
+
+
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,110 @@
+#ifndef RADIUMENGINE_DRAW_LIST_HPP
+#define RADIUMENGINE_DRAW_LIST_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/*
+* The class DrawList sorts the draws of a frame by a 64 bits key, so that the draws of a pass sharing a shader, then
+* a material, then a mesh are consecutive, and only the state which changes between two draws has to be bound :
+*
+*       63 .. 60    59 .. 48    47 .. 32    31 .. 16    15 .. 0
+*       PASS        SHADER      MATERIAL    MESH        DEPTH
+*
+* Shaders, materials and meshes are identified by small integers given by the renderer ( e.g. in order of first use
+* in the frame ). The depth, in [0, 1], orders the draws using the same state front to back.
+* The sort is a stable radix sort : draws with the same key stay in the order they were added.
+*/
+class RA_CORE_API DrawList {
+public:
+    /// KEY
+    static const uint PassBits     = 4;
+    static const uint ShaderBits   = 12;
+    static const uint MaterialBits = 16;
+    static const uint MeshBits     = 16;
+    static const uint DepthBits    = 16;
+
+    static uint64_t makeKey( const uint pass, const uint shader, const uint material, const uint mesh, const Scalar depth );
+
+    static inline uint getPass( const uint64_t key ) {
+        return uint( key >> ( 64 - PassBits ) );
+    }
+
+    static inline uint getShader( const uint64_t key ) {
+        return uint( key >> ( MaterialBits + MeshBits + DepthBits ) ) & ( ( 1u << ShaderBits ) - 1 );
+    }
+
+    static inline uint getMaterial( const uint64_t key ) {
+        return uint( key >> ( MeshBits + DepthBits ) ) & ( ( 1u << MaterialBits ) - 1 );
+    }
+
+    static inline uint getMesh( const uint64_t key ) {
+        return uint( key >> DepthBits ) & ( ( 1u << MeshBits ) - 1 );
+    }
+
+    /// STATE CHANGE
+    // State to bind before a draw, compared to the previous one. The first draw binds everything.
+    enum StateChange : uint {
+        CHANGE_PASS     = 1 << 0,
+        CHANGE_SHADER   = 1 << 1,
+        CHANGE_MATERIAL = 1 << 2,
+        CHANGE_MESH     = 1 << 3
+    };
+
+    struct Draw {
+        uint64_t m_key;
+        uint     m_item;    // Index of the drawn object, given by the renderer.
+        uint     m_change;  // StateChange flags, set by sort().
+    };
+
+    // Number of draws and of binds ( shader, material and mesh ) of the sorted list, compared to binding
+    // everything for every draw.
+    struct Statistics {
+        uint m_draw      = 0;
+        uint m_bind      = 0;
+        uint m_naiveBind = 0;
+    };
+
+    /// CONSTRUCTOR
+    DrawList();
+
+    /// LIST
+    void clear();
+    void reserve( const uint size );
+
+    inline void add( const uint64_t key, const uint item ) {
+        m_draw.push_back( Draw { key, item, 0 } );
+    }
+
+    // Sort the draws by key, and compute their state changes.
+    void sort();
+
+    /// QUERY
+    inline uint size() const {
+        return m_draw.size();
+    }
+
+    inline const Draw& operator[]( const uint i ) const {
+        return m_draw[i];
+    }
+
+    inline const std::vector< Draw >& getDraws() const {
+        return m_draw;
+    }
+
+    Statistics getStatistics() const;
+
+private:
+    /// VARIABLE
+    std::vector< Draw > m_draw;
+    std::vector< Draw > m_buffer;   // Ping-pong buffer of the radix sort.
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_DRAW_LIST_HPP
@@ -0,0 +1,236 @@
+#include <Core/Utils/File/BlobFile.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace Ra {
+namespace Core {
+
+namespace {
+const char     BlobMagic[4]      = { 'R', 'B', 'L', 'B' };
+const uint32_t BlobFormatVersion = 1;
+const uint64_t BlobAlignment     = 16;
+
+inline uint64_t align( const uint64_t offset ) {
+    return ( offset + BlobAlignment - 1 ) / BlobAlignment * BlobAlignment;
+}
+}
+
+
+
+/// ===============================================================================
+/// FILE STAMP
+/// ===============================================================================
+uint64_t hashBytes( const void* data, const std::size_t size, uint64_t hash ) {
+    const char* bytes = static_cast< const char* >( data );
+    std::size_t i = 0;
+    for( ; i + sizeof( uint64_t ) <= size; i += sizeof( uint64_t ) ) {
+        uint64_t word;
+        std::memcpy( &word, bytes + i, sizeof( word ) );
+        hash = ( hash ^ word ) * 1099511628211ull;
+    }
+    for( ; i < size; ++i ) {
+        hash = ( hash ^ static_cast< unsigned char >( bytes[i] ) ) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool getFileStamp( const std::string& filename, FileStamp& stamp, const bool HASH_CONTENT ) {
+    struct stat info;
+    if( stat( filename.c_str(), &info ) != 0 ) {
+        return false;
+    }
+    stamp.m_path    = hashBytes( filename.data(), filename.size() );
+    stamp.m_time    = static_cast< int64_t >( info.st_mtime );
+    stamp.m_size    = static_cast< uint64_t >( info.st_size );
+    stamp.m_content = 0;
+    if( HASH_CONTENT && stamp.m_size != 0 ) {
+        MappedFile file;
+        if( !file.open( filename ) ) {
+            return false;
+        }
+        stamp.m_content = hashBytes( file.data(), file.size() );
+    }
+    return true;
+}
+
+
+
+/// ===============================================================================
+/// WRITER
+/// ===============================================================================
+void BlobWriter::addSection( const void* data, const std::size_t elementSize, const std::size_t count ) {
+    BlobSection section;
+    section.m_elementSize = elementSize;
+    section.m_padding     = 0;
+    section.m_count       = count;
+    section.m_offset      = 0;
+    m_sections.push_back( section );
+    m_data.push_back( static_cast< const char* >( data ) );
+}
+
+void BlobWriter::addCopy( const void* data, const std::size_t elementSize, const std::size_t count ) {
+    const char* bytes = static_cast< const char* >( data );
+    m_copies.push_back( std::vector< char >( bytes, bytes + elementSize * count ) );
+    addSection( m_copies.back().data(), elementSize, count );
+}
+
+void BlobWriter::addStrings( const std::vector< std::string >& list ) {
+    std::vector< uint32_t > length( list.size() );
+    std::string text;
+    for( uint i = 0; i < list.size(); ++i ) {
+        length[i] = list[i].size();
+        text += list[i];
+    }
+    addCopy( length.data(), sizeof( uint32_t ), length.size() );
+    addString( text );
+}
+
+bool BlobWriter::save( const std::string& filename, const FileStamp& stamp, const uint32_t version ) const {
+    BlobHeader header;
+    std::memcpy( header.m_magic, BlobMagic, sizeof( BlobMagic ) );
+    header.m_formatVersion = BlobFormatVersion;
+    header.m_scalarSize    = sizeof( Scalar );
+    header.m_version       = version;
+    header.m_sectionSize   = m_sections.size();
+    header.m_padding       = 0;
+    header.m_stamp         = stamp;
+
+    std::vector< BlobSection > table = m_sections;
+    uint64_t offset = sizeof( BlobHeader ) + table.size() * sizeof( BlobSection );
+    for( auto& section : table ) {
+        offset           = align( offset );
+        section.m_offset = offset;
+        offset          += section.m_elementSize * section.m_count;
+    }
+
+    const std::string tmp = filename + ".tmp";
+    std::ofstream file( tmp, std::ios::binary | std::ios::trunc );
+    if( !file ) {
+        return false;
+    }
+    file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    file.write( reinterpret_cast< const char* >( table.data() ), table.size() * sizeof( BlobSection ) );
+    const char padding[BlobAlignment] = {};
+    uint64_t position = sizeof( BlobHeader ) + table.size() * sizeof( BlobSection );
+    for( uint i = 0; i < table.size(); ++i ) {
+        file.write( padding, table[i].m_offset - position );
+        file.write( m_data[i], table[i].m_elementSize * table[i].m_count );
+        position = table[i].m_offset + table[i].m_elementSize * table[i].m_count;
+    }
+    file.close();
+    if( !file ) {
+        std::remove( tmp.c_str() );
+        return false;
+    }
+    std::remove( filename.c_str() );
+    return ( std::rename( tmp.c_str(), filename.c_str() ) == 0 );
+}
+
+bool BlobWriter::setStamp( const std::string& filename, const FileStamp& stamp ) {
+    std::fstream file( filename, std::ios::binary | std::ios::in | std::ios::out );
+    BlobHeader header;
+    if( !file || !file.read( reinterpret_cast< char* >( &header ), sizeof( header ) ) ||
+        std::memcmp( header.m_magic, BlobMagic, sizeof( BlobMagic ) ) != 0 ) {
+        return false;
+    }
+    file.seekp( offsetof( BlobHeader, m_stamp ) );
+    file.write( reinterpret_cast< const char* >( &stamp ), sizeof( stamp ) );
+    file.close();
+    return !file.fail();
+}
+
+void BlobWriter::clear() {
+    m_sections.clear();
+    m_data.clear();
+    m_copies.clear();
+}
+
+
+
+/// ===============================================================================
+/// READER
+/// ===============================================================================
+BlobReader::BlobReader() : m_file(), m_header( nullptr ), m_sections( nullptr ), m_next( 0 ), m_valid( false ) { }
+
+bool BlobReader::open( const std::string& filename, const uint32_t version ) {
+    close();
+    if( !m_file.open( filename ) || m_file.size() < sizeof( BlobHeader ) ) {
+        close();
+        return false;
+    }
+    const BlobHeader* header = reinterpret_cast< const BlobHeader* >( m_file.data() );
+    if( std::memcmp( header->m_magic, BlobMagic, sizeof( BlobMagic ) ) != 0 ||
+        header->m_formatVersion != BlobFormatVersion ||
+        header->m_scalarSize != sizeof( Scalar ) ||
+        header->m_version != version ||
+        ( m_file.size() - sizeof( BlobHeader ) ) / sizeof( BlobSection ) < header->m_sectionSize ) {
+        close();
+        return false;
+    }
+
+    // Every section must lie in the file.
+    const BlobSection* sections = reinterpret_cast< const BlobSection* >( m_file.data() + sizeof( BlobHeader ) );
+    for( uint i = 0; i < header->m_sectionSize; ++i ) {
+        const BlobSection& s = sections[i];
+        if( s.m_offset % BlobAlignment != 0 || s.m_offset > m_file.size() ||
+            ( s.m_elementSize != 0 && s.m_count > ( m_file.size() - s.m_offset ) / s.m_elementSize ) ) {
+            close();
+            return false;
+        }
+    }
+    m_header   = header;
+    m_sections = sections;
+    m_next     = 0;
+    m_valid    = true;
+    return true;
+}
+
+void BlobReader::close() {
+    m_file.close();
+    m_header   = nullptr;
+    m_sections = nullptr;
+    m_next     = 0;
+    m_valid    = false;
+}
+
+const void* BlobReader::readSection( const std::size_t elementSize, std::size_t& count ) {
+    count = 0;
+    if( !m_valid || m_next >= m_header->m_sectionSize || m_sections[m_next].m_elementSize != elementSize ) {
+        m_valid = false;
+        return nullptr;
+    }
+    const BlobSection& section = m_sections[m_next++];
+    count = section.m_count;
+    return m_file.data() + section.m_offset;
+}
+
+bool BlobReader::readStrings( std::vector< std::string >& list ) {
+    std::size_t count  = 0;
+    std::size_t size   = 0;
+    const uint32_t* length = readArray< uint32_t >( count );
+    const char*     text   = readArray< char >( size );
+    list.clear();
+    if( !m_valid ) {
+        return false;
+    }
+    list.reserve( count );
+    std::size_t offset = 0;
+    for( std::size_t i = 0; i < count; ++i ) {
+        if( length[i] > size - offset ) {
+            m_valid = false;
+            list.clear();
+            return false;
+        }
+        list.push_back( std::string( text + offset, length[i] ) );
+        offset += length[i];
+    }
+    return true;
+}
+
+
+
+} // namespace Core
+} // namespace Ra
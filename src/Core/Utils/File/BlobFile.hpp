@@ -0,0 +1,203 @@
+#ifndef RADIUMENGINE_BLOB_FILE_HPP
+#define RADIUMENGINE_BLOB_FILE_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Utils/File/MappedFile.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/*
+* Identity of a source file. A file built from the source stays valid while their stamps match.
+* The path, time and size are cheap to get. The content hash reads the whole file: it allows to keep the
+* built file when the source was only touched or copied.
+*/
+struct FileStamp {
+    uint64_t m_path    = 0; // Hash of the path.
+    int64_t  m_time    = 0; // Last modification, in seconds.
+    uint64_t m_size    = 0; // In bytes.
+    uint64_t m_content = 0; // Hash of the content, 0 when not computed.
+};
+
+// FNV-1a hash, 8 bytes at a time. Stable across platforms and runs.
+RA_CORE_API uint64_t hashBytes( const void* data, const std::size_t size, uint64_t hash = 14695981039346656037ull );
+
+// Return false if the file does not exist. The content is hashed only when HASH_CONTENT is true.
+RA_CORE_API bool getFileStamp( const std::string& filename, FileStamp& stamp, const bool HASH_CONTENT );
+
+/*
+* A blob file is a list of contiguous arrays ( sections ), aligned so that they can be used in place
+* once the file is mapped in memory:
+*
+*       HEADER          "RBLB", FORMAT_VERSION, SCALAR_SIZE, VERSION, #sections, STAMP
+*       TABLE           ELEMENT_SIZE COUNT OFFSET
+*                       ...
+*       DATA            each section starts on a 16 bytes boundary
+*
+* VERSION is given by the user of the blob and identifies the list of its sections, STAMP is the FileStamp
+* of the source of the data. The sections are read back in the order they were added.
+*/
+struct BlobHeader {
+    char      m_magic[4];
+    uint32_t  m_formatVersion;
+    uint32_t  m_scalarSize;
+    uint32_t  m_version;
+    uint32_t  m_sectionSize;
+    uint32_t  m_padding;
+    FileStamp m_stamp;
+};
+
+struct BlobSection {
+    uint32_t m_elementSize;
+    uint32_t m_padding;
+    uint64_t m_count;
+    uint64_t m_offset; // From the beginning of the file.
+};
+
+class RA_CORE_API BlobWriter {
+public:
+    /// SECTION
+    // Add an array of count elements of elementSize bytes. The data is not copied and must stay valid until save().
+    void addSection( const void* data, const std::size_t elementSize, const std::size_t count );
+
+    // Same as addSection(), with a copy of the data.
+    void addCopy( const void* data, const std::size_t elementSize, const std::size_t count );
+
+    // The elements are copied bytewise: plain data and fixed size Eigen types.
+    template < typename T >
+    inline void addArray( const T* data, const std::size_t count ) {
+        addSection( data, sizeof( T ), count );
+    }
+
+    template < typename Container >
+    inline void addArray( const Container& array ) { // Contiguous container: std::vector, VectorArray...
+        addArray( array.data(), array.size() );
+    }
+
+    template < typename Container >
+    inline void addArrayCopy( const Container& array ) { // For temporary arrays.
+        addCopy( array.data(), sizeof( typename Container::value_type ), array.size() );
+    }
+
+    template < typename T >
+    inline void addValue( const T& value ) {
+        addCopy( &value, sizeof( T ), 1 );
+    }
+
+    inline void addString( const std::string& text ) {
+        addCopy( text.data(), 1, text.size() );
+    }
+
+    void addStrings( const std::vector< std::string >& list ); // Add two sections: the lengths and the characters.
+
+    /// SIZE
+    inline uint getSectionSize() const {
+        return m_sections.size();
+    }
+
+    /// FILE
+    // Write the blob in a temporary file renamed as filename, so that a reader never sees a partial blob.
+    bool save( const std::string& filename, const FileStamp& stamp, const uint32_t version ) const;
+
+    // Rewrite the stamp of the blob filename in place, e.g. when its source was touched but its content is the same.
+    static bool setStamp( const std::string& filename, const FileStamp& stamp );
+
+    void clear();
+
+private:
+    /// VARIABLE
+    std::vector< BlobSection >         m_sections;
+    std::vector< const char* >         m_data;
+    std::list< std::vector< char > >   m_copies;
+};
+
+class RA_CORE_API BlobReader {
+public:
+    /// CONSTRUCTOR
+    BlobReader();
+
+    /// FILE
+    // Map the file and check its header and table. Return false if it is not a blob of the given version.
+    bool open( const std::string& filename, const uint32_t version );
+    void close();
+
+    /// QUERY
+    inline bool isOpen() const {
+        return m_file.isOpen();
+    }
+
+    inline const FileStamp& getStamp() const {
+        return m_header->m_stamp;
+    }
+
+    inline uint getSectionSize() const {
+        return m_header->m_sectionSize;
+    }
+
+    // True while all the sections read had the expected type.
+    inline bool isValid() const {
+        return m_valid;
+    }
+
+    /// SECTION
+    // Return the next section and its number of elements, nullptr if its elements are not elementSize bytes
+    // or if there are no more sections. The data lives in the mapped file, until close().
+    const void* readSection( const std::size_t elementSize, std::size_t& count );
+
+    template < typename T >
+    inline const T* readArray( std::size_t& count ) {
+        return static_cast< const T* >( readSection( sizeof( T ), count ) );
+    }
+
+    template < typename Container >
+    inline bool readArray( Container& array ) { // Resize the container and copy the section.
+        typedef typename Container::value_type T;
+        std::size_t count = 0;
+        const T* data = readArray< T >( count );
+        array.resize( count );
+        if( count != 0 ) {
+            std::memcpy( static_cast< void* >( &array[0] ), data, count * sizeof( T ) );
+        }
+        return m_valid;
+    }
+
+    template < typename T >
+    inline bool readValue( T& value ) {
+        std::size_t count = 0;
+        const T* data = readArray< T >( count );
+        if( count != 1 ) {
+            m_valid = false;
+            return false;
+        }
+        std::memcpy( static_cast< void* >( &value ), data, sizeof( T ) );
+        return m_valid;
+    }
+
+    inline bool readString( std::string& text ) {
+        std::size_t count = 0;
+        const char* data = readArray< char >( count );
+        text.assign( m_valid ? data : "", m_valid ? count : 0 );
+        return m_valid;
+    }
+
+    bool readStrings( std::vector< std::string >& list );
+
+private:
+    /// VARIABLE
+    MappedFile         m_file;
+    const BlobHeader*  m_header;
+    const BlobSection* m_sections;
+    uint               m_next;
+    bool               m_valid;
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_BLOB_FILE_HPP
@@ -0,0 +1,91 @@
+#include <Core/Utils/File/CORFileManager.hpp>
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+CORFileManager::CORFileManager() : FileManager< KeyedCoR, true >() { }
+
+
+
+/// ===============================================================================
+/// DESTRUCTOR
+/// ===============================================================================
+CORFileManager::~CORFileManager() { }
+
+
+
+/// ===============================================================================
+/// HEADER
+/// ===============================================================================
+std::string CORFileManager::header() const {
+    return "COR1";
+}
+
+
+
+/// ===============================================================================
+/// INTERFACE
+/// ===============================================================================
+std::string CORFileManager::fileExtension() const {
+    return "cor";
+}
+
+
+
+bool CORFileManager::importData( std::ifstream& file, KeyedCoR& data ) {
+    std::string h( header().size(), ' ' );
+    uint32_t scalarSize = 0;
+    uint32_t size       = 0;
+    file.read( &h[0], h.size() );
+    file.read( reinterpret_cast< char* >( &scalarSize ), sizeof( scalarSize ) );
+    file.read( reinterpret_cast< char* >( &data.m_key ), sizeof( data.m_key ) );
+    file.read( reinterpret_cast< char* >( &size ), sizeof( size ) );
+    if( !file || h != header() ) {
+        addLogErrorEntry( "HEADER IS NOT CORRECT." );
+        return false;
+    }
+    if( scalarSize != sizeof( Scalar ) ) {
+        addLogErrorEntry( "SCALAR SIZE DOES NOT MATCH." );
+        return false;
+    }
+    data.m_CoR.resize( size );
+    for( uint i = 0; i < size; ++i ) {
+        Scalar p[3];
+        file.read( reinterpret_cast< char* >( p ), sizeof( p ) );
+        data.m_CoR[i] = Vector3( p[0], p[1], p[2] );
+    }
+    if( !file ) {
+        addLogErrorEntry( "FILE IS TRUNCATED." );
+        data.m_CoR.clear();
+        return false;
+    }
+    return true;
+}
+
+
+
+bool CORFileManager::exportData( std::ofstream& file, const KeyedCoR& data ) {
+    const uint32_t scalarSize = sizeof( Scalar );
+    const uint32_t size       = data.m_CoR.size();
+    file.write( header().c_str(), header().size() );
+    file.write( reinterpret_cast< const char* >( &scalarSize ), sizeof( scalarSize ) );
+    file.write( reinterpret_cast< const char* >( &data.m_key ), sizeof( data.m_key ) );
+    file.write( reinterpret_cast< const char* >( &size ), sizeof( size ) );
+    for( uint i = 0; i < size; ++i ) {
+        const Scalar p[3] = { data.m_CoR[i].x(), data.m_CoR[i].y(), data.m_CoR[i].z() };
+        file.write( reinterpret_cast< const char* >( p ), sizeof( p ) );
+    }
+    if( !file ) {
+        addLogErrorEntry( "WRITE FAILED." );
+        return false;
+    }
+    return true;
+}
+
+
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,52 @@
+#ifndef RADIUMENGINE_COR_FILE_MANAGER_HPP
+#define RADIUMENGINE_COR_FILE_MANAGER_HPP
+
+#include <cstdint>
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Utils/File/FileManager.hpp>
+
+namespace Ra {
+namespace Core {
+
+/*
+* Centers of rotation, along with the key identifying the skinning data they were computed from.
+*/
+struct KeyedCoR {
+    uint64_t     m_key;
+    Vector3Array m_CoR;
+};
+
+/*
+* The class CORFileManager handles the loading/storing of centers of rotation in a binary file:
+*
+*       HEADER SCALAR_SIZE KEY #rows
+*       X Y Z
+*       ...
+*       X Y Z
+*
+* where HEADER is equal to the 4 characters "COR1", SCALAR_SIZE is the size of a Scalar as a uint32,
+* KEY is a uint64 and #rows a uint32. The coordinates are stored as raw Scalars.
+*/
+class CORFileManager : public FileManager< KeyedCoR, true > {
+public:
+    /// CONSTRUCTOR
+    CORFileManager();
+
+    /// DESTRUCTOR
+    virtual ~CORFileManager();
+
+protected:
+    /// HEADER
+    std::string header() const;
+
+    /// INTERFACE
+    virtual std::string fileExtension() const override;
+    virtual bool importData( std::ifstream& file, KeyedCoR& data ) override;
+    virtual bool exportData( std::ofstream& file, const KeyedCoR& data ) override;
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_COR_FILE_MANAGER_HPP
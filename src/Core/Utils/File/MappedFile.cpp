@@ -0,0 +1,115 @@
+#include <Core/Utils/File/MappedFile.hpp>
+
+#ifdef OS_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+#ifdef OS_WINDOWS
+MappedFile::MappedFile() : m_data( nullptr ), m_size( 0 ), m_file( nullptr ), m_mapping( nullptr ) { }
+#else
+MappedFile::MappedFile() : m_data( nullptr ), m_size( 0 ) { }
+#endif
+
+
+
+/// ===============================================================================
+/// DESTRUCTOR
+/// ===============================================================================
+MappedFile::~MappedFile() {
+    close();
+}
+
+
+
+/// ===============================================================================
+/// FILE
+/// ===============================================================================
+#ifdef OS_WINDOWS
+bool MappedFile::open( const std::string& filename ) {
+    close();
+    HANDLE file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr );
+    if( file == INVALID_HANDLE_VALUE ) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if( !GetFileSizeEx( file, &size ) || size.QuadPart == 0 ) {
+        CloseHandle( file );
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( mapping == nullptr ) {
+        CloseHandle( file );
+        return false;
+    }
+    const void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    if( data == nullptr ) {
+        CloseHandle( mapping );
+        CloseHandle( file );
+        return false;
+    }
+    m_data    = static_cast< const char* >( data );
+    m_size    = static_cast< std::size_t >( size.QuadPart );
+    m_file    = file;
+    m_mapping = mapping;
+    return true;
+}
+
+void MappedFile::close() {
+    if( m_data != nullptr ) {
+        UnmapViewOfFile( m_data );
+        CloseHandle( m_mapping );
+        CloseHandle( m_file );
+    }
+    m_data    = nullptr;
+    m_size    = 0;
+    m_file    = nullptr;
+    m_mapping = nullptr;
+}
+#else
+bool MappedFile::open( const std::string& filename ) {
+    close();
+    const int file = ::open( filename.c_str(), O_RDONLY );
+    if( file < 0 ) {
+        return false;
+    }
+    struct stat info;
+    if( fstat( file, &info ) != 0 || info.st_size == 0 ) {
+        ::close( file );
+        return false;
+    }
+    void* data = mmap( nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+    // The mapping keeps its own reference to the file.
+    ::close( file );
+    if( data == MAP_FAILED ) {
+        return false;
+    }
+    m_data = static_cast< const char* >( data );
+    m_size = static_cast< std::size_t >( info.st_size );
+    return true;
+}
+
+void MappedFile::close() {
+    if( m_data != nullptr ) {
+        munmap( const_cast< char* >( m_data ), m_size );
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
+
+
+
+} // namespace Core
+} // namespace Ra
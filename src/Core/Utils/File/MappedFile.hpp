@@ -0,0 +1,57 @@
+#ifndef RADIUMENGINE_MAPPED_FILE_HPP
+#define RADIUMENGINE_MAPPED_FILE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace Ra {
+namespace Core {
+
+/*
+* The class MappedFile maps a whole file in memory, read only.
+* Nothing is read by open(): the pages are loaded by the system when they are first accessed,
+* and they are shared with the file cache of the system.
+*/
+class RA_CORE_API MappedFile {
+public:
+    /// CONSTRUCTOR
+    MappedFile();
+    MappedFile( const MappedFile& file ) = delete;
+    MappedFile& operator=( const MappedFile& file ) = delete;
+
+    /// DESTRUCTOR
+    ~MappedFile();
+
+    /// FILE
+    bool open( const std::string& filename ); // Return false if the file does not exist, is empty or cannot be mapped.
+    void close();
+
+    /// QUERY
+    inline bool isOpen() const {
+        return ( m_data != nullptr );
+    }
+
+    inline const char* data() const {
+        return m_data;
+    }
+
+    inline std::size_t size() const {
+        return m_size;
+    }
+
+private:
+    /// VARIABLE
+    const char* m_data;
+    std::size_t m_size;
+#ifdef OS_WINDOWS
+    void*       m_file;    // HANDLE of the file.
+    void*       m_mapping; // HANDLE of the file mapping.
+#endif
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_MAPPED_FILE_HPP
@@ -5,9 +5,10 @@ namespace Core {
 namespace Graph {
 
     /// CONSTRUCTOR
-    AdjacencyList::AdjacencyList() : m_child(), m_parent() { }
-    AdjacencyList::AdjacencyList( const uint n ) : m_child( n ), m_parent( n, -1 ) { }
-    AdjacencyList::AdjacencyList( const AdjacencyList& adj ) : m_child( adj.m_child ), m_parent( adj.m_parent ) { }
+    AdjacencyList::AdjacencyList() : m_child(), m_parent(), m_level(), m_version( 0 ) { }
+    AdjacencyList::AdjacencyList( const uint n ) : m_child( n ), m_parent( n, -1 ), m_level( n, 0 ), m_version( 0 ) { }
+    AdjacencyList::AdjacencyList( const AdjacencyList& adj ) :
+        m_child( adj.m_child ), m_parent( adj.m_parent ), m_level( adj.m_level ), m_version( adj.m_version ) { }
 
     /// DESTRUCTOR
     AdjacencyList::~AdjacencyList() { }
@@ -34,6 +34,7 @@ public:
     // NODE
     //////////////////////////////////////////////////////////////////////////////
     inline uint addNode( const int parent); // Return the index of the added leaf. Use -1 to create the root node.
+    inline void setParent( const uint i, const int parent ); // Move the node i and its subtree under parent. Use -1 to make it a root node.
     inline void pruneLeaves( std::vector<uint>& pruned, std::vector<bool>& delete_flag ); // Prune the leaves of the graph and returns the changes.
     inline void pruneLeaves(); // Prune the leaves of the graph.
 
@@ -53,6 +54,12 @@ public:
     inline bool isJoint( const uint i ) const;              // Return true if the node is a joint node. ( |child| == 1 )
     inline bool isEdge( const uint i, const uint j ) const; // Return true if the edge { i, j } exists.
 
+    //////////////////////////////////////////////////////////////////////////////
+    // VERSION
+    //////////////////////////////////////////////////////////////////////////////
+    inline uint getVersion() const; // Changed by every edit of the graph, e.g. to rebuild data derived from it.
+    inline void touch();            // Change the version. Call it after editing the variables directly.
+
 
     //////////////////////////////////////////////////////////////////////////////
     // VARIABLE
@@ -60,6 +67,9 @@ public:
     Adjacency    m_child;  // Adjacency matrix
     ParentList   m_parent; // Parents ids vector
     LevelList    m_level;
+
+private:
+    uint         m_version;
 };
 
 } // namespace GraphicsEntity
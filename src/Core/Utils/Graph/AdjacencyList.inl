@@ -1,5 +1,6 @@
 #include <Core/Utils/Graph/AdjacencyList.hpp>
 
+#include <algorithm>
 #include <set>
 
 namespace Ra {
@@ -19,10 +20,35 @@ namespace Graph {
             m_level.push_back( 0 );
         }
         m_parent.push_back( parent ); // Set new node parent
+        touch();
         return idx;
     }
 
 
+    inline void AdjacencyList::setParent( const uint i, const int parent ) {
+        CORE_ASSERT( ( i < size() ) && ( parent < int( size() ) ), "Index out of bounds" );
+        ON_DEBUG( for( int p = parent; p >= 0; p = m_parent[p] ) { CORE_ASSERT( uint( p ) != i, "Cycle in the graph" ); } )
+        if( m_parent[i] >= 0 ) {
+            ChildrenList& siblings = m_child[m_parent[i]];
+            siblings.erase( std::find( siblings.begin(), siblings.end(), i ) );
+        }
+        if( parent >= 0 ) {
+            m_child[parent].push_back( i );
+        }
+        m_parent[i] = parent;
+        if( m_level.size() == size() ) {
+            std::vector< uint > stack( 1, i );
+            while( !stack.empty() ) {
+                const uint node = stack.back();
+                stack.pop_back();
+                m_level[node] = isRoot( node ) ? 0 : m_level[m_parent[node]] + 1;
+                stack.insert( stack.end(), m_child[node].begin(), m_child[node].end() );
+            }
+        }
+        touch();
+    }
+
+
     inline void AdjacencyList::pruneLeaves( std::vector<uint>& pruned, std::vector<bool>& delete_flag ) {
         pruned.clear();
         delete_flag.clear();
@@ -58,6 +84,7 @@ namespace Graph {
                 }
             }
         }
+        touch();
     }
 
 
@@ -77,6 +104,8 @@ namespace Graph {
     inline void AdjacencyList::clear() {
         m_child.clear();
         m_parent.clear();
+        m_level.clear();
+        touch();
     }
 
     /// QUERY
@@ -113,6 +142,15 @@ namespace Graph {
         return false;
     }
 
+    /// VERSION
+    inline uint AdjacencyList::getVersion() const {
+        return m_version;
+    }
+
+    inline void AdjacencyList::touch() {
+        ++m_version;
+    }
+
 } // namespace GraphicsEntity
 } // namespace Core
 } // namespace Ra
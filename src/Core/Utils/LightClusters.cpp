@@ -0,0 +1,222 @@
+#include <Core/Utils/LightClusters.hpp>
+
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// LIGHT
+/// ===============================================================================
+Scalar LightClusters::getRange( const Scalar intensity, const Scalar constant, const Scalar linear,
+                                const Scalar quadratic, const Scalar threshold ) {
+    // Solve constant + linear * d + quadratic * d^2 = intensity / threshold.
+    const Scalar k = intensity / threshold - constant;
+    if( k <= 0 ) {
+        return 0;
+    }
+    if( quadratic > 0 ) {
+        return ( std::sqrt( linear * linear + 4 * quadratic * k ) - linear ) / ( 2 * quadratic );
+    }
+    if( linear > 0 ) {
+        return k / linear;
+    }
+    return std::numeric_limits< Scalar >::max();
+}
+
+
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+LightClusters::LightClusters( const uint tileX, const uint tileY, const uint sliceZ ) :
+    m_tileX( tileX ),
+    m_tileY( tileY ),
+    m_sliceZ( sliceZ ),
+    m_tanX( 1.0 ),
+    m_tanY( 1.0 ),
+    m_near( 0.1 ),
+    m_far( 1000.0 ),
+    m_sliceScale( 0.0 ),
+    m_grid( 2 * tileX * tileY * sliceZ, 0 ),
+    m_indices(),
+    m_sliceIndices( sliceZ ),
+    m_sliceGrid( sliceZ ) {
+    CORE_ASSERT( tileX > 0 && tileY > 0 && sliceZ > 0, "Empty cluster grid" );
+    setFrustum( m_tanX, m_tanY, m_near, m_far );
+}
+
+
+
+/// ===============================================================================
+/// FRUSTUM
+/// ===============================================================================
+void LightClusters::setFrustum( const Scalar tanHalfFovX, const Scalar tanHalfFovY,
+                                const Scalar zNear, const Scalar zFar ) {
+    CORE_ASSERT( tanHalfFovX > 0 && tanHalfFovY > 0 && zNear > 0 && zFar > zNear, "Invalid frustum" );
+    m_tanX       = tanHalfFovX;
+    m_tanY       = tanHalfFovY;
+    m_near       = zNear;
+    m_far        = zFar;
+    m_sliceScale = Scalar( m_sliceZ ) / std::log( zFar / zNear );
+}
+
+void LightClusters::setProjection( const Matrix4& projection ) {
+    const Scalar a = projection( 2, 2 );
+    const Scalar b = projection( 2, 3 );
+    setFrustum( 1 / projection( 0, 0 ), 1 / projection( 1, 1 ), b / ( a - 1 ), b / ( a + 1 ) );
+}
+
+
+
+/// ===============================================================================
+/// CLUSTER
+/// ===============================================================================
+uint LightClusters::getSlice( const Scalar depth ) const {
+    const Scalar s = std::log( std::max( depth, m_near ) / m_near ) * m_sliceScale;
+    return std::min( uint( std::max( s, Scalar( 0 ) ) ), m_sliceZ - 1 );
+}
+
+int LightClusters::getCluster( const Vector3& point ) const {
+    const Scalar depth = -point[2];
+    if( depth < m_near || depth > m_far ) {
+        return -1;
+    }
+    const Scalar x = point[0] / ( depth * m_tanX );
+    const Scalar y = point[1] / ( depth * m_tanY );
+    if( std::abs( x ) > 1 || std::abs( y ) > 1 ) {
+        return -1;
+    }
+    const uint i = std::min( uint( ( x + 1 ) / 2 * m_tileX ), m_tileX - 1 );
+    const uint j = std::min( uint( ( y + 1 ) / 2 * m_tileY ), m_tileY - 1 );
+    return getCluster( i, j, getSlice( depth ) );
+}
+
+Aabb LightClusters::getClusterAabb( const uint x, const uint y, const uint z ) const {
+    const Scalar zn = m_near * std::exp( Scalar( z ) / m_sliceScale );
+    const Scalar zf = m_near * std::exp( Scalar( z + 1 ) / m_sliceScale );
+    const Scalar x0 = ( Scalar( 2 * x ) / m_tileX - 1 ) * m_tanX;
+    const Scalar x1 = ( Scalar( 2 * x + 2 ) / m_tileX - 1 ) * m_tanX;
+    const Scalar y0 = ( Scalar( 2 * y ) / m_tileY - 1 ) * m_tanY;
+    const Scalar y1 = ( Scalar( 2 * y + 2 ) / m_tileY - 1 ) * m_tanY;
+    // The sides of a cluster are planes through the eye, its extremes are at the near or far depth.
+    return Aabb( Vector3( std::min( x0 * zn, x0 * zf ), std::min( y0 * zn, y0 * zf ), -zf ),
+                 Vector3( std::max( x1 * zn, x1 * zf ), std::max( y1 * zn, y1 * zf ), -zn ) );
+}
+
+
+
+/// ===============================================================================
+/// BINNING
+/// ===============================================================================
+void LightClusters::build( const std::vector< Light >& lights ) {
+    const uint n    = lights.size();
+    const uint tile = m_tileX * m_tileY;
+
+    // Depth range of each light, as slices. Lights outside the depth range get an empty range.
+    std::vector< uint > sliceBegin( n, 0 );
+    std::vector< uint > sliceEnd( n, 0 );
+    for( uint l = 0; l < n; ++l ) {
+        const Scalar depth = -lights[l].m_center[2];
+        const Scalar r     = lights[l].m_radius;
+        if( r <= 0 || depth + r < m_near || depth - r > m_far ) {
+            continue;
+        }
+        sliceBegin[l] = getSlice( depth - r );
+        sliceEnd[l]   = getSlice( depth + r ) + 1;
+    }
+
+    // Each slice is binned independently : the lights crossing the slice are tested against the clusters of the
+    // tiles covered by their bounding box, then counted and listed per cluster.
+    parallelFor( 0, m_sliceZ, 1, [&]( const uint begin, const uint end ) {
+        std::vector< uint > cluster;
+        std::vector< uint > light;
+        std::vector< uint > cursor;
+        for( uint z = begin; z < end; ++z ) {
+            const Scalar zn = m_near * std::exp( Scalar( z ) / m_sliceScale );
+            const Scalar zf = m_near * std::exp( Scalar( z + 1 ) / m_sliceScale );
+            cluster.clear();
+            light.clear();
+            for( uint l = 0; l < n; ++l ) {
+                if( z < sliceBegin[l] || z >= sliceEnd[l] ) {
+                    continue;
+                }
+                const Vector3& c     = lights[l].m_center;
+                const Scalar   r     = lights[l].m_radius;
+                const Scalar   depth = -c[2];
+                const Scalar   za    = std::max( depth - r, zn );
+                const Scalar   zb    = std::min( depth + r, zf );
+                // Screen extent of the box of the sphere, over the depths of the slice.
+                const Scalar x0 = std::min( ( c[0] - r ) / za, ( c[0] - r ) / zb ) / m_tanX;
+                const Scalar x1 = std::max( ( c[0] + r ) / za, ( c[0] + r ) / zb ) / m_tanX;
+                const Scalar y0 = std::min( ( c[1] - r ) / za, ( c[1] - r ) / zb ) / m_tanY;
+                const Scalar y1 = std::max( ( c[1] + r ) / za, ( c[1] + r ) / zb ) / m_tanY;
+                if( x1 < -1 || x0 > 1 || y1 < -1 || y0 > 1 ) {
+                    continue;
+                }
+                const uint i0 = uint( std::max( ( x0 + 1 ) / 2 * m_tileX, Scalar( 0 ) ) );
+                const uint i1 = std::min( uint( ( x1 + 1 ) / 2 * m_tileX ), m_tileX - 1 );
+                const uint j0 = uint( std::max( ( y0 + 1 ) / 2 * m_tileY, Scalar( 0 ) ) );
+                const uint j1 = std::min( uint( ( y1 + 1 ) / 2 * m_tileY ), m_tileY - 1 );
+                for( uint j = j0; j <= j1; ++j ) {
+                    for( uint i = i0; i <= i1; ++i ) {
+                        const Aabb box = getClusterAabb( i, j, z );
+                        if( box.squaredExteriorDistance( c ) <= r * r ) {
+                            cluster.push_back( i + m_tileX * j );
+                            light.push_back( l );
+                        }
+                    }
+                }
+            }
+
+            // Counting sort by cluster, which keeps the lights of a cluster in increasing order.
+            std::vector< uint >& grid    = m_sliceGrid[z];
+            std::vector< uint >& indices = m_sliceIndices[z];
+            grid.assign( 2 * tile, 0 );
+            for( const uint k : cluster ) {
+                ++grid[2 * k + 1];
+            }
+            uint offset = 0;
+            for( uint k = 0; k < tile; ++k ) {
+                grid[2 * k] = offset;
+                offset     += grid[2 * k + 1];
+            }
+            indices.resize( offset );
+            cursor.resize( tile );
+            for( uint k = 0; k < tile; ++k ) {
+                cursor[k] = grid[2 * k];
+            }
+            for( uint e = 0; e < cluster.size(); ++e ) {
+                indices[cursor[cluster[e]]++] = light[e];
+            }
+        }
+    } );
+
+    // Concatenation of the slices.
+    uint total = 0;
+    for( uint z = 0; z < m_sliceZ; ++z ) {
+        total += m_sliceIndices[z].size();
+    }
+    m_indices.resize( total );
+    m_grid.resize( 2 * getClusterSize() );
+    uint offset = 0;
+    for( uint z = 0; z < m_sliceZ; ++z ) {
+        const std::vector< uint >& grid    = m_sliceGrid[z];
+        const std::vector< uint >& indices = m_sliceIndices[z];
+        for( uint k = 0; k < tile; ++k ) {
+            m_grid[2 * ( k + tile * z )]     = offset + grid[2 * k];
+            m_grid[2 * ( k + tile * z ) + 1] = grid[2 * k + 1];
+        }
+        std::copy( indices.begin(), indices.end(), m_indices.begin() + offset );
+        offset += indices.size();
+    }
+}
+
+
+
+} // namespace Core
+} // namespace Ra
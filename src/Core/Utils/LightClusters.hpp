@@ -0,0 +1,134 @@
+#ifndef RADIUMENGINE_LIGHT_CLUSTERS_HPP
+#define RADIUMENGINE_LIGHT_CLUSTERS_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/*
+* The class LightClusters assigns lights to the clusters ( froxels ) of a view frustum, so that a fragment only
+* shades the lights of its cluster. The frustum is split in TILE_X x TILE_Y tiles on the screen, and in SLICE_Z
+* slices along the view direction whose depths grow exponentially from the near to the far plane :
+*
+*       slice( depth ) = floor( log( depth / near ) * SLICE_Z / log( far / near ) )
+*
+* The lights are spheres in view space ( the camera looks along -z ). A light is listed in a cluster if the screen
+* extent of its sphere over the depths of the slice covers the tile, and if its sphere intersects the bounding box
+* of the cluster, so the lists are conservative.
+*
+* The result is a grid of ( offset, count ) pairs, one per cluster ( cluster = x + TILE_X * ( y + TILE_Y * z ) ),
+* into a compact list of light indices, ready to be uploaded to the GPU. The slices are binned in parallel
+* ( see parallelFor() ), the lights of a cluster are listed in increasing order.
+*/
+class RA_CORE_API LightClusters {
+public:
+    /// LIGHT
+    struct Light {
+        Vector3 m_center;   // View space.
+        Scalar  m_radius;   // Distance beyond which the light is neglected.
+    };
+
+    // Distance at which an intensity attenuated by 1 / ( constant + linear * d + quadratic * d^2 ) falls below
+    // threshold, the largest Scalar if it never does ( a sentinel callers may compare with == ).
+    static Scalar getRange( const Scalar intensity, const Scalar constant, const Scalar linear, const Scalar quadratic,
+                            const Scalar threshold );
+
+    /// CONSTRUCTOR
+    LightClusters( const uint tileX = 16, const uint tileY = 9, const uint sliceZ = 24 );
+
+    /// FRUSTUM
+    // Symmetric perspective frustum : tangents of the half field of view, near and far distances.
+    void setFrustum( const Scalar tanHalfFovX, const Scalar tanHalfFovY, const Scalar zNear, const Scalar zFar );
+
+    // Same as setFrustum(), from a symmetric perspective projection matrix.
+    void setProjection( const Matrix4& projection );
+
+    inline Scalar getNear() const {
+        return m_near;
+    }
+
+    inline Scalar getFar() const {
+        return m_far;
+    }
+
+    // Factor of the logarithm of the depth in the slice formula.
+    inline Scalar getSliceScale() const {
+        return m_sliceScale;
+    }
+
+    /// BINNING
+    void build( const std::vector< Light >& lights );
+
+    /// CLUSTER
+    inline uint getTileX() const {
+        return m_tileX;
+    }
+
+    inline uint getTileY() const {
+        return m_tileY;
+    }
+
+    inline uint getSliceZ() const {
+        return m_sliceZ;
+    }
+
+    inline uint getClusterSize() const {
+        return m_tileX * m_tileY * m_sliceZ;
+    }
+
+    inline uint getCluster( const uint x, const uint y, const uint z ) const {
+        return x + m_tileX * ( y + m_tileY * z );
+    }
+
+    // Slice of a depth in [near, far].
+    uint getSlice( const Scalar depth ) const;
+
+    // Cluster of a view space point, -1 if it is outside the frustum.
+    int getCluster( const Vector3& point ) const;
+
+    // View space bounding box of a cluster.
+    Aabb getClusterAabb( const uint x, const uint y, const uint z ) const;
+
+    /// LIGHT LIST
+    // Offset in getIndices() and number of lights of each cluster.
+    inline const std::vector< uint >& getGrid() const {
+        return m_grid;
+    }
+
+    inline const std::vector< uint >& getIndices() const {
+        return m_indices;
+    }
+
+    inline uint getLightSize( const uint cluster ) const {
+        return m_grid[2 * cluster + 1];
+    }
+
+    inline const uint* getLights( const uint cluster ) const {
+        return m_indices.data() + m_grid[2 * cluster];
+    }
+
+private:
+    /// VARIABLE
+    uint   m_tileX;
+    uint   m_tileY;
+    uint   m_sliceZ;
+    Scalar m_tanX;
+    Scalar m_tanY;
+    Scalar m_near;
+    Scalar m_far;
+    Scalar m_sliceScale;
+
+    std::vector< uint >                  m_grid;
+    std::vector< uint >                  m_indices;
+    std::vector< std::vector< uint > >   m_sliceIndices;    // Lights of the clusters of each slice.
+    std::vector< std::vector< uint > >   m_sliceGrid;       // Offset and count of the clusters of each slice.
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_LIGHT_CLUSTERS_HPP
@@ -0,0 +1,220 @@
+#include <Core/Utils/UniformTable.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ra {
+namespace Core {
+
+namespace {
+// Length of the name without a final "[0]" : "a[0]" and "a" are the same uniform.
+inline std::size_t canonicalLength( const char* name, std::size_t length ) {
+    if( length > 3 && std::strcmp( name + length - 3, "[0]" ) == 0 ) {
+        length -= 3;
+    }
+    return length;
+}
+
+inline uint64_t hashName( const char* name, const std::size_t length ) {
+    uint64_t hash = 14695981039346656037ull;
+    for( std::size_t i = 0; i < length; ++i ) {
+        hash = ( hash ^ static_cast< unsigned char >( name[i] ) ) * 1099511628211ull;
+    }
+    return hash;
+}
+}
+
+
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+UniformTable::UniformTable( const UniformFunctions& functions ) :
+    m_functions( functions ),
+    m_program( 0 ),
+    m_uniform(),
+    m_attribute(),
+    m_uniformTable(),
+    m_attributeTable(),
+    m_value() { }
+
+
+
+/// ===============================================================================
+/// REFLECTION
+/// ===============================================================================
+void UniformTable::reflect( const uint program ) {
+    m_program = program;
+    m_value.clear();
+    for( auto& uniform : m_uniform ) {
+        uniform.m_location = -1;
+        uniform.m_set      = false;
+        uniform.m_offset   = 0;
+        uniform.m_bytes    = 0;
+        uniform.m_capacity = 0;
+    }
+
+    // Active uniforms, keeping the handles of the names already known.
+    std::vector< bool > listed( m_uniform.size(), false );
+    std::string name;
+    int location;
+    const uint uniformSize = m_functions.m_activeUniformSize( program );
+    for( uint i = 0; i < uniformSize; ++i ) {
+        m_functions.m_activeUniform( program, i, name, location );
+        const std::size_t length = canonicalLength( name.c_str(), name.size() );
+        const uint64_t    hash   = hashName( name.c_str(), length );
+        int index = find( m_uniformTable, name.c_str(), length, hash );
+        if( index < 0 ) {
+            index = m_uniform.size();
+            m_uniform.push_back( Uniform { -1, false, UniformType_INT, 0, 0, 0 } );
+            listed.push_back( false );
+            insert( m_uniformTable, name.c_str(), length, hash, index );
+        }
+        m_uniform[index].m_location = location;
+        listed[index] = true;
+    }
+
+    // The other names were set by the user : query them again.
+    for( uint i = 0; i < m_uniformTable.m_index.size(); ++i ) {
+        const int index = m_uniformTable.m_index[i];
+        if( index >= 0 && !listed[index] ) {
+            m_uniform[index].m_location = m_functions.m_uniformLocation( program, m_uniformTable.m_name[i].c_str() );
+        }
+    }
+
+    // Active attributes.
+    m_attribute.clear();
+    clear( m_attributeTable );
+    const uint attributeSize = m_functions.m_activeAttributeSize( program );
+    for( uint i = 0; i < attributeSize; ++i ) {
+        m_functions.m_activeAttribute( program, i, name, location );
+        const std::size_t length = canonicalLength( name.c_str(), name.size() );
+        const uint64_t    hash   = hashName( name.c_str(), length );
+        if( find( m_attributeTable, name.c_str(), length, hash ) < 0 ) {
+            insert( m_attributeTable, name.c_str(), length, hash, m_attribute.size() );
+            m_attribute.push_back( location );
+        }
+    }
+}
+
+
+
+/// ===============================================================================
+/// UNIFORM
+/// ===============================================================================
+UniformHandle UniformTable::getUniform( const char* name ) {
+    const std::size_t length = canonicalLength( name, std::strlen( name ) );
+    const uint64_t    hash   = hashName( name, length );
+    UniformHandle handle;
+    handle.m_index = find( m_uniformTable, name, length, hash );
+    if( handle.m_index < 0 ) {
+        int location = -1;
+        if( m_program != 0 ) {
+            location = m_functions.m_uniformLocation( m_program, std::string( name, length ).c_str() );
+        }
+        handle.m_index = m_uniform.size();
+        m_uniform.push_back( Uniform { location, false, UniformType_INT, 0, 0, 0 } );
+        insert( m_uniformTable, name, length, hash, handle.m_index );
+    }
+    return handle;
+}
+
+int UniformTable::getLocation( const UniformHandle& handle ) const {
+    CORE_ASSERT( uint( handle.m_index ) < m_uniform.size(), "Handle is not from this table" );
+    return m_uniform[handle.m_index].m_location;
+}
+
+bool UniformTable::set( const UniformHandle& handle, const UniformType type, const void* data, const uint bytes,
+                        const int count ) {
+    CORE_ASSERT( uint( handle.m_index ) < m_uniform.size(), "Handle is not from this table" );
+    Uniform& uniform = m_uniform[handle.m_index];
+    if( uniform.m_location < 0 ) {
+        return false;
+    }
+    if( uniform.m_set && uniform.m_type == type && uniform.m_bytes == bytes &&
+        std::memcmp( m_value.data() + uniform.m_offset, data, bytes ) == 0 ) {
+        return false;
+    }
+    if( bytes > uniform.m_capacity ) {
+        uniform.m_offset   = m_value.size();
+        uniform.m_capacity = bytes;
+        m_value.resize( m_value.size() + bytes );
+    }
+    if( bytes != 0 ) {
+        std::memcpy( m_value.data() + uniform.m_offset, data, bytes );
+    }
+    uniform.m_set   = true;
+    uniform.m_type  = type;
+    uniform.m_bytes = bytes;
+    m_functions.m_upload( uniform.m_location, type, count, data );
+    return true;
+}
+
+
+
+/// ===============================================================================
+/// ATTRIBUTE
+/// ===============================================================================
+int UniformTable::getAttributeLocation( const char* name ) const {
+    const std::size_t length = canonicalLength( name, std::strlen( name ) );
+    const int index = find( m_attributeTable, name, length, hashName( name, length ) );
+    return ( index < 0 ) ? -1 : m_attribute[index];
+}
+
+
+
+/// ===============================================================================
+/// NAME TABLE
+/// ===============================================================================
+int UniformTable::find( const NameTable& table, const char* name, const std::size_t length, const uint64_t hash ) {
+    if( table.m_size == 0 ) {
+        return -1;
+    }
+    const std::size_t mask = table.m_index.size() - 1;
+    for( std::size_t i = hash & mask; table.m_index[i] >= 0; i = ( i + 1 ) & mask ) {
+        if( table.m_hash[i] == hash && table.m_name[i].size() == length &&
+            std::memcmp( table.m_name[i].data(), name, length ) == 0 ) {
+            return table.m_index[i];
+        }
+    }
+    return -1;
+}
+
+void UniformTable::insert( NameTable& table, const char* name, const std::size_t length, const uint64_t hash,
+                           const int index ) {
+    // Keep the table at most half full.
+    if( 2 * ( table.m_size + 1 ) > table.m_index.size() ) {
+        NameTable grown;
+        const std::size_t size = std::max< std::size_t >( 16, 2 * table.m_index.size() );
+        grown.m_name.resize( size );
+        grown.m_hash.resize( size, 0 );
+        grown.m_index.resize( size, -1 );
+        for( uint i = 0; i < table.m_index.size(); ++i ) {
+            if( table.m_index[i] >= 0 ) {
+                insert( grown, table.m_name[i].data(), table.m_name[i].size(), table.m_hash[i], table.m_index[i] );
+            }
+        }
+        std::swap( table, grown );
+    }
+    const std::size_t mask = table.m_index.size() - 1;
+    std::size_t i = hash & mask;
+    while( table.m_index[i] >= 0 ) {
+        i = ( i + 1 ) & mask;
+    }
+    table.m_name[i].assign( name, length );
+    table.m_hash[i]  = hash;
+    table.m_index[i] = index;
+    ++table.m_size;
+}
+
+void UniformTable::clear( NameTable& table ) {
+    table.m_name.clear();
+    table.m_hash.clear();
+    table.m_index.clear();
+    table.m_size = 0;
+}
+
+
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,126 @@
+#ifndef RADIUMENGINE_UNIFORM_TABLE_HPP
+#define RADIUMENGINE_UNIFORM_TABLE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/// Types of the values uploaded to a uniform.
+enum UniformType : uint {
+    UniformType_INT = 0,
+    UniformType_UINT,
+    UniformType_FLOAT,
+    UniformType_VEC2,
+    UniformType_VEC3,
+    UniformType_VEC4,
+    UniformType_MAT2,
+    UniformType_MAT3,
+    UniformType_MAT4,
+    UniformType_COUNT
+};
+
+/// A uniform of a UniformTable. Handles stay valid for the lifetime of the table, even when the program is relinked.
+struct UniformHandle {
+    int m_index = -1;
+
+    inline bool isValid() const {
+        return ( m_index >= 0 );
+    }
+};
+
+/*
+* The functions of the graphics API used by a UniformTable : the OpenGL ones in a ShaderProgram, a mock in the tests.
+*/
+struct UniformFunctions {
+    uint ( *m_activeUniformSize )( uint program );                                          // Number of active uniforms.
+    void ( *m_activeUniform )( uint program, uint i, std::string& name, int& location );    // Name and location of the i-th one.
+    int  ( *m_uniformLocation )( uint program, const char* name );                          // -1 if the uniform is not active.
+    uint ( *m_activeAttributeSize )( uint program );
+    void ( *m_activeAttribute )( uint program, uint i, std::string& name, int& location );
+    void ( *m_upload )( int location, UniformType type, int count, const void* data );      // Upload to the program in use.
+};
+
+/*
+* The class UniformTable stores the uniforms and attributes of a shader program, reflected once after each link, in
+* a hash table of their names. It also keeps the last value uploaded to each uniform, and skips the uploads of the
+* same value : the values of a program are kept by the API while it is not relinked, even when another program is used.
+* Uniforms must then only be set through the table.
+*
+* Uniform arrays are listed by the API as "name[0]" and are found with and without the suffix. Names which are not
+* listed ( e.g. "name[2]" ) are queried once, and remembered even if they are not active.
+*/
+class RA_CORE_API UniformTable {
+public:
+    /// CONSTRUCTOR
+    explicit UniformTable( const UniformFunctions& functions );
+
+    /// REFLECTION
+    // Read the active uniforms and attributes of the program, once linked. The values set are forgotten.
+    void reflect( const uint program );
+
+    /// UNIFORM
+    // Return the handle of the uniform, a valid one even if the uniform is not active.
+    UniformHandle getUniform( const char* name );
+
+    // -1 if the uniform is not active.
+    int getLocation( const UniformHandle& handle ) const;
+
+    inline uint getUniformSize() const {
+        return m_uniform.size();
+    }
+
+    // Upload count values of the given type, of bytes bytes in total. Return false if the upload was skipped,
+    // because the uniform is not active or already has this value.
+    bool set( const UniformHandle& handle, const UniformType type, const void* data, const uint bytes, const int count );
+
+    template < typename T >
+    inline bool set( const UniformHandle& handle, const UniformType type, const T& value ) {
+        return set( handle, type, &value, sizeof( T ), 1 );
+    }
+
+    /// ATTRIBUTE
+    // -1 if the attribute is not active.
+    int getAttributeLocation( const char* name ) const;
+
+private:
+    /// NAME TABLE
+    // Open addressing hash table of names, mapping to indices in a list of entries.
+    struct NameTable {
+        std::vector< std::string > m_name;
+        std::vector< uint64_t >    m_hash;
+        std::vector< int >         m_index;    // -1 for empty buckets.
+        uint                       m_size = 0;
+    };
+
+    static int  find( const NameTable& table, const char* name, const std::size_t length, const uint64_t hash );
+    static void insert( NameTable& table, const char* name, const std::size_t length, const uint64_t hash,
+                        const int index );
+    static void clear( NameTable& table );
+
+    /// VARIABLE
+    struct Uniform {
+        int         m_location;
+        bool        m_set;      // If m_value holds the last uploaded value.
+        UniformType m_type;
+        uint        m_offset;   // In m_value.
+        uint        m_bytes;
+        uint        m_capacity;
+    };
+
+    UniformFunctions         m_functions;
+    uint                     m_program;
+    std::vector< Uniform >   m_uniform;
+    std::vector< int >       m_attribute;   // Locations.
+    NameTable                m_uniformTable;
+    NameTable                m_attributeTable;
+    std::vector< char >      m_value;
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_UNIFORM_TABLE_HPP
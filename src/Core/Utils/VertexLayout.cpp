@@ -0,0 +1,51 @@
+#include <Core/Utils/VertexLayout.hpp>
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+VertexLayout::VertexLayout() : m_attribute(), m_stride( 0 ) { }
+
+
+
+/// ===============================================================================
+/// LAYOUT
+/// ===============================================================================
+void VertexLayout::clear() {
+    m_attribute.clear();
+    m_stride = 0;
+}
+
+void VertexLayout::addAttribute( const uint index, const uint component, const Scalar* data ) {
+    CORE_ASSERT( component > 0 && data != nullptr, "Empty attribute" );
+    m_attribute.push_back( Attribute { index, component, m_stride, data } );
+    m_stride += component;
+}
+
+
+
+/// ===============================================================================
+/// PACKING
+/// ===============================================================================
+void VertexLayout::pack( const uint size, std::vector< Scalar >& buffer ) const {
+    buffer.resize( size * m_stride );
+    // One attribute at a time : each source array is read sequentially.
+    for( const auto& attribute : m_attribute ) {
+        const Scalar* src = attribute.m_data;
+        Scalar*       dst = buffer.data() + attribute.m_offset;
+        for( uint v = 0; v < size; ++v ) {
+            for( uint c = 0; c < attribute.m_component; ++c ) {
+                dst[c] = src[c];
+            }
+            src += attribute.m_component;
+            dst += m_stride;
+        }
+    }
+}
+
+
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,71 @@
+#ifndef RADIUMENGINE_VERTEX_LAYOUT_HPP
+#define RADIUMENGINE_VERTEX_LAYOUT_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/*
+* The class VertexLayout packs vertex attributes stored in separate arrays into one interleaved array, where the
+* attributes of a vertex are consecutive :
+*
+*       | position0 normal0 texcoord0 | position1 normal1 texcoord1 | ...
+*
+* Sizes and offsets are in Scalar. The attributes keep the order in which they were added.
+*/
+class RA_CORE_API VertexLayout {
+public:
+    /// ATTRIBUTE
+    struct Attribute {
+        uint          m_index;      // Given by the caller, e.g. the shader attribute location.
+        uint          m_component;  // Number of Scalar per vertex.
+        uint          m_offset;     // Of the attribute in a vertex.
+        const Scalar* m_data;
+    };
+
+    /// CONSTRUCTOR
+    VertexLayout();
+
+    /// LAYOUT
+    void clear();
+
+    // Add an attribute of component Scalar per vertex, read from data.
+    void addAttribute( const uint index, const uint component, const Scalar* data );
+
+    // Same as above for an array of fixed size vectors ( e.g. Vector3Array ).
+    template < typename VectorArray >
+    inline void addAttribute( const uint index, const VectorArray& array ) {
+        addAttribute( index, VectorArray::Vector::RowsAtCompileTime, array.data()->data() );
+    }
+
+    /// PACKING
+    // Interleave the attributes of the vertices [0, size) in buffer, resized to size * getStride().
+    void pack( const uint size, std::vector< Scalar >& buffer ) const;
+
+    /// QUERY
+    // Number of Scalar per vertex.
+    inline uint getStride() const {
+        return m_stride;
+    }
+
+    inline uint size() const {
+        return m_attribute.size();
+    }
+
+    inline const Attribute& operator[]( const uint i ) const {
+        return m_attribute[i];
+    }
+
+private:
+    /// VARIABLE
+    std::vector< Attribute > m_attribute;
+    uint                     m_stride;
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_VERTEX_LAYOUT_HPP
@@ -22,6 +22,7 @@ class AnimationData {
 public:
     /// FRIEND
     friend class AssimpAnimationDataLoader;
+    friend class AssetCache;
 
     /// CONSTRUCTOR
     AnimationData( const std::string& name = "" );
@@ -37,7 +38,7 @@ public:
 
     /// KEY FRAME
     inline uint getFramesSize() const;
-    inline std::vector< HandleAnimation > getFrames() const;
+    inline const std::vector< HandleAnimation >& getFrames() const;
 
     /// DEBUG
     inline void displayInfo() const;
@@ -24,7 +24,7 @@ inline uint AnimationData::getFramesSize() const {
     return m_keyFrame.size();
 }
 
-inline std::vector< HandleAnimation > AnimationData::getFrames() const {
+inline const std::vector< HandleAnimation >& AnimationData::getFrames() const {
     return m_keyFrame;
 }
 
@@ -0,0 +1,481 @@
+#include <Engine/Assets/AssetCache.hpp>
+
+#include <cstdio>
+
+#include <Core/Utils/File/BlobFile.hpp>
+
+#include <Engine/Assets/GeometryData.hpp>
+#include <Engine/Assets/HandleData.hpp>
+#include <Engine/Assets/AnimationData.hpp>
+
+namespace Ra {
+namespace Asset {
+
+namespace {
+
+// Lists of dynamic vectors (faces, polyhedra) are stored as the sizes followed by all the coefficients.
+template < typename List >
+void writeVectorList( Core::BlobWriter& blob, const List& list ) {
+    typedef typename List::value_type::Scalar Coefficient;
+    std::vector< uint32_t >    size( list.size() );
+    std::vector< Coefficient > coefficient;
+    for( uint i = 0; i < list.size(); ++i ) {
+        size[i] = list[i].size();
+        coefficient.insert( coefficient.end(), list[i].data(), list[i].data() + list[i].size() );
+    }
+    blob.addArrayCopy( size );
+    blob.addArrayCopy( coefficient );
+}
+
+template < typename List >
+bool readVectorList( Core::BlobReader& blob, List& list ) {
+    typedef typename List::value_type::Scalar Coefficient;
+    std::size_t sizeCount        = 0;
+    std::size_t coefficientCount = 0;
+    const uint32_t*    size        = blob.readArray< uint32_t >( sizeCount );
+    const Coefficient* coefficient = blob.readArray< Coefficient >( coefficientCount );
+    list.clear();
+    if( !blob.isValid() ) {
+        return false;
+    }
+    list.resize( sizeCount );
+    std::size_t offset = 0;
+    for( std::size_t i = 0; i < sizeCount; ++i ) {
+        if( size[i] > coefficientCount - offset ) {
+            list.clear();
+            return false;
+        }
+        list[i] = Eigen::Map< const typename List::value_type >( coefficient + offset, size[i] );
+        offset += size[i];
+    }
+    return true;
+}
+
+inline void writeTransform( Core::BlobWriter& blob, const Core::Transform& transform ) {
+    blob.addValue( Core::Matrix4( transform.matrix() ) );
+}
+
+inline bool readTransform( Core::BlobReader& blob, Core::Transform& transform ) {
+    Core::Matrix4 matrix;
+    if( !blob.readValue( matrix ) ) {
+        return false;
+    }
+    transform.matrix() = matrix;
+    return true;
+}
+
+}
+
+
+
+/// FILENAME
+std::string AssetCache::getCacheFileName( const std::string& directory, const std::string& filename ) {
+    char name[32];
+    std::snprintf( name, sizeof( name ), "%016llx.rab",
+                   static_cast< unsigned long long >( Core::hashBytes( filename.data(), filename.size() ) ) );
+    return directory + "/" + name;
+}
+
+
+
+/// LOAD
+bool AssetCache::load( const std::string&                                directory,
+                       const std::string&                                filename,
+                       std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                       std::vector< std::unique_ptr< HandleData > >&    handleData,
+                       std::vector< std::unique_ptr< AnimationData > >& animationData ) {
+    Core::FileStamp stamp;
+    if( directory.empty() || !Core::getFileStamp( filename, stamp, false ) ) {
+        return false;
+    }
+
+    Core::BlobReader blob;
+    if( !blob.open( getCacheFileName( directory, filename ), Version ) ) {
+        return false;
+    }
+    const Core::FileStamp& cached = blob.getStamp();
+    if( ( cached.m_path != stamp.m_path ) || ( cached.m_size != stamp.m_size ) ) {
+        return false;
+    }
+    bool restamp = false;
+    if( cached.m_time != stamp.m_time ) {
+        // The file was touched or copied: the content decides.
+        if( !Core::getFileStamp( filename, stamp, true ) || ( stamp.m_content != cached.m_content ) ) {
+            return false;
+        }
+        restamp = true;
+    }
+
+    std::vector< uint32_t > size;
+    if( !blob.readArray( size ) || size.size() != 3 ) {
+        return false;
+    }
+    std::vector< std::unique_ptr< GeometryData > >  geometry;
+    std::vector< std::unique_ptr< HandleData > >    handle;
+    std::vector< std::unique_ptr< AnimationData > > animation;
+    for( uint i = 0; i < size[0]; ++i ) {
+        geometry.emplace_back( new GeometryData() );
+        if( !readGeometry( blob, *geometry.back() ) ) {
+            return false;
+        }
+    }
+    for( uint i = 0; i < size[1]; ++i ) {
+        handle.emplace_back( new HandleData() );
+        if( !readHandle( blob, *handle.back() ) ) {
+            return false;
+        }
+    }
+    for( uint i = 0; i < size[2]; ++i ) {
+        animation.emplace_back( new AnimationData() );
+        if( !readAnimation( blob, *animation.back() ) ) {
+            return false;
+        }
+    }
+
+    geometryData  = std::move( geometry );
+    handleData    = std::move( handle );
+    animationData = std::move( animation );
+
+    // Same content: store the new time, so that the next loadings do not hash the file again.
+    if( restamp ) {
+        blob.close();
+        Core::BlobWriter::setStamp( getCacheFileName( directory, filename ), stamp );
+    }
+    return true;
+}
+
+
+
+/// SAVE
+bool AssetCache::save( const std::string&                                      directory,
+                       const std::string&                                      filename,
+                       const std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                       const std::vector< std::unique_ptr< HandleData > >&    handleData,
+                       const std::vector< std::unique_ptr< AnimationData > >& animationData ) {
+    Core::FileStamp stamp;
+    if( directory.empty() || !Core::getFileStamp( filename, stamp, true ) ) {
+        return false;
+    }
+
+    Core::BlobWriter blob;
+    blob.addArrayCopy( std::vector< uint32_t >{ uint32_t( geometryData.size() ), uint32_t( handleData.size() ),
+                                                uint32_t( animationData.size() ) } );
+    for( const auto& data : geometryData ) {
+        writeGeometry( blob, *data );
+    }
+    for( const auto& data : handleData ) {
+        writeHandle( blob, *data );
+    }
+    for( const auto& data : animationData ) {
+        writeAnimation( blob, *data );
+    }
+    return blob.save( getCacheFileName( directory, filename ), stamp, Version );
+}
+
+
+
+/// GEOMETRY
+void AssetCache::writeGeometry( Core::BlobWriter& blob, const GeometryData& data ) {
+    blob.addString( data.m_name );
+    blob.addValue( uint32_t( data.m_type ) );
+    writeTransform( blob, data.m_frame );
+
+    blob.addArray( data.m_vertex );
+    blob.addArray( data.m_edge );
+    writeVectorList( blob, data.m_faces );
+    writeVectorList( blob, data.m_polyhedron );
+    blob.addArray( data.m_normal );
+    blob.addArray( data.m_tangent );
+    blob.addArray( data.m_bitangent );
+    blob.addArray( data.m_texCoord );
+    blob.addArray( data.m_color );
+
+    // Weights: number of weights of each vertex, then all the weights and their handles.
+    std::vector< uint32_t > weightSize( data.m_weights.size() );
+    std::vector< Scalar >   weight;
+    std::vector< uint32_t > weightHandle;
+    for( uint i = 0; i < data.m_weights.size(); ++i ) {
+        weightSize[i] = data.m_weights[i].size();
+        for( const auto& w : data.m_weights[i] ) {
+            weight.push_back( w.first );
+            weightHandle.push_back( w.second );
+        }
+    }
+    blob.addArrayCopy( weightSize );
+    blob.addArrayCopy( weight );
+    blob.addArrayCopy( weightHandle );
+
+    const MaterialData& material = data.m_material;
+    blob.addValue( material.m_diffuse );
+    blob.addValue( material.m_specular );
+    blob.addArrayCopy( std::vector< Scalar >{ material.m_shininess, material.m_opacity } );
+    blob.addStrings( { material.m_texDiffuse, material.m_texSpecular, material.m_texShininess,
+                       material.m_texNormal, material.m_texOpacity } );
+    blob.addArrayCopy( std::vector< uint8_t >{ material.m_hasDiffuse, material.m_hasSpecular, material.m_hasShininess,
+                                               material.m_hasOpacity, material.m_hasTexDiffuse, material.m_hasTexSpecular,
+                                               material.m_hasTexShininess, material.m_hasTexNormal, material.m_hasTexOpacity,
+                                               data.m_hasMaterial, data.m_loadDuplicates } );
+
+    std::vector< uint32_t > duplicate;
+    for( const auto& it : data.m_duplicateTable ) {
+        duplicate.push_back( it.first );
+        duplicate.push_back( it.second );
+    }
+    blob.addArrayCopy( duplicate );
+}
+
+bool AssetCache::readGeometry( Core::BlobReader& blob, GeometryData& data ) {
+    uint32_t type = 0;
+    blob.readString( data.m_name );
+    blob.readValue( type );
+    data.m_type = GeometryData::GeometryType( type );
+    readTransform( blob, data.m_frame );
+
+    blob.readArray( data.m_vertex );
+    blob.readArray( data.m_edge );
+    readVectorList( blob, data.m_faces );
+    readVectorList( blob, data.m_polyhedron );
+    blob.readArray( data.m_normal );
+    blob.readArray( data.m_tangent );
+    blob.readArray( data.m_bitangent );
+    blob.readArray( data.m_texCoord );
+    blob.readArray( data.m_color );
+
+    std::size_t vertexCount  = 0;
+    std::size_t weightCount  = 0;
+    std::size_t handleCount  = 0;
+    const uint32_t* weightSize   = blob.readArray< uint32_t >( vertexCount );
+    const Scalar*   weight       = blob.readArray< Scalar >( weightCount );
+    const uint32_t* weightHandle = blob.readArray< uint32_t >( handleCount );
+    if( !blob.isValid() || weightCount != handleCount ) {
+        return false;
+    }
+    data.m_weights.resize( vertexCount );
+    std::size_t offset = 0;
+    for( std::size_t i = 0; i < vertexCount; ++i ) {
+        if( weightSize[i] > weightCount - offset ) {
+            return false;
+        }
+        data.m_weights[i].resize( weightSize[i] );
+        for( auto& w : data.m_weights[i] ) {
+            w = GeometryData::Weight( weight[offset], weightHandle[offset] );
+            ++offset;
+        }
+    }
+
+    MaterialData& material = data.m_material;
+    std::vector< Scalar >      value;
+    std::vector< std::string > texture;
+    std::vector< uint8_t >     flag;
+    blob.readValue( material.m_diffuse );
+    blob.readValue( material.m_specular );
+    blob.readArray( value );
+    blob.readStrings( texture );
+    blob.readArray( flag );
+    if( !blob.isValid() || value.size() != 2 || texture.size() != 5 || flag.size() != 11 ) {
+        return false;
+    }
+    material.m_shininess       = value[0];
+    material.m_opacity         = value[1];
+    material.m_texDiffuse      = texture[0];
+    material.m_texSpecular     = texture[1];
+    material.m_texShininess    = texture[2];
+    material.m_texNormal       = texture[3];
+    material.m_texOpacity      = texture[4];
+    material.m_hasDiffuse      = flag[0];
+    material.m_hasSpecular     = flag[1];
+    material.m_hasShininess    = flag[2];
+    material.m_hasOpacity      = flag[3];
+    material.m_hasTexDiffuse   = flag[4];
+    material.m_hasTexSpecular  = flag[5];
+    material.m_hasTexShininess = flag[6];
+    material.m_hasTexNormal    = flag[7];
+    material.m_hasTexOpacity   = flag[8];
+    data.m_hasMaterial         = flag[9];
+    data.m_loadDuplicates      = flag[10];
+
+    std::size_t duplicateCount = 0;
+    const uint32_t* duplicate = blob.readArray< uint32_t >( duplicateCount );
+    data.m_duplicateTable.clear();
+    for( std::size_t i = 0; i + 1 < duplicateCount; i += 2 ) {
+        data.m_duplicateTable.insert( data.m_duplicateTable.end(), std::make_pair( duplicate[i], duplicate[i + 1] ) );
+    }
+    return blob.isValid();
+}
+
+
+
+/// HANDLE
+void AssetCache::writeHandle( Core::BlobWriter& blob, const HandleData& data ) {
+    blob.addString( data.m_name );
+    blob.addArrayCopy( std::vector< uint32_t >{ uint32_t( data.m_type ), data.m_endNode, data.m_vertexSize } );
+    writeTransform( blob, data.m_frame );
+
+    std::vector< std::string > name;
+    std::vector< uint32_t >    index;
+    for( const auto& it : data.m_nameTable ) {
+        name.push_back( it.first );
+        index.push_back( it.second );
+    }
+    blob.addStrings( name );
+    blob.addArrayCopy( index );
+
+    // Components: frames and names, then the weights as for the geometry.
+    Core::AlignedStdVector< Core::Matrix4 > frame;
+    std::vector< std::string >              componentName;
+    std::vector< uint32_t >                 weightSize;
+    std::vector< uint32_t >                 weightVertex;
+    std::vector< Scalar >                   weight;
+    for( const auto& component : data.m_component ) {
+        frame.push_back( component.m_frame.matrix() );
+        componentName.push_back( component.m_name );
+        weightSize.push_back( component.m_weight.size() );
+        for( const auto& w : component.m_weight ) {
+            weightVertex.push_back( w.first );
+            weight.push_back( w.second );
+        }
+    }
+    blob.addArrayCopy( frame );
+    blob.addStrings( componentName );
+    blob.addArrayCopy( weightSize );
+    blob.addArrayCopy( weightVertex );
+    blob.addArrayCopy( weight );
+
+    blob.addArray( data.m_edge );
+    writeVectorList( blob, data.m_face );
+}
+
+bool AssetCache::readHandle( Core::BlobReader& blob, HandleData& data ) {
+    std::vector< uint32_t > value;
+    blob.readString( data.m_name );
+    blob.readArray( value );
+    if( !blob.isValid() || value.size() != 3 ) {
+        return false;
+    }
+    data.m_type       = HandleData::HandleType( value[0] );
+    data.m_endNode    = value[1];
+    data.m_vertexSize = value[2];
+    readTransform( blob, data.m_frame );
+
+    std::vector< std::string > name;
+    std::vector< uint32_t >    index;
+    blob.readStrings( name );
+    blob.readArray( index );
+    if( !blob.isValid() || name.size() != index.size() ) {
+        return false;
+    }
+    data.m_nameTable.clear();
+    for( uint i = 0; i < name.size(); ++i ) {
+        data.m_nameTable[name[i]] = index[i];
+    }
+
+    Core::AlignedStdVector< Core::Matrix4 > frame;
+    std::vector< std::string >              componentName;
+    std::vector< uint32_t >                 weightSize;
+    std::size_t vertexCount = 0;
+    std::size_t weightCount = 0;
+    blob.readArray( frame );
+    blob.readStrings( componentName );
+    blob.readArray( weightSize );
+    const uint32_t* weightVertex = blob.readArray< uint32_t >( vertexCount );
+    const Scalar*   weight       = blob.readArray< Scalar >( weightCount );
+    if( !blob.isValid() || componentName.size() != frame.size() || weightSize.size() != frame.size() ||
+        vertexCount != weightCount ) {
+        return false;
+    }
+    data.m_component.resize( frame.size() );
+    std::size_t offset = 0;
+    for( uint i = 0; i < frame.size(); ++i ) {
+        HandleComponentData& component = data.m_component[i];
+        component.m_frame.matrix() = frame[i];
+        component.m_name           = componentName[i];
+        if( weightSize[i] > weightCount - offset ) {
+            return false;
+        }
+        component.m_weight.resize( weightSize[i] );
+        for( auto& w : component.m_weight ) {
+            w = std::make_pair( weightVertex[offset], weight[offset] );
+            ++offset;
+        }
+    }
+
+    blob.readArray( data.m_edge );
+    return readVectorList( blob, data.m_face ) && blob.isValid();
+}
+
+
+
+/// ANIMATION
+void AssetCache::writeAnimation( Core::BlobWriter& blob, const AnimationData& data ) {
+    blob.addString( data.m_name );
+    blob.addArrayCopy( std::vector< Time >{ data.m_time.getStart(), data.m_time.getEnd(), data.m_dt } );
+
+    // Handles: names, time ranges and number of keys, then the times and the transforms of all the keys.
+    std::vector< std::string >              name;
+    std::vector< Time >                     range;
+    std::vector< uint32_t >                 keySize;
+    std::vector< Time >                     time;
+    Core::AlignedStdVector< Core::Matrix4 > frame;
+    for( const auto& handle : data.m_keyFrame ) {
+        name.push_back( handle.m_name );
+        range.push_back( handle.m_anim.getAnimationTime().getStart() );
+        range.push_back( handle.m_anim.getAnimationTime().getEnd() );
+        keySize.push_back( handle.m_anim.size() );
+        for( const auto& key : handle.m_anim.getKeyFrames() ) {
+            time.push_back( key.first );
+            frame.push_back( key.second.matrix() );
+        }
+    }
+    blob.addStrings( name );
+    blob.addArrayCopy( range );
+    blob.addArrayCopy( keySize );
+    blob.addArrayCopy( time );
+    blob.addArrayCopy( frame );
+}
+
+bool AssetCache::readAnimation( Core::BlobReader& blob, AnimationData& data ) {
+    std::vector< Time > value;
+    blob.readString( data.m_name );
+    blob.readArray( value );
+    if( !blob.isValid() || value.size() != 3 ) {
+        return false;
+    }
+    data.m_time = AnimationTime( value[0], value[1] );
+    data.m_dt   = value[2];
+
+    std::vector< std::string > name;
+    std::vector< Time >        range;
+    std::vector< uint32_t >    keySize;
+    std::size_t timeCount  = 0;
+    std::size_t frameCount = 0;
+    blob.readStrings( name );
+    blob.readArray( range );
+    blob.readArray( keySize );
+    const Time*          time  = blob.readArray< Time >( timeCount );
+    const Core::Matrix4* frame = blob.readArray< Core::Matrix4 >( frameCount );
+    if( !blob.isValid() || range.size() != 2 * name.size() || keySize.size() != name.size() || timeCount != frameCount ) {
+        return false;
+    }
+    data.m_keyFrame.clear();
+    data.m_keyFrame.reserve( name.size() );
+    std::size_t offset = 0;
+    for( uint i = 0; i < name.size(); ++i ) {
+        if( keySize[i] > timeCount - offset ) {
+            return false;
+        }
+        data.m_keyFrame.push_back( HandleAnimation( name[i] ) );
+        KeyTransform& anim = data.m_keyFrame.back().m_anim;
+        anim.setAnimationTime( AnimationTime( range[2 * i], range[2 * i + 1] ) );
+        for( uint k = 0; k < keySize[i]; ++k, ++offset ) {
+            Core::Transform transform;
+            transform.matrix() = frame[offset];
+            anim.insertKeyFrame( time[offset], transform );
+        }
+    }
+    return true;
+}
+
+
+
+} // namespace Asset
+} // namespace Ra
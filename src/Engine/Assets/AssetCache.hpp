@@ -0,0 +1,72 @@
+#ifndef RADIUMENGINE_ASSET_CACHE_HPP
+#define RADIUMENGINE_ASSET_CACHE_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+class BlobWriter;
+class BlobReader;
+}
+}
+
+namespace Ra {
+namespace Asset {
+
+class GeometryData;
+class HandleData;
+class AnimationData;
+
+/*
+* The class AssetCache stores the data loaded from an asset file in a binary blob ( see Core::BlobWriter ),
+* so that the next loadings of the file skip the importer and its post processing.
+*
+* The blob of a file is <directory>/<hash of the path>.rab. It is used while the path, the modification time
+* and the size of the file did not change, or when the content of the file has the same hash. The arrays of
+* the data are read from the mapped blob with a single copy each.
+*/
+class RA_ENGINE_API AssetCache {
+public:
+    /// VERSION
+    static const uint32_t Version = 1; // To increment when the sections stored change.
+
+    /// FILENAME
+    static std::string getCacheFileName( const std::string& directory, const std::string& filename );
+
+    /// LOAD
+    // Return false, and leave the data untouched, if the cache of filename is missing or outdated.
+    static bool load( const std::string&                                directory,
+                      const std::string&                                filename,
+                      std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                      std::vector< std::unique_ptr< HandleData > >&    handleData,
+                      std::vector< std::unique_ptr< AnimationData > >& animationData );
+
+    /// SAVE
+    static bool save( const std::string&                                      directory,
+                      const std::string&                                      filename,
+                      const std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                      const std::vector< std::unique_ptr< HandleData > >&    handleData,
+                      const std::vector< std::unique_ptr< AnimationData > >& animationData );
+
+private:
+    /// GEOMETRY
+    static void writeGeometry( Core::BlobWriter& blob, const GeometryData& data );
+    static bool readGeometry( Core::BlobReader& blob, GeometryData& data );
+
+    /// HANDLE
+    static void writeHandle( Core::BlobWriter& blob, const HandleData& data );
+    static bool readHandle( Core::BlobReader& blob, HandleData& data );
+
+    /// ANIMATION
+    static void writeAnimation( Core::BlobWriter& blob, const AnimationData& data );
+    static bool readAnimation( Core::BlobReader& blob, AnimationData& data );
+};
+
+} // namespace Asset
+} // namespace Ra
+
+#endif // RADIUMENGINE_ASSET_CACHE_HPP
@@ -4,6 +4,7 @@
 #include <assimp/mesh.h>
 
 #include <Core/Log/Log.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Engine/Assets/GeometryData.hpp>
 #include <Engine/Assets/AssimpWrapper.hpp>
 
@@ -237,26 +238,28 @@ namespace Ra {
         void AssimpGeometryDataLoader::fetchEdges( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumFaces;
             std::vector< Core::Vector2ui > edge( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                edge[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
-                edge[i][0] = data.m_duplicateTable.at( edge[i][0] );
-                edge[i][1] = data.m_duplicateTable.at( edge[i][1] );
-            }
+            Core::parallelFor( 0, size, 0, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    edge[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
+                    edge[i][0] = data.m_duplicateTable.at( edge[i][0] );
+                    edge[i][1] = data.m_duplicateTable.at( edge[i][1] );
+                }
+            } );
             data.setEdges( edge );
         }
 
         void AssimpGeometryDataLoader::fetchFaces( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumFaces;
             std::vector< Core::VectorNui > face( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                face[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
-                const uint face_vertices = mesh.mFaces[i].mNumIndices;
-                for( uint j = 0; j < face_vertices; ++j ) {
-                    face[i][j] = data.m_duplicateTable.at( face[i][j] );
+            Core::parallelFor( 0, size, 0, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    face[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
+                    const uint face_vertices = mesh.mFaces[i].mNumIndices;
+                    for( uint j = 0; j < face_vertices; ++j ) {
+                        face[i][j] = data.m_duplicateTable.at( face[i][j] );
+                    }
                 }
-            }
+            } );
             data.setFaces( face );
         }
 
@@ -267,17 +270,18 @@ namespace Ra {
         void AssimpGeometryDataLoader::fetchNormals( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumVertices;
             std::vector<Core::Vector3> normal(data.getVerticesSize(), Core::Vector3::Zero());
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) 
+            // Duplicated vertices accumulate in the same normal : this loop stays serial.
+            for( uint i = 0; i < size; ++i )
             {
                 normal.at( data.m_duplicateTable.at( i ) ) += assimpToCore( mesh.mNormals[i] );
             }
 
-#pragma omp parallel for
-            for( int i = 0; i < int(normal.size()); ++i ) 
-            {
-                normal[i].normalize();
-            }
+            Core::parallelFor( 0, normal.size(), 0, [&normal]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i )
+                {
+                    normal[i].normalize();
+                }
+            } );
             data.setNormals( normal );
         }
 
@@ -10,10 +10,14 @@
 #include <Engine/Assets/AssimpGeometryDataLoader.hpp>
 #include <Engine/Assets/AssimpHandleDataLoader.hpp>
 #include <Engine/Assets/AssimpAnimationDataLoader.hpp>
+#include <Engine/Assets/AssetCache.hpp>
 
 namespace Ra {
 namespace Asset {
 
+namespace {
+std::string g_cacheDirectory;
+}
 
 
 /// CONSTRUCTOR
@@ -51,6 +55,19 @@ void FileData::loadFile( const bool FORCE_RELOAD ) {
     // File extension check
     // - If we decide to deal with user-defined file, here we should check if we are dealing with one of them or not
 
+    std::clock_t startTime;
+    startTime = std::clock();
+
+    if( AssetCache::load( g_cacheDirectory, getFileName(), m_geometryData, m_handleData, m_animationData ) ) {
+        m_loadingTime = ( std::clock() - startTime ) / Scalar( CLOCKS_PER_SEC );
+        if( m_verbose ) {
+            LOG(logINFO) << "File loaded from the cache.";
+            displayInfo();
+        }
+        m_processed = true;
+        return;
+    }
+
     Assimp::Importer importer;
     const aiScene* scene = importer.ReadFile( getFileName(),
                                               aiProcess_Triangulate           | // This could/should be taken away if we want to deal with mesh types other than trimehses
@@ -71,9 +88,6 @@ void FileData::loadFile( const bool FORCE_RELOAD ) {
         LOG(logINFO) << "File Loading begin...";
     }
 
-    std::clock_t startTime;
-    startTime = std::clock();
-
     AssimpGeometryDataLoader geometryLoader( Core::StringUtils::getDirName( getFileName() ), m_verbose );
     geometryLoader.loadData( scene, m_geometryData );
 
@@ -85,6 +99,10 @@ void FileData::loadFile( const bool FORCE_RELOAD ) {
 
     m_loadingTime = ( std::clock() - startTime ) / Scalar( CLOCKS_PER_SEC );
 
+    if( !g_cacheDirectory.empty() && !AssetCache::save( g_cacheDirectory, getFileName(), m_geometryData, m_handleData, m_animationData ) ) {
+        LOG( logWARNING ) << "Could not write the cache of \"" << getFileName() << "\".";
+    }
+
     if( m_verbose ) {
         LOG(logINFO) << "File Loading end.";
         displayInfo();
@@ -95,6 +113,13 @@ void FileData::loadFile( const bool FORCE_RELOAD ) {
 
 
 
+/// CACHE
+void FileData::setCacheDirectory( const std::string& directory ) {
+    g_cacheDirectory = directory;
+}
+
+
+
 } // namespace Asset
 } // namespace Ra
 
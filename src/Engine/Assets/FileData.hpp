@@ -28,6 +28,10 @@ public:
     /// LOAD
     void loadFile( const bool FORCE_RELOAD = false );
 
+    /// CACHE
+    // Directory of the binary caches of the loaded files ( see AssetCache ), empty to disable the cache.
+    static void setCacheDirectory( const std::string& directory );
+
     /// FILENAME
     inline std::string getFileName() const;
 
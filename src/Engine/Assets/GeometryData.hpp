@@ -53,6 +53,7 @@ class GeometryData : public AssetData {
 
     /// FRIEND
     friend class AssimpGeometryDataLoader;
+    friend class AssetCache;
 
 public:
     using Vector3Array  = Core::VectorArray<Core::Vector3>  ;
@@ -12,6 +12,9 @@ namespace Asset {
 template < class FRAME >
 class KeyFrame {
 public:
+    /// TYPEDEF
+    typedef std::map < Time, FRAME, std::less<Time>, Ra::Core::AlignedAllocator<std::pair < Time, FRAME >, 16 > > KeyFrameMap;
+
     /// CONSTRUCTOR
     KeyFrame( const AnimationTime& time = AnimationTime() ) : m_time( time ) { }
     KeyFrame( const KeyFrame& keyframe ) = default;
@@ -90,6 +93,10 @@ public:
         return m_keyframe.empty();
     }
 
+    inline const KeyFrameMap& getKeyFrames() const { // Keys sorted by time.
+        return m_keyframe;
+    }
+
     inline std::set< Time > timeSchedule() const {
         std::set< Time > time;
         for( const auto& it : m_keyframe ) {
@@ -118,16 +125,16 @@ protected:
                            FRAME& F0,
                            FRAME& F1,
                            Scalar& dt ) const {
-        auto it = m_keyframe.find( t );
-        if( it != m_keyframe.end() ) {
-            F0 = it->second;
-            F1 = it->second;
-            dt = 0.0;
-            return;
-        }
+        // A single search: lower is the last key not after t, which is in the time range.
         auto upper = m_keyframe.upper_bound( t );
         auto lower = upper;
         --lower;
+        if( ( lower->first == t ) || ( upper == m_keyframe.end() ) ) {
+            F0 = lower->second;
+            F1 = lower->second;
+            dt = 0.0;
+            return;
+        }
 
         F0 = lower->second;
         F1 = upper->second;
@@ -143,7 +150,7 @@ protected:
 protected:
     /// VARIABLE
     AnimationTime           m_time;
-    std::map < Time, FRAME, std::less<Time>, Ra::Core::AlignedAllocator<std::pair < Time, FRAME >, 16 > > m_keyframe;
+    KeyFrameMap             m_keyframe;
 };
 
 
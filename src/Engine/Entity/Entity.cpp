@@ -20,6 +20,7 @@ namespace Ra
                 , m_doubleBufferedTransform( Core::Transform::Identity() )
                 , m_name( name )
                 , m_transformChanged( false )
+                , m_transformVersion( 0 )
         {
         }
 
@@ -85,6 +86,7 @@ namespace Ra
             {
                 m_transform = m_doubleBufferedTransform;
                 m_transformChanged = false;
+                m_transformVersion.fetch_add( 1, std::memory_order_release );
             }
         }
 
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <atomic>
 #include <mutex>
 #include <thread>
 
@@ -46,6 +47,9 @@ namespace Ra
             Core::Transform getTransform() const;
             Core::Matrix4 getTransformAsMatrix() const;
 
+            /// Incremented each time the transform changes, can be read without locking.
+            inline uint getTransformVersion() const;
+
             void swapTransformBuffers();
 
             // Components
@@ -78,6 +82,7 @@ namespace Ra
             std::vector<std::unique_ptr<Component>> m_components;
 
             bool m_transformChanged;
+            std::atomic<uint> m_transformVersion;
             mutable std::mutex m_transformMutex;
         };
 
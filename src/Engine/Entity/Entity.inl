@@ -39,6 +39,11 @@ namespace Ra
             return m_transform.matrix();
         }
 
+        inline uint Entity::getTransformVersion() const
+        {
+            return m_transformVersion.load( std::memory_order_acquire );
+        }
+
         inline uint Entity::getNumComponents() const
         {
             return uint(m_components.size());
@@ -8,6 +8,7 @@ namespace Ra
     namespace Engine
     {
         /// Structure passed to each system before they fill the task queue.
+        /// The engine keeps one instance, updated at the beginning of each frame.
         struct RA_ENGINE_API FrameInfo
         {
             /// Time elapsed since the last frame in seconds.
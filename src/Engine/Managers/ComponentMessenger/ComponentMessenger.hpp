@@ -3,6 +3,7 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <typeindex>
@@ -36,6 +37,8 @@ namespace Ra
         /// and rw() functions.
         /// For more efficiency the underlying function pointers are directly accessible
         /// as well and can be queried with the same identifiers.
+        /// Components reading an output register as its consumers while they need it, so that
+        /// producers can skip computing outputs nobody reads (see hasConsumers()).
         class RA_ENGINE_API ComponentMessenger
         {
         RA_SINGLETON_INTERFACE(ComponentMessenger);
@@ -72,6 +75,8 @@ namespace Ra
             /// Class hierarchy for polymorphic storage of callback functions.
             struct CallbackBase
             {
+                /// Number of registered consumers, see registerConsumer().
+                std::atomic<uint> m_numConsumers{0};
             };
             template<typename T>
             struct GetterCallback : public CallbackBase
@@ -141,6 +146,21 @@ namespace Ra
             template<typename ReturnType>
             inline bool canRw(const Entity* entity, const std::string& id);
 
+            /// Returns true if a component registered as a consumer of the given output,
+            /// i.e. if the output may be read at any time, with get() or its getter callback.
+            /// Can be called concurrently with other queries.
+            template<typename ReturnType>
+            inline bool hasConsumers(const Entity* entity, const std::string& id);
+
+            /// Declares that the caller reads the given output, which must exist, until the
+            /// matching unregisterConsumer() call. Outputs computed on demand are only kept
+            /// up to date while they have consumers.
+            template<typename ReturnType>
+            inline void registerConsumer(const Entity* entity, const std::string& id);
+
+            template<typename ReturnType>
+            inline void unregisterConsumer(const Entity* entity, const std::string& id);
+
 
             //
             // Register callbacks
@@ -158,6 +178,16 @@ namespace Ra
             inline void registerInput(const Entity* entity, Component* comp, const std::string& id,
                                       const typename CallbackTypes<ReturnType>::Setter& cb);
 
+        private:
+            /// Returns the getter entry of the given output, or nullptr if it does not exist.
+            /// Only looks the maps up, so that it can be called concurrently.
+            template<typename ReturnType>
+            inline GetterCallback<ReturnType>* findGetter(const Entity* entity, const std::string& id) const;
+
+            /// Returns the getter entry of the given output, which must exist.
+            template<typename ReturnType>
+            inline GetterCallback<ReturnType>* getterEntry(const Entity* entity, const std::string& id) const;
+
         private:
             std::unordered_map<const Entity*, CallbackMap> m_entityGetLists; /// Per-entity callback get list.
             std::unordered_map<const Entity*, CallbackMap> m_entitySetLists; /// Per-entity callback set list.
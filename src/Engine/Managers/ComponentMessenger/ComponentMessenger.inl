@@ -10,13 +10,39 @@ namespace Ra
             return Core::StdUtils::hash(k);
         }
 
+        template<typename ReturnType>
+        inline ComponentMessenger::GetterCallback<ReturnType>* ComponentMessenger::findGetter(
+                const Entity* entity, const std::string& id) const
+        {
+            const auto& entityListPos = m_entityGetLists.find(entity);
+            if (entityListPos == m_entityGetLists.end())
+            {
+                return nullptr;
+            }
+
+            const CallbackMap& entityList = entityListPos->second;
+            const auto& callbackEntry = entityList.find(Key(id, std::type_index(typeid(ReturnType))));
+            if (callbackEntry == entityList.end())
+            {
+                return nullptr;
+            }
+            return static_cast<GetterCallback <ReturnType>*>(callbackEntry->second.get());
+        }
+
+        template<typename ReturnType>
+        inline ComponentMessenger::GetterCallback<ReturnType>* ComponentMessenger::getterEntry(
+                const Entity* entity, const std::string& id) const
+        {
+            GetterCallback <ReturnType>* getter = findGetter<ReturnType>(entity, id);
+            CORE_ASSERT(getter != nullptr, "Unregistered callback");
+            return getter;
+        }
+
         template<typename ReturnType>
         inline typename ComponentMessenger::CallbackTypes<ReturnType>::Getter ComponentMessenger::getterCallback(
                 const Entity* entity, const std::string& id)
         {
-            CORE_ASSERT(canGet<ReturnType>(entity, id), "Unregistered callback");
-            return static_cast<GetterCallback <ReturnType>*>(m_entityGetLists[entity][Key(id, std::type_index(
-                    typeid(ReturnType)))].get())->m_cb;
+            return getterEntry<ReturnType>(entity, id)->m_cb;
         }
 
         template<typename ReturnType>
@@ -40,7 +66,7 @@ namespace Ra
         template<typename ReturnType>
         inline const ReturnType& ComponentMessenger::get(const Entity* entity, const std::string& id)
         {
-            return *(getterCallback<ReturnType>(entity, id)());
+            return *(getterEntry<ReturnType>(entity, id)->m_cb());
         }
 
         template<typename ReturnType>
@@ -106,6 +132,27 @@ namespace Ra
             return found;
         }
 
+        template<typename ReturnType>
+        inline bool ComponentMessenger::hasConsumers(const Entity* entity, const std::string& id)
+        {
+            const GetterCallback <ReturnType>* getter = findGetter<ReturnType>(entity, id);
+            return getter != nullptr && getter->m_numConsumers.load(std::memory_order_acquire) > 0;
+        }
+
+        template<typename ReturnType>
+        inline void ComponentMessenger::registerConsumer(const Entity* entity, const std::string& id)
+        {
+            getterEntry<ReturnType>(entity, id)->m_numConsumers.fetch_add(1, std::memory_order_release);
+        }
+
+        template<typename ReturnType>
+        inline void ComponentMessenger::unregisterConsumer(const Entity* entity, const std::string& id)
+        {
+            GetterCallback <ReturnType>* getter = getterEntry<ReturnType>(entity, id);
+            CORE_ASSERT(getter->m_numConsumers.load() > 0, "Consumer not registered");
+            getter->m_numConsumers.fetch_sub(1, std::memory_order_release);
+        }
+
         template<typename ReturnType>
         inline void ComponentMessenger::registerOutput(const Entity* entity, Component* comp, const std::string& id,
                                                 const typename CallbackTypes<ReturnType>::Getter& cb)
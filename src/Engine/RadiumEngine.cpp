@@ -14,6 +14,7 @@
 #include <Core/Event/EventEnums.hpp>
 #include <Core/Event/KeyEvent.hpp>
 #include <Core/Event/MouseEvent.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
 
 #include <Engine/FrameInfo.hpp>
 #include <Engine/System/System.hpp>
@@ -32,7 +33,10 @@ namespace Ra
     {
 
         RadiumEngine::RadiumEngine()
+            : m_tasksChanged( true )
         {
+            m_frameInfo.m_dt = 0;
+            m_frameInfo.m_numFrame = 0;
         }
 
         RadiumEngine::~RadiumEngine()
@@ -70,14 +74,30 @@ namespace Ra
 
         void RadiumEngine::getTasks( Core::TaskQueue* taskQueue,  Scalar dt )
         {
-            static uint frameCounter = 0;
-            FrameInfo frameInfo;
-            frameInfo.m_dt = dt;
-            frameInfo.m_numFrame = frameCounter++;
+            m_frameInfo.m_dt = dt;
             for ( auto& syst : m_systems )
             {
-                syst.second->generateTasks( taskQueue, frameInfo );
+                syst.second->prepareFrame( m_frameInfo );
             }
+
+            // The task graph is only built again when the systems changed,
+            // otherwise the task queue replays the tasks of the last frame.
+            if ( m_tasksChanged )
+            {
+                taskQueue->flushTaskQueue();
+                for ( auto& syst : m_systems )
+                {
+                    syst.second->generateTasks( taskQueue, m_frameInfo );
+                }
+                m_tasksChanged = false;
+            }
+
+            ++m_frameInfo.m_numFrame;
+        }
+
+        void RadiumEngine::invalidateTasks()
+        {
+            m_tasksChanged = true;
         }
 
         void RadiumEngine::registerSystem( const std::string& name, System* system )
@@ -86,6 +106,7 @@ namespace Ra
                          "Same system added multiple times." );
 
             m_systems[name] = std::shared_ptr<System> ( system );
+            invalidateTasks();
             LOG(logINFO) << "Loaded : " << name;
         }
 
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <Core/Log/Log.hpp>
+#include <Engine/FrameInfo.hpp>
 #include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
 #include <Engine/Managers/EntityManager/EntityManager.hpp>
 #include <Engine/Managers/SignalManager/SignalManager.hpp>
@@ -47,8 +48,14 @@ namespace Ra
             void initialize();
             void cleanup();
 
+            /// Prepares the task queue for a new frame. The systems tasks are kept in the
+            /// queue between frames, and are only generated again after invalidateTasks().
             void getTasks( Core::TaskQueue* taskQueue, Scalar dt );
 
+            /// Requires the systems tasks to be generated again at the next frame
+            /// (e.g. because components were added or removed).
+            void invalidateTasks();
+
             void registerSystem( const std::string& name,
                                  System* system );
             System* getSystem( const std::string& system ) const;
@@ -67,6 +74,11 @@ namespace Ra
         private:
             std::map<std::string, std::shared_ptr<System>> m_systems;
 
+            /// Information on the current frame, shared with the systems tasks.
+            FrameInfo m_frameInfo;
+            /// True if the systems tasks must be generated again.
+            bool m_tasksChanged;
+
             std::unique_ptr<RenderObjectManager> m_renderObjectManager;
             std::unique_ptr<EntityManager>       m_entityManager;
             std::unique_ptr<SignalManager>       m_signalManager;
@@ -0,0 +1,196 @@
+#include <Engine/Renderer/Light/ClusteredLights.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/Renderer.hpp>
+#include <Engine/Renderer/RenderTechnique/ShaderProgram.hpp>
+#include <Engine/Renderer/Light/Light.hpp>
+#include <Engine/Renderer/Light/DirLight.hpp>
+#include <Engine/Renderer/Light/PointLight.hpp>
+#include <Engine/Renderer/Light/SpotLight.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+
+        namespace
+        {
+            // Intensity below which a light is neglected.
+            const Scalar Threshold = 1.0 / 256.0;
+
+            const GLenum formats[] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+        }
+
+        ClusteredLights::ClusteredLights()
+            : m_clusters()
+            , m_globalCount( 0 )
+            , m_screen( 1, 1 )
+        {
+            m_buffers.fill( 0 );
+            m_textures.fill( 0 );
+            m_capacity.fill( 0 );
+        }
+
+        ClusteredLights::~ClusteredLights()
+        {
+            if ( m_buffers[0] != 0 )
+            {
+                glDeleteTextures( Buffer_Count, m_textures.data() );
+                glDeleteBuffers( Buffer_Count, m_buffers.data() );
+            }
+        }
+
+        bool ClusteredLights::update( const std::vector<Light*>& lights, const RenderData& renderData,
+                                      uint width, uint height )
+        {
+            // The clusters are slices of a perspective frustum.
+            if ( renderData.projMatrix( 3, 2 ) == 0 )
+            {
+                return false;
+            }
+            m_clusters.setProjection( renderData.projMatrix );
+            m_screen = Core::Vector2f( float( width ), float( height ) );
+
+            // Range of the lights, the largest Scalar for the ones shaded everywhere.
+            const Scalar global = std::numeric_limits<Scalar>::max();
+            std::vector<Scalar> range( lights.size(), global );
+            for ( uint i = 0; i < lights.size(); ++i )
+            {
+                const Light* light = lights[i];
+                const Scalar intensity = light->getColor().head<3>().maxCoeff();
+                if ( light->getType() == Light::POINT )
+                {
+                    const auto& a = static_cast<const PointLight*>( light )->getAttenuation();
+                    range[i] = Core::LightClusters::getRange( intensity, a.constant, a.linear, a.quadratic, Threshold );
+                }
+                else if ( light->getType() == Light::SPOT )
+                {
+                    const auto& a = static_cast<const SpotLight*>( light )->getAttenuation();
+                    range[i] = Core::LightClusters::getRange( intensity, a.constant, a.linear, a.quadratic, Threshold );
+                }
+            }
+
+            auto pushLight = [this]( const Light* light )
+            {
+                Core::Vector4f color = light->getColor().cast<float>();
+                color[3] = float( light->getType() );
+                Core::Vector4f position = Core::Vector4f::Zero();
+                Core::Vector4f direction = Core::Vector4f::Zero();
+                Core::Vector4f attenuation = Core::Vector4f::Zero();
+                if ( light->getType() == Light::DIRECTIONAL )
+                {
+                    direction.head<3>() = static_cast<const DirectionalLight*>( light )->getDirection().cast<float>();
+                }
+                else if ( light->getType() == Light::POINT )
+                {
+                    const PointLight* point = static_cast<const PointLight*>( light );
+                    const auto& a = point->getAttenuation();
+                    position.head<3>() = point->getPosition().cast<float>();
+                    attenuation = Core::Vector4f( a.constant, a.linear, a.quadratic, 0 );
+                }
+                else
+                {
+                    const SpotLight* spot = static_cast<const SpotLight*>( light );
+                    const auto& a = spot->getAttenuation();
+                    position = Core::Vector4f( spot->getPosition()[0], spot->getPosition()[1],
+                                               spot->getPosition()[2], spot->getInnerAngle() );
+                    direction = Core::Vector4f( spot->getDirection()[0], spot->getDirection()[1],
+                                                spot->getDirection()[2], spot->getOuterAngle() );
+                    attenuation = Core::Vector4f( a.constant, a.linear, a.quadratic, 0 );
+                }
+                m_lightData.push_back( color );
+                m_lightData.push_back( position );
+                m_lightData.push_back( direction );
+                m_lightData.push_back( attenuation );
+            };
+
+            // Global lights first, then the binned ones, in the order of their spheres.
+            m_lightData.clear();
+            m_spheres.clear();
+            for ( uint i = 0; i < lights.size(); ++i )
+            {
+                if ( range[i] == global )
+                {
+                    pushLight( lights[i] );
+                }
+            }
+            m_globalCount = m_lightData.size() / 4;
+            for ( uint i = 0; i < lights.size(); ++i )
+            {
+                if ( range[i] == global || range[i] <= 0 )
+                {
+                    continue;
+                }
+                const Core::Vector3& position = ( lights[i]->getType() == Light::POINT )
+                    ? static_cast<const PointLight*>( lights[i] )->getPosition()
+                    : static_cast<const SpotLight*>( lights[i] )->getPosition();
+                const Core::Vector4 center = renderData.viewMatrix * Core::Vector4( position[0], position[1], position[2], 1 );
+                m_spheres.push_back( Core::LightClusters::Light { center.head<3>(), range[i] } );
+                pushLight( lights[i] );
+            }
+
+            m_clusters.build( m_spheres );
+
+            if ( m_buffers[0] == 0 )
+            {
+                GL_ASSERT( glGenBuffers( Buffer_Count, m_buffers.data() ) );
+                GL_ASSERT( glGenTextures( Buffer_Count, m_textures.data() ) );
+            }
+            upload( Buffer_Lights, m_lightData.data(), m_lightData.size() * sizeof( Core::Vector4f ) );
+            upload( Buffer_Grid, m_clusters.getGrid().data(), m_clusters.getGrid().size() * sizeof( uint ) );
+            upload( Buffer_Indices, m_clusters.getIndices().data(), m_clusters.getIndices().size() * sizeof( uint ) );
+
+            return true;
+        }
+
+        void ClusteredLights::upload( Buffer buffer, const void* data, size_t bytes )
+        {
+            GL_ASSERT( glBindBuffer( GL_TEXTURE_BUFFER, m_buffers[buffer] ) );
+
+            // Orphan the previous frame data store, so that the upload does not wait for the draws using it.
+            const bool grow = ( bytes > m_capacity[buffer] );
+            if ( grow )
+            {
+                m_capacity[buffer] = std::max( std::max( bytes, 2 * m_capacity[buffer] ), size_t( 64 ) );
+            }
+            GL_ASSERT( glBufferData( GL_TEXTURE_BUFFER, m_capacity[buffer], nullptr, GL_STREAM_DRAW ) );
+            if ( bytes > 0 )
+            {
+                GL_ASSERT( glBufferSubData( GL_TEXTURE_BUFFER, 0, bytes, data ) );
+            }
+            GL_ASSERT( glBindBuffer( GL_TEXTURE_BUFFER, 0 ) );
+
+            if ( grow )
+            {
+                GL_ASSERT( glBindTexture( GL_TEXTURE_BUFFER, m_textures[buffer] ) );
+                GL_ASSERT( glTexBuffer( GL_TEXTURE_BUFFER, formats[buffer], m_buffers[buffer] ) );
+                GL_ASSERT( glBindTexture( GL_TEXTURE_BUFFER, 0 ) );
+            }
+        }
+
+        void ClusteredLights::bind( const ShaderProgram* shader ) const
+        {
+            const char* samplers[] = { "clusters.lights", "clusters.grid", "clusters.indices" };
+            for ( int i = 0; i < Buffer_Count; ++i )
+            {
+                GL_ASSERT( glActiveTexture( GL_TEXTURE0 + TextureUnit + i ) );
+                GL_ASSERT( glBindTexture( GL_TEXTURE_BUFFER, m_textures[i] ) );
+                shader->setUniform( samplers[i], TextureUnit + i );
+            }
+            GL_ASSERT( glActiveTexture( GL_TEXTURE0 ) );
+
+            shader->setUniform( "clusters.globalCount", int( m_globalCount ) );
+            shader->setUniform( "clusters.tileX", int( m_clusters.getTileX() ) );
+            shader->setUniform( "clusters.tileY", int( m_clusters.getTileY() ) );
+            shader->setUniform( "clusters.sliceZ", int( m_clusters.getSliceZ() ) );
+            shader->setUniform( "clusters.screen", m_screen );
+            shader->setUniform( "clusters.zNear", float( m_clusters.getNear() ) );
+            shader->setUniform( "clusters.sliceScale", float( m_clusters.getSliceScale() ) );
+        }
+
+    } // namespace Engine
+} // namespace Ra
@@ -0,0 +1,87 @@
+#ifndef RADIUMENGINE_CLUSTEREDLIGHTS_HPP
+#define RADIUMENGINE_CLUSTEREDLIGHTS_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <array>
+#include <vector>
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Utils/LightClusters.hpp>
+
+namespace Ra
+{
+    namespace Engine
+    {
+        class Light;
+        class ShaderProgram;
+        struct RenderData;
+    }
+}
+
+namespace Ra
+{
+    namespace Engine
+    {
+        /// Lights of a frame for single pass forward shading (see Shaders/BlinnPhongClustered.frag.glsl).
+        /// The point and spot lights are binned in the clusters of the view frustum (see Core::LightClusters),
+        /// directional and unattenuated lights are shaded everywhere.
+        /// The light data and the cluster lists are uploaded once per frame in texture buffers.
+        class RA_ENGINE_API ClusteredLights
+        {
+        public:
+            /// First texture unit used by the buffers, after the ones of the materials.
+            static const int TextureUnit = 5;
+
+        public:
+            ClusteredLights();
+            ~ClusteredLights();
+
+            /// Bins the lights in the clusters of the view and uploads them.
+            /// Returns false if the projection is not a perspective, in which case nothing is uploaded.
+            bool update( const std::vector<Light*>& lights, const RenderData& renderData,
+                         uint width, uint height );
+
+            /// Binds the buffers and sets the uniforms of the clustered lighting of a shader.
+            void bind( const ShaderProgram* shader ) const;
+
+            inline const Core::LightClusters& getClusters() const { return m_clusters; }
+
+            /// Number of lights shaded by every fragment.
+            inline uint getGlobalLightCount() const { return m_globalCount; }
+
+        private:
+            ClusteredLights( const ClusteredLights& ) = delete;
+            void operator=( const ClusteredLights& ) = delete;
+
+            enum Buffer
+            {
+                Buffer_Lights = 0,
+                Buffer_Grid,
+                Buffer_Indices,
+                Buffer_Count
+            };
+
+            /// Uploads data to a buffer, growing it if needed.
+            void upload( Buffer buffer, const void* data, size_t bytes );
+
+        private:
+            Core::LightClusters m_clusters;
+
+            // 4 texels per light, global lights first :
+            // color and type, position and inner angle, direction and outer angle, attenuation.
+            std::vector<Core::Vector4f> m_lightData;
+            std::vector<Core::LightClusters::Light> m_spheres; // Of the binned lights, in view space.
+            uint m_globalCount;
+
+            Core::Vector2f m_screen;
+
+            std::array<uint, Buffer_Count> m_buffers;
+            std::array<uint, Buffer_Count> m_textures;
+            std::array<size_t, Buffer_Count> m_capacity;
+        };
+
+    } // namespace Engine
+} // namespace Ra
+
+#endif // RADIUMENGINE_CLUSTEREDLIGHTS_HPP
@@ -2,10 +2,22 @@
 
 #include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Mesh/HalfEdge.hpp>
+#include <Core/Utils/VertexLayout.hpp>
+
+#include <cstring>
 
 namespace Ra {
     namespace Engine {
 
+        namespace
+        {
+#ifdef CORE_USE_DOUBLE
+            const GLenum ScalarType = GL_DOUBLE;
+#else
+            const GLenum ScalarType = GL_FLOAT;
+#endif
+        }
+
         // Dirty is initializes as false so that we do not create the vao while
         // we have no data to send to the gpu.
         Mesh::Mesh( const std::string& name, GLenum renderMode )
@@ -13,8 +25,15 @@ namespace Ra {
             , m_vao( 0 )
             , m_renderMode(renderMode)
             , m_numElements (0)
+            , m_geometryVersion( 0 )
             , m_isDirty( false )
+            , m_interleavedVbo( 0 )
+            , m_ringSlot( 0 )
+            , m_ringAdvanced( false )
+            , m_ringRegionFree( true )
         {
+            m_ringFences.fill( nullptr );
+
             CORE_ASSERT( m_renderMode == GL_LINES
                       || m_renderMode == GL_LINES_ADJACENCY
                       || m_renderMode == GL_TRIANGLES,
@@ -34,14 +53,40 @@ namespace Ra {
                         glDeleteBuffers(1, &vbo);
                     }
                 }
+
+                if ( m_interleavedVbo != 0 )
+                {
+                    glDeleteBuffers( 1, &m_interleavedVbo );
+                }
+
+                for ( auto& fence : m_ringFences )
+                {
+                    if ( fence != nullptr )
+                    {
+                        glDeleteSync( fence );
+                    }
+                }
             }
         }
 
         void Mesh::render()
+        {
+            bind();
+            draw();
+        }
+
+        void Mesh::bind()
         {
             if ( m_vao != 0 )
             {
                 GL_ASSERT( glBindVertexArray( m_vao ) );
+            }
+        }
+
+        void Mesh::draw()
+        {
+            if ( m_vao != 0 )
+            {
                 GL_ASSERT( glDrawElements( m_renderMode, m_numElements, GL_UNSIGNED_INT, (void*)0 ) );
             }
         }
@@ -52,8 +97,9 @@ namespace Ra {
             m_numElements = mesh.m_triangles.size() * 3;
             for (uint i = 0; i < MAX_MESH; ++i)
             {
-                m_dataDirty[i] = true;
+                m_dataDirty[i].addAll();
             }
+            ++m_geometryVersion;
             m_isDirty = true;
 
         }
@@ -80,8 +126,9 @@ namespace Ra {
             // Mark mesh as dirty.
             for (uint i = 0; i < MAX_MESH; ++i)
             {
-                m_dataDirty[i] = true;
+                m_dataDirty[i].addAll();
             }
+            ++m_geometryVersion;
             m_isDirty = true;
 
         }
@@ -89,14 +136,14 @@ namespace Ra {
         void Mesh::addData( const Vec3Data& type, const Core::Vector3Array& data )
         {
             m_v3Data[static_cast<uint>(type)] = data;
-            m_dataDirty[MAX_MESH + static_cast<uint>(type)] = true;
+            m_dataDirty[MAX_MESH + static_cast<uint>(type)].addAll();
             m_isDirty = true;
         }
 
         void Mesh::addData( const Vec4Data& type, const Core::Vector4Array& data )
         {
             m_v4Data[static_cast<uint>(type)] = data;
-            m_dataDirty[MAX_MESH + MAX_VEC3 + static_cast<uint>(type)] = true;
+            m_dataDirty[MAX_MESH + MAX_VEC3 + static_cast<uint>(type)].addAll();
             m_isDirty = true;
         }
 
@@ -104,38 +151,179 @@ namespace Ra {
         template< typename VecArray >
         void Mesh::sendGLData( const VecArray& arr, const uint vboIdx )
         {
-
-#ifdef CORE_USE_DOUBLE
-            GLenum type = GL_DOUBLE;
-#else
-            GLenum type = GL_FLOAT;
-#endif
             constexpr GLuint size = VecArray::Vector::RowsAtCompileTime;
             constexpr GLboolean normalized  = GL_FALSE;
-            constexpr GLint64 ptr = 0;
+            constexpr uint elementSize = sizeof( typename VecArray::Vector );
 
-            // This vbo has not been created yet
-            if ( m_vbos[vboIdx] == 0 && arr.size() > 0 )
+            if ( m_dataDirty[vboIdx].isEmpty() )
+            {
+                m_streamCounts[vboIdx] = 0;
+                return;
+            }
+
+            if ( arr.empty() )
+            {
+                GL_ASSERT( glDisableVertexAttribArray( vboIdx - 1 ) );
+                m_dataDirty[vboIdx].clear();
+                m_streamCounts[vboIdx] = 0;
+                return;
+            }
+
+            // Data rewritten entirely at consecutive updates are streamed, other data are updated in place.
+            m_streamCounts[vboIdx] = m_dataDirty[vboIdx].isAll( arr.size() ) ? m_streamCounts[vboIdx] + 1 : 0;
+            uint offset = 0;
+            if ( m_streamCounts[vboIdx] >= StreamUpdates )
+            {
+                offset = streamData( vboIdx, arr.data(), arr.size() * elementSize );
+            }
+            else
+            {
+                uploadData( GL_ARRAY_BUFFER, vboIdx, arr.data(), elementSize, arr.size() );
+            }
+
+            // Use (vboIdx - 1) as attribute index because vbo 0 is actually ibo.
+            GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
+            GL_ASSERT( glVertexAttribPointer( vboIdx - 1, size, ScalarType, normalized,
+                                              elementSize, (GLvoid*)GLint64( offset ) ) );
+            GL_ASSERT( glEnableVertexAttribArray( vboIdx - 1 ) );
+        }
+
+        void Mesh::uploadData( GLenum target, uint vboIdx, const void* data, uint elementSize, uint count )
+        {
+            Core::DirtyRanges& dirty = m_dataDirty[vboIdx];
+            const uint bytes = count * elementSize;
+
+            if ( m_vbos[vboIdx] == 0 )
             {
                 GL_ASSERT( glGenBuffers( 1, &m_vbos[vboIdx] ) );
-                GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
-                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, arr.size() * sizeof( typename VecArray::Vector ),
-                arr.data(), GL_DYNAMIC_DRAW ) );
+            }
+            GL_ASSERT( glBindBuffer( target, m_vbos[vboIdx] ) );
 
-                // Use (vboIdx - 1) as attribute index because vbo 0 is actually ibo.
-                GL_ASSERT( glVertexAttribPointer( vboIdx - 1, size, type, normalized,
-                                                  sizeof( typename VecArray::Vector ), (GLvoid*)ptr ) );
+            if ( bytes != m_vboSizes[vboIdx] )
+            {
+                GL_ASSERT( glBufferData( target, bytes, data, GL_DYNAMIC_DRAW ) );
+                m_vboSizes[vboIdx] = bytes;
+            }
+            else
+            {
+                dirty.clamp( count );
+                for ( uint i = 0; i < dirty.size(); ++i )
+                {
+                    const uint begin = dirty[i].m_begin * elementSize;
+                    const uint end = dirty[i].m_end * elementSize;
+                    GL_ASSERT( glBufferSubData( target, begin, end - begin, static_cast<const char*>( data ) + begin ) );
+                }
+            }
+            dirty.clear();
+        }
+
+        uint Mesh::streamData( uint vboIdx, const void* data, uint size )
+        {
+            if ( !m_ringAdvanced )
+            {
+                advanceRing();
+                m_ringAdvanced = true;
+            }
+
+            if ( m_vbos[vboIdx] == 0 )
+            {
+                GL_ASSERT( glGenBuffers( 1, &m_vbos[vboIdx] ) );
+            }
+            GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
+
+            if ( m_vboSizes[vboIdx] != RingSize * size )
+            {
+                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, RingSize * size, nullptr, GL_STREAM_DRAW ) );
+                m_vboSizes[vboIdx] = RingSize * size;
+            }
+
+            // If the fence of the region was waited for, there is no need for the driver to synchronize.
+            const uint offset = m_ringSlot * size;
+            const GLbitfield sync = m_ringRegionFree ? GL_MAP_UNSYNCHRONIZED_BIT : 0;
+            void* dst = glMapBufferRange( GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT |
+                                          GL_MAP_INVALIDATE_RANGE_BIT | sync );
+            if ( dst != nullptr )
+            {
+                std::memcpy( dst, data, size );
+            }
+            GL_ASSERT( glUnmapBuffer( GL_ARRAY_BUFFER ) );
+
+            m_dataDirty[vboIdx].clear();
+            return offset;
+        }
+
+        void Mesh::advanceRing()
+        {
+            // The draws issued since the last update read the current region.
+            if ( m_ringFences[m_ringSlot] != nullptr )
+            {
+                glDeleteSync( m_ringFences[m_ringSlot] );
+            }
+            m_ringFences[m_ringSlot] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+            m_ringSlot = ( m_ringSlot + 1 ) % RingSize;
+            m_ringRegionFree = true;
+            if ( m_ringFences[m_ringSlot] != nullptr )
+            {
+                // The draws will complete : keep waiting on timeouts. Only a failed wait
+                // leaves the region in use.
+                GLenum status = glClientWaitSync( m_ringFences[m_ringSlot], GL_SYNC_FLUSH_COMMANDS_BIT,
+                                                  GLuint64( 1000000000 ) );
+                while ( status == GL_TIMEOUT_EXPIRED )
+                {
+                    status = glClientWaitSync( m_ringFences[m_ringSlot], 0, GLuint64( 1000000000 ) );
+                }
+                m_ringRegionFree = ( status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED );
+                glDeleteSync( m_ringFences[m_ringSlot] );
+                m_ringFences[m_ringSlot] = nullptr;
+            }
+        }
 
-                GL_ASSERT( glEnableVertexAttribArray( vboIdx - 1 ) );
+        void Mesh::uploadInterleaved()
+        {
+            const uint size = m_mesh.m_vertices.size();
 
+            // Use (vboIdx - 1) as attribute index because vbo 0 is actually ibo.
+            Core::VertexLayout layout;
+            layout.addAttribute( VERTEX_POSITION - 1, m_mesh.m_vertices );
+            if ( m_mesh.m_normals.size() == size )
+            {
+                layout.addAttribute( VERTEX_NORMAL - 1, m_mesh.m_normals );
             }
+            for ( uint i = 0; i < MAX_VEC3; ++i )
+            {
+                if ( m_v3Data[i].size() == size )
+                {
+                    layout.addAttribute( MAX_MESH + i - 1, m_v3Data[i] );
+                }
+            }
+            for ( uint i = 0; i < MAX_VEC4; ++i )
+            {
+                if ( m_v4Data[i].size() == size )
+                {
+                    layout.addAttribute( MAX_MESH + MAX_VEC3 + i - 1, m_v4Data[i] );
+                }
+            }
+
+            std::vector<Scalar> buffer;
+            layout.pack( size, buffer );
 
-            if ( m_dataDirty[vboIdx] == true && m_vbos[vboIdx] != 0 && arr.size() > 0 )
+            GL_ASSERT( glGenBuffers( 1, &m_interleavedVbo ) );
+            GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_interleavedVbo ) );
+            GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, buffer.size() * sizeof( Scalar ), buffer.data(), GL_STATIC_DRAW ) );
+
+            const GLsizei stride = layout.getStride() * sizeof( Scalar );
+            for ( uint i = 0; i < layout.size(); ++i )
+            {
+                const Core::VertexLayout::Attribute& attribute = layout[i];
+                GL_ASSERT( glVertexAttribPointer( attribute.m_index, attribute.m_component, ScalarType, GL_FALSE,
+                                                  stride, (GLvoid*)GLint64( attribute.m_offset * sizeof( Scalar ) ) ) );
+                GL_ASSERT( glEnableVertexAttribArray( attribute.m_index ) );
+            }
+
+            for ( uint i = INDEX + 1; i < MAX_DATA; ++i )
             {
-                GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
-                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, arr.size() * sizeof( typename VecArray::Vector ),
-                arr.data(), GL_DYNAMIC_DRAW ) );
-                m_dataDirty[vboIdx] = false;
+                m_dataDirty[i].clear();
             }
         }
 
@@ -144,12 +332,13 @@ namespace Ra {
             if ( m_isDirty )
             {
                 // Check that our dirty bits are consistent.
-                ON_DEBUG(bool dirtyTest = false; for (const auto& d : m_dataDirty) { dirtyTest = dirtyTest || d;});
+                ON_DEBUG(bool dirtyTest = false; for (const auto& d : m_dataDirty) { dirtyTest = dirtyTest || !d.isEmpty();});
                 CORE_ASSERT( dirtyTest == m_isDirty, "Dirty flags inconsistency");
 
                 CORE_ASSERT( ! ( m_mesh.m_vertices.empty()|| m_mesh.m_triangles.empty() ),
                              "Either vertices or indices are empty arrays.");
 
+                const bool firstUpload = ( m_vao == 0 );
                 if ( m_vao == 0 )
                 {
                     // Create VAO if it does not exist
@@ -159,32 +348,51 @@ namespace Ra {
                 // Bind it
                 GL_ASSERT( glBindVertexArray( m_vao ) );
 
-                if (m_vbos[INDEX] == 0 )
+                if ( !m_dataDirty[INDEX].isEmpty() )
                 {
-                    GL_ASSERT( glGenBuffers( 1, &m_vbos[INDEX]) );
-                    GL_ASSERT( glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_vbos[INDEX]) );
+                    uploadData( GL_ELEMENT_ARRAY_BUFFER, INDEX, m_mesh.m_triangles.data(),
+                                sizeof( Ra::Core::Triangle ), m_mesh.m_triangles.size() );
                 }
-                if (m_dataDirty[INDEX])
+
+                bool vertexDirty = false;
+                for ( uint i = INDEX + 1; i < MAX_DATA; ++i )
                 {
-                    GL_ASSERT( glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_mesh.m_triangles.size() * sizeof( Ra::Core::Triangle ),
-                                             m_mesh.m_triangles.data(), GL_DYNAMIC_DRAW ) );
-                    m_dataDirty[INDEX] = false;
+                    vertexDirty = vertexDirty || !m_dataDirty[i].isEmpty();
+                }
 
+                if ( firstUpload )
+                {
+                    uploadInterleaved();
                 }
+                else if ( vertexDirty )
+                {
+                    // The vertex data changes : one buffer per attribute from now on.
+                    if ( m_interleavedVbo != 0 )
+                    {
+                        GL_ASSERT( glDeleteBuffers( 1, &m_interleavedVbo ) );
+                        m_interleavedVbo = 0;
+                        for ( uint i = INDEX + 1; i < MAX_DATA; ++i )
+                        {
+                            m_dataDirty[i].addAll();
+                        }
+                    }
+
+                    m_ringAdvanced = false;
 
-                // Geometry data
-                sendGLData(m_mesh.m_vertices, VERTEX_POSITION);
-                sendGLData(m_mesh.m_normals,  VERTEX_NORMAL);
+                    // Geometry data
+                    sendGLData(m_mesh.m_vertices, VERTEX_POSITION);
+                    sendGLData(m_mesh.m_normals,  VERTEX_NORMAL);
 
-                // Vec3 data
-                sendGLData(m_v3Data[VERTEX_TANGENT],   MAX_MESH + VERTEX_TANGENT);
-                sendGLData(m_v3Data[VERTEX_BITANGENT], MAX_MESH + VERTEX_BITANGENT);
-                sendGLData(m_v3Data[VERTEX_TEXCOORD],  MAX_MESH + VERTEX_TEXCOORD);
+                    // Vec3 data
+                    sendGLData(m_v3Data[VERTEX_TANGENT],   MAX_MESH + VERTEX_TANGENT);
+                    sendGLData(m_v3Data[VERTEX_BITANGENT], MAX_MESH + VERTEX_BITANGENT);
+                    sendGLData(m_v3Data[VERTEX_TEXCOORD],  MAX_MESH + VERTEX_TEXCOORD);
 
-                // Vec4 data
-                sendGLData(m_v4Data[VERTEX_COLOR],      MAX_MESH + MAX_VEC3 + VERTEX_COLOR );
-                sendGLData(m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
-                sendGLData(m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
+                    // Vec4 data
+                    sendGLData(m_v4Data[VERTEX_COLOR],      MAX_MESH + MAX_VEC3 + VERTEX_COLOR );
+                    sendGLData(m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
+                    sendGLData(m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
+                }
 
                 GL_ASSERT( glBindVertexArray( 0 ) );
 
@@ -11,6 +11,7 @@
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Containers/VectorArray.hpp>
 #include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Utils/DirtyRanges.hpp>
 #include <Engine/Renderer/RenderObject/RenderObject.hpp>
 
 namespace Ra
@@ -31,7 +32,13 @@ namespace Ra
         /// A class representing an openGL general mesh to be displayed.
         /// It stores the vertex attributes, indices, and can be rendered
         /// with a specific render mode (e.g. GL_TRIANGLES or GL_LINES).
-        /// It maintains the attributes and keeps them in sync with the GPU.
+        /// It maintains the attributes and keeps them in sync with the GPU :
+        /// - the vertex attributes are first uploaded in one interleaved buffer, which suits meshes which never
+        ///   change. The first update of the vertex data moves the mesh to one buffer per attribute.
+        /// - only the dirty ranges of an attribute are sent to its buffer, which is reallocated only if its size
+        ///   changes.
+        /// - attributes rewritten entirely at every update (e.g. skinned vertices) are streamed in a ring of
+        ///   RingSize regions of their buffer, so that an update does not wait for the draws of the previous frames.
         class RA_ENGINE_API Mesh
         {
         public:
@@ -106,6 +113,16 @@ namespace Ra
             inline void setDirty( const Vec3Data& type );
             inline void setDirty( const Vec4Data& type );
 
+            /// Mark the elements [begin, end) of one of the data types as dirty (triangles for INDEX) :
+            /// only the dirty elements are sent to the openGL buffer.
+            inline void setDirty( const MeshData& type, uint begin, uint end );
+            inline void setDirty( const Vec3Data& type, uint begin, uint end );
+            inline void setDirty( const Vec4Data& type, uint begin, uint end );
+
+            /// Counter incremented each time the vertex positions are loaded or marked as dirty.
+            /// Objects caching data computed from the geometry (e.g. bounding boxes) compare it to their copy.
+            inline uint getGeometryVersion() const;
+
             /// This function is called at the start of the rendering. It will update the
             /// necessary openGL buffers.
             void updateGL();
@@ -113,6 +130,10 @@ namespace Ra
             /// Draw the mesh.
             void render();
 
+            /// Same as render() in two steps, so that consecutive draws of the mesh bind it once.
+            void bind();
+            void draw();
+
         private:
             Mesh(const Mesh& rhs) = delete;
             void operator=(const Mesh& rhs) = delete;
@@ -121,6 +142,19 @@ namespace Ra
             template < typename VecArray >
             void sendGLData( const VecArray& arr, const uint vboIdx );
 
+            /// Sends the dirty ranges of an array to its buffer, reallocated only if its size changed.
+            void uploadData( GLenum target, uint vboIdx, const void* data, uint elementSize, uint count );
+
+            /// Writes a whole array in the current region of its ring buffer, and returns the region offset.
+            uint streamData( uint vboIdx, const void* data, uint size );
+
+            /// Moves the ring buffers to their next region, waiting for the draws reading it to complete.
+            /// If the wait fails, the region is marked as not free and is written with synchronization.
+            void advanceRing();
+
+            /// Sends all the vertex attributes in one interleaved buffer.
+            void uploadInterleaved();
+
         private:
             std::string m_name;  /// Name of the mesh.
 
@@ -140,11 +174,25 @@ namespace Ra
             // vbo index - 1 (thus vertex position is VBO number 1 but attribute 0).
 
             std::array<uint, MAX_DATA> m_vbos = {{ 0 }}; /// Indices of our openGL VBOs.
-            std::array<bool, MAX_DATA> m_dataDirty = {{ false }}; /// Dirty bits of our vertex data.
+            std::array<Core::DirtyRanges, MAX_DATA> m_dataDirty; /// Dirty elements of our vertex data.
+            std::array<uint, MAX_DATA> m_vboSizes = {{ 0 }}; /// Sizes in bytes of the VBOs storage.
+            std::array<uint, MAX_DATA> m_streamCounts = {{ 0 }}; /// Consecutive updates rewriting each data entirely.
+
+            uint m_interleavedVbo; /// VBO of the vertex attributes until they are first updated, 0 afterwards.
+
+            static const uint RingSize = 3;      /// Number of regions of the ring buffers.
+            static const uint StreamUpdates = 2; /// Consecutive entire rewrites after which an attribute is streamed.
+
+            uint m_ringSlot;                           /// Region of the ring buffers written by the last update.
+            bool m_ringAdvanced;                       /// Whether the current update already advanced the ring.
+            bool m_ringRegionFree;                     /// Whether the draws reading the current region completed.
+            std::array<GLsync, RingSize> m_ringFences; /// Completion of the draws reading each region.
 
             uint m_numElements; /// number of elements to draw. For triangles this is 3*numTriangles but not for lines.
             // (val) : this is a bit hacky.
 
+            uint m_geometryVersion; /// Version of the vertex positions, see getGeometryVersion().
+
             bool m_isDirty; /// General dirty bit of the mesh.
             // TODO (Val) this flag could just be replaced by an efficient "or" of the other flags.
         };
@@ -27,9 +27,34 @@ namespace Engine {
         return m_v4Data[static_cast<uint>(type)];
     }
 
-    void Mesh::setDirty(const Mesh::MeshData &type) { m_dataDirty[type] = true; m_isDirty = true;}
-    void Mesh::setDirty(const Mesh::Vec3Data &type) { m_dataDirty[MAX_MESH + type] = true; m_isDirty = true;}
-    void Mesh::setDirty(const Mesh::Vec4Data &type) { m_dataDirty[MAX_MESH + MAX_VEC3 + type ] = true ; m_isDirty = true;}
+    void Mesh::setDirty(const Mesh::MeshData &type)
+    {
+        setDirty( type, 0, uint( -1 ) );
+    }
+    void Mesh::setDirty(const Mesh::Vec3Data &type) { setDirty( type, 0, uint( -1 ) ); }
+    void Mesh::setDirty(const Mesh::Vec4Data &type) { setDirty( type, 0, uint( -1 ) ); }
+
+    void Mesh::setDirty(const Mesh::MeshData &type, uint begin, uint end)
+    {
+        m_dataDirty[type].add( begin, end );
+        m_isDirty = true;
+        if ( type == VERTEX_POSITION )
+        {
+            ++m_geometryVersion;
+        }
+    }
+    void Mesh::setDirty(const Mesh::Vec3Data &type, uint begin, uint end)
+    {
+        m_dataDirty[MAX_MESH + type].add( begin, end );
+        m_isDirty = true;
+    }
+    void Mesh::setDirty(const Mesh::Vec4Data &type, uint begin, uint end)
+    {
+        m_dataDirty[MAX_MESH + MAX_VEC3 + type].add( begin, end );
+        m_isDirty = true;
+    }
+
+    uint Mesh::getGeometryVersion() const { return m_geometryVersion; }
 
 }
 }
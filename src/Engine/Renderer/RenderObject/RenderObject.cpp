@@ -32,6 +32,8 @@ namespace Ra
             , m_type( type )
             , m_renderTechnique( nullptr )
             , m_mesh( nullptr )
+            , m_aabbVersion( 0 )
+            , m_localTransformVersion( 0 )
             , m_lifetime( lifetime )
             , m_visible( true )
             , m_xray( false )
@@ -292,9 +294,28 @@ namespace Ra
             return m_renderTechnique;
         }
 
+        const RenderParameters& RenderObject::getRenderParameters() const
+        {
+            return m_renderParameters;
+        }
+
+        RenderParameters& RenderObject::getRenderParameters()
+        {
+            return m_renderParameters;
+        }
+
+        void RenderObject::bindRenderParameters( const ShaderProgram* shader ) const
+        {
+            shader->setUniform( "skinning.enabled", 0 );
+            m_renderParameters.bind( shader );
+        }
+
         void RenderObject::setMesh( const std::shared_ptr<Mesh>& mesh )
         {
-            m_mesh = mesh;
+            std::lock_guard<std::mutex> lock( m_aabbMutex );
+            // getAabb() reads the pointer without locking.
+            std::atomic_store( &m_mesh, mesh );
+            m_aabbVersion.fetch_add( 1, std::memory_order_release );
         }
 
         std::shared_ptr<const Mesh> RenderObject::getMesh() const
@@ -319,15 +340,39 @@ namespace Ra
 
         Core::Aabb RenderObject::getAabb() const
         {
-            Core::Aabb aabb = Core::MeshUtils::getAabb(m_mesh->getGeometry());
-            Core::Aabb result;
+            // The versions are read before the data, a change in between is caught at the next call.
+            // The mesh is read after its version, and copied as setMesh() may replace it meanwhile.
+            const uint aabbVersion = m_aabbVersion.load( std::memory_order_acquire );
+            const std::shared_ptr<const Mesh> mesh = std::atomic_load( &m_mesh );
+            const std::uint64_t localVersion = Core::AabbCache::makeVersion( aabbVersion, mesh->getGeometryVersion() );
+            const std::uint64_t transformVersion =
+                Core::AabbCache::makeVersion( m_component->getEntity()->getTransformVersion(),
+                                              m_localTransformVersion.load( std::memory_order_acquire ) );
+
+            Core::Aabb aabb;
+            if ( m_aabbCache.getAabb( localVersion, transformVersion, aabb ) )
+            {
+                return aabb;
+            }
 
-            for (int i = 0; i < 8; ++i)
+            std::lock_guard<std::mutex> lock( m_aabbMutex );
+            if ( m_aabbCache.getAabb( localVersion, transformVersion, aabb ) )
+            {
+                return aabb;
+            }
+            if ( !m_aabbCache.isLocalValid( localVersion ) )
             {
-                result.extend(getTransform() * aabb.corner((Core::Aabb::CornerType)i));
+                m_aabbCache.setLocalAabb( m_customAabb.isEmpty() ? Core::MeshUtils::getAabb( mesh->getGeometry() )
+                                                                 : m_customAabb, localVersion );
             }
+            return m_aabbCache.update( getTransform(), transformVersion );
+        }
 
-            return result;
+        void RenderObject::setCustomAabb( const Core::Aabb& aabb )
+        {
+            std::lock_guard<std::mutex> lock( m_aabbMutex );
+            m_customAabb = aabb;
+            m_aabbVersion.fetch_add( 1, std::memory_order_release );
         }
 
         Core::Aabb RenderObject::getMeshAabb() const
@@ -338,11 +383,13 @@ namespace Ra
         void RenderObject::setLocalTransform( const Core::Transform& transform )
         {
             m_localTransform = transform;
+            m_localTransformVersion.fetch_add( 1, std::memory_order_release );
         }
 
         void RenderObject::setLocalTransform( const Core::Matrix4& transform )
         {
             m_localTransform = Core::Transform( transform );
+            m_localTransformVersion.fetch_add( 1, std::memory_order_release );
         }
 
         const Core::Transform& RenderObject::getLocalTransform() const
@@ -396,6 +443,7 @@ namespace Ra
                 lightParams.bind( shader );
 
                 getRenderTechnique()->material->bind( shader );
+                bindRenderParameters( shader );
 
                 // render
                 getMesh()->render();
@@ -4,11 +4,13 @@
 #include <Engine/RaEngine.hpp>
 
 #include <string>
+#include <atomic>
 #include <mutex>
 #include <memory>
 
 #include <Core/Index/IndexedObject.hpp>
 #include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Math/AabbCache.hpp>
 #include <Engine/Renderer/RenderTechnique/Material.hpp>
 #include <Engine/Renderer/RenderTechnique/RenderParameters.hpp>
 #include <Engine/Renderer/RenderObject/RenderObjectTypes.hpp>
@@ -98,6 +100,14 @@ namespace Ra
             const RenderTechnique* getRenderTechnique() const;
             RenderTechnique* getRenderTechnique();
 
+            /// Per-object uniforms (e.g. the bone palette of a skinned mesh), bound after the material.
+            const RenderParameters& getRenderParameters() const;
+            RenderParameters& getRenderParameters();
+
+            /// Binds the per-object uniforms. Uniforms which are only set by some objects
+            /// (skinning) are reset first, as they are part of the shader state.
+            void bindRenderParameters( const ShaderProgram* shader ) const;
+
             void setMesh( const std::shared_ptr<Mesh>& mesh );
             std::shared_ptr<const Mesh> getMesh() const;
             const std::shared_ptr<Mesh>& getMesh();
@@ -105,9 +115,17 @@ namespace Ra
             Core::Transform getTransform() const;
             Core::Matrix4 getTransformAsMatrix() const;
 
+            /// World space bounding box. It is cached : an up to date box is read without locking,
+            /// the lock is only taken when the box is outdated or being updated. The local box is recomputed when the mesh vertices
+            /// changed (see Mesh::getGeometryVersion()), the world box is transformed from it in O(1)
+            /// when the transform changed (see Entity::getTransformVersion()).
             Core::Aabb getAabb() const;
             Core::Aabb getMeshAabb() const;
 
+            /// Sets a local bounding box used instead of the one of the mesh, e.g. when the
+            /// vertices are deformed by the vertex shader. An empty box restores the mesh one.
+            void setCustomAabb( const Core::Aabb& aabb );
+
             void setLocalTransform( const Core::Transform& transform );
             void setLocalTransform( const Core::Matrix4& transform );
             const Core::Transform& getLocalTransform() const;
@@ -131,11 +149,17 @@ namespace Ra
             RenderTechnique* m_renderTechnique;
             std::shared_ptr<Mesh> m_mesh;
 
-            // FIXME(Charly): Remove this
             RenderParameters m_renderParameters;
 
             mutable std::mutex m_updateMutex;
 
+            // Bounding box cache, see getAabb().
+            Core::Aabb m_customAabb;
+            mutable Core::AabbCache m_aabbCache;
+            std::atomic<uint> m_aabbVersion; // Changed by setMesh() and setCustomAabb().
+            std::atomic<uint> m_localTransformVersion;
+            mutable std::mutex m_aabbMutex;
+
             int m_lifetime;
 
             bool m_visible;
@@ -3,6 +3,8 @@
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Component/Component.hpp>
+#include <Engine/Renderer/Mesh/Mesh.hpp>
+#include <Engine/Renderer/RenderObject/RenderObject.hpp>
 
 namespace Ra
 {
@@ -37,7 +39,7 @@ namespace Ra
             m_renderObjectByType[(int)type].insert( index );
 
             if (type == RenderObjectType::Fancy)
-                m_fancyBVH.insertLeaf(newRenderObject);
+                m_fancyCulling.addObject( newRenderObject );
 
             Engine::RadiumEngine::getInstance()->getSignalManager()->fireRenderObjectAdded(
                     ItemEntry( renderObject->getComponent()->getEntity(),
@@ -64,6 +66,8 @@ namespace Ra
             m_renderObjects.remove( index );
             auto type = renderObject->getType();
             m_renderObjectByType[(int)type].erase( index );
+            if (type == RenderObjectType::Fancy)
+                m_fancyCulling.removeObject( renderObject );
             renderObject.reset();
         }
 
@@ -92,15 +96,15 @@ namespace Ra
             // Take the mutex
             std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
 
-            /*if (type == RenderObjectType::Fancy)
+            if ( type == RenderObjectType::Fancy )
             {
-                Core::Matrix4 mvp(renderData.projMatrix * renderData.viewMatrix);
-                m_fancyBVH.update();
-                m_fancyBVH.getInFrustumSlow(objectsOut, Core::Frustum(mvp));
+                // Only the objects whose bounding box intersects the view frustum are rendered.
+                const Core::Matrix4 viewProj = renderData.projMatrix * renderData.viewMatrix;
+                m_fancyCulling.cull( Core::Frustum( viewProj ), objectsOut );
             }
-            else*/
+            else
             {
-                //// Copy each element in m_renderObjects
+                // Copy each element in m_renderObjects
                 for ( const auto& idx : m_renderObjectByType[(int)type] )
                 {
                     objectsOut.push_back( m_renderObjects.at( idx ) );
@@ -108,6 +112,24 @@ namespace Ra
             }
         }
 
+        void RenderObjectManager::setCullingEnabled( bool enabled )
+        {
+            std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
+            m_fancyCulling.setEnabled( enabled );
+        }
+
+        bool RenderObjectManager::isCullingEnabled() const
+        {
+            std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
+            return m_fancyCulling.isEnabled();
+        }
+
+        RenderObjectManager::CullingStats RenderObjectManager::getCullingStats() const
+        {
+            std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
+            return m_fancyCulling.getStats();
+        }
+
         void RenderObjectManager::renderObjectExpired( const Core::Index& idx )
         {
             std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
@@ -118,6 +140,8 @@ namespace Ra
             auto type = ro->getType();
 
             m_renderObjectByType[(int)type].erase( idx );
+            if (type == RenderObjectType::Fancy)
+                m_fancyCulling.removeObject( ro );
 
             ro->hasExpired();
 
@@ -13,7 +13,7 @@
 
 #include <Core/Index/Index.hpp>
 #include <Core/Index/IndexMap.hpp>
-#include <Core/TreeStructures/BVH.hpp>
+#include <Core/TreeStructures/CullingStage.hpp>
 #include <Core/Math/Frustum.hpp>
 #include <Engine/Renderer/RenderObject/RenderObjectTypes.hpp>
 #include <Engine/Renderer/Renderer.hpp>
@@ -26,6 +26,9 @@ namespace Ra
 
         class RA_ENGINE_API RenderObjectManager
         {
+        public:
+            typedef Core::CullingStage<RenderObject>::Stats CullingStats;
+
         public:
             RenderObjectManager();
             ~RenderObjectManager();
@@ -43,9 +46,18 @@ namespace Ra
              */
             void getRenderObjects( std::vector<std::shared_ptr<RenderObject>>& objectsOut) const;
 
+            /// Appends the render objects of the given type to objectsOut. Fancy objects outside
+            /// of the view frustum of renderData are skipped when culling is enabled.
             void getRenderObjectsByType( const RenderData& renderData, std::vector<std::shared_ptr<RenderObject>>& objectsOut,
                                          const RenderObjectType& type ) const;
 
+            /// Enables or disables the frustum culling of fancy objects (enabled by default).
+            void setCullingEnabled( bool enabled );
+            bool isCullingEnabled() const;
+
+            /// Number of fancy objects visible and culled by the last getRenderObjectsByType().
+            CullingStats getCullingStats() const;
+
             /// Returns true if the index points to a valid render object.
             bool exists( const Core::Index& index) const;
 
@@ -62,7 +74,7 @@ namespace Ra
         private:
             Core::IndexMap<std::shared_ptr<RenderObject>> m_renderObjects;
 
-            mutable Core::BVH<RenderObject> m_fancyBVH ;
+            mutable Core::CullingStage<RenderObject> m_fancyCulling;
 
             std::array<std::set<Core::Index>, (int)RenderObjectType::Count> m_renderObjectByType;
 
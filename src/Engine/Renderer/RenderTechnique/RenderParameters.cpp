@@ -19,6 +19,8 @@ namespace Ra
             m_mat3ParamsVector.bind( shader );
             m_mat4ParamsVector.bind( shader );
 
+            m_mat4ArrayParamsVector.bind( shader );
+
             m_texParamsVector.bind( shader );
         }
 
@@ -67,6 +69,11 @@ namespace Ra
             m_mat4ParamsVector[name] = Mat4Parameter( name, value );
         }
 
+        void RenderParameters::addParameter( const char* name, const Core::AlignedStdVector<Core::Matrix4>& values )
+        {
+            m_mat4ArrayParamsVector[name] = Mat4ArrayParameter( name, values );
+        }
+
         void RenderParameters::addParameter( const char* name, Texture* tex, int texUnit )
         {
             m_texParamsVector[name] = TextureParameter( name, tex, texUnit );
@@ -117,6 +124,13 @@ namespace Ra
             m_mat4ParamsVector[name] = Mat4Parameter( name, value );
         }
 
+        void RenderParameters::updateParameter( const char* name, const Core::AlignedStdVector<Core::Matrix4>& values )
+        {
+            // Reuse the storage of the array, which is typically updated every frame.
+            m_mat4ArrayParamsVector[name].m_name = name;
+            m_mat4ArrayParamsVector[name].m_value.assign( values.begin(), values.end() );
+        }
+
         void RenderParameters::concatParameters( const RenderParameters &params )
         {
             for (const auto& param : params.m_intParamsVector)
@@ -164,6 +178,11 @@ namespace Ra
                 m_mat4ParamsVector.insert( param );
             }
 
+            for (const auto& param : params.m_mat4ArrayParamsVector)
+            {
+                m_mat4ArrayParamsVector.insert( param );
+            }
+
             for (const auto& param : params.m_texParamsVector)
             {
                 m_texParamsVector.insert( param );
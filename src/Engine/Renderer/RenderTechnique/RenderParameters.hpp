@@ -78,6 +78,8 @@ namespace Ra
             typedef TParameter<Core::Matrix3> Mat3Parameter;
             typedef TParameter<Core::Matrix4> Mat4Parameter;
 
+            typedef TParameter<Core::AlignedStdVector<Core::Matrix4>> Mat4ArrayParameter;
+
         public:
             void addParameter( const char* name, int    value );
             void addParameter( const char* name, uint   value );
@@ -91,6 +93,8 @@ namespace Ra
             void addParameter( const char* name, const Core::Matrix3& value );
             void addParameter( const char* name, const Core::Matrix4& value );
 
+            void addParameter( const char* name, const Core::AlignedStdVector<Core::Matrix4>& values );
+
             void addParameter( const char* name, Texture* tex, int texUnit );
 
             void updateParameter( const char* name, int    value );
@@ -105,10 +109,15 @@ namespace Ra
             void updateParameter( const char* name, const Core::Matrix3& value );
             void updateParameter( const char* name, const Core::Matrix4& value );
 
+            void updateParameter( const char* name, const Core::AlignedStdVector<Core::Matrix4>& values );
+
             void concatParameters( const RenderParameters& params );
 
             void bind(const ShaderProgram* shader ) const;
 
+            /// True if bind() binds textures, which may replace the ones of a material.
+            bool hasTextures() const { return !m_texParamsVector.empty(); }
+
             void print() const
             {
                 for (const auto& p : m_scalarParamsVector)
@@ -131,6 +140,8 @@ namespace Ra
             UniformBindableVector<Mat3Parameter>    m_mat3ParamsVector;
             UniformBindableVector<Mat4Parameter>    m_mat4ParamsVector;
 
+            UniformBindableVector<Mat4ArrayParameter> m_mat4ArrayParamsVector;
+
             UniformBindableVector<TextureParameter> m_texParamsVector;
         };
 
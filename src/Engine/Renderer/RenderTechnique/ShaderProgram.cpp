@@ -359,9 +359,85 @@ namespace Ra
             return true;
         }
 
+        namespace
+        {
+            uint glActiveUniformSize( uint program )
+            {
+                GLint size = 0;
+                GL_ASSERT( glGetProgramiv( program, GL_ACTIVE_UNIFORMS, &size ) );
+                return size;
+            }
+
+            uint glActiveAttributeSize( uint program )
+            {
+                GLint size = 0;
+                GL_ASSERT( glGetProgramiv( program, GL_ACTIVE_ATTRIBUTES, &size ) );
+                return size;
+            }
+
+            void glActiveUniform( uint program, uint i, std::string& name, int& location )
+            {
+                GLint length = 0;
+                GLint size;
+                GLenum type;
+                GL_ASSERT( glGetProgramiv( program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &length ) );
+                std::vector<GLchar> buffer( length + 1, 0 );
+                GL_ASSERT( glGetActiveUniform( program, i, buffer.size(), &length, &size, &type, buffer.data() ) );
+                name.assign( buffer.data(), length );
+                GL_ASSERT( location = glGetUniformLocation( program, buffer.data() ) );
+            }
+
+            void glActiveAttribute( uint program, uint i, std::string& name, int& location )
+            {
+                GLint length = 0;
+                GLint size;
+                GLenum type;
+                GL_ASSERT( glGetProgramiv( program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &length ) );
+                std::vector<GLchar> buffer( length + 1, 0 );
+                GL_ASSERT( glGetActiveAttrib( program, i, buffer.size(), &length, &size, &type, buffer.data() ) );
+                name.assign( buffer.data(), length );
+                GL_ASSERT( location = glGetAttribLocation( program, buffer.data() ) );
+            }
+
+            int glUniformLocation( uint program, const char* name )
+            {
+                GLint location;
+                GL_ASSERT( location = glGetUniformLocation( program, name ) );
+                return location;
+            }
+
+            void glUpload( int location, Core::UniformType type, int count, const void* data )
+            {
+                const GLfloat* v = static_cast<const GLfloat*>( data );
+                switch ( type )
+                {
+                    case Core::UniformType_INT:   GL_ASSERT( glUniform1iv( location, count, static_cast<const GLint*>( data ) ) ); break;
+                    case Core::UniformType_UINT:  GL_ASSERT( glUniform1uiv( location, count, static_cast<const GLuint*>( data ) ) ); break;
+                    case Core::UniformType_FLOAT: GL_ASSERT( glUniform1fv( location, count, v ) ); break;
+                    case Core::UniformType_VEC2:  GL_ASSERT( glUniform2fv( location, count, v ) ); break;
+                    case Core::UniformType_VEC3:  GL_ASSERT( glUniform3fv( location, count, v ) ); break;
+                    case Core::UniformType_VEC4:  GL_ASSERT( glUniform4fv( location, count, v ) ); break;
+                    case Core::UniformType_MAT2:  GL_ASSERT( glUniformMatrix2fv( location, count, GL_FALSE, v ) ); break;
+                    case Core::UniformType_MAT3:  GL_ASSERT( glUniformMatrix3fv( location, count, GL_FALSE, v ) ); break;
+                    case Core::UniformType_MAT4:  GL_ASSERT( glUniformMatrix4fv( location, count, GL_FALSE, v ) ); break;
+                    default: CORE_ERROR( "Wrong UniformType" );
+                }
+            }
+
+            const Core::UniformFunctions glUniformFunctions = {
+                glActiveUniformSize,
+                glActiveUniform,
+                glUniformLocation,
+                glActiveAttributeSize,
+                glActiveAttribute,
+                glUpload
+            };
+        }
+
         ShaderProgram:: ShaderProgram()
             : m_linked(false)
             , m_shaderId( 0 )
+            , m_uniforms( glUniformFunctions )
         {
             for ( uint i = 0; i < m_shaderObjects.size(); ++i )
             {
@@ -573,6 +649,8 @@ namespace Ra
                 LOG(logINFO) << "Shader name : " << m_configuration.m_name;
                 LOG(logINFO) << log;
             }
+
+            m_uniforms.reflect( m_shaderId );
         }
 
         void ShaderProgram::bind() const
@@ -608,98 +686,221 @@ namespace Ra
             return basicConfig;
         }
 
+        Core::UniformHandle ShaderProgram::getUniformHandle( const char* name ) const
+        {
+            return m_uniforms.getUniform( name );
+        }
+
+        int ShaderProgram::getAttributeLocation( const char* name ) const
+        {
+            return m_uniforms.getAttributeLocation( name );
+        }
+
         void ShaderProgram::setUniform( const char* name, int value ) const
         {
-            GL_ASSERT( glUniform1i( glGetUniformLocation( m_shaderId, name ), value ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
-        void ShaderProgram::setUniform( const char* name, unsigned int value ) const
+        void ShaderProgram::setUniform( const char* name, uint value ) const
         {
-            GL_ASSERT( glUniform1ui( glGetUniformLocation( m_shaderId, name ), value ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, float value ) const
         {
-            GL_ASSERT( glUniform1f( glGetUniformLocation( m_shaderId, name ), value ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, double value ) const
         {
-            float v = static_cast<float>(value);
-            GL_ASSERT( glUniform1f( glGetUniformLocation( m_shaderId, name ), v ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector2f& value ) const
         {
-            GL_ASSERT( glUniform2fv( glGetUniformLocation( m_shaderId, name ), 1, value.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector2d& value ) const
         {
-            Core::Vector2f v = value.cast<float>();
-            GL_ASSERT( glUniform2fv( glGetUniformLocation( m_shaderId, name ), 1, v.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector3f& value ) const
         {
-            GL_ASSERT( glUniform3fv( glGetUniformLocation( m_shaderId, name ), 1, value.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector3d& value ) const
         {
-            Core::Vector3f v = value.cast<float>();
-            GL_ASSERT( glUniform3fv( glGetUniformLocation( m_shaderId, name ), 1, v.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector4f& value ) const
         {
-            GL_ASSERT( glUniform4fv( glGetUniformLocation( m_shaderId, name ), 1, value.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Vector4d& value ) const
         {
-            Core::Vector4f v = value.cast<float>();
-            GL_ASSERT( glUniform4fv( glGetUniformLocation( m_shaderId, name ), 1, v.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix2f& value ) const
         {
-            GL_ASSERT( glUniformMatrix2fv( glGetUniformLocation( m_shaderId, name ), 1, GL_FALSE, value.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix2d& value ) const
         {
-            Core::Matrix2f v = value.cast<float>();
-            GL_ASSERT( glUniformMatrix2fv( glGetUniformLocation( m_shaderId, name ), 1, GL_FALSE, v.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix3f& value ) const
         {
-            GL_ASSERT( glUniformMatrix3fv( glGetUniformLocation( m_shaderId, name ), 1, GL_FALSE, value.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix3d& value ) const
         {
-            Core::Matrix3f v = value.cast<float>();
-            GL_ASSERT( glUniformMatrix3fv( glGetUniformLocation( m_shaderId, name ), 1, GL_FALSE, v.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix4f& value ) const
         {
-            GL_ASSERT( glUniformMatrix4fv( glGetUniformLocation( m_shaderId, name ), 1, GL_FALSE, value.data() ) );
+            setUniform( m_uniforms.getUniform( name ), value );
         }
 
         void ShaderProgram::setUniform( const char* name, const Core::Matrix4d& value ) const
+        {
+            setUniform( m_uniforms.getUniform( name ), value );
+        }
+
+        void ShaderProgram::setUniform( const char* name, const Core::AlignedStdVector<Core::Matrix4f>& values ) const
+        {
+            setUniform( m_uniforms.getUniform( name ), values );
+        }
+
+        void ShaderProgram::setUniform( const char* name, const Core::AlignedStdVector<Core::Matrix4d>& values ) const
+        {
+            setUniform( m_uniforms.getUniform( name ), values );
+        }
+
+        void ShaderProgram::setUniform( const char* name, Texture* tex, int texUnit ) const
+        {
+            setUniform( m_uniforms.getUniform( name ), tex, texUnit );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, int value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_INT, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, unsigned int value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_UINT, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, float value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_FLOAT, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, double value ) const
+        {
+            float v = static_cast<float>(value);
+            m_uniforms.set( handle, Core::UniformType_FLOAT, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Vector2f& value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_VEC2, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Vector2d& value ) const
+        {
+            Core::Vector2f v = value.cast<float>();
+            m_uniforms.set( handle, Core::UniformType_VEC2, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Vector3f& value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_VEC3, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Vector3d& value ) const
+        {
+            Core::Vector3f v = value.cast<float>();
+            m_uniforms.set( handle, Core::UniformType_VEC3, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Vector4f& value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_VEC4, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Vector4d& value ) const
+        {
+            Core::Vector4f v = value.cast<float>();
+            m_uniforms.set( handle, Core::UniformType_VEC4, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Matrix2f& value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_MAT2, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Matrix2d& value ) const
+        {
+            Core::Matrix2f v = value.cast<float>();
+            m_uniforms.set( handle, Core::UniformType_MAT2, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Matrix3f& value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_MAT3, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Matrix3d& value ) const
+        {
+            Core::Matrix3f v = value.cast<float>();
+            m_uniforms.set( handle, Core::UniformType_MAT3, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Matrix4f& value ) const
+        {
+            m_uniforms.set( handle, Core::UniformType_MAT4, value );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::Matrix4d& value ) const
         {
             Core::Matrix4f v = value.cast<float>();
-            GL_ASSERT( glUniformMatrix4fv( glGetUniformLocation( m_shaderId, name ), 1, GL_FALSE, v.data() ) );
+            m_uniforms.set( handle, Core::UniformType_MAT4, v );
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::AlignedStdVector<Core::Matrix4f>& values ) const
+        {
+            if ( !values.empty() )
+            {
+                m_uniforms.set( handle, Core::UniformType_MAT4, values[0].data(), values.size() * sizeof( Core::Matrix4f ), values.size() );
+            }
+        }
+
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, const Core::AlignedStdVector<Core::Matrix4d>& values ) const
+        {
+            Core::AlignedStdVector<Core::Matrix4f> v( values.size() );
+            for ( uint i = 0; i < values.size(); ++i )
+            {
+                v[i] = values[i].cast<float>();
+            }
+            setUniform( handle, v );
         }
 
         // TODO : Provide Texture support
-        void ShaderProgram::setUniform( const char* name, Texture* tex, int texUnit ) const
+        void ShaderProgram::setUniform( const Core::UniformHandle& handle, Texture* tex, int texUnit ) const
         {
             tex->bind( texUnit );
-            GL_ASSERT( glUniform1i( glGetUniformLocation( m_shaderId, name ), texUnit ) );
+            m_uniforms.set( handle, Core::UniformType_INT, texUnit );
         }
 
 
@@ -10,6 +10,8 @@
 
 #include <Core/CoreMacros.hpp>
 #include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Utils/UniformTable.hpp>
 
 namespace Ra
 {
@@ -171,7 +173,12 @@ namespace Ra
 
             uint getId() const;
 
-            // Uniform setters
+            /// Handle of a uniform, which can be kept instead of its name. The uniforms and attributes are read
+            /// once when the program is linked, and their handles stay valid when it is reloaded.
+            Core::UniformHandle getUniformHandle( const char* name ) const;
+            int getAttributeLocation( const char* name ) const;
+
+            // Uniform setters. Values equal to the last ones set are not uploaded again.
             void setUniform( const char* name, int value ) const;
             void setUniform( const char* name, uint value ) const;
             void setUniform( const char* name, float value ) const;
@@ -191,8 +198,37 @@ namespace Ra
             void setUniform( const char* name, const Core::Matrix4f& value ) const;
             void setUniform( const char* name, const Core::Matrix4d& value ) const;
 
+            /// Uniform arrays, uploaded with a single call.
+            void setUniform( const char* name, const Core::AlignedStdVector<Core::Matrix4f>& values ) const;
+            void setUniform( const char* name, const Core::AlignedStdVector<Core::Matrix4d>& values ) const;
+
             void setUniform( const char* name, Texture* tex, int texUnit ) const;
 
+            // Same setters, by handle.
+            void setUniform( const Core::UniformHandle& handle, int value ) const;
+            void setUniform( const Core::UniformHandle& handle, uint value ) const;
+            void setUniform( const Core::UniformHandle& handle, float value ) const;
+            void setUniform( const Core::UniformHandle& handle, double value ) const;
+
+            void setUniform( const Core::UniformHandle& handle, const Core::Vector2f& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Vector2d& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Vector3f& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Vector3d& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Vector4f& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Vector4d& value ) const;
+
+            void setUniform( const Core::UniformHandle& handle, const Core::Matrix2f& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Matrix2d& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Matrix3f& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Matrix3d& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Matrix4f& value ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::Matrix4d& value ) const;
+
+            void setUniform( const Core::UniformHandle& handle, const Core::AlignedStdVector<Core::Matrix4f>& values ) const;
+            void setUniform( const Core::UniformHandle& handle, const Core::AlignedStdVector<Core::Matrix4d>& values ) const;
+
+            void setUniform( const Core::UniformHandle& handle, Texture* tex, int texUnit ) const;
+
         private:
             //  bool exists(const std::string& filename);
             void loadShader(ShaderType type, const std::string& name, const std::set<std::string>& props);
@@ -208,6 +244,8 @@ namespace Ra
             uint m_shaderId;
             std::array<ShaderObject*, ShaderType_COUNT> m_shaderObjects;
             std::array<bool, ShaderType_COUNT> m_shaderStatus;
+            // Locations and last values of the uniforms, updated by the const setters.
+            mutable Core::UniformTable m_uniforms;
         };
 
     } // namespace Engine
@@ -57,6 +57,8 @@ namespace Ra
             , m_drawDebug( true )
             , m_wireframe(false)
             , m_postProcessEnabled(true)
+            , m_numBinds( 0 )
+            , m_numNaiveBinds( 0 )
         {
         }
 
@@ -124,6 +126,10 @@ namespace Ra
 
             m_timerData.feedRenderQueuesEnd = Core::Timer::Clock::now();
 
+            const RenderObjectManager::CullingStats cullingStats = m_roMgr->getCullingStats();
+            m_timerData.numVisibleObjects = cullingStats.m_numVisible;
+            m_timerData.numCulledObjects = cullingStats.m_numCulled;
+
             // 2. Update them (from an opengl point of view)
             // FIXME(Charly): Maybe we could just update objects if they need it
             // before drawing them, that would be cleaner (performance problem ?)
@@ -144,6 +150,8 @@ namespace Ra
             // 4. Do the rendering.
             renderInternal( data );
             m_timerData.mainRenderEnd = Core::Timer::Clock::now();
+            m_timerData.numBinds = m_numBinds;
+            m_timerData.numNaiveBinds = m_numNaiveBinds;
 
             // 5. Post processing
             postProcessInternal( data );
@@ -176,6 +184,16 @@ namespace Ra
             for ( auto& ro : m_uiRenderObjects    ) ro->updateGL();
         }
 
+        void Renderer::enableFrustumCulling( bool enabled )
+        {
+            m_roMgr->setCullingEnabled( enabled );
+        }
+
+        bool Renderer::isFrustumCullingEnabled() const
+        {
+            return m_roMgr->isCullingEnabled();
+        }
+
         void Renderer::feedRenderQueuesInternal( const RenderData& renderData )
         {
             m_fancyRenderObjects.clear();
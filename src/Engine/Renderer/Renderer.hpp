@@ -65,6 +65,14 @@ namespace Ra
                 Core::Timer::TimePoint mainRenderEnd;
                 Core::Timer::TimePoint postProcessEnd;
                 Core::Timer::TimePoint renderEnd;
+
+                /// Number of fancy objects sent to the render queues and skipped by frustum culling.
+                uint numVisibleObjects = 0;
+                uint numCulledObjects = 0;
+
+                /// Number of shader, material and mesh binds of the sorted opaque passes, and without sorting.
+                uint numBinds = 0;
+                uint numNaiveBinds = 0;
             };
 
             struct PickingQuery
@@ -114,6 +122,10 @@ namespace Ra
                 m_postProcessEnabled = enabled;
             }
 
+            /// Enables or disables the frustum culling of the render objects (enabled by default).
+            virtual void enableFrustumCulling(bool enabled) final;
+            virtual bool isFrustumCullingEnabled() const final;
+
             /**
              * @brief Tell the renderer it needs to render.
              * This method does the following steps :
@@ -316,6 +328,9 @@ namespace Ra
             bool m_wireframe;           // Are we rendering in "real" wireframe mode
             bool m_postProcessEnabled;  // Should we do post processing ?
 
+            uint m_numBinds;            // Binds of the last frame, for renderers sorting their draws (see TimerData).
+            uint m_numNaiveBinds;
+
         private:
             // Qt has the nice idea to bind an fbo before giving you the opengl context,
             // this flag is used to save it (and render the final screen on it)
@@ -10,6 +10,7 @@
 #include <Core/Math/ColorPresets.hpp>
 #include <Core/Containers/Algorithm.hpp>
 #include <Core/Containers/MakeShared.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
@@ -28,6 +29,9 @@
 #include <Engine/Renderer/Texture/TextureManager.hpp>
 #include <Engine/Renderer/Texture/Texture.hpp>
 #include <Engine/Renderer/Renderers/DebugRender.hpp>
+#include <Engine/Renderer/RenderObject/RenderObject.hpp>
+
+#include <unordered_map>
 
 //#define NO_TRANSPARENCY
 namespace Ra
@@ -52,7 +56,9 @@ namespace Ra
 
         ForwardRenderer::ForwardRenderer( uint width, uint height )
             : Renderer(width, height)
+            , m_drawListExact( true )
         {
+            m_drawPassBegin.fill( 0 );
         }
 
         ForwardRenderer::~ForwardRenderer()
@@ -73,6 +79,7 @@ namespace Ra
         {
             m_shaderMgr->addShaderProgram("DepthMap", "../Shaders/DepthMap.vert.glsl", "../Shaders/DepthMap.frag.glsl");
             m_shaderMgr->addShaderProgram("DepthAmbientPass", "../Shaders/BlinnPhong.vert.glsl", "../Shaders/DepthAmbientPass.frag.glsl");
+            m_shaderMgr->addShaderProgram("BlinnPhongClustered", "../Shaders/BlinnPhong.vert.glsl", "../Shaders/BlinnPhongClustered.frag.glsl");
             m_shaderMgr->addShaderProgram("FinalCompose", "../Shaders/Basic2D.vert.glsl", "../Shaders/FinalCompose.frag.glsl");
 #ifndef NO_TRANSPARENCY
             m_shaderMgr->addShaderProgram("LitOIT", "../Shaders/BlinnPhong.vert.glsl", "../Shaders/LitOIT.frag.glsl");
@@ -152,6 +159,135 @@ namespace Ra
 
             // FIXME(charly) Do we want ui too  ?
 #endif
+            updateDrawList( renderData );
+        }
+
+        void ForwardRenderer::updateDrawList( const RenderData& renderData )
+        {
+            // Matrices of the objects, computed once for the passes and the lights.
+            const uint size = m_fancyRenderObjects.size();
+            m_drawMatrices.resize( size );
+            Core::parallelFor( 0, size, 0, [this, &renderData]( uint begin, uint end )
+            {
+                for ( uint i = begin; i < end; ++i )
+                {
+                    const Core::Transform T = m_fancyRenderObjects[i]->getTransform();
+                    DrawMatrices& matrices = m_drawMatrices[i];
+                    matrices.model = T.matrix();
+                    matrices.worldNormal = T.inverse( Eigen::Affine ).matrix().transpose();
+                    matrices.depth = -( renderData.viewMatrix * matrices.model.col( 3 ) )( 2 );
+                }
+            } );
+
+            Scalar farthest = 0;
+            for ( uint i = 0; i < size; ++i )
+            {
+                farthest = std::max( farthest, m_drawMatrices[i].depth );
+            }
+            const Scalar depthScale = ( farthest > 0 ) ? 1 / farthest : 0;
+
+            // Small identifiers of the shaders, materials and meshes, in order of first use.
+            std::unordered_map<const void*, uint> shaders, materials, meshes;
+            auto id = []( std::unordered_map<const void*, uint>& ids, const void* object )
+            {
+                return ids.emplace( object, uint( ids.size() ) ).first->second;
+            };
+
+            m_drawList.clear();
+            m_drawList.reserve( 2 * size );
+            const ShaderProgram* depthShader = m_shaderMgr->getShaderProgram( "DepthAmbientPass" );
+            const ShaderProgram* clusteredShader = m_shaderMgr->getShaderProgram( "BlinnPhongClustered" );
+            const ShaderProgram* blinnPhong = m_shaderMgr->getShaderProgram( "BlinnPhong" );
+            if ( blinnPhong == m_shaderMgr->getDefaultShaderProgram() )
+            {
+                blinnPhong = nullptr;
+            }
+            for ( uint i = 0; i < size; ++i )
+            {
+                const auto& ro = m_fancyRenderObjects[i];
+                if ( !ro->isVisible() )
+                {
+                    continue;
+                }
+                const RenderTechnique* technique = ro->getRenderTechnique();
+                const uint material = id( materials, technique->material ) & ( ( 1u << Core::DrawList::MaterialBits ) - 1 );
+                const uint mesh = id( meshes, ro->getMesh().get() ) & ( ( 1u << Core::DrawList::MeshBits ) - 1 );
+                const Scalar depth = m_drawMatrices[i].depth * depthScale;
+
+                const uint depthShaderId = id( shaders, depthShader ) & ( ( 1u << Core::DrawList::ShaderBits ) - 1 );
+                m_drawList.add( Core::DrawList::makeKey( DrawPass_Depth, depthShaderId, material, mesh, depth ), i );
+                if ( technique->shader != nullptr )
+                {
+                    const bool clustered = ( technique->shader == blinnPhong );
+                    const uint pass = clustered ? DrawPass_Clustered : DrawPass_Light;
+                    const uint shader = id( shaders, clustered ? clusteredShader : technique->shader ) &
+                                        ( ( 1u << Core::DrawList::ShaderBits ) - 1 );
+                    m_drawList.add( Core::DrawList::makeKey( pass, shader, material, mesh, depth ), i );
+                }
+            }
+            m_drawList.sort();
+
+            // Identifiers which do not fit in the keys : the state changes are not reliable.
+            m_drawListExact = ( shaders.size() <= ( 1u << Core::DrawList::ShaderBits ) &&
+                                materials.size() <= ( 1u << Core::DrawList::MaterialBits ) &&
+                                meshes.size() <= ( 1u << Core::DrawList::MeshBits ) );
+
+            m_drawPassBegin.fill( m_drawList.size() );
+            for ( int i = int( m_drawList.size() ) - 1; i >= 0; --i )
+            {
+                m_drawPassBegin[Core::DrawList::getPass( m_drawList[i].m_key )] = i;
+            }
+            for ( int pass = DrawPass_Count - 1; pass >= 0; --pass )
+            {
+                m_drawPassBegin[pass] = std::min( m_drawPassBegin[pass], m_drawPassBegin[pass + 1] );
+            }
+
+            const Core::DrawList::Statistics stats = m_drawList.getStatistics();
+            m_numBinds = m_drawListExact ? stats.m_bind : stats.m_naiveBind;
+            m_numNaiveBinds = stats.m_naiveBind;
+        }
+
+        void ForwardRenderer::renderDrawList( uint pass, const ShaderProgram* shader, const RenderParameters* lightParams,
+                                              const RenderData& renderData )
+        {
+            const ShaderProgram* current = nullptr;
+            bool replacedTextures = false;
+            for ( uint i = m_drawPassBegin[pass]; i < m_drawPassBegin[pass + 1]; ++i )
+            {
+                const Core::DrawList::Draw& draw = m_drawList[i];
+                const uint change = m_drawListExact ? draw.m_change : ~0u;
+                const auto& ro = m_fancyRenderObjects[draw.m_item];
+                const DrawMatrices& matrices = m_drawMatrices[draw.m_item];
+
+                if ( change & Core::DrawList::CHANGE_SHADER )
+                {
+                    current = ( shader != nullptr ) ? shader : ro->getRenderTechnique()->shader;
+                    current->bind();
+                    current->setUniform( "transform.proj", renderData.projMatrix );
+                    current->setUniform( "transform.view", renderData.viewMatrix );
+                    if ( lightParams != nullptr )
+                    {
+                        lightParams->bind( current );
+                    }
+                }
+
+                // The textures of the previous object parameters may have replaced the ones of the material.
+                if ( ( change & Core::DrawList::CHANGE_MATERIAL ) || replacedTextures )
+                {
+                    ro->getRenderTechnique()->material->bind( current );
+                }
+
+                current->setUniform( "transform.model", matrices.model );
+                current->setUniform( "transform.worldNormal", matrices.worldNormal );
+                ro->bindRenderParameters( current );
+                replacedTextures = ro->getRenderParameters().hasTextures();
+
+                if ( change & Core::DrawList::CHANGE_MESH )
+                {
+                    ro->getMesh()->bind();
+                }
+                ro->getMesh()->draw();
+            }
         }
 
         void ForwardRenderer::renderInternal( const RenderData& renderData )
@@ -186,26 +322,7 @@ namespace Ra
             GL_ASSERT( glDrawBuffers( 4, buffers ) );
 
             shader = m_shaderMgr->getShaderProgram("DepthAmbientPass");
-            shader->bind();
-            for ( const auto& ro : m_fancyRenderObjects )
-            {
-                if ( ro->isVisible() )
-                {
-                    // bind data
-                    Core::Matrix4 M = ro->getTransformAsMatrix();
-                    Core::Matrix4 N = M.inverse().transpose();
-
-                    shader->setUniform( "transform.proj", renderData.projMatrix );
-                    shader->setUniform( "transform.view", renderData.viewMatrix );
-                    shader->setUniform( "transform.model", M );
-                    shader->setUniform( "transform.worldNormal", N );
-
-                    ro->getRenderTechnique()->material->bind( shader );
-
-                    // render
-                    ro->getMesh()->render();
-                }
-            }
+            renderDrawList( DrawPass_Depth, shader, nullptr, renderData );
 
             // Light pass
             GL_ASSERT( glDepthFunc( GL_LEQUAL ) );
@@ -216,33 +333,44 @@ namespace Ra
 
             GL_ASSERT(glDrawBuffers(1, buffers));   // Draw color texture
 
-            if ( m_lights.size() > 0 )
-            {
-                for ( const auto& l : m_lights )
-                {
-                    RenderParameters params;
-                    l->getRenderParameters( params );
+            DirectionalLight defaultLight;
+            defaultLight.setDirection( Core::Vector3( 0.3f, -1.0f, 0.0f ) );
 
-                    for ( const auto& ro : m_fancyRenderObjects )
-                    {
-                        ro->render(params, renderData);
-                    }
-                }
+            std::vector<Light*> lights;
+            for ( const auto& l : m_lights )
+            {
+                lights.push_back( l.get() );
             }
-            else
+            if ( lights.empty() )
             {
-                DirectionalLight l;
-                l.setDirection( Core::Vector3( 0.3f, -1.0f, 0.0f ) );
+                lights.push_back( &defaultLight );
+            }
 
+            // The Blinn-Phong objects are drawn once with the lights binned in the clusters of the view, or once
+            // per light if the view is not a perspective.
+            const bool clustered = ( m_drawPassBegin[DrawPass_Clustered] < m_drawPassBegin[DrawPass_Clustered + 1] ) &&
+                                   m_clusteredLights.update( lights, renderData, m_width, m_height );
+
+            for ( Light* l : lights )
+            {
                 RenderParameters params;
-                l.getRenderParameters( params );
+                l->getRenderParameters( params );
 
-                for ( const auto& ro : m_fancyRenderObjects )
+                renderDrawList( DrawPass_Light, nullptr, &params, renderData );
+                if ( !clustered )
                 {
-                    ro->render(params, renderData);
+                    renderDrawList( DrawPass_Clustered, m_shaderMgr->getShaderProgram( "BlinnPhong" ), &params, renderData );
                 }
             }
 
+            if ( clustered )
+            {
+                shader = m_shaderMgr->getShaderProgram( "BlinnPhongClustered" );
+                shader->bind();
+                m_clusteredLights.bind( shader );
+                renderDrawList( DrawPass_Clustered, shader, nullptr, renderData );
+            }
+
 #ifndef NO_TRANSPARENCY
             m_fbo->unbind();
             m_oitFbo->useAsTarget();
@@ -468,6 +596,7 @@ namespace Ra
                         shader->setUniform( "transform.model", M );
 
                         ro->getRenderTechnique()->material->bind( shader );
+                        ro->bindRenderParameters( shader );
 
                         // render
                         ro->getMesh()->render();
@@ -528,6 +657,7 @@ namespace Ra
                     shader->setUniform( "transform.model", M );
 
                     ro->getRenderTechnique()->material->bind( shader );
+                    ro->bindRenderParameters( shader );
 
                     // render
                     ro->getMesh()->render();
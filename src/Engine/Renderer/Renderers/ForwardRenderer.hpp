@@ -4,10 +4,17 @@
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Renderer/Renderer.hpp>
 
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Utils/DrawList.hpp>
+
+#include <Engine/Renderer/Light/ClusteredLights.hpp>
+
 namespace Ra
 {
     namespace Engine
     {
+        class RenderParameters;
+
         class RA_ENGINE_API ForwardRenderer : public Renderer
         {
         public:
@@ -34,6 +41,14 @@ namespace Ra
 
             void updateShadowMaps();
 
+            /// Sorts the draws of the opaque passes by state, and computes the matrices of the objects.
+            void updateDrawList( const RenderData& renderData );
+
+            /// Draws a pass of the draw list, binding only the state which changes between two draws.
+            /// shader replaces the ones of the objects if not null.
+            void renderDrawList( uint pass, const ShaderProgram* shader, const RenderParameters* lightParams,
+                                 const RenderData& renderData );
+
         private:
             enum RendererTextures
             {
@@ -62,6 +77,28 @@ namespace Ra
             static const int ShadowMapSize = 1024;
             std::vector<std::shared_ptr<Texture>> m_shadowMaps;
             std::vector<Core::Matrix4> m_lightMatrices;
+
+            enum DrawPass
+            {
+                DrawPass_Depth = 0,
+                DrawPass_Light,
+                DrawPass_Clustered, // Objects of the Blinn-Phong program, lit by all the lights at once.
+                DrawPass_Count
+            };
+
+            struct DrawMatrices
+            {
+                Core::Matrix4 model;
+                Core::Matrix4 worldNormal;
+                Scalar depth; // Along the view direction.
+            };
+
+            Core::DrawList m_drawList;
+            std::array<uint, DrawPass_Count + 1> m_drawPassBegin;
+            bool m_drawListExact; // False if there were too many shaders, materials or meshes for the sort keys.
+            Core::AlignedStdVector<DrawMatrices> m_drawMatrices; // Of m_fancyRenderObjects.
+
+            ClusteredLights m_clusteredLights;
         };
 
     } // namespace Engine
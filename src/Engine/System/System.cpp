@@ -1,6 +1,7 @@
 #include <Engine/System/System.hpp>
 
 #include <Core/String/StringUtils.hpp>
+#include <Engine/RadiumEngine.hpp>
 #include <Engine/Component/Component.hpp>
 #include <Engine/Entity/Entity.hpp>
 
@@ -33,6 +34,7 @@ namespace Ra
 #endif // DEBUG
             m_components.push_back({ ent, component });
             component->setSystem( this );
+            RadiumEngine::getInstance()->invalidateTasks();
 
         }
 
@@ -47,6 +49,7 @@ namespace Ra
             CORE_ASSERT( pos->first == ent, "Component belongs to a different entity" );
 
             m_components.erase( pos );
+            RadiumEngine::getInstance()->invalidateTasks();
         }
 
 
@@ -58,6 +61,7 @@ namespace Ra
             {
                 m_components.erase( pos );
             }
+            RadiumEngine::getInstance()->invalidateTasks();
         }
     }
 } // namespace Ra
@@ -43,8 +43,11 @@ namespace Ra
         /// Systems are responsible of updating a specific subset of the components of each entity.
         /// They can provide factory methods to create components, but their main role is to keep a
         /// list of "active" components associated to an entity.
-        /// At each frame, each system loaded into the engine will be queried for tasks.
+        /// Each system loaded into the engine is queried for tasks, which are then run at each frame.
         /// The goal of the tasks is to update the active components during the frame.
+        /// The tasks are kept from one frame to the next and are only generated again when the
+        /// components of a system change (or when a system calls RadiumEngine::invalidateTasks()).
+        /// Per-frame data should thus be read by the tasks when they run, not when they are created.
         class RA_ENGINE_API System
         {
         public:
@@ -56,11 +59,17 @@ namespace Ra
              * A very basic version of this method could be to iterate on components
              * and just call Component::update() method on them.
              * This update depends on time (e.g. physics system).
+             * The generated tasks are replayed at each frame until the task graph is invalidated.
              *
-             * @param dt Time elapsed since last call.
+             * @param frameInfo Information on the current frame. The reference stays valid and is
+             * updated before each frame, so tasks may keep it.
              */
             virtual void generateTasks( Core::TaskQueue* taskQueue, const Engine::FrameInfo& frameInfo ) = 0;
 
+            /// Called on the main thread at each frame, before the tasks are started.
+            /// Override it to update the per-frame state read by the tasks.
+            virtual void prepareFrame( const Engine::FrameInfo& frameInfo ) {}
+
 
             /// Registers a component belonging to an entity, making it active within the system.
             void registerComponent( const Entity* entity, Component* component );
@@ -410,4 +410,9 @@ namespace Ra
     {
         m_currentRenderer->enableDebugDraw(enabled);
     }
+
+    void Gui::Viewer::enableFrustumCulling(int enabled)
+    {
+        m_currentRenderer->enableFrustumCulling(enabled);
+    }
 } // namespace Ra
@@ -0,0 +1,78 @@
+#ifndef RADIUM_AABBCACHE_BENCHMARKS_HPP_
+#define RADIUM_AABBCACHE_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Math/AabbCache.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Bounding boxes of 100k objects : computed from the corners at each query, then cached
+    /// and queried with no change, and when every transform changed.
+    class AabbCacheBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "AabbCache"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const uint numObjects = 100000;
+            std::vector<Aabb> localAabbs( numObjects );
+            std::vector<Transform, Eigen::aligned_allocator<Transform>> transforms( numObjects );
+            std::vector<std::unique_ptr<AabbCache>> caches( numObjects );
+            for ( uint i = 0; i < numObjects; ++i )
+            {
+                const Vector3 half = Vector3::Random().cwiseAbs();
+                localAabbs[i] = Aabb( -half, half );
+                transforms[i] = Transform::Identity();
+                transforms[i].translate( 50 * Vector3::Random() );
+                transforms[i].rotate( AngleAxis( Scalar( i ), Vector3::Random().normalized() ) );
+                caches[i].reset( new AabbCache );
+                caches[i]->setLocalAabb( localAabbs[i], 0 );
+            }
+
+            std::vector<Aabb> aabbs( numObjects );
+            report( "100k objects : 8 transformed corners", bestOf( 10, [&]()
+            {
+                for ( uint i = 0; i < numObjects; ++i )
+                {
+                    aabbs[i].setEmpty();
+                    for ( int c = 0; c < 8; ++c )
+                    {
+                        aabbs[i].extend( transforms[i] * localAabbs[i].corner( static_cast<Aabb::CornerType>( c ) ) );
+                    }
+                }
+            } ) );
+
+            std::uint64_t transformVersion = 0;
+            report( "100k objects : transform changed", bestOf( 10, [&]()
+            {
+                ++transformVersion;
+                for ( uint i = 0; i < numObjects; ++i )
+                {
+                    if ( !caches[i]->getAabb( 0, transformVersion, aabbs[i] ) )
+                    {
+                        aabbs[i] = caches[i]->update( transforms[i], transformVersion );
+                    }
+                }
+            } ) );
+
+            report( "100k objects : cached", bestOf( 10, [&]()
+            {
+                for ( uint i = 0; i < numObjects; ++i )
+                {
+                    if ( !caches[i]->getAabb( 0, transformVersion, aabbs[i] ) )
+                    {
+                        aabbs[i] = caches[i]->update( transforms[i], transformVersion );
+                    }
+                }
+            } ) );
+        }
+    };
+    RA_BENCHMARK_CLASS( AabbCacheBenchmark );
+}
+
+#endif // RADIUM_AABBCACHE_BENCHMARKS_HPP_
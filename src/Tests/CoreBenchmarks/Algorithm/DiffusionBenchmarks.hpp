@@ -0,0 +1,90 @@
+#ifndef RADIUM_DIFFUSION_BENCHMARKS_HPP_
+#define RADIUM_DIFFUSION_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Algorithm/HeatDiffusion/DiffusionContext.hpp>
+#include <Core/Geometry/Operator/OperatorPattern.hpp>
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Heat diffusion queries on a 500k vertices grid : one-shot Algorithm::heat() against a
+    /// DiffusionContext factorized once (single and multiple sources, refactorization, smoothing).
+    class DiffusionBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "Diffusion"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const uint res = 706;
+            TriangleMesh mesh = MeshUtils::makePlaneGrid( res, res, Vector2( 1.f, 1.f ) );
+            const VectorArray<Vector3>& p = mesh.m_vertices;
+            const VectorArray<Triangle>& T = mesh.m_triangles;
+            const uint n = p.size();
+            const std::string size = std::to_string( n ) + " vertices";
+            const Scalar h = 2.f / res;
+            const Algorithm::Time t = Algorithm::t( 1.f, h );
+
+            Geometry::OperatorPattern pattern;
+            Geometry::LaplacianMatrix L;
+            report( "cotangent Laplacian (pattern and values) : " + size, bestOf( 1, [&]()
+            {
+                L = pattern.cotangentWeightLaplacian( p, T );
+            } ) );
+            report( "cotangent Laplacian (values) : " + size, bestOf( 3, [&]()
+            {
+                L = pattern.cotangentWeightLaplacian( p, T );
+            } ) );
+            const Geometry::AreaVector A = Geometry::barycentricAreaVector( p, T );
+
+            const uint numQueries = 64;
+            Algorithm::Source sources;
+            for ( uint k = 0; k < numQueries; ++k )
+            {
+                sources.push_back( ( uint64_t( k ) * 7919 * n / numQueries ) % n );
+            }
+
+            Algorithm::Heat u;
+            report( "one-shot heat, per query", bestOf( 1, [&]()
+            {
+                Algorithm::heat( Geometry::diagonalMatrix( A ), t, L, u, Algorithm::delta( { sources[0] }, n ) );
+            } ) );
+
+            Algorithm::DiffusionContext context;
+            report( "context : analysis and factorization", bestOf( 1, [&]()
+            {
+                context.compute( A, t, L );
+            } ) );
+            report( "context : numeric refactorization", bestOf( 1, [&]()
+            {
+                context.refactorize( A, 2 * t, L );
+            } ) );
+
+            report( "context : single source, per query", bestOf( 3, [&]()
+            {
+                context.solve( Algorithm::delta( { sources[0] }, n ), u );
+            } ) );
+
+            MatrixN U;
+            const double all = bestOf( 1, [&]()
+            {
+                context.heat( sources, U );
+            } );
+            report( "context : " + std::to_string( numQueries ) + " sources, per query", all / numQueries );
+
+            VectorArray<Vector3> smoothed;
+            report( "context : implicit smoothing step", bestOf( 3, [&]()
+            {
+                context.smooth( p, smoothed );
+            } ) );
+        }
+    };
+    RA_BENCHMARK_CLASS( DiffusionBenchmark );
+}
+
+#endif // RADIUM_DIFFUSION_BENCHMARKS_HPP_
@@ -0,0 +1,309 @@
+#ifndef RADIUM_ANIMATION_BENCHMARKS_HPP_
+#define RADIUM_ANIMATION_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Animation/Animation.hpp>
+#include <Core/Animation/CompressedAnimation.hpp>
+#include <Core/Animation/Handle/ForwardKinematics.hpp>
+#include <Core/Animation/Handle/Skeleton.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Samples 1000 skeletons of 100 bones for one second at 60 Hz. The skeletons play 10 clips of
+    /// 300 keys with different time offsets. Compares the linear search of the key interval
+    /// (previous Animation::getPose()) with the binary search and the cursors.
+    class AnimationBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "Animation"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+            typedef Ra::Core::Animation::Animation Clip;
+
+            const uint numClips     = 10;
+            const uint numKeys      = 300;
+            const uint numBones     = 100;
+            const uint numSkeletons = 1000;
+            const uint numFrames    = 60;
+            const Scalar frameTime  = Scalar( 1 ) / 60;
+
+            std::vector< Clip > clips( numClips );
+            for ( auto& clip : clips )
+            {
+                Pose pose( numBones );
+                for ( uint k = 0; k < numKeys; ++k )
+                {
+                    for ( auto& t : pose )
+                    {
+                        t = Translation( Vector3::Random() ) * AngleAxis( Scalar( 1 ), Vector3::Random().normalized() );
+                    }
+                    clip.addKeyPose( pose, k * Scalar( 1 ) / 30 );
+                }
+                clip.normalize();
+            }
+            std::vector< Scalar > offsets( numSkeletons );
+            for ( uint i = 0; i < numSkeletons; ++i )
+            {
+                offsets[i] = Scalar( i % 97 ) / 10;
+            }
+
+            // Previous getPose() : linear search, then interpolatePoses().
+            std::vector< std::vector< KeyPose > > keys( numClips );
+            for ( uint c = 0; c < numClips; ++c )
+            {
+                for ( uint k = 0; k < numKeys; ++k )
+                {
+                    keys[c].push_back( KeyPose( k * Scalar( 1 ) / 30, clips[c].getPose( k * Scalar( 1 ) / 30 ) ) );
+                }
+            }
+            auto linearPose = [&]( uint c, Scalar timestamp )
+            {
+                const std::vector< KeyPose >& k = keys[c];
+                const Scalar duration = k.back().first;
+                const Scalar t = duration - std::abs( std::fmod( timestamp, 2 * duration ) - duration );
+                if ( t <= k.front().first )
+                {
+                    return k.front().second;
+                }
+                for ( uint i = 0; i < k.size() - 1; ++i )
+                {
+                    if ( t >= k[i].first && t <= k[i + 1].first )
+                    {
+                        return interpolatePoses( k[i].second, k[i + 1].second,
+                                                 ( t - k[i].first ) / ( k[i + 1].first - k[i].first ) );
+                    }
+                }
+                return k.back().second;
+            };
+
+            std::vector< Pose > poses( numSkeletons );
+            std::vector< Clip::Cursor > cursors( numSkeletons );
+            const std::string frames = std::to_string( numSkeletons ) + " skeletons, "
+                                     + std::to_string( numFrames ) + " frames";
+
+            report( "linear search : " + frames, bestOf( 3, [&]()
+            {
+                for ( uint f = 0; f < numFrames; ++f )
+                {
+                    for ( uint i = 0; i < numSkeletons; ++i )
+                    {
+                        poses[i] = linearPose( i % numClips, offsets[i] + f * frameTime );
+                    }
+                }
+            } ) );
+            report( "binary search : " + frames, bestOf( 3, [&]()
+            {
+                for ( uint f = 0; f < numFrames; ++f )
+                {
+                    for ( uint i = 0; i < numSkeletons; ++i )
+                    {
+                        poses[i] = clips[i % numClips].getPose( offsets[i] + f * frameTime );
+                    }
+                }
+            } ) );
+            report( "cursors : " + frames, bestOf( 3, [&]()
+            {
+                for ( uint f = 0; f < numFrames; ++f )
+                {
+                    for ( uint i = 0; i < numSkeletons; ++i )
+                    {
+                        clips[i % numClips].getPose( offsets[i] + f * frameTime, cursors[i], poses[i] );
+                    }
+                }
+            } ) );
+            report( "cursors, parallel : " + frames, bestOf( 3, [&]()
+            {
+                for ( uint f = 0; f < numFrames; ++f )
+                {
+                    parallelFor( 0, numSkeletons, 0, [&]( uint begin, uint end )
+                    {
+                        for ( uint i = begin; i < end; ++i )
+                        {
+                            clips[i % numClips].getPose( offsets[i] + f * frameTime, cursors[i], poses[i] );
+                        }
+                    } );
+                }
+            } ) );
+        }
+    };
+    RA_BENCHMARK_CLASS( AnimationBenchmark );
+
+    /// Model poses of 1000 skeletons of 100 bones : previous Skeleton::setPose() loop over the
+    /// children lists, against the flattened hierarchy, one skeleton at a time and batched.
+    class ForwardKinematicsBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "ForwardKinematics"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            const uint numBones     = 100;
+            const uint numSkeletons = 1000;
+
+            // Chains of 10 bones attached to a spine.
+            Skeleton skeleton;
+            Pose local( numBones );
+            for ( uint i = 0; i < numBones; ++i )
+            {
+                local[i] = Translation( Vector3::Random() ) * AngleAxis( Scalar( 1 ), Vector3::Random().normalized() );
+                skeleton.addBone( i == 0 ? -1 : int( i % 10 == 0 ? i - 10 : i - 1 ), local[i] );
+            }
+            const Graph::AdjacencyList& graph = skeleton.m_graph;
+            std::vector< Pose > locals( numSkeletons, local );
+            std::vector< Pose > models( numSkeletons );
+            const std::string size = std::to_string( numSkeletons ) + " skeletons";
+
+            report( "previous setPose(LOCAL) : " + size, bestOf( 10, [&]()
+            {
+                for ( uint s = 0; s < numSkeletons; ++s )
+                {
+                    models[s].resize( numBones );
+                    for ( uint i = 0; i < graph.size(); ++i )
+                    {
+                        if ( graph.isRoot( i ) )
+                        {
+                            models[s][i] = locals[s][i];
+                        }
+                        for ( const auto& child : graph.m_child[i] )
+                        {
+                            models[s][child] = models[s][i] * locals[s][child];
+                        }
+                    }
+                }
+            } ) );
+            report( "previous setPose(MODEL) : " + size, bestOf( 10, [&]()
+            {
+                for ( uint s = 0; s < numSkeletons; ++s )
+                {
+                    locals[s].resize( numBones );
+                    for ( uint i = 0; i < graph.size(); ++i )
+                    {
+                        if ( graph.isRoot( i ) )
+                        {
+                            locals[s][i] = models[s][i];
+                        }
+                        for ( const auto& child : graph.m_child[i] )
+                        {
+                            locals[s][child] = models[s][i].inverse() * models[s][child];
+                        }
+                    }
+                }
+            } ) );
+
+            ForwardKinematics fk( graph );
+            report( "computeModelPose : " + size, bestOf( 10, [&]()
+            {
+                for ( uint s = 0; s < numSkeletons; ++s )
+                {
+                    fk.computeModelPose( locals[s], models[s] );
+                }
+            } ) );
+            report( "computeLocalPose : " + size, bestOf( 10, [&]()
+            {
+                for ( uint s = 0; s < numSkeletons; ++s )
+                {
+                    fk.computeLocalPose( models[s], locals[s] );
+                }
+            } ) );
+
+            PoseArrays localArrays;
+            PoseArrays modelArrays;
+            localArrays.resize( numSkeletons * numBones );
+            for ( uint s = 0; s < numSkeletons; ++s )
+            {
+                fk.setPose( locals[s], s, localArrays );
+            }
+            report( "computeModelPoses, batched : " + size, bestOf( 10, [&]()
+            {
+                fk.computeModelPoses( localArrays, modelArrays );
+            } ) );
+        }
+    };
+    RA_BENCHMARK_CLASS( ForwardKinematicsBenchmark );
+
+    /// Two minutes of a 70 bones rig at 30 Hz : memory of the dense Animation against the
+    /// CompressedAnimation, compression error, and decoding of 60 poses of 1000 skeletons.
+    class CompressedAnimationBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "CompressedAnimation"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+            typedef Ra::Core::Animation::Animation Clip;
+
+            const uint numSamples   = 2 * 60 * 30 + 1;
+            const uint numBones     = 70;
+            const uint numSkeletons = 1000;
+            const uint numFrames    = 60;
+
+            // A quarter of the bones do not move (e.g. fingers), the root translates, the others rotate.
+            std::vector< Pose > samples( numSamples, Pose( numBones ) );
+            Clip clip;
+            for ( uint i = 0; i < numSamples; ++i )
+            {
+                const Scalar t = Scalar( i ) / 30;
+                for ( uint b = 0; b < numBones; ++b )
+                {
+                    const Vector3 axis = Vector3( 1, Scalar( b % 7 ), Scalar( b % 3 ) ).normalized();
+                    const Scalar a = ( b % 4 == 3 ) ? Scalar( 0.3 ) : std::sin( ( 1 + b % 5 ) * t + b ) / 2;
+                    const Vector3 tr = ( b == 0 ) ? Vector3( t, std::abs( std::sin( 4 * t ) ) / 10, 0 )
+                                                  : Vector3( 0, Scalar( 0.2 ), 0 );
+                    samples[i][b] = Translation( tr ) * AngleAxis( a, axis );
+                }
+                clip.addKeyPose( samples[i], t );
+            }
+
+            CompressedAnimation compressed;
+            report( "compress : " + std::to_string( numSamples ) + " samples", bestOf( 1, [&]()
+            {
+                compressed.compress( samples );
+            } ) );
+            const CompressedAnimation::ErrorReport error = compressed.computeError( samples );
+            const size_t dense = size_t( numSamples ) * numBones * sizeof( Transform );
+            printf( "  (dense poses %.1f MB, compressed %.2f MB, %u constant tracks of %u)\n",
+                    dense / 1e6, compressed.getMemorySize() / 1e6, compressed.getConstantTrackSize(), 3 * numBones );
+            printf( "  (max errors : rotation %.2e rad, translation %.2e, scale %.2e)\n",
+                    error.m_rotation, error.m_translation, error.m_scale );
+
+            std::vector< Pose > poses( numSkeletons );
+            std::vector< Clip::Cursor > cursors( numSkeletons );
+            const std::string frames = std::to_string( numSkeletons ) + " skeletons, "
+                                     + std::to_string( numFrames ) + " frames";
+            report( "dense, cursors : " + frames, bestOf( 3, [&]()
+            {
+                for ( uint f = 0; f < numFrames; ++f )
+                {
+                    for ( uint i = 0; i < numSkeletons; ++i )
+                    {
+                        clip.getPose( Scalar( i ) / 10 + Scalar( f ) / 60, cursors[i], poses[i] );
+                    }
+                }
+            } ) );
+            report( "compressed : " + frames, bestOf( 3, [&]()
+            {
+                for ( uint f = 0; f < numFrames; ++f )
+                {
+                    for ( uint i = 0; i < numSkeletons; ++i )
+                    {
+                        compressed.getPose( Scalar( i ) / 10 + Scalar( f ) / 60, poses[i] );
+                    }
+                }
+            } ) );
+        }
+    };
+    RA_BENCHMARK_CLASS( CompressedAnimationBenchmark );
+}
+
+#endif // RADIUM_ANIMATION_BENCHMARKS_HPP_
@@ -0,0 +1,131 @@
+#ifndef RADIUM_SKINNING_BENCHMARKS_HPP_
+#define RADIUM_SKINNING_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
+#include <Core/Animation/Skinning/GPUSkinning.hpp>
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
+#include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Skins a 100k vertices mesh with 100 bones and 4 influences per vertex, with LBS and DQS.
+    class SkinningBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "Skinning"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            const uint numVertices = 100000;
+            const uint numBones    = 100;
+
+            Vector3Array mesh;
+            WeightMatrix weights;
+            Pose pose;
+            makeSkinnedMesh( numVertices, numBones, 4, mesh, weights, pose );
+
+            Vector3Array result;
+            report( "LBS sparse weights", bestOf( 10, [&]()
+            {
+                linearBlendSkinning( mesh, pose, weights, result );
+            } ) );
+
+            InfluenceTable table;
+            report( "build influence table", bestOf( 10, [&]()
+            {
+                buildInfluenceTable( weights, 8, false, table );
+            } ) );
+            report( "LBS influence table, 1 thread", bestOf( 10, [&]()
+            {
+                linearBlendSkinning( mesh, pose, table, result );
+            } ) );
+
+            Vector4Array packedWeights;
+            Vector4Array packedIndices;
+            BonePalette palette;
+            report( "pack GPU skinning weights", bestOf( 10, [&]()
+            {
+                packGPUSkinningWeights( weights, packedWeights, packedIndices );
+            } ) );
+            report( "GPU skinning palette", bestOf( 10, [&]()
+            {
+                computeGPUSkinningPalette( pose, palette );
+            } ) );
+            report( "LBS packed weights (GPU reference), 1 thread", bestOf( 10, [&]()
+            {
+                gpuSkinning( mesh, palette, packedWeights, packedIndices, result );
+            } ) );
+
+            DQList DQ;
+            report( "DQS sparse computeDQ + skinning", bestOf( 10, [&]()
+            {
+                computeDQ( pose, weights, DQ );
+                dualQuaternionSkinning( mesh, DQ, result );
+            } ) );
+            report( "DQS fused, 1 thread", bestOf( 10, [&]()
+            {
+                dualQuaternionSkinning( mesh, pose, table, result );
+            } ) );
+            report( "DQS fused with DQ output, 1 thread", bestOf( 10, [&]()
+            {
+                dualQuaternionSkinning( mesh, pose, table, result, &DQ );
+            } ) );
+
+            const uint numThreads = std::max( 1u, std::thread::hardware_concurrency() - 1 );
+            TaskQueue queue( numThreads );
+            TaskQueue* previousQueue = getParallelForQueue();
+            setParallelForQueue( &queue );
+            report( "LBS influence table, " + std::to_string( numThreads + 1 ) + " threads", bestOf( 10, [&]()
+            {
+                linearBlendSkinning( mesh, pose, table, result );
+            } ) );
+            report( "DQS fused, " + std::to_string( numThreads + 1 ) + " threads", bestOf( 10, [&]()
+            {
+                dualQuaternionSkinning( mesh, pose, table, result );
+            } ) );
+            setParallelForQueue( previousQueue );
+        }
+
+    public:
+        /// Fills a random mesh where each vertex is influenced by numInfluences bones.
+        static void makeSkinnedMesh( uint numVertices, uint numBones, uint numInfluences,
+                                     Ra::Core::Vector3Array& mesh, Ra::Core::Animation::WeightMatrix& weights,
+                                     Ra::Core::Animation::Pose& pose )
+        {
+            using namespace Ra::Core;
+
+            mesh.resize( numVertices );
+            std::vector< Eigen::Triplet< Scalar > > triplets;
+            triplets.reserve( numVertices * numInfluences );
+            for ( uint i = 0; i < numVertices; ++i )
+            {
+                mesh[i] = Vector3::Random();
+                const uint firstBone = ( i * numBones ) / numVertices;
+                for ( uint k = 0; k < numInfluences; ++k )
+                {
+                    triplets.push_back( Eigen::Triplet< Scalar >( i, ( firstBone + k ) % numBones,
+                                                                  Scalar( 1 ) / numInfluences ) );
+                }
+            }
+            weights.resize( numVertices, numBones );
+            weights.setFromTriplets( triplets.begin(), triplets.end() );
+
+            pose.resize( numBones );
+            for ( auto& t : pose )
+            {
+                t = Translation( Vector3::Random() ) * AngleAxis( Scalar( 0.5 ), Vector3::Random().normalized() );
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( SkinningBenchmark );
+}
+
+#endif // RADIUM_SKINNING_BENCHMARKS_HPP_
@@ -0,0 +1,58 @@
+#ifndef RADIUM_BENCHMARKS_HPP_
+#define RADIUM_BENCHMARKS_HPP_
+#include <Core/CoreMacros.hpp>
+#include <Core/Time/Timer.hpp>
+#include <Tests/CoreBenchmarks/Manager.hpp>
+
+#include <string>
+#include <limits>
+#include <algorithm>
+
+namespace RaBenchmarks {
+/// Base class for all benchmarks.
+/// Benchmarks are not pass/fail tests : they only print their timings.
+class Benchmark
+{
+public:
+    Benchmark()
+    {
+        if (!BenchmarkManager::getInstance())
+        {
+            BenchmarkManager::createInstance();
+        }
+        BenchmarkManager::getInstance()->add(this);
+    }
+
+    virtual std::string getName() const = 0;
+    virtual void run() = 0;
+
+    virtual ~Benchmark() {};
+
+protected:
+    /// Runs f() the given number of times and returns the best time in milliseconds.
+    template <typename Func>
+    static double bestOf(uint repeats, const Func& f)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (uint i = 0; i < repeats; ++i)
+        {
+            const auto start = Ra::Core::Timer::Clock::now();
+            f();
+            const auto end = Ra::Core::Timer::Clock::now();
+            best = std::min(best, double(Ra::Core::Timer::getIntervalMicro(start, end)) / 1000.0);
+        }
+        return best;
+    }
+
+    /// Prints one timing line.
+    static void report(const std::string& label, double ms)
+    {
+        printf("  %-48s %12.3f ms\n", label.c_str(), ms);
+    }
+};
+
+// Poor man's singleton to automatically instantiate a benchmark.
+#define RA_BENCHMARK_CLASS( TYPE ) namespace TYPE##NS { TYPE bench_instance;}
+
+}
+#endif // RADIUM_BENCHMARKS_HPP_
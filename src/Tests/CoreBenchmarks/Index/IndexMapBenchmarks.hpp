@@ -0,0 +1,112 @@
+#ifndef RADIUM_INDEXMAP_BENCHMARKS_HPP_
+#define RADIUM_INDEXMAP_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Index/IndexMap.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Compares the slot map IndexMap with its previous implementation (sorted indices
+    /// searched linearly) for 10^3 to 10^6 objects.
+    class IndexMapBenchmark : public Benchmark
+    {
+        /// Previous IndexMap : objects sorted by index, the smallest free index is reused.
+        struct LinearIndexMap
+        {
+            std::deque<int> m_data;
+            std::deque<Ra::Core::Index> m_index;
+            std::deque<Ra::Core::Index> m_free = std::deque<Ra::Core::Index>( 1, Ra::Core::Index( 0 ) );
+
+            Ra::Core::Index insert( int obj )
+            {
+                Ra::Core::Index idx = m_free.front();
+                m_free.pop_front();
+                if ( m_free.empty() )
+                {
+                    m_free.push_back( idx + 1 );
+                }
+                auto it = std::lower_bound( m_index.begin(), m_index.end(), idx );
+                m_data.insert( m_data.begin() + ( it - m_index.begin() ), obj );
+                m_index.insert( it, idx );
+                return idx;
+            }
+
+            int& access( const Ra::Core::Index& idx )
+            {
+                return m_data[std::find( m_index.begin(), m_index.end(), idx ) - m_index.begin()];
+            }
+
+            void remove( const Ra::Core::Index& idx )
+            {
+                auto it = std::find( m_index.begin(), m_index.end(), idx );
+                m_data.erase( m_data.begin() + ( it - m_index.begin() ) );
+                m_index.erase( it );
+                m_free.insert( std::lower_bound( m_free.begin(), m_free.end(), idx ), idx );
+            }
+        };
+
+        std::string getName() const override { return "IndexMap"; }
+
+        template <typename Map>
+        void runMap( const std::string& name, uint size, const std::vector<Ra::Core::Index>& queries )
+        {
+            Map map;
+            report( name + " : insert " + std::to_string( size ), bestOf( 1, [&]()
+            {
+                for ( uint i = 0; i < size; ++i )
+                {
+                    map.insert( int( i ) );
+                }
+            } ) );
+
+            int sum = 0;
+            report( name + " : 1000 accesses", bestOf( 3, [&]()
+            {
+                for ( const auto& idx : queries )
+                {
+                    sum += map.access( idx );
+                }
+            } ) );
+
+            report( name + " : 1000 removals and insertions", bestOf( 1, [&]()
+            {
+                for ( const auto& idx : queries )
+                {
+                    map.remove( idx );
+                }
+                for ( uint i = 0; i < queries.size(); ++i )
+                {
+                    map.insert( int( i ) );
+                }
+            } ) );
+            if ( sum == 42 )
+            {
+                printf( "\n" );
+            }
+        }
+
+        void run() override
+        {
+            for ( uint size : { 1000u, 10000u, 100000u, 1000000u } )
+            {
+                // Distinct indices, as the removals use the same queries.
+                std::vector<Ra::Core::Index> queries;
+                for ( uint i = 0; i < 1000; ++i )
+                {
+                    queries.push_back( Ra::Core::Index( int( ( uint64_t( i ) * size ) / 1000 ) ) );
+                }
+                std::random_shuffle( queries.begin(), queries.end() );
+
+                runMap<Ra::Core::IndexMap<int>>( "slot map", size, queries );
+                runMap<LinearIndexMap>( "linear search", size, queries );
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( IndexMapBenchmark );
+}
+
+#endif // RADIUM_INDEXMAP_BENCHMARKS_HPP_
@@ -0,0 +1,24 @@
+#include <Tests/CoreBenchmarks/Manager.hpp>
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+
+namespace RaBenchmarks {
+
+    RA_SINGLETON_IMPLEMENTATION( BenchmarkManager );
+
+    void BenchmarkManager::add(Benchmark* bench)
+    {
+        m_benchmarks.push_back(bench);
+    }
+
+    void BenchmarkManager::run(const std::string& filter)
+    {
+        for (auto b : m_benchmarks)
+        {
+            if (filter.empty() || b->getName().find(filter) != std::string::npos)
+            {
+                printf("=== %s\n", b->getName().c_str());
+                b->run();
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef RADIUM_BENCHMARKS_MANAGER_HPP_
+#define RADIUM_BENCHMARKS_MANAGER_HPP_
+#include <Core/Utils/Singleton.hpp>
+
+#include <string>
+#include <vector>
+
+namespace RaBenchmarks {
+
+class Benchmark;
+
+/// Singleton class responsible for running the benchmarks.
+class BenchmarkManager {
+
+    RA_SINGLETON_INTERFACE(BenchmarkManager);
+public:
+    /// Empty constructor.
+    BenchmarkManager() {}
+
+    /// Register one benchmark into the manager.
+    void add(Benchmark* bench);
+
+    /// Run all benchmarks whose name contains the filter string (all if empty).
+    void run(const std::string& filter);
+
+public:
+    std::vector<Benchmark*> m_benchmarks; /// Storage for the benchmark instances.
+};
+
+}
+
+#endif // RADIUM_BENCHMARKS_MANAGER_HPP_
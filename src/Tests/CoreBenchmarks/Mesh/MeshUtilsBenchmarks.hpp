@@ -0,0 +1,81 @@
+#ifndef RADIUM_MESHUTILS_BENCHMARKS_HPP_
+#define RADIUM_MESHUTILS_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Welds the vertices of triangle soups (one vertex per triangle corner) of geodesic spheres,
+    /// up to 1M vertices, and compares with the previous quadratic search on the small ones.
+    class DuplicatesBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "Duplicates"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            for ( uint level : { 3u, 5u, 7u } )
+            {
+                const TriangleMesh sphere = MeshUtils::makeGeodesicSphere( 1.f, level );
+                TriangleMesh soup;
+                for ( const auto& t : sphere.m_triangles )
+                {
+                    const uint first = soup.m_vertices.size();
+                    for ( uint k = 0; k < 3; ++k )
+                    {
+                        soup.m_vertices.push_back( sphere.m_vertices[t[k]] );
+                        soup.m_normals.push_back( sphere.m_normals[t[k]] );
+                    }
+                    soup.m_triangles.push_back( Triangle( first, first + 1, first + 2 ) );
+                }
+                const std::string n = std::to_string( soup.m_vertices.size() );
+
+                std::vector<VertexIdx> map;
+                report( "exact : " + n + " vertices", bestOf( 3, [&]()
+                {
+                    MeshUtils::findDuplicates( soup, map );
+                } ) );
+
+                MeshUtils::DuplicatesOptions options;
+                options.m_epsilon = 1e-4f;
+                options.m_compareNormals = true;
+                options.m_attribEpsilon = 1e-2f;
+                report( "epsilon and normals : " + n + " vertices", bestOf( 3, [&]()
+                {
+                    MeshUtils::findDuplicates( soup, map, options );
+                } ) );
+
+                TriangleMesh welded;
+                std::vector<VertexIdx> vertexMap;
+                report( "remove : " + n + " vertices", bestOf( 3, [&]()
+                {
+                    welded = soup;
+                    MeshUtils::removeDuplicates( welded, vertexMap );
+                } ) );
+
+                if ( soup.m_vertices.size() < 100000 )
+                {
+                    // Previous implementation : linear search of each vertex among the previous ones.
+                    report( "quadratic : " + n + " vertices", bestOf( 1, [&]()
+                    {
+                        map.assign( soup.m_vertices.size(), VertexIdx( -1 ) );
+                        for ( uint i = 0; i < soup.m_vertices.size(); ++i )
+                        {
+                            auto it = std::find( soup.m_vertices.begin(), soup.m_vertices.begin() + i, soup.m_vertices[i] );
+                            map[i] = ( it == soup.m_vertices.begin() + i ) ? i : map[it - soup.m_vertices.begin()];
+                        }
+                    } ) );
+                }
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( DuplicatesBenchmark );
+}
+
+#endif // RADIUM_MESHUTILS_BENCHMARKS_HPP_
@@ -0,0 +1,81 @@
+#ifndef RADIUM_RAYCAST_BENCHMARKS_HPP_
+#define RADIUM_RAYCAST_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/TreeStructures/TriangleBVH.hpp>
+
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Casts 1M rays against geodesic spheres of increasing subdivision levels, with a TriangleBVH,
+    /// and compares with the brute force MeshUtils::castRay on a subset of the rays.
+    class RayCastBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "RayCast"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            // Rays from a sphere of radius 3 towards random points of the unit ball : most of them hit.
+            const uint numRays = 1000000;
+            const uint numBruteForceRays = 1000;
+            std::vector<Ray> rays;
+            rays.reserve( numRays );
+            for ( uint i = 0; i < numRays; ++i )
+            {
+                const Vector3 origin = 3 * Vector3::Random().normalized();
+                const Vector3 target = Vector3::Random();
+                rays.push_back( Ray( origin, ( target - origin ).normalized() ) );
+            }
+
+            for ( uint level : { 2u, 4u, 6u, 8u } )
+            {
+                TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, level );
+                const std::string n = std::to_string( mesh.m_triangles.size() );
+
+                TriangleBVH bvh;
+                report( n + " triangles : build", bestOf( 3, [&]() { bvh.build( mesh ); } ) );
+                report( n + " triangles : refit", bestOf( 3, [&]() { bvh.refit( mesh ); } ) );
+
+                uint numHits = 0;
+                report( n + " triangles : 1M closest hits", bestOf( 1, [&]()
+                {
+                    numHits = 0;
+                    TriangleBVH::Hit hit;
+                    for ( const Ray& ray : rays )
+                    {
+                        numHits += bvh.closestHit( mesh, ray, hit ) ? 1 : 0;
+                    }
+                } ) );
+                report( n + " triangles : 1M any hits", bestOf( 1, [&]()
+                {
+                    TriangleBVH::Hit hit;
+                    for ( const Ray& ray : rays )
+                    {
+                        bvh.anyHit( mesh, ray, hit );
+                    }
+                } ) );
+
+                if ( level <= 6 )
+                {
+                    const double bruteForce = bestOf( 1, [&]()
+                    {
+                        for ( uint i = 0; i < numBruteForceRays; ++i )
+                        {
+                            MeshUtils::castRay( mesh, rays[i] );
+                        }
+                    } );
+                    report( n + " triangles : 1M brute force (extrapolated)", bruteForce * numRays / numBruteForceRays );
+                }
+                printf( "  (%u rays hit the mesh)\n", numHits );
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( RayCastBenchmark );
+}
+
+#endif // RADIUM_RAYCAST_BENCHMARKS_HPP_
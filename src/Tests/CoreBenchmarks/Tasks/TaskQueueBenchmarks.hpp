@@ -0,0 +1,86 @@
+#ifndef RADIUM_TASKQUEUE_BENCHMARKS_HPP_
+#define RADIUM_TASKQUEUE_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/Task.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace RaBenchmarks
+{
+    /// Compares the scheduling strategies of the task queue on a frame made of many
+    /// tiny independent tasks and on a frame made of a long chain of dependent tasks.
+    class TaskQueueBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "TaskQueue"; }
+
+        void run() override
+        {
+            const uint numThreads = std::max( 1u, std::thread::hardware_concurrency() - 1 );
+            printf( "  %u worker threads\n", numThreads );
+
+            for ( auto scheduling : { Ra::Core::TaskQueue::Scheduling::SharedQueue,
+                                      Ra::Core::TaskQueue::Scheduling::WorkStealing } )
+            {
+                const std::string mode = ( scheduling == Ra::Core::TaskQueue::Scheduling::SharedQueue ) ?
+                                         "shared queue" : "work stealing";
+                Ra::Core::TaskQueue queue( numThreads, scheduling );
+
+                report( mode + " : 10k independent tasks", bestOf( 10, [&queue]()
+                {
+                    runFrame( queue, 10000, false );
+                } ) );
+                report( mode + " : 10k tasks dependency chain", bestOf( 10, [&queue]()
+                {
+                    runFrame( queue, 10000, true );
+                } ) );
+
+                // Same frames, replaying a task graph built once.
+                std::atomic<uint> counter( 0 );
+                for ( bool chain : { false, true } )
+                {
+                    buildTasks( queue, 10000, chain, counter );
+                    report( mode + ( chain ? " : replay 10k tasks chain" : " : replay 10k independent tasks" ),
+                            bestOf( 10, [&queue]()
+                    {
+                        queue.startTasks();
+                        queue.waitForTasks();
+                    } ) );
+                    queue.flushTaskQueue();
+                }
+            }
+        }
+
+        /// Registers, runs and flushes one frame of numTasks tiny function tasks.
+        static void runFrame( Ra::Core::TaskQueue& queue, uint numTasks, bool chain )
+        {
+            std::atomic<uint> counter( 0 );
+            buildTasks( queue, numTasks, chain, counter );
+            queue.startTasks();
+            queue.waitForTasks();
+            queue.flushTaskQueue();
+            CORE_ASSERT( counter == numTasks, "Some tasks were not run" );
+        }
+
+        /// Registers numTasks tiny function tasks, optionally chained one after the other.
+        static void buildTasks( Ra::Core::TaskQueue& queue, uint numTasks, bool chain, std::atomic<uint>& counter )
+        {
+            Ra::Core::TaskQueue::TaskId previous = Ra::Core::TaskQueue::InvalidTaskId;
+            for ( uint i = 0; i < numTasks; ++i )
+            {
+                Ra::Core::TaskQueue::TaskId id = queue.registerTask( new Ra::Core::FunctionTask(
+                    [&counter]() { ++counter; }, "Tiny task" ) );
+                if ( chain && previous != Ra::Core::TaskQueue::InvalidTaskId )
+                {
+                    queue.addDependency( previous, id );
+                }
+                previous = id;
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( TaskQueueBenchmark );
+}
+
+#endif // RADIUM_TASKQUEUE_BENCHMARKS_HPP_
@@ -0,0 +1,93 @@
+#ifndef RADIUM_BVH_BENCHMARKS_HPP_
+#define RADIUM_BVH_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/TreeStructures/BVH.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Builds, refits and queries a BVH of 1k, 10k and 100k random boxes.
+    class BVHBenchmark : public Benchmark
+    {
+        struct Box
+        {
+            Ra::Core::Aabb m_aabb;
+            Ra::Core::Aabb getAabb() const { return m_aabb; }
+        };
+
+        std::string getName() const override { return "BVH"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const Matrix4 proj = MatrixUtils::perspective( Scalar( 0.5 ), Scalar( 1.5 ), Scalar( 0.1 ), Scalar( 100 ) );
+            const Matrix4 view = MatrixUtils::lookAt( Vector3( 0, 0, 80 ), Vector3( 20, 10, 0 ), Vector3( 0, 1, 0 ) );
+            const Frustum frustum( proj * view );
+
+            const uint numThreads = std::max( 1u, std::thread::hardware_concurrency() - 1 );
+            TaskQueue queue( numThreads );
+
+            for ( uint numBoxes : { 1000u, 10000u, 100000u } )
+            {
+                const std::string n = std::to_string( numBoxes );
+                BVH<Box> bvh;
+                std::vector<std::shared_ptr<Box>> boxes;
+                for ( uint i = 0; i < numBoxes; ++i )
+                {
+                    auto box = std::make_shared<Box>();
+                    const Vector3 center = 50 * Vector3::Random();
+                    const Vector3 half = Vector3::Random().cwiseAbs() * Scalar( 0.5 );
+                    box->m_aabb = Aabb( center - half, center + half );
+                    boxes.push_back( box );
+                    bvh.insertLeaf( box );
+                }
+
+                report( n + " boxes : build, 1 thread", bestOf( 5, [&]() { bvh.build(); } ) );
+                TaskQueue* previousQueue = getParallelForQueue();
+                setParallelForQueue( &queue );
+                report( n + " boxes : build, " + std::to_string( numThreads + 1 ) + " threads",
+                        bestOf( 5, [&]() { bvh.build(); } ) );
+                setParallelForQueue( previousQueue );
+
+                report( n + " boxes : refit", bestOf( 5, [&]() { bvh.refit(); } ) );
+
+                std::vector<std::shared_ptr<Box>> visible;
+                report( n + " boxes : frustum query", bestOf( 10, [&]()
+                {
+                    visible.clear();
+                    bvh.getInFrustum( visible, frustum );
+                } ) );
+                const std::string numVisible = std::to_string( visible.size() );
+                report( n + " boxes : frustum test of each box", bestOf( 10, [&]()
+                {
+                    visible.clear();
+                    for ( const auto& box : boxes )
+                    {
+                        bool inside = true;
+                        for ( uint i = 0; i < 6 && inside; ++i )
+                        {
+                            const Vector4& plane = frustum.m_planes[i];
+                            const Vector3 p = ( plane.head<3>().array() >= 0 ).select( box->m_aabb.max(), box->m_aabb.min() );
+                            inside = plane.head<3>().dot( p ) + plane.w() >= 0;
+                        }
+                        if ( inside )
+                        {
+                            visible.push_back( box );
+                        }
+                    }
+                } ) );
+                printf( "  (%s visible boxes)\n", numVisible.c_str() );
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( BVHBenchmark );
+}
+
+#endif // RADIUM_BVH_BENCHMARKS_HPP_
@@ -0,0 +1,82 @@
+#ifndef RADIUM_BLOBFILE_BENCHMARKS_HPP_
+#define RADIUM_BLOBFILE_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Utils/File/BlobFile.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Building a mesh from a triangle soup (welding, as an importer post process does) against
+    /// reading it back from a blob file, with the cost of the stamps checked before using a blob.
+    class BlobFileBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "BlobFile"; }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const TriangleMesh sphere = MeshUtils::makeGeodesicSphere( 1.f, 7 );
+            TriangleMesh soup;
+            for ( const auto& t : sphere.m_triangles )
+            {
+                const uint first = soup.m_vertices.size();
+                for ( uint k = 0; k < 3; ++k )
+                {
+                    soup.m_vertices.push_back( sphere.m_vertices[t[k]] );
+                    soup.m_normals.push_back( sphere.m_normals[t[k]] );
+                }
+                soup.m_triangles.push_back( Triangle( first, first + 1, first + 2 ) );
+            }
+            const std::string n = std::to_string( soup.m_vertices.size() ) + " vertices";
+            const std::string filename = "./blob_benchmark.rab";
+
+            TriangleMesh welded;
+            std::vector<VertexIdx> vertexMap;
+            report( "build : weld " + n, bestOf( 3, [&]()
+            {
+                welded = soup;
+                MeshUtils::removeDuplicates( welded, vertexMap );
+            } ) );
+
+            FileStamp stamp;
+            report( "build : write blob", bestOf( 3, [&]()
+            {
+                BlobWriter writer;
+                writer.addArray( welded.m_vertices );
+                writer.addArray( welded.m_normals );
+                writer.addArray( welded.m_triangles );
+                writer.save( filename, stamp, 1 );
+            } ) );
+
+            TriangleMesh loaded;
+            report( "load : read blob", bestOf( 5, [&]()
+            {
+                BlobReader reader;
+                reader.open( filename, 1 );
+                reader.readArray( loaded.m_vertices );
+                reader.readArray( loaded.m_normals );
+                reader.readArray( loaded.m_triangles );
+            } ) );
+            CORE_ASSERT( loaded.m_triangles.size() == welded.m_triangles.size(), "Blob should be read back" );
+
+            report( "stamp : path, time and size", bestOf( 5, [&]()
+            {
+                getFileStamp( filename, stamp, false );
+            } ) );
+            report( "stamp : with content hash", bestOf( 5, [&]()
+            {
+                getFileStamp( filename, stamp, true );
+            } ) );
+            std::remove( filename.c_str() );
+        }
+    };
+    RA_BENCHMARK_CLASS( BlobFileBenchmark );
+}
+
+#endif // RADIUM_BLOBFILE_BENCHMARKS_HPP_
@@ -0,0 +1,71 @@
+#ifndef RADIUM_DRAWLIST_BENCHMARKS_HPP_
+#define RADIUM_DRAWLIST_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Utils/DrawList.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Sorting the draws of synthetic scenes (a depth pass and a light pass, 16 shaders, 256 materials,
+    /// 1000 meshes), against std::sort, and the binds saved by the sorted order.
+    class DrawListBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "DrawList"; }
+
+        void run() override
+        {
+            using Ra::Core::DrawList;
+
+            for ( uint size : { 1000u, 10000u, 100000u } )
+            {
+                std::mt19937 rng( 7 );
+                std::vector<uint64_t> keys;
+                for ( uint i = 0; i < size; ++i )
+                {
+                    const uint material = rng() % 256;
+                    const uint mesh = rng() % 1000;
+                    const float depth = float( rng() % 4096 ) / 4096.f;
+                    keys.push_back( DrawList::makeKey( 0, 0, material, mesh, depth ) );
+                    keys.push_back( DrawList::makeKey( 1, rng() % 16, material, mesh, depth ) );
+                }
+                const std::string n = std::to_string( keys.size() ) + " draws";
+
+                DrawList list;
+                list.reserve( keys.size() );
+                report( "radix sort : " + n, bestOf( 10, [&]()
+                {
+                    list.clear();
+                    for ( uint i = 0; i < keys.size(); ++i )
+                    {
+                        list.add( keys[i], i );
+                    }
+                    list.sort();
+                } ) );
+
+                std::vector<DrawList::Draw> draws;
+                report( "std::sort : " + n, bestOf( 10, [&]()
+                {
+                    draws.clear();
+                    for ( uint i = 0; i < keys.size(); ++i )
+                    {
+                        draws.push_back( DrawList::Draw { keys[i], i, 0 } );
+                    }
+                    std::sort( draws.begin(), draws.end(), []( const DrawList::Draw& a, const DrawList::Draw& b )
+                    {
+                        return a.m_key < b.m_key;
+                    } );
+                } ) );
+
+                const DrawList::Statistics stats = list.getStatistics();
+                printf( "  (%u binds instead of %u)\n", stats.m_bind, stats.m_naiveBind );
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( DrawListBenchmark );
+}
+
+#endif // RADIUM_DRAWLIST_BENCHMARKS_HPP_
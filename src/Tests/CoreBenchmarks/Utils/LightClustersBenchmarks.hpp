@@ -0,0 +1,57 @@
+#ifndef RADIUM_LIGHTCLUSTERS_BENCHMARKS_HPP_
+#define RADIUM_LIGHTCLUSTERS_BENCHMARKS_HPP_
+
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+#include <Core/Utils/LightClusters.hpp>
+
+#include <random>
+#include <vector>
+
+namespace RaBenchmarks
+{
+    /// Binning random point lights in the 16x9x24 clusters of a 90 degrees frustum, and the number of lights
+    /// a fragment shades compared to looping over all the lights.
+    class LightClustersBenchmark : public Benchmark
+    {
+        std::string getName() const override { return "LightClusters"; }
+
+        void run() override
+        {
+            using Ra::Core::LightClusters;
+            using Ra::Core::Vector3;
+
+            for ( uint size : { 1000u, 10000u } )
+            {
+                std::mt19937 rng( 7 );
+                std::uniform_real_distribution<Scalar> unit( 0.f, 1.f );
+                std::vector<LightClusters::Light> lights( size );
+                for ( auto& l : lights )
+                {
+                    const Scalar depth = 0.1f + 200.f * unit( rng );
+                    l.m_center = Vector3( ( 2.f * unit( rng ) - 1.f ) * depth,
+                                          ( 2.f * unit( rng ) - 1.f ) * 0.5625f * depth, -depth );
+                    l.m_radius = 0.5f + 4.f * unit( rng );
+                }
+
+                LightClusters clusters;
+                clusters.setFrustum( 1.f, 0.5625f, 0.1f, 200.f );
+                report( "build : " + std::to_string( size ) + " lights", bestOf( 10, [&]()
+                {
+                    clusters.build( lights );
+                } ) );
+
+                uint used = 0;
+                for ( uint c = 0; c < clusters.getClusterSize(); ++c )
+                {
+                    used += ( clusters.getLightSize( c ) > 0 );
+                }
+                printf( "  (%u indices, %.1f lights per non empty cluster instead of %u)\n",
+                        uint( clusters.getIndices().size() ),
+                        used == 0 ? 0.0 : double( clusters.getIndices().size() ) / used, size );
+            }
+        }
+    };
+    RA_BENCHMARK_CLASS( LightClustersBenchmark );
+}
+
+#endif // RADIUM_LIGHTCLUSTERS_BENCHMARKS_HPP_
@@ -0,0 +1,22 @@
+#include <Tests/CoreBenchmarks/Benchmarks.hpp>
+
+#include <Tests/CoreBenchmarks/Algebra/AabbCacheBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Algorithm/DiffusionBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Animation/AnimationBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Animation/SkinningBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Index/IndexMapBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Mesh/MeshUtilsBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/RayCasts/RayCastBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Tasks/TaskQueueBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/TreeStructures/BVHBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Utils/BlobFileBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Utils/DrawListBenchmarks.hpp>
+#include <Tests/CoreBenchmarks/Utils/LightClustersBenchmarks.hpp>
+
+/// Runs all the benchmarks, or only the ones whose name contains the first argument.
+int main(int argc, char** argv)
+{
+    if (! RaBenchmarks::BenchmarkManager::getInstance()) {RaBenchmarks::BenchmarkManager::createInstance();}
+    RaBenchmarks::BenchmarkManager::getInstance()->run(argc > 1 ? argv[1] : "");
+    return 0;
+}
@@ -0,0 +1,105 @@
+#ifndef RADIUM_AABBCACHE_TESTS_HPP_
+#define RADIUM_AABBCACHE_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Math/AabbCache.hpp>
+
+#include <thread>
+
+namespace RaTests
+{
+    class AabbCacheTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            // The O(1) transform gives the box of the transformed corners.
+            const Aabb box( Vector3( -1, 2, 0 ), Vector3( 3, 5, 1 ) );
+            bool exact = true;
+            for ( uint i = 0; i < 20; ++i )
+            {
+                Transform transform = Transform::Identity();
+                transform.translate( 10 * Vector3::Random() );
+                transform.rotate( AngleAxis( Scalar( i ), Vector3::Random().normalized() ) );
+                transform.scale( Vector3::Random().cwiseAbs() + Vector3::Constant( Scalar( 0.1 ) ) );
+
+                Aabb corners;
+                for ( int c = 0; c < 8; ++c )
+                {
+                    corners.extend( transform * box.corner( static_cast<Aabb::CornerType>( c ) ) );
+                }
+                const Aabb transformed = AabbCache::transformAabb( box, transform );
+                exact = exact && transformed.min().isApprox( corners.min(), Scalar( 1e-4 ) ) &&
+                        transformed.max().isApprox( corners.max(), Scalar( 1e-4 ) );
+            }
+            RA_UNIT_TEST( exact, "Transformed box should bound the transformed corners tightly" );
+            RA_UNIT_TEST( AabbCache::transformAabb( Aabb(), Transform::Identity() ).isEmpty(),
+                          "An empty box stays empty" );
+
+            RA_UNIT_TEST( AabbCache::makeVersion( 1, 0 ) != AabbCache::makeVersion( 0, 1 ),
+                          "Packed versions should not collide" );
+
+            // Staleness.
+            AabbCache cache;
+            Aabb aabb;
+            RA_UNIT_TEST( !cache.isLocalValid( 0 ) && !cache.getAabb( 0, 0, aabb ), "New cache is outdated" );
+
+            cache.setLocalAabb( box, 0 );
+            RA_UNIT_TEST( cache.isLocalValid( 0 ) && !cache.getAabb( 0, 0, aabb ),
+                          "The world box is outdated until updated" );
+
+            Transform transform = Transform::Identity();
+            transform.translate( Vector3( 1, 0, 0 ) );
+            cache.update( transform, 0 );
+            RA_UNIT_TEST( cache.getAabb( 0, 0, aabb ) && aabb.min().isApprox( Vector3( 0, 2, 0 ) ) &&
+                          aabb.max().isApprox( Vector3( 4, 5, 1 ) ), "Cached world box" );
+            RA_UNIT_TEST( !cache.getAabb( 0, 1, aabb ) && !cache.getAabb( 1, 0, aabb ),
+                          "A new version should outdate the world box" );
+
+            // A new local box outdates the world box, not the other way around.
+            cache.update( Transform::Identity(), 1 );
+            RA_UNIT_TEST( cache.isLocalValid( 0 ) && cache.getAabb( 0, 1, aabb ) && aabb.isApprox( box ),
+                          "Updating the transform keeps the local box" );
+            cache.setLocalAabb( Aabb( Vector3::Zero(), Vector3::Ones() ), 1 );
+            RA_UNIT_TEST( !cache.isLocalValid( 0 ) && !cache.getAabb( 0, 1, aabb ) && !cache.getAabb( 1, 1, aabb ),
+                          "A new local box should outdate the world box" );
+            cache.update( Transform::Identity(), 1 );
+            RA_UNIT_TEST( cache.getAabb( 1, 1, aabb ) && aabb.isApprox( cache.getLocalAabb() ), "Updated world box" );
+
+            // Readers racing with updates never get a box mixing two transforms.
+            cache.update( Transform( Translation( Vector3::Ones() ) ), 1 );
+            std::atomic<std::uint64_t> published( 1 );
+            std::atomic<bool> torn( false );
+            std::atomic<bool> done( false );
+            std::thread writer( [&]() {
+                for ( std::uint64_t version = 2; version < 200000; ++version )
+                {
+                    cache.update( Transform( Translation( Vector3::Constant( Scalar( version % 64 ) ) ) ), version );
+                    published.store( version, std::memory_order_release );
+                }
+                done = true;
+            } );
+            std::thread reader( [&]() {
+                const Aabb local = cache.getLocalAabb();
+                while ( !done )
+                {
+                    const std::uint64_t version = published.load( std::memory_order_acquire );
+                    Aabb read;
+                    const Vector3 offset = Vector3::Constant( Scalar( version % 64 ) );
+                    if ( cache.getAabb( 1, version, read ) &&
+                         ( read.min() != local.min() + offset || read.max() != local.max() + offset ) )
+                    {
+                        torn = true;
+                    }
+                }
+            } );
+            writer.join();
+            reader.join();
+            RA_UNIT_TEST( !torn, "A box read during an update should be rejected" );
+        }
+    };
+    RA_TEST_CLASS( AabbCacheTests );
+}
+
+#endif // RADIUM_AABBCACHE_TESTS_HPP_
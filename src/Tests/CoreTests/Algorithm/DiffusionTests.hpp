@@ -0,0 +1,88 @@
+#ifndef RADIUM_DIFFUSION_TESTS_HPP_
+#define RADIUM_DIFFUSION_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Algorithm/HeatDiffusion/DiffusionContext.hpp>
+#include <Core/Geometry/Operator/OperatorPattern.hpp>
+#include <Core/Geometry/Operator/TripletAssembly.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+
+namespace RaTests
+{
+    class DiffusionTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, 3 );
+            std::vector<VertexIdx> vertexMap;
+            MeshUtils::removeDuplicates( mesh, vertexMap );
+            const VectorArray<Vector3>& p = mesh.m_vertices;
+            const VectorArray<Triangle>& T = mesh.m_triangles;
+            const uint n = p.size();
+
+            Geometry::OperatorPattern pattern;
+            const Geometry::AreaVector A = Geometry::barycentricAreaVector( p, T );
+            const Algorithm::Time t = 0.01f;
+            Algorithm::DiffusionContext context;
+            RA_UNIT_TEST( context.compute( A, t, pattern.cotangentWeightLaplacian( p, T ) ) && context.size() == n,
+                          "Factorization failed" );
+
+            // Same heat as the one-shot function.
+            const Algorithm::Source source = { 0, 7, 42 };
+            Algorithm::Heat u;
+            context.solve( Algorithm::delta( source, n ), u );
+            const Algorithm::Heat reference = Algorithm::heat( Geometry::diagonalMatrix( A ), t,
+                                                               Geometry::cotangentWeightLaplacian( p, T ),
+                                                               Algorithm::delta( source, n ) );
+            RA_UNIT_TEST( u.getMap().isApprox( reference.getMap() ), "Wrong heat" );
+
+            // One column per source, summing to the heat of all the sources.
+            MatrixN U;
+            context.heat( source, U );
+            RA_UNIT_TEST( U.cols() == 3 && U.rowwise().sum().isApprox( reference.getMap().transpose() ),
+                          "Wrong multi-source heat" );
+            RA_UNIT_TEST( U( 7, 1 ) > U( 0, 1 ) && U( 7, 1 ) > U( 42, 1 ), "Heat should be maximal at its source" );
+
+            // Numeric refactorization of a deformed mesh.
+            for ( auto& v : mesh.m_vertices )
+            {
+                v = v.cwiseProduct( Vector3( 2.f, 1.f, 1.f ) );
+            }
+            const Geometry::AreaVector A2 = Geometry::barycentricAreaVector( p, T );
+            RA_UNIT_TEST( context.refactorize( A2, t, pattern.cotangentWeightLaplacian( p, T ) )
+                          && context.getAnalysisCount() == 1, "Refactorization should reuse the analysis" );
+            Algorithm::DiffusionContext fresh;
+            fresh.compute( A2, t, Geometry::cotangentWeightLaplacian( p, T ) );
+            Algorithm::Heat u2;
+            context.solve( Algorithm::delta( source, n ), u );
+            fresh.solve( Algorithm::delta( source, n ), u2 );
+            RA_UNIT_TEST( u.getMap().isApprox( u2.getMap() ), "Wrong heat after refactorization" );
+
+            // Implicit smoothing : noise is removed, and a zero time step does nothing.
+            VectorArray<Vector3> noisy = p;
+            for ( uint i = 0; i < n; ++i )
+            {
+                noisy[i] += ( i % 2 == 0 ? 0.05f : -0.05f ) * Vector3::UnitY();
+            }
+            VectorArray<Vector3> smoothed;
+            context.smooth( noisy, smoothed );
+            Scalar before = 0;
+            Scalar after = 0;
+            for ( uint i = 0; i < n; ++i )
+            {
+                before += ( noisy[i] - p[i] ).squaredNorm();
+                after += ( smoothed[i] - p[i] ).squaredNorm();
+            }
+            RA_UNIT_TEST( after < 0.5f * before, "Smoothing should remove the noise" );
+            context.refactorize( A2, 0, pattern.cotangentWeightLaplacian( p, T ) );
+            context.smooth( noisy, smoothed );
+            RA_UNIT_TEST( smoothed.getMap().isApprox( noisy.getMap() ), "Zero time step should not move the vertices" );
+        }
+    };
+    RA_TEST_CLASS( DiffusionTests );
+}
+
+#endif // RADIUM_DIFFUSION_TESTS_HPP_
@@ -0,0 +1,306 @@
+#ifndef RADIUM_ANIMATION_TESTS_HPP_
+#define RADIUM_ANIMATION_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/Animation.hpp>
+#include <Core/Animation/CompressedAnimation.hpp>
+#include <Core/Animation/Handle/ForwardKinematics.hpp>
+#include <Core/Animation/Handle/Skeleton.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace RaTests
+{
+    class AnimationTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            const uint numKeys  = 50;
+            const uint numBones = 10;
+
+            // Irregular key times, added out of order.
+            std::vector< KeyPose > keys( numKeys );
+            Scalar time = 0;
+            for ( uint i = 0; i < numKeys; ++i )
+            {
+                keys[i].first = time;
+                time += Scalar( 0.05 ) + Scalar( 0.1 ) * ( i % 3 );
+                keys[i].second.resize( numBones );
+                for ( auto& t : keys[i].second )
+                {
+                    t = Translation( Vector3::Random() ) * AngleAxis( Scalar( 1 ), Vector3::Random().normalized() );
+                }
+            }
+            Ra::Core::Animation::Animation animation;
+            for ( uint i = numKeys; i-- > 0; )
+            {
+                animation.addKeyPose( keys[i] );
+            }
+            animation.normalize();
+            RA_UNIT_TEST( animation.getKeySize() == numKeys && animation.getPoseSize() == numBones,
+                          "Animation should have all the keys" );
+
+            // Reference : linear search of the key interval, then pose interpolation.
+            const Scalar duration = keys.back().first;
+            auto reference = [&]( Scalar timestamp )
+            {
+                const Scalar t = duration - std::abs( std::fmod( timestamp, 2 * duration ) - duration );
+                if ( t <= keys.front().first )
+                {
+                    return keys.front().second;
+                }
+                uint i = 0;
+                while ( i + 2 < numKeys && t > keys[i + 1].first )
+                {
+                    ++i;
+                }
+                return interpolatePoses( keys[i].second, keys[i + 1].second,
+                                         ( t - keys[i].first ) / ( keys[i + 1].first - keys[i].first ) );
+            };
+            auto same = []( const Pose& a, const Pose& b )
+            {
+                if ( a.size() != b.size() )
+                {
+                    return false;
+                }
+                for ( uint i = 0; i < a.size(); ++i )
+                {
+                    if ( !a[i].matrix().isApprox( b[i].matrix(), Scalar( 1e-4 ) ) )
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            // Monotonic playback over two ping pong periods, with key times included.
+            Ra::Core::Animation::Animation::Cursor cursor;
+            Pose pose;
+            bool binarySame = true;
+            bool cursorSame = true;
+            for ( Scalar t = 0; t < 4 * duration; t += Scalar( 1 ) / 60 )
+            {
+                const Pose expected = reference( t );
+                binarySame = binarySame && same( animation.getPose( t ), expected );
+                animation.getPose( t, cursor, pose );
+                cursorSame = cursorSame && same( pose, expected );
+            }
+            for ( const auto& key : keys )
+            {
+                binarySame = binarySame && same( animation.getPose( key.first ), reference( key.first ) );
+            }
+            RA_UNIT_TEST( binarySame, "Binary search sampling should match the linear search" );
+            RA_UNIT_TEST( cursorSame, "Cursor sampling should match the linear search" );
+
+            // Random jumps : the cursor falls back to the binary search.
+            bool jumpSame = true;
+            for ( uint i = 0; i < 200; ++i )
+            {
+                const Scalar t = ( Scalar( 1 ) + Vector3::Random()[0] ) * duration * 2;
+                animation.getPose( t, cursor, pose );
+                jumpSame = jumpSame && same( pose, reference( t ) );
+            }
+            RA_UNIT_TEST( jumpSame, "Cursor sampling should handle jumps" );
+
+            Ra::Core::Animation::Animation single;
+            single.addKeyPose( keys[3].second, 1 );
+            single.getPose( Scalar( 0.5 ), cursor, pose );
+            RA_UNIT_TEST( same( pose, keys[3].second ), "Single key animation should return its pose" );
+        }
+    };
+    RA_TEST_CLASS( AnimationTests );
+
+    class ForwardKinematicsTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            // Random hierarchy, with non-uniform scales.
+            const uint numBones = 60;
+            Skeleton skeleton;
+            Pose local( numBones );
+            for ( uint i = 0; i < numBones; ++i )
+            {
+                local[i] = Translation( Vector3::Random() ) * AngleAxis( Scalar( 1 ), Vector3::Random().normalized() )
+                         * Eigen::Scaling( Vector3( Vector3::Random().cwiseAbs() + Vector3::Ones() ) );
+                skeleton.addBone( ( i == 0 || i == 7 ) ? -1 : int( ( i * 37 ) % i ), local[i] );
+            }
+
+            // Reference : the previous Skeleton::setPose(). Parents come first in this hierarchy.
+            const Graph::AdjacencyList& graph = skeleton.m_graph;
+            auto modelPose = [&graph]( const Pose& localPose )
+            {
+                Pose result( localPose.size() );
+                for ( uint i = 0; i < localPose.size(); ++i )
+                {
+                    if ( graph.isRoot( i ) )
+                    {
+                        result[i] = localPose[i];
+                    }
+                    for ( const auto& child : graph.m_child[i] )
+                    {
+                        result[child] = result[i] * localPose[child];
+                    }
+                }
+                return result;
+            };
+            const Pose model = modelPose( local );
+            auto same = []( const Pose& a, const Pose& b )
+            {
+                bool result = ( a.size() == b.size() );
+                for ( uint i = 0; i < a.size() && result; ++i )
+                {
+                    result = a[i].matrix().isApprox( b[i].matrix(), Scalar( 1e-4 ) );
+                }
+                return result;
+            };
+
+            ForwardKinematics fk( graph );
+            bool sorted = ( fk.size() == numBones );
+            std::vector< bool > done( numBones, false );
+            for ( uint k = 0; k < fk.size() && sorted; ++k )
+            {
+                sorted = ( fk.getParent()[k] == graph.m_parent[fk.getOrder()[k]] )
+                      && ( fk.getParent()[k] < 0 || done[fk.getParent()[k]] );
+                done[fk.getOrder()[k]] = true;
+            }
+            RA_UNIT_TEST( sorted, "Bones should come after their parent" );
+
+            skeleton.setPose( local, Handle::SpaceType::LOCAL );
+            RA_UNIT_TEST( same( skeleton.getPose( Handle::SpaceType::MODEL ), model ), "Model pose should match" );
+            skeleton.setPose( model, Handle::SpaceType::MODEL );
+            RA_UNIT_TEST( same( skeleton.getPose( Handle::SpaceType::LOCAL ), local ), "Local pose should match" );
+
+            // Re-parenting keeps the number of bones, the hierarchy is flattened again.
+            const uint version = skeleton.m_graph.getVersion();
+            skeleton.m_graph.setParent( 7, 0 );
+            RA_UNIT_TEST( skeleton.m_graph.getVersion() != version && skeleton.m_graph.m_parent[7] == 0
+                          && skeleton.m_graph.isEdge( 0, 7 ), "Re-parented bone" );
+            skeleton.setPose( local, Handle::SpaceType::LOCAL );
+            RA_UNIT_TEST( same( skeleton.getPose( Handle::SpaceType::MODEL ), modelPose( local ) ),
+                          "Model pose should follow the new hierarchy" );
+            skeleton.m_graph.setParent( 7, -1 );
+
+            // Batch of skeletons.
+            const uint numSkeletons = 5;
+            PoseArrays localArrays;
+            PoseArrays modelArrays;
+            localArrays.resize( numSkeletons * numBones );
+            std::vector< Pose > poses( numSkeletons, local );
+            for ( uint s = 0; s < numSkeletons; ++s )
+            {
+                poses[s][3 * s] = poses[s][3 * s] * AngleAxis( Scalar( s ), Vector3::UnitZ() );
+                fk.setPose( poses[s], s, localArrays );
+            }
+            fk.computeModelPoses( localArrays, modelArrays );
+            bool batchSame = ( modelArrays.size() == numSkeletons * numBones );
+            for ( uint s = 0; s < numSkeletons && batchSame; ++s )
+            {
+                Pose expected;
+                Pose result;
+                fk.computeModelPose( poses[s], expected );
+                fk.getPose( modelArrays, s, result );
+                batchSame = same( result, expected );
+            }
+            RA_UNIT_TEST( batchSame, "Batched model poses should match" );
+        }
+    };
+    RA_TEST_CLASS( ForwardKinematicsTests );
+
+    class CompressedAnimationTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            // 4 seconds at 30 Hz. Bones 0 to 4 are constant, 5 to 9 move linearly,
+            // the others oscillate, with a non-uniform scale on some of them.
+            const uint numSamples = 121;
+            const uint numBones   = 20;
+            std::vector< Pose > samples( numSamples, Pose( numBones ) );
+            for ( uint i = 0; i < numSamples; ++i )
+            {
+                const Scalar t = Scalar( i ) / 30;
+                for ( uint b = 0; b < numBones; ++b )
+                {
+                    const Vector3 axis = Vector3( 1, Scalar( b ), 2 ).normalized();
+                    Scalar a = Scalar( b ) / 10;
+                    Vector3 tr( Scalar( b ), 1, 0 );
+                    Vector3 scale = Vector3::Ones();
+                    if ( b >= 5 && b < 10 )
+                    {
+                        a += t / 2;
+                        tr += t * Vector3( 1, -1, 0 );
+                    }
+                    else if ( b >= 10 )
+                    {
+                        a += std::sin( 3 * t + b );
+                        tr += Vector3( std::cos( 2 * t ), 0, std::sin( 5 * t ) );
+                        scale = Vector3( 1, 1 + std::sin( t ) / 2, 1 );
+                    }
+                    samples[i][b] = Translation( tr ) * AngleAxis( a, axis ) * Eigen::Scaling( scale );
+                }
+            }
+
+            CompressedAnimation::Options options;
+            CompressedAnimation compressed;
+            compressed.compress( samples, options );
+            RA_UNIT_TEST( compressed.getSampleSize() == numSamples && compressed.getPoseSize() == numBones,
+                          "Compressed animation should have all the samples" );
+            RA_UNIT_TEST( std::abs( compressed.getDuration() - 4 ) < 1e-4, "Wrong duration" );
+            RA_UNIT_TEST( compressed.getConstantTrackSize() >= 5 * 3 + 5, "Constant tracks should have one key" );
+            RA_UNIT_TEST( compressed.getMemorySize() * 4 < numSamples * numBones * sizeof( Transform ),
+                          "Compressed animation should be smaller" );
+
+            const CompressedAnimation::ErrorReport error = compressed.computeError( samples );
+            RA_UNIT_TEST( error.m_rotation < 2 * options.m_rotationTolerance, "Rotation error too large" );
+            RA_UNIT_TEST( error.m_translation < 2 * options.m_translationTolerance, "Translation error too large" );
+            RA_UNIT_TEST( error.m_scale < 2 * options.m_scaleTolerance, "Scale error too large" );
+
+            // Between the samples, and with the ping pong playback.
+            Pose pose;
+            bool close = true;
+            for ( uint i = 0; i + 1 < numSamples; i += 7 )
+            {
+                const Scalar t = ( Scalar( i ) + Scalar( 0.5 ) ) / 30;
+                const Matrix4 expected = samples[i][12].matrix() + ( samples[i + 1][12].matrix() - samples[i][12].matrix() ) / 2;
+                compressed.getPose( t, pose );
+                close = close && pose[12].matrix().isApprox( expected, Scalar( 1e-2 ) );
+                compressed.getPose( 8 - t, pose );
+                close = close && pose[12].matrix().isApprox( expected, Scalar( 1e-2 ) );
+            }
+            RA_UNIT_TEST( close, "Poses between the samples should be interpolated" );
+
+            // From key poses.
+            Ra::Core::Animation::Animation animation;
+            for ( uint i = 0; i < numSamples; i += 6 )
+            {
+                Pose key = samples[i];
+                for ( auto& t : key )
+                {
+                    t.linear() = Matrix3( t.rotation() );
+                }
+                animation.addKeyPose( key, Scalar( i ) / 30 );
+            }
+            compressed.compress( animation, options );
+            bool same = !compressed.isEmpty();
+            for ( uint i = 0; i < numSamples && same; i += 6 )
+            {
+                compressed.getPose( Scalar( i ) / 30, pose );
+                same = same && ( pose[17].translation() - samples[i][17].translation() ).norm() < 1e-2;
+            }
+            RA_UNIT_TEST( same, "Key poses should be kept" );
+        }
+    };
+    RA_TEST_CLASS( CompressedAnimationTests );
+}
+
+#endif // RADIUM_ANIMATION_TESTS_HPP_
@@ -0,0 +1,200 @@
+#ifndef RADIUM_SKINNING_TESTS_HPP_
+#define RADIUM_SKINNING_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
+#include <Core/Animation/Skinning/GPUSkinning.hpp>
+#include <Core/Animation/Skinning/InfluenceTable.hpp>
+#include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
+#include <Core/Animation/Skinning/RotationCenterSkinning.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <cstdio>
+#include <vector>
+
+namespace RaTests
+{
+    class SkinningTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            const uint numVertices = 1000;
+            const uint numHandles  = 20;
+
+            // Vertex i is influenced by 1 to 5 handles.
+            Vector3Array mesh( numVertices );
+            std::vector< Eigen::Triplet< Scalar > > triplets;
+            for ( uint i = 0; i < numVertices; ++i )
+            {
+                mesh[i] = Vector3::Random();
+                const uint n = 1 + i % 5;
+                for ( uint k = 0; k < n; ++k )
+                {
+                    triplets.push_back( Eigen::Triplet< Scalar >( i, ( i + 3 * k ) % numHandles, Scalar( 1 ) / n ) );
+                }
+            }
+            WeightMatrix weights( numVertices, numHandles );
+            weights.setFromTriplets( triplets.begin(), triplets.end() );
+
+            Pose pose( numHandles );
+            for ( auto& t : pose )
+            {
+                t = Translation( Vector3::Random() ) * AngleAxis( Scalar( 0.5 ), Vector3::Random().normalized() );
+            }
+
+            InfluenceTable table;
+            buildInfluenceTable( weights, 8, false, table );
+            RA_UNIT_TEST( table.m_width == 5, "Table width should be the max number of influences" );
+            RA_UNIT_TEST( table.weight( 5, 1 ) == 0 && table.weight( 5, 0 ) != 0, "Unused slots should be at the end" );
+
+            Vector3Array sparseResult;
+            Vector3Array tableResult;
+            linearBlendSkinning( mesh, pose, weights, sparseResult );
+            linearBlendSkinning( mesh, pose, table, tableResult );
+            bool same = true;
+            for ( uint i = 0; i < numVertices; ++i )
+            {
+                same = same && sparseResult[i].isApprox( tableResult[i], Scalar( 1e-4 ) );
+            }
+            RA_UNIT_TEST( same, "Per-vertex LBS should match the sparse LBS" );
+
+            // The per-vertex path gives the same bits whatever the threads.
+            TaskQueue queue( 3 );
+            TaskQueue* previousQueue = getParallelForQueue();
+            setParallelForQueue( &queue );
+            Vector3Array parallelResult;
+            linearBlendSkinning( mesh, pose, table, parallelResult );
+            setParallelForQueue( previousQueue );
+            bool identical = true;
+            for ( uint i = 0; i < numVertices; ++i )
+            {
+                identical = identical && ( parallelResult[i] == tableResult[i] );
+            }
+            RA_UNIT_TEST( identical, "Per-vertex LBS should be deterministic" );
+
+            // The fused DQS pass matches the sparse two-pass version.
+            DQList sparseDQ;
+            computeDQ_naive( pose, weights, sparseDQ );
+            dualQuaternionSkinning( mesh, sparseDQ, sparseResult );
+            DQList fusedDQ;
+            dualQuaternionSkinning( mesh, pose, table, tableResult, &fusedDQ );
+            DQList tableDQ;
+            computeDQ( pose, table, tableDQ );
+            same = ( fusedDQ.size() == numVertices );
+            for ( uint i = 0; i < numVertices && same; ++i )
+            {
+                same = sparseResult[i].isApprox( tableResult[i], Scalar( 1e-4 ) )
+                       && fusedDQ[i].getQ0().coeffs() == tableDQ[i].getQ0().coeffs()
+                       && fusedDQ[i].getQe().coeffs() == tableDQ[i].getQe().coeffs();
+            }
+            RA_UNIT_TEST( same, "Fused DQS should match the sparse DQS" );
+
+            // Truncated influences keep the total weight of each vertex.
+            InfluenceTable truncated;
+            buildInfluenceTable( weights, 2, false, truncated );
+            RA_UNIT_TEST( truncated.m_width == 2, "Table width should be capped" );
+            RA_UNIT_TEST( Math::areApproxEqual( truncated.weight( 4, 0 ) + truncated.weight( 4, 1 ), Scalar( 1 ) ),
+                          "Truncated weights should keep the vertex total weight" );
+
+            testGPUSkinning( mesh, pose, weights );
+            testCoR();
+        }
+
+        void testGPUSkinning( const Ra::Core::Vector3Array& mesh, const Ra::Core::Animation::Pose& pose,
+                              const Ra::Core::Animation::WeightMatrix& weights )
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            Vector4Array packedWeights;
+            Vector4Array packedIndices;
+            packGPUSkinningWeights( weights, packedWeights, packedIndices );
+            RA_UNIT_TEST( packedWeights.size() == mesh.size() && packedIndices.size() == mesh.size(),
+                          "One packed influence per vertex" );
+
+            // Vertex 4 has 5 equal influences : the 4 first handles are kept and renormalized.
+            RA_UNIT_TEST( packedWeights[4].isApprox( Vector4::Constant( Scalar( 0.25 ) ) ), "Kept weights should sum to 1" );
+            RA_UNIT_TEST( packedIndices[4] == Vector4( 4, 7, 10, 13 ), "Kept handles should be the first ones" );
+            // Vertex 1 has 2 influences : the unused slots are zero.
+            RA_UNIT_TEST( packedWeights[1] == Vector4( 0.5, 0.5, 0, 0 ) && packedIndices[1] == Vector4( 1, 4, 0, 0 ),
+                          "Unused slots should be zero" );
+
+            BonePalette palette;
+            RA_UNIT_TEST( computeGPUSkinningPalette( pose, palette ), "Pose should fit in the palette" );
+            RA_UNIT_TEST( palette.size() == pose.size() && palette[3] == pose[3].matrix(), "Palette should store the pose" );
+            Pose bigPose( GPUSkinningMaxBones + 1, Transform::Identity() );
+            BonePalette bigPalette;
+            RA_UNIT_TEST( !computeGPUSkinningPalette( bigPose, bigPalette ) && bigPalette.size() == bigPose.size(),
+                          "Too many bones should not fit in the shader" );
+
+            // Same result as the per-vertex LBS on the same (truncated, normalized) influences.
+            InfluenceTable table;
+            buildInfluenceTable( weights, GPUSkinningWidth, true, table );
+            Vector3Array lbsResult;
+            Vector3Array gpuResult;
+            linearBlendSkinning( mesh, pose, table, lbsResult );
+            gpuSkinning( mesh, palette, packedWeights, packedIndices, gpuResult );
+            bool same = ( gpuResult.size() == mesh.size() );
+            for ( uint i = 0; i < mesh.size() && same; ++i )
+            {
+                same = lbsResult[i].isApprox( gpuResult[i], Scalar( 1e-4 ) );
+            }
+            RA_UNIT_TEST( same, "Packed skinning should match LBS" );
+        }
+
+        void testCoR()
+        {
+            using namespace Ra::Core;
+            using namespace Ra::Core::Animation;
+
+            // A sphere bent by three handles along the z axis.
+            Skinning::RefData data;
+            data.m_referenceMesh = MeshUtils::makeGeodesicSphere( 1.f, 2 );
+            const uint numVertices = data.m_referenceMesh.m_vertices.size();
+            std::vector< Eigen::Triplet< Scalar > > triplets;
+            for ( uint i = 0; i < numVertices; ++i )
+            {
+                const Scalar z = data.m_referenceMesh.m_vertices[i].z();
+                triplets.push_back( Eigen::Triplet< Scalar >( i, 0, std::max( z, Scalar( 0 ) ) ) );
+                triplets.push_back( Eigen::Triplet< Scalar >( i, 1, 1 - std::abs( z ) ) );
+                triplets.push_back( Eigen::Triplet< Scalar >( i, 2, std::max( -z, Scalar( 0 ) ) ) );
+            }
+            data.m_weights.resize( numVertices, 3 );
+            data.m_weights.setFromTriplets( triplets.begin(), triplets.end() );
+
+            Skinning::RefData naive = data;
+            computeCoR( data );
+            computeCoR_naive( naive );
+            bool same = ( data.m_CoR.size() == numVertices );
+            for ( uint i = 0; i < numVertices && same; ++i )
+            {
+                same = ( data.m_CoR[i] - naive.m_CoR[i] ).norm() < Scalar( 1e-4 );
+            }
+            RA_UNIT_TEST( same, "Clustered CoR should match the naive CoR" );
+
+            // Cache round trip, in the current directory.
+            Skinning::RefData cached = data;
+            cached.m_CoR.clear();
+            const uint64_t key = hashCoRInput( cached );
+            char filename[32];
+            std::snprintf( filename, sizeof( filename ), "./%016llx.cor", static_cast< unsigned long long >( key ) );
+            std::remove( filename );
+            RA_UNIT_TEST( !computeCoRCached( cached, "." ), "CoR should not be in the cache yet" );
+            cached.m_CoR.clear();
+            RA_UNIT_TEST( computeCoRCached( cached, "." ), "CoR should be loaded from the cache" );
+            RA_UNIT_TEST( cached.m_CoR == data.m_CoR, "Cached CoR should be identical" );
+            std::remove( filename );
+
+            cached.m_weights.coeffRef( 0, 1 ) += Scalar( 0.01 );
+            RA_UNIT_TEST( hashCoRInput( cached ) != key, "Changing the weights should change the CoR key" );
+        }
+    };
+    RA_TEST_CLASS( SkinningTests );
+}
+
+#endif // RADIUM_SKINNING_TESTS_HPP_
@@ -3,6 +3,13 @@
 
 #include <Core/Geometry/Distance/DistanceQueries.hpp>
 #include <Core/Math/PolyLine.hpp>
+#include <Core/Geometry/Area/Area.hpp>
+#include <Core/Geometry/Laplacian/Laplacian.hpp>
+#include <Core/Geometry/Normal/Normal.hpp>
+#include <Core/Geometry/Normal/NormalUpdater.hpp>
+#include <Core/Geometry/Operator/OperatorPattern.hpp>
+#include <Core/Geometry/Triangle/TriangleOperation.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
 
 using Ra::Core::DistanceQueries::pointToLineSq;
 using Ra::Core::DistanceQueries::pointToSegmentSq;
@@ -84,8 +91,148 @@ namespace RaTests
         }
     };
 
+    class OperatorTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, 3 );
+            const uint n = mesh.m_vertices.size();
+            const VectorArray<Vector3>& p = mesh.m_vertices;
+            const VectorArray<Triangle>& T = mesh.m_triangles;
+
+            // Reference operators, accumulated triangle by triangle.
+            MatrixN cotan = MatrixN::Zero( n, n );
+            MatrixN uniform = MatrixN::Zero( n, n );
+            VectorN area = VectorN::Zero( n );
+            for ( const auto& t : T )
+            {
+                for ( uint c = 0; c < 3; ++c )
+                {
+                    const uint i = t[c];
+                    const uint j = t[( c + 1 ) % 3];
+                    const uint k = t[( c + 2 ) % 3];
+                    const Scalar w = 0.5f * Vector::cotan( ( p[j] - p[i] ).eval(), ( p[k] - p[i] ).eval() );
+                    cotan( j, k ) += w;
+                    cotan( k, j ) += w;
+                    uniform( i, j ) = 1;
+                    area[i] += Geometry::triangleArea( p[t[0]], p[t[1]], p[t[2]] );
+                }
+            }
+            MatrixN laplacian = -cotan;
+            laplacian.diagonal() = cotan.rowwise().sum();
+
+            const Geometry::AdjacencyMatrix A = Geometry::cotangentWeightAdjacency( p, T );
+            RA_UNIT_TEST( MatrixN( A ).isApprox( cotan ), "Wrong cotangent weight adjacency" );
+            RA_UNIT_TEST( MatrixN( Geometry::uniformAdjacency( n, T ) ) == uniform, "Wrong uniform adjacency" );
+            RA_UNIT_TEST( MatrixN( Geometry::cotangentWeightLaplacian( p, T ) ).isApprox( laplacian ),
+                          "Wrong cotangent weight Laplacian" );
+
+            // Diagonal operators.
+            const Geometry::DegreeVector degree = Geometry::adjacencyDegreeVector( A );
+            RA_UNIT_TEST( degree.isApprox( cotan.rowwise().sum() ), "Wrong degree vector" );
+            RA_UNIT_TEST( MatrixN( Geometry::adjacencyDegree( A ) ).isApprox( MatrixN( degree.asDiagonal() ) ),
+                          "Wrong degree matrix" );
+            RA_UNIT_TEST( Geometry::oneRingAreaVector( p, T ).isApprox( area ), "Wrong one ring area" );
+            RA_UNIT_TEST( MatrixN( Geometry::barycentricArea( p, T ) ).isApprox( MatrixN( ( area / 3 ).asDiagonal() ) ),
+                          "Wrong barycentric area" );
+
+            // Cached pattern : same operators, for a deformed mesh too.
+            Geometry::OperatorPattern pattern;
+            RA_UNIT_TEST( MatrixN( pattern.cotangentWeightLaplacian( p, T ) ).isApprox( laplacian ),
+                          "Wrong cached Laplacian" );
+            RA_UNIT_TEST( pattern.isValid( n, T ), "Pattern should be built" );
+            for ( auto& v : mesh.m_vertices )
+            {
+                v = v.cwiseProduct( Vector3( 1.f, 2.f, 0.5f ) );
+            }
+            RA_UNIT_TEST( pattern.cotangentWeightLaplacian( p, T ).isApprox( Geometry::cotangentWeightLaplacian( p, T ) ),
+                          "Wrong Laplacian of the deformed mesh" );
+            RA_UNIT_TEST( pattern.cotangentWeightAdjacency( p, T ).isApprox( Geometry::cotangentWeightAdjacency( p, T ) ),
+                          "Wrong adjacency of the deformed mesh" );
+
+            // A new topology rebuilds the pattern.
+            mesh.m_triangles.pop_back();
+            RA_UNIT_TEST( !pattern.isValid( n, T ), "Pattern should be invalid" );
+            RA_UNIT_TEST( pattern.cotangentWeightLaplacian( p, T ).isApprox( Geometry::cotangentWeightLaplacian( p, T ) ),
+                          "Wrong Laplacian after a topology change" );
+        }
+    };
+
+    class NormalTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, 3 );
+            for ( auto& v : mesh.m_vertices )
+            {
+                v = v.cwiseProduct( Vector3( 1.f, 2.f, 0.5f ) );
+            }
+            const VectorArray<Vector3>& p = mesh.m_vertices;
+            const VectorArray<Triangle>& T = mesh.m_triangles;
+
+            auto areClose = []( const VectorArray<Vector3>& a, const VectorArray<Vector3>& b )
+            {
+                bool close = a.size() == b.size();
+                for ( uint i = 0; i < a.size() && close; ++i )
+                {
+                    close = ( a[i] - b[i] ).norm() < 1e-5f;
+                }
+                return close;
+            };
+
+            // Same normals as the reference functions.
+            Geometry::NormalUpdater updater;
+            VectorArray<Vector3> normals;
+            VectorArray<Vector3> reference;
+            updater.update( p, T, normals );
+            Geometry::uniformNormal( p, T, reference );
+            RA_UNIT_TEST( updater.isValid( p.size(), T ) && areClose( normals, reference ), "Wrong uniform normals" );
+            updater.setWeighting( Geometry::NormalUpdater::ANGLE );
+            updater.compute( p, normals );
+            Geometry::angleWeightedNormal( p, T, reference );
+            RA_UNIT_TEST( areClose( normals, reference ), "Wrong angle weighted normals" );
+            updater.setWeighting( Geometry::NormalUpdater::AREA );
+            updater.compute( p, normals );
+            Geometry::areaWeightedNormal( p, T, reference );
+            RA_UNIT_TEST( areClose( normals, reference ), "Wrong area weighted normals" );
+
+            // Incremental update around moved vertices.
+            const std::vector<uint> moved = { 3, 17 };
+            for ( uint i : moved )
+            {
+                mesh.m_vertices[i] *= 1.5f;
+            }
+            std::vector<uint> affected;
+            updater.getAffectedVertices( moved, affected );
+            bool complete = true;
+            for ( const auto& t : T )
+            {
+                for ( uint i : moved )
+                {
+                    if ( t[0] == int( i ) || t[1] == int( i ) || t[2] == int( i ) )
+                    {
+                        for ( uint c = 0; c < 3; ++c )
+                        {
+                            complete = complete && std::binary_search( affected.begin(), affected.end(), uint( t[c] ) );
+                        }
+                    }
+                }
+            }
+            RA_UNIT_TEST( complete && affected.size() < p.size() / 10, "Wrong affected vertices" );
+            updater.compute( p, moved, normals );
+            Geometry::areaWeightedNormal( p, T, reference );
+            RA_UNIT_TEST( areClose( normals, reference ), "Wrong incrementally updated normals" );
+        }
+    };
+
     RA_TEST_CLASS(GeometryTests);
     RA_TEST_CLASS(PolylineTests);
+    RA_TEST_CLASS(OperatorTests);
+    RA_TEST_CLASS(NormalTests);
 }
 
 
@@ -0,0 +1,103 @@
+#ifndef RADIUM_INDEXMAP_TESTS_HPP_
+#define RADIUM_INDEXMAP_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Index/IndexMap.hpp>
+
+#include <map>
+#include <vector>
+
+namespace RaTests
+{
+    class IndexMapTests : public Test
+    {
+        void run() override
+        {
+            using Ra::Core::Index;
+            using Ra::Core::IndexMap;
+
+            // Without removals, indices are given in insertion order.
+            IndexMap<int> map;
+            bool ordered = true;
+            for ( int i = 0; i < 100; ++i )
+            {
+                ordered = ordered && map.insert( 10 * i ) == Index( i );
+            }
+            RA_UNIT_TEST( ordered && map.size() == 100 && map.compact(), "Indices should be consecutive" );
+
+            // Removed indices become stale, even when their slot is reused.
+            const Index removed = map.index( 42 );
+            RA_UNIT_TEST( map.remove( removed ) && !map.contain( removed ) && !map.remove( removed ),
+                          "Removed index should not be found" );
+            RA_UNIT_TEST( map.size() == 99 && !map.compact(), "Wrong size after a removal" );
+            const Index reused = map.insert( -1 );
+            RA_UNIT_TEST( reused.isValid() && reused.getValue() == removed.getValue()
+                          && reused.getGeneration() != removed.getGeneration() && !map.contain( removed )
+                          && map.at( reused ) == -1, "Stale index should not reach the new object" );
+            RA_UNIT_TEST( map.contain( Index( 42 ) ) && map.at( Index( 42 ) ) == -1,
+                          "Index without generation should reach the object of its slot" );
+            int obj = 0;
+            RA_UNIT_TEST( !map.at( removed, obj ) && !map.contain( Index::INVALID_IDX() )
+                          && !map.contain( Index( 1000 ) ), "Unknown indices should not be found" );
+
+            // Random insertions and removals, checked against a std::map.
+            std::map<int, int> reference;
+            for ( uint i = 0; i < map.size(); ++i )
+            {
+                reference[map.index( i )] = map.at( i );
+            }
+            bool same = true;
+            for ( int k = 0; k < 5000 && same; ++k )
+            {
+                if ( std::rand() % 3 == 0 && !reference.empty() )
+                {
+                    auto it = reference.begin();
+                    std::advance( it, std::rand() % reference.size() );
+                    same = map.remove( Index( it->first ) );
+                    reference.erase( it );
+                }
+                else
+                {
+                    const Index idx = map.insert( k );
+                    same = idx.isValid() && reference.find( idx ) == reference.end();
+                    reference[idx] = k;
+                }
+                same = same && map.size() == reference.size();
+            }
+            for ( const auto& p : reference )
+            {
+                same = same && map.contain( Index( p.first ) ) && map[Index( p.first )] == p.second;
+            }
+            for ( uint i = 0; i < map.size(); ++i )
+            {
+                same = same && reference.at( map.index( i ) ) == map.at( i );
+            }
+            RA_UNIT_TEST( same, "Map should match the reference" );
+
+            // Copies keep the indices.
+            IndexMap<int> copy( map );
+            const Index idx = copy.index( 0 );
+            RA_UNIT_TEST( copy.contain( idx ) && copy.at( idx ) == map.at( idx ), "Copy should keep the indices" );
+
+            map.clear();
+            RA_UNIT_TEST( map.empty() && map.insert( 1 ) == Index( 0 ), "Cleared map should start again from 0" );
+
+            // Large maps, e.g. the half-edges of a mesh of a million vertices.
+            IndexMap<int> large;
+            const int numLarge = ( 1 << 22 ) + 16;
+            bool inserted = true;
+            for ( int i = 0; i < numLarge && inserted; ++i )
+            {
+                inserted = large.insert( i ) == Index( i );
+            }
+            const Index last = large.index( numLarge - 1 );
+            RA_UNIT_TEST( inserted && large.size() == uint( numLarge ) && !large.full(),
+                          "More than 2^22 objects should be inserted" );
+            RA_UNIT_TEST( large.remove( last ) && !large.contain( last ) && large.insert( 0 ).getValue() == last.getValue(),
+                          "Slots above 2^22 should be reused" );
+        }
+    };
+    RA_TEST_CLASS( IndexMapTests );
+}
+
+#endif // RADIUM_INDEXMAP_TESTS_HPP_
@@ -0,0 +1,123 @@
+#ifndef RADIUM_MESHUTILS_TESTS_HPP_
+#define RADIUM_MESHUTILS_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+
+#include <vector>
+
+namespace RaTests
+{
+    class DuplicatesTests : public Test
+    {
+        // One vertex per triangle corner.
+        static Ra::Core::TriangleMesh makeSoup( const Ra::Core::TriangleMesh& mesh )
+        {
+            Ra::Core::TriangleMesh soup;
+            for ( const auto& t : mesh.m_triangles )
+            {
+                const uint first = soup.m_vertices.size();
+                for ( uint k = 0; k < 3; ++k )
+                {
+                    soup.m_vertices.push_back( mesh.m_vertices[t[k]] );
+                    soup.m_normals.push_back( mesh.m_normals[t[k]] );
+                }
+                soup.m_triangles.push_back( Ra::Core::Triangle( first, first + 1, first + 2 ) );
+            }
+            return soup;
+        }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const TriangleMesh sphere = MeshUtils::makeGeodesicSphere( 1.f, 2 );
+            TriangleMesh soup = makeSoup( sphere );
+
+            // Exact duplicates : each vertex maps to the first equal one.
+            std::vector<VertexIdx> map;
+            RA_UNIT_TEST( MeshUtils::findDuplicates( soup, map ), "Soup should have duplicates" );
+            bool first = true;
+            for ( uint i = 0; i < soup.m_vertices.size(); ++i )
+            {
+                uint expected = i;
+                for ( uint j = 0; j < i && expected == i; ++j )
+                {
+                    expected = ( soup.m_vertices[j] == soup.m_vertices[i] ) ? j : i;
+                }
+                first = first && map[i] == expected;
+            }
+            RA_UNIT_TEST( first, "Duplicates should map to the first occurrence" );
+
+            // The sphere itself has duplicates : the soup has as many distinct vertices as the welded sphere.
+            std::vector<VertexIdx> vertexMap;
+            TriangleMesh reference = sphere;
+            MeshUtils::removeDuplicates( reference, vertexMap );
+            TriangleMesh welded = soup;
+            MeshUtils::removeDuplicates( welded, vertexMap );
+            RA_UNIT_TEST( welded.m_vertices.size() == reference.m_vertices.size()
+                          && welded.m_normals.size() == reference.m_vertices.size(), "Wrong number of vertices" );
+            bool remapped = true;
+            for ( uint i = 0; i < soup.m_triangles.size(); ++i )
+            {
+                for ( uint k = 0; k < 3; ++k )
+                {
+                    remapped = remapped && welded.m_triangles[i][k] == int( vertexMap[soup.m_triangles[i][k]] )
+                               && welded.m_vertices[welded.m_triangles[i][k]] == soup.m_vertices[soup.m_triangles[i][k]];
+                }
+            }
+            RA_UNIT_TEST( remapped, "Triangles should use the welded vertices" );
+            RA_UNIT_TEST( !MeshUtils::findDuplicates( welded, map ), "Welded mesh should not have duplicates" );
+
+            // Slightly moved vertices are only welded with a tolerance.
+            TriangleMesh noisy = soup;
+            for ( uint i = 0; i < noisy.m_vertices.size(); ++i )
+            {
+                noisy.m_vertices[i] += Vector3::Constant( Scalar( i % 7 ) * 1e-5f );
+            }
+            MeshUtils::DuplicatesOptions options;
+            options.m_epsilon = 1e-3f;
+            MeshUtils::findDuplicates( noisy, map, options );
+            bool tolerant = true;
+            for ( uint i = 0; i < noisy.m_vertices.size(); ++i )
+            {
+                tolerant = tolerant && map[map[i]] == map[i] && map[i] <= i
+                           && soup.m_vertices[map[i]] == soup.m_vertices[i];
+            }
+            RA_UNIT_TEST( tolerant, "Close vertices should be welded" );
+            TriangleMesh noisyWelded = noisy;
+            MeshUtils::removeDuplicates( noisyWelded, vertexMap, options );
+            RA_UNIT_TEST( noisyWelded.m_vertices.size() == reference.m_vertices.size(), "Wrong number of welded vertices" );
+
+            // Different normals prevent welding.
+            soup.m_normals[3] = -soup.m_normals[3];
+            options.m_epsilon = 0;
+            options.m_compareNormals = true;
+            options.m_attribEpsilon = 1e-3f;
+            MeshUtils::findDuplicates( soup, map, options );
+            bool split = true;
+            for ( uint i = 0; i < soup.m_vertices.size(); ++i )
+            {
+                split = split && ( ( map[i] == 3 ) == ( i == 3 ) );
+            }
+            RA_UNIT_TEST( split, "Vertices with different normals should not be welded" );
+
+            // Texture coordinates too.
+            Vector3Array texCoords( soup.m_vertices.size(), Vector3::Zero() );
+            texCoords[4] = Vector3::UnitX();
+            soup.m_normals[3] = -soup.m_normals[3];
+            options.m_texCoords = &texCoords;
+            MeshUtils::findDuplicates( soup, map, options );
+            split = true;
+            for ( uint i = 0; i < soup.m_vertices.size(); ++i )
+            {
+                split = split && ( ( map[i] == 4 ) == ( i == 4 ) );
+            }
+            RA_UNIT_TEST( split, "Vertices with different texture coordinates should not be welded" );
+        }
+    };
+    RA_TEST_CLASS( DuplicatesTests );
+}
+
+#endif // RADIUM_MESHUTILS_TESTS_HPP_
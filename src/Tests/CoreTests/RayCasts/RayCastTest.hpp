@@ -3,6 +3,9 @@
 
 #include <Tests/CoreTests/Tests.hpp>
 #include <Core/Math/RayCast.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/TreeStructures/TriangleBVH.hpp>
 
 namespace RaTests {
 
@@ -80,6 +83,97 @@ class RayCastAabbTests : public Test
     }
 };
     RA_TEST_CLASS(RayCastAabbTests);
+
+class RayCastTriangleBVHTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 2.f, 3 );
+        TriangleBVH bvh;
+        bvh.build( mesh );
+
+        std::vector<uint> order = bvh.getTriangleOrder();
+        std::sort( order.begin(), order.end() );
+        bool isPermutation = ( order.size() == mesh.m_triangles.size() );
+        for ( uint i = 0; i < order.size() && isPermutation; ++i )
+        {
+            isPermutation = ( order[i] == i );
+        }
+        RA_UNIT_TEST( isPermutation, "Each triangle should appear once" );
+
+        RA_UNIT_TEST( checkRays( mesh, bvh ), "Ray casts should match the brute force test" );
+
+        // Deform the mesh and refit the tree.
+        for ( auto& v : mesh.m_vertices )
+        {
+            v = Vector3( 2 * v.x(), v.y() + v.x() * v.x(), v.z() ) + Vector3( 0.5, 0, 0 );
+        }
+        bvh.refit( mesh );
+        RA_UNIT_TEST( checkRays( mesh, bvh ), "Ray casts should match after a refit" );
+
+        // Hits further than tMax are ignored.
+        const Ray ray( Vector3( 0, 0, 10 ), Vector3( 0, 0, -1 ) );
+        TriangleBVH::Hit hit;
+        RA_UNIT_TEST( bvh.closestHit( mesh, ray, hit ) && !bvh.closestHit( mesh, ray, hit, hit.m_t * 0.5f )
+                      && !bvh.anyHit( mesh, ray, hit, 1.f ), "Hits beyond tMax should be ignored" );
+
+        // On an obtuse triangle, the nearest vertex is not the one with the largest weight :
+        // the hit point ( 1.1, 0.02 ) has weights ( 0.35, 0.45, 0.2 ) but is closest to vertex 2.
+        TriangleMesh obtuse;
+        obtuse.m_vertices = { Vector3( 0, 0, 0 ), Vector3( 2, 0, 0 ), Vector3( 1, 0.1, 0 ) };
+        obtuse.m_triangles = { Triangle( 0, 1, 2 ) };
+        bvh.build( obtuse );
+        const Ray pick( Vector3( 1.1, 0.02, 1 ), Vector3( 0, 0, -1 ) );
+        int largestWeight = -1;
+        RA_UNIT_TEST( bvh.closestHit( obtuse, pick, hit ), "The ray should hit the triangle" );
+        hit.m_barycentrics.maxCoeff( &largestWeight );
+        RA_UNIT_TEST( largestWeight == 1 && TriangleBVH::getNearestVertex( obtuse, pick, hit ) == 2
+                      && MeshUtils::castRay( obtuse, pick ).m_nearestVertex == 2,
+                      "The nearest vertex should be the geometrically nearest one" );
+    }
+
+    static bool checkRays( const Ra::Core::TriangleMesh& mesh, const Ra::Core::TriangleBVH& bvh )
+    {
+        using namespace Ra::Core;
+
+        uint numHits = 0;
+        bool ok = true;
+        for ( uint i = 0; i < 500 && ok; ++i )
+        {
+            // Rays from outside the mesh, some of them missing it.
+            const Vector3 origin = 8 * Vector3::Random();
+            const Vector3 target = 3 * Vector3::Random();
+            const Ray ray( origin, ( target - origin ).normalized() );
+
+            Scalar minT = std::numeric_limits<Scalar>::max();
+            std::vector<Scalar> hits;
+            std::vector<Triangle> triangles;
+            RayCast::vsTriangleMesh( ray, mesh, hits, triangles );
+            for ( Scalar t : hits )
+            {
+                minT = std::min( minT, t );
+            }
+
+            TriangleBVH::Hit closest, any;
+            const bool hasHit = bvh.closestHit( mesh, ray, closest );
+            ok = hasHit == !hits.empty() && bvh.anyHit( mesh, ray, any ) == hasHit;
+            if ( ok && hasHit )
+            {
+                ++numHits;
+                const Triangle& tri = mesh.m_triangles[closest.m_triangle];
+                const Vector3 p = closest.m_barycentrics[0] * mesh.m_vertices[tri[0]]
+                                  + closest.m_barycentrics[1] * mesh.m_vertices[tri[1]]
+                                  + closest.m_barycentrics[2] * mesh.m_vertices[tri[2]];
+                ok = std::abs( closest.m_t - minT ) < 1e-3f && ( p - ray.pointAt( closest.m_t ) ).norm() < 1e-3f
+                     && any.m_triangle >= 0 && any.m_t >= minT - 1e-3f;
+            }
+        }
+        return ok && numHits > 0 && numHits < 500;
+    }
+};
+    RA_TEST_CLASS(RayCastTriangleBVHTests);
 }
 
 
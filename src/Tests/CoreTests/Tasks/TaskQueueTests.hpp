@@ -0,0 +1,120 @@
+#ifndef RADIUM_TASKQUEUE_TESTS_HPP_
+#define RADIUM_TASKQUEUE_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/Task.hpp>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace RaTests
+{
+    class TaskQueueTests : public Test
+    {
+        void run() override
+        {
+            for ( auto scheduling : { Ra::Core::TaskQueue::Scheduling::SharedQueue,
+                                      Ra::Core::TaskQueue::Scheduling::WorkStealing } )
+            {
+                Ra::Core::TaskQueue queue( 3, scheduling );
+
+                // A diamond graph ( 0 -> {1,2} -> 3 ), replayed several times.
+                std::vector<uint> order;
+                std::mutex orderMutex;
+                for ( uint i = 0; i < 4; ++i )
+                {
+                    queue.registerTask( new Ra::Core::FunctionTask( [i, &order, &orderMutex]()
+                    {
+                        std::lock_guard<std::mutex> lock( orderMutex );
+                        order.push_back( i );
+                    }, "Diamond" ) );
+                }
+                queue.addDependency( 0, 1 );
+                queue.addDependency( 0, 2 );
+                queue.addDependency( 1, 3 );
+                queue.addDependency( 2, 3 );
+
+                for ( uint frame = 0; frame < 3; ++frame )
+                {
+                    order.clear();
+                    queue.startTasks();
+                    queue.waitForTasks();
+                    RA_UNIT_TEST( order.size() == 4, "All tasks should run once per frame" );
+                    RA_UNIT_TEST( order.front() == 0 && order.back() == 3, "Dependencies not respected" );
+                }
+                queue.flushTaskQueue();
+                RA_UNIT_TEST( queue.getNumTasks() == 0, "Tasks should be flushed" );
+
+                // Nested parallel loops started from tasks.
+                std::vector<std::atomic<uint>> counters( 1000 );
+                for ( auto& c : counters )
+                {
+                    c = 0;
+                }
+                for ( uint t = 0; t < 8; ++t )
+                {
+                    queue.registerTask( new Ra::Core::FunctionTask( [&queue, &counters]()
+                    {
+                        queue.parallelFor( 0, counters.size(), 10, [&queue, &counters]( uint begin, uint end )
+                        {
+                            queue.parallelFor( begin, end, 0, [&counters]( uint b, uint e )
+                            {
+                                for ( uint i = b; i < e; ++i )
+                                {
+                                    ++counters[i];
+                                }
+                            } );
+                        } );
+                    }, "Parallel" ) );
+                }
+                queue.startTasks();
+                queue.waitForTasks();
+                queue.flushTaskQueue();
+
+                bool allDone = true;
+                for ( const auto& c : counters )
+                {
+                    allDone = allDone && ( c == 8 );
+                }
+                RA_UNIT_TEST( allDone, "Each index should be processed once per parallel loop" );
+
+                // Tasks spawning a binary tree of child tasks and waiting for them.
+                std::atomic<uint> leaves( 0 );
+                std::function<void( uint )> split = [&queue, &leaves, &split]( uint depth )
+                {
+                    if ( depth == 0 )
+                    {
+                        ++leaves;
+                        return;
+                    }
+                    Ra::Core::TaskQueue::TaskGroup group;
+                    for ( uint i = 0; i < 2; ++i )
+                    {
+                        queue.spawnTask( new Ra::Core::FunctionTask( [&split, depth]()
+                        {
+                            split( depth - 1 );
+                        }, "Child" ), group );
+                    }
+                    queue.waitForGroup( group );
+                };
+                for ( uint t = 0; t < 4; ++t )
+                {
+                    queue.registerTask( new Ra::Core::FunctionTask( [&split]()
+                    {
+                        split( 6 );
+                    }, "Spawning" ) );
+                }
+                queue.startTasks();
+                queue.waitForTasks();
+                queue.flushTaskQueue();
+                RA_UNIT_TEST( leaves == 4 * 64, "Each spawned task should run once before its group is done" );
+            }
+        }
+    };
+    RA_TEST_CLASS( TaskQueueTests );
+}
+
+#endif // RADIUM_TASKQUEUE_TESTS_HPP_
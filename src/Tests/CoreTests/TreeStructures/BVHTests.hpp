@@ -0,0 +1,231 @@
+#ifndef RADIUM_BVH_TESTS_HPP_
+#define RADIUM_BVH_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/TreeStructures/BVH.hpp>
+#include <Core/TreeStructures/CullingStage.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace RaTests
+{
+    class BVHTests : public Test
+    {
+    public:
+        /// Minimal BVH leaf.
+        struct Box
+        {
+            Ra::Core::Aabb m_aabb;
+            Ra::Core::Aabb getAabb() const { return m_aabb; }
+        };
+
+        /// Reference frustum test : a box is culled if all its corners are outside one plane.
+        static bool isInFrustum( const Ra::Core::Aabb& aabb, const Ra::Core::Frustum& frustum )
+        {
+            for ( uint i = 0; i < 6; ++i )
+            {
+                bool outside = true;
+                for ( int c = 0; c < 8 && outside; ++c )
+                {
+                    const Ra::Core::Vector3 p = aabb.corner( Ra::Core::Aabb::CornerType( c ) );
+                    outside = frustum.m_planes[i].head<3>().dot( p ) + frustum.m_planes[i].w() < 0;
+                }
+                if ( outside )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const uint numBoxes = 5000;
+            BVH<Box> bvh;
+            std::vector<std::shared_ptr<Box>> boxes;
+            for ( uint i = 0; i < numBoxes; ++i )
+            {
+                auto box = std::make_shared<Box>();
+                const Vector3 center = 20 * Vector3::Random();
+                const Vector3 half = Vector3::Random().cwiseAbs() * Scalar( 0.5 );
+                box->m_aabb = Aabb( center - half, center + half );
+                boxes.push_back( box );
+                bvh.insertLeaf( box );
+            }
+            bvh.update();
+
+            // Every leaf is in exactly one leaf node, and nodes contain their children.
+            std::vector<uint> order = bvh.getLeafOrder();
+            std::sort( order.begin(), order.end() );
+            bool isPermutation = ( order.size() == numBoxes );
+            for ( uint i = 0; i < order.size() && isPermutation; ++i )
+            {
+                isPermutation = ( order[i] == i );
+            }
+            RA_UNIT_TEST( isPermutation, "Each leaf should appear once" );
+
+            uint numLeaves = 0;
+            bool nested = true;
+            for ( const auto& node : bvh.getNodes() )
+            {
+                if ( node.isLeaf() )
+                {
+                    numLeaves += node.m_count;
+                    nested = nested && node.m_count <= BVH<Box>::MaxLeafSize * 4;
+                }
+                else
+                {
+                    const auto& nodes = bvh.getNodes();
+                    nested = nested && node.getAabb().contains( nodes[node.m_index].getAabb() )
+                             && node.getAabb().contains( nodes[node.m_index + 1].getAabb() );
+                }
+            }
+            RA_UNIT_TEST( numLeaves == numBoxes && nested, "Nodes should contain their children" );
+
+            const Matrix4 proj = MatrixUtils::perspective( Scalar( 1 ), Scalar( 1.5 ), Scalar( 0.1 ), Scalar( 30 ) );
+            const Matrix4 view = MatrixUtils::lookAt( Vector3( 0, 0, 25 ), Vector3( 3, 2, 0 ), Vector3( 0, 1, 0 ) );
+            const Frustum frustum( proj * view );
+            RA_UNIT_TEST( checkQuery( bvh, boxes, frustum ), "Frustum query should match the brute force test" );
+
+            // Move the boxes, refit and query again.
+            for ( auto& box : boxes )
+            {
+                box->m_aabb.translate( Vector3::Random() * 5 );
+            }
+            bvh.refit();
+            RA_UNIT_TEST( checkQuery( bvh, boxes, frustum ), "Frustum query should match after a refit" );
+
+            // Removing a leaf.
+            RA_UNIT_TEST( bvh.removeLeaf( boxes.back() ), "Leaf should be removed" );
+            boxes.pop_back();
+            bvh.update();
+            RA_UNIT_TEST( bvh.size() == boxes.size() && checkQuery( bvh, boxes, frustum ),
+                          "Frustum query should match after a removal" );
+
+            // The tree does not depend on the number of threads.
+            TaskQueue queue( 3 );
+            TaskQueue* previousQueue = getParallelForQueue();
+            setParallelForQueue( &queue );
+            BVH<Box> parallelBvh = bvh;
+            parallelBvh.build();
+            setParallelForQueue( previousQueue );
+            bool same = parallelBvh.getNodes().size() == bvh.getNodes().size()
+                        && parallelBvh.getLeafOrder() == bvh.getLeafOrder();
+            for ( uint i = 0; i < bvh.getNodes().size() && same; ++i )
+            {
+                same = parallelBvh.getNodes()[i].m_index == bvh.getNodes()[i].m_index
+                       && parallelBvh.getNodes()[i].m_count == bvh.getNodes()[i].m_count;
+            }
+            RA_UNIT_TEST( same, "Parallel build should give the same tree" );
+        }
+
+        static bool checkQuery( const Ra::Core::BVH<Box>& bvh, const std::vector<std::shared_ptr<Box>>& boxes,
+                                const Ra::Core::Frustum& frustum )
+        {
+            std::vector<std::shared_ptr<Box>> result;
+            bvh.getInFrustum( result, frustum );
+            std::vector<std::shared_ptr<Box>> expected;
+            for ( const auto& box : boxes )
+            {
+                if ( isInFrustum( box->m_aabb, frustum ) )
+                {
+                    expected.push_back( box );
+                }
+            }
+            std::sort( result.begin(), result.end() );
+            std::sort( expected.begin(), expected.end() );
+            return !expected.empty() && expected.size() < boxes.size() && result == expected;
+        }
+    };
+    RA_TEST_CLASS( BVHTests );
+
+    class CullingStageTests : public Test
+    {
+        typedef BVHTests::Box Box;
+
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            // A 20x20 grid of unit boxes in the z = 0 plane, seen from above.
+            CullingStage<Box> culling;
+            std::vector<std::shared_ptr<Box>> boxes;
+            for ( int i = -10; i < 10; ++i )
+            {
+                for ( int j = -10; j < 10; ++j )
+                {
+                    auto box = std::make_shared<Box>();
+                    box->m_aabb = Aabb( Vector3( 2 * i, 2 * j, 0 ), Vector3( 2 * i + 1, 2 * j + 1, 1 ) );
+                    boxes.push_back( box );
+                    culling.addObject( box );
+                }
+            }
+
+            const Matrix4 proj = MatrixUtils::perspective( Scalar( 0.8 ), Scalar( 1 ), Scalar( 0.1 ), Scalar( 100 ) );
+            const Matrix4 view = MatrixUtils::lookAt( Vector3( 5, 5, 20 ), Vector3( 5, 5, 0 ), Vector3( 0, 1, 0 ) );
+            const Frustum frustum( proj * view );
+
+            RA_UNIT_TEST( check( culling, boxes, frustum ), "Visible objects should match the brute force test" );
+            const uint numVisible = culling.getStats().m_numVisible;
+            RA_UNIT_TEST( numVisible > 0 && culling.getStats().m_numCulled > 0
+                          && culling.getStats().m_numObjects == boxes.size()
+                          && numVisible + culling.getStats().m_numCulled == boxes.size(), "Wrong culling counts" );
+
+            // Disabled, every object is visible.
+            culling.setEnabled( false );
+            std::vector<std::shared_ptr<Box>> all;
+            culling.cull( frustum, all );
+            RA_UNIT_TEST( all.size() == boxes.size() && culling.getStats().m_numCulled == 0,
+                          "Disabled culling should keep every object" );
+            culling.setEnabled( true );
+
+            // Moving objects are refitted before the query.
+            for ( auto& box : boxes )
+            {
+                box->m_aabb.translate( Vector3( 7, 0, 0 ) );
+            }
+            RA_UNIT_TEST( check( culling, boxes, frustum ), "Visible objects should follow moving objects" );
+
+            // Added and removed objects are taken into account.
+            RA_UNIT_TEST( culling.removeObject( boxes.front() ), "Object should be removed" );
+            boxes.erase( boxes.begin() );
+            auto box = std::make_shared<Box>();
+            box->m_aabb = Aabb( Vector3( 5, 5, 0 ), Vector3( 6, 6, 1 ) );
+            boxes.push_back( box );
+            culling.addObject( box );
+            RA_UNIT_TEST( check( culling, boxes, frustum ), "Visible objects should match after an update" );
+
+            // Visible objects are appended to the output, counts only consider this query.
+            std::vector<std::shared_ptr<Box>> visible( 3 );
+            culling.cull( frustum, visible );
+            RA_UNIT_TEST( visible.size() == 3 + culling.getStats().m_numVisible, "Output should only be appended to" );
+        }
+
+        static bool check( Ra::Core::CullingStage<Box>& culling, const std::vector<std::shared_ptr<Box>>& boxes,
+                           const Ra::Core::Frustum& frustum )
+        {
+            std::vector<std::shared_ptr<Box>> result;
+            culling.cull( frustum, result );
+            std::vector<std::shared_ptr<Box>> expected;
+            for ( const auto& box : boxes )
+            {
+                if ( BVHTests::isInFrustum( box->m_aabb, frustum ) )
+                {
+                    expected.push_back( box );
+                }
+            }
+            std::sort( result.begin(), result.end() );
+            std::sort( expected.begin(), expected.end() );
+            return !expected.empty() && result == expected && culling.getStats().m_numVisible == result.size();
+        }
+    };
+    RA_TEST_CLASS( CullingStageTests );
+}
+
+#endif // RADIUM_BVH_TESTS_HPP_
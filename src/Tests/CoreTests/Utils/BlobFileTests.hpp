@@ -0,0 +1,112 @@
+#ifndef RADIUM_BLOBFILE_TESTS_HPP_
+#define RADIUM_BLOBFILE_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/File/BlobFile.hpp>
+#include <Core/Containers/VectorArray.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace RaTests
+{
+    class BlobFileTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+
+            const std::string filename = "./blob_test.rab";
+            std::remove( filename.c_str() );
+
+            Vector3Array points;
+            for ( uint i = 0; i < 1000; ++i )
+            {
+                points.push_back( Vector3( Scalar( i ), Scalar( 2 * i ), Scalar( -1 ) ) );
+            }
+            const std::vector<uint32_t> empty;
+            const std::vector<std::string> names = { "root", "", "spine" };
+
+            FileStamp stamp;
+            stamp.m_path = 1;
+            stamp.m_time = 2;
+            stamp.m_size = 3;
+            stamp.m_content = 4;
+
+            BlobWriter writer;
+            writer.addArray( points );
+            writer.addArray( empty );
+            writer.addValue( Scalar( 0.5 ) );
+            writer.addString( "name" );
+            writer.addStrings( names );
+            RA_UNIT_TEST( writer.getSectionSize() == 6, "Strings should take two sections" );
+            RA_UNIT_TEST( writer.save( filename, stamp, 7 ), "Blob should be written" );
+
+            // Round trip.
+            BlobReader reader;
+            RA_UNIT_TEST( !reader.open( filename, 8 ), "Another version should be rejected" );
+            RA_UNIT_TEST( reader.open( filename, 7 ), "Blob should be opened" );
+            RA_UNIT_TEST( reader.getSectionSize() == 6 && reader.getStamp().m_time == 2 && reader.getStamp().m_content == 4,
+                          "Header should be read back" );
+
+            std::size_t count = 0;
+            const Vector3* mapped = reader.readArray<Vector3>( count );
+            RA_UNIT_TEST( count == points.size() && reinterpret_cast<std::size_t>( mapped ) % 16 == 0,
+                          "Sections should be aligned in the mapped file" );
+            RA_UNIT_TEST( mapped[999] == points[999], "Sections should be usable in place" );
+
+            std::vector<uint32_t> readEmpty( 3 );
+            Scalar value = 0;
+            std::string name;
+            std::vector<std::string> readNames;
+            RA_UNIT_TEST( reader.readArray( readEmpty ) && readEmpty.empty(), "Empty arrays should be read back" );
+            RA_UNIT_TEST( reader.readValue( value ) && value == Scalar( 0.5 ), "Values should be read back" );
+            RA_UNIT_TEST( reader.readString( name ) && name == "name", "Strings should be read back" );
+            RA_UNIT_TEST( reader.readStrings( readNames ) && readNames == names, "String lists should be read back" );
+            RA_UNIT_TEST( !reader.readValue( value ) && !reader.isValid(), "Reading past the last section should fail" );
+
+            // Copy into a container, and type checks.
+            RA_UNIT_TEST( reader.open( filename, 7 ), "Blob should be reopened" );
+            Vector3Array copy;
+            RA_UNIT_TEST( reader.readArray( copy ) && copy == points, "Sections should be copied into containers" );
+            RA_UNIT_TEST( !reader.readValue( value ) && !reader.isValid(), "Element sizes should be checked" );
+            reader.close();
+
+            // New stamp, same data.
+            stamp.m_time = 5;
+            RA_UNIT_TEST( BlobWriter::setStamp( filename, stamp ) && reader.open( filename, 7 ) &&
+                          reader.getStamp().m_time == 5 && reader.getStamp().m_content == 4 &&
+                          reader.readArray( copy ) && copy == points, "Stamp should be rewritten in place" );
+            reader.close();
+
+            // Truncated file.
+            {
+                std::ifstream in( filename, std::ios::binary );
+                std::string content( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+                std::ofstream out( filename, std::ios::binary | std::ios::trunc );
+                out.write( content.data(), content.size() / 2 );
+            }
+            RA_UNIT_TEST( !reader.open( filename, 7 ), "Truncated blob should be rejected" );
+
+            // Stamps.
+            FileStamp first;
+            FileStamp second;
+            RA_UNIT_TEST( getFileStamp( filename, first, true ) && first.m_size != 0 && first.m_content != 0,
+                          "Stamp of an existing file" );
+            {
+                std::ofstream out( filename, std::ios::binary | std::ios::app );
+                out << 'x';
+            }
+            RA_UNIT_TEST( getFileStamp( filename, second, true ) && second.m_path == first.m_path &&
+                          second.m_size == first.m_size + 1 && second.m_content != first.m_content,
+                          "Stamp should change with the content" );
+            std::remove( filename.c_str() );
+            RA_UNIT_TEST( !getFileStamp( filename, second, false ), "Missing file has no stamp" );
+        }
+    };
+    RA_TEST_CLASS( BlobFileTests );
+}
+
+#endif // RADIUM_BLOBFILE_TESTS_HPP_
@@ -0,0 +1,86 @@
+#ifndef RADIUM_DIRTYRANGES_TESTS_HPP_
+#define RADIUM_DIRTYRANGES_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/DirtyRanges.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace RaTests
+{
+    class DirtyRangesTests : public Test
+    {
+        void run() override
+        {
+            using Ra::Core::DirtyRanges;
+
+            DirtyRanges dirty;
+            RA_UNIT_TEST( dirty.isEmpty() && dirty.getElementSize() == 0, "New ranges are empty" );
+
+            // Merging.
+            dirty.add( 10, 20 );
+            dirty.add( 30, 40 );
+            dirty.add( 20, 25 );
+            dirty.add( 5, 5 );
+            RA_UNIT_TEST( dirty.size() == 2 && dirty[0].m_begin == 10 && dirty[0].m_end == 25 &&
+                          dirty[1].m_begin == 30 && dirty[1].m_end == 40, "Adjacent ranges should merge" );
+            dirty.add( 0, 35 );
+            RA_UNIT_TEST( dirty.size() == 1 && dirty[0].m_begin == 0 && dirty[0].m_end == 40 && dirty.isAll( 40 ),
+                          "Overlapping ranges should merge" );
+
+            // Too many ranges : the closest ones merge.
+            dirty.clear();
+            for ( uint i : { 0u, 100u, 200u, 300u } )
+            {
+                dirty.add( i, i + 10 );
+            }
+            dirty.add( 212, 220 );
+            RA_UNIT_TEST( dirty.size() == DirtyRanges::MaxRanges && dirty[2].m_begin == 200 && dirty[2].m_end == 220,
+                          "The closest ranges should merge" );
+
+            // Clamping to a smaller array.
+            dirty.clamp( 205 );
+            RA_UNIT_TEST( dirty.size() == 3 && dirty[2].m_end == 205 && dirty.getElementSize() == 25,
+                          "Ranges should be clamped to the array" );
+            dirty.clear();
+            dirty.addAll();
+            dirty.clamp( 64 );
+            RA_UNIT_TEST( dirty.isAll( 64 ) && dirty.getElementSize() == 64, "Whole array" );
+
+            // Random updates : the ranges always cover the marked elements, sorted and disjoint.
+            std::mt19937 rng( 3 );
+            std::vector<bool> marked( 1000, false );
+            dirty.clear();
+            bool covered = true;
+            for ( uint i = 0; i < 200; ++i )
+            {
+                const uint begin = uint( rng() % 1000 );
+                const uint end = std::min( 1000u, begin + 1 + uint( rng() % 20 ) );
+                dirty.add( begin, end );
+                for ( uint e = begin; e < end; ++e )
+                {
+                    marked[e] = true;
+                }
+                for ( uint r = 1; r < dirty.size(); ++r )
+                {
+                    covered = covered && dirty[r - 1].m_end < dirty[r].m_begin;
+                }
+                for ( uint e = 0; e < marked.size(); ++e )
+                {
+                    bool in = false;
+                    for ( uint r = 0; r < dirty.size(); ++r )
+                    {
+                        in = in || ( e >= dirty[r].m_begin && e < dirty[r].m_end );
+                    }
+                    covered = covered && ( !marked[e] || in );
+                }
+            }
+            RA_UNIT_TEST( covered && dirty.size() <= DirtyRanges::MaxRanges, "Ranges should cover the marked elements" );
+        }
+    };
+    RA_TEST_CLASS( DirtyRangesTests );
+}
+
+#endif // RADIUM_DIRTYRANGES_TESTS_HPP_
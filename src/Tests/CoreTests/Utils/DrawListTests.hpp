@@ -0,0 +1,95 @@
+#ifndef RADIUM_DRAWLIST_TESTS_HPP_
+#define RADIUM_DRAWLIST_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/DrawList.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace RaTests
+{
+    class DrawListTests : public Test
+    {
+        void run() override
+        {
+            using Ra::Core::DrawList;
+
+            // Key fields.
+            const uint64_t key = DrawList::makeKey( 2, 4095, 7, 65535, 0.5f );
+            RA_UNIT_TEST( DrawList::getPass( key ) == 2 && DrawList::getShader( key ) == 4095 &&
+                          DrawList::getMaterial( key ) == 7 && DrawList::getMesh( key ) == 65535,
+                          "Key fields should be read back" );
+            RA_UNIT_TEST( DrawList::makeKey( 0, 0, 0, 0, 0.25f ) < DrawList::makeKey( 0, 0, 0, 0, 0.75f ) &&
+                          DrawList::makeKey( 0, 0, 0, 1, 1.f ) < DrawList::makeKey( 0, 0, 1, 0, 0.f ) &&
+                          DrawList::makeKey( 0, 1, 0, 0, 0.f ) < DrawList::makeKey( 1, 0, 0, 0, 0.f ),
+                          "Keys should order pass, shader, material, mesh, then depth" );
+
+            // Synthetic scene : objects drawn in a depth pass and a light pass, added in a random order.
+            struct Object { uint shader, material, mesh; float depth; };
+            std::mt19937 rng( 42 );
+            std::vector<Object> objects( 5000 );
+            for ( auto& o : objects )
+            {
+                o.shader = rng() % 8;
+                o.material = rng() % 64;
+                o.mesh = rng() % 200;
+                o.depth = float( rng() % 1000 ) / 1000.f;
+            }
+
+            DrawList list;
+            std::vector<std::pair<uint64_t, uint>> expected;
+            for ( uint pass = 0; pass < 2; ++pass )
+            {
+                for ( uint i = 0; i < objects.size(); ++i )
+                {
+                    const Object& o = objects[i];
+                    // Objects sharing a depth shader only differ by material and mesh in the first pass.
+                    const uint64_t k = DrawList::makeKey( pass, pass == 0 ? 0 : o.shader, o.material, o.mesh, o.depth );
+                    list.add( k, i );
+                    expected.push_back( { k, i } );
+                }
+            }
+            list.sort();
+            std::stable_sort( expected.begin(), expected.end(),
+                              []( const std::pair<uint64_t, uint>& a, const std::pair<uint64_t, uint>& b )
+                              { return a.first < b.first; } );
+
+            bool sorted = ( list.size() == expected.size() );
+            for ( uint i = 0; sorted && i < list.size(); ++i )
+            {
+                sorted = ( list[i].m_key == expected[i].first && list[i].m_item == expected[i].second );
+            }
+            RA_UNIT_TEST( sorted, "Radix sort should match a stable sort" );
+
+            // State changes : replaying the sorted list binds exactly when the state differs.
+            bool changes = ( list[0].m_change & DrawList::CHANGE_SHADER ) && ( list[0].m_change & DrawList::CHANGE_MESH );
+            for ( uint i = 1; changes && i < list.size(); ++i )
+            {
+                const uint64_t a = list[i - 1].m_key;
+                const uint64_t b = list[i].m_key;
+                const bool newPass = DrawList::getPass( a ) != DrawList::getPass( b );
+                const bool newShader = newPass || DrawList::getShader( a ) != DrawList::getShader( b );
+                changes = ( ( ( list[i].m_change & DrawList::CHANGE_SHADER ) != 0 ) == newShader ) &&
+                          ( ( ( list[i].m_change & DrawList::CHANGE_MATERIAL ) != 0 ) ==
+                            ( newShader || DrawList::getMaterial( a ) != DrawList::getMaterial( b ) ) ) &&
+                          ( ( ( list[i].m_change & DrawList::CHANGE_MESH ) != 0 ) ==
+                            ( newShader || DrawList::getMesh( a ) != DrawList::getMesh( b ) ) );
+            }
+            RA_UNIT_TEST( changes, "State changes should follow the keys" );
+
+            const DrawList::Statistics stats = list.getStatistics();
+            RA_UNIT_TEST( stats.m_draw == 10000 && stats.m_naiveBind == 30000, "Statistics of the list" );
+            RA_UNIT_TEST( stats.m_bind < stats.m_naiveBind / 2, "Sorting should save most of the binds" );
+
+            // Reuse.
+            list.clear();
+            list.sort();
+            RA_UNIT_TEST( list.size() == 0 && list.getStatistics().m_bind == 0, "Empty list" );
+        }
+    };
+    RA_TEST_CLASS( DrawListTests );
+}
+
+#endif // RADIUM_DRAWLIST_TESTS_HPP_
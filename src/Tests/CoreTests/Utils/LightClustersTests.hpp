@@ -0,0 +1,131 @@
+#ifndef RADIUM_LIGHTCLUSTERS_TESTS_HPP_
+#define RADIUM_LIGHTCLUSTERS_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/LightClusters.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace RaTests
+{
+    class LightClustersTests : public Test
+    {
+        void run() override
+        {
+            using Ra::Core::LightClusters;
+            using Ra::Core::Vector3;
+            using Ra::Core::Matrix4;
+
+            // Range of an attenuated light.
+            RA_UNIT_TEST( std::abs( LightClusters::getRange( 1.f, 1.f, 0.f, 1.f, 0.01f ) - std::sqrt( 99.f ) ) < 1e-3f &&
+                          std::abs( LightClusters::getRange( 1.f, 0.f, 0.5f, 0.f, 0.1f ) - 20.f ) < 1e-3f &&
+                          LightClusters::getRange( 1.f, 2.f, 1.f, 1.f, 0.5f ) == 0.f,
+                          "Attenuation range" );
+            RA_UNIT_TEST( LightClusters::getRange( 1.f, 1.f, 0.f, 0.f, 0.01f ) == std::numeric_limits<Scalar>::max(), "Unattenuated light" );
+
+            LightClusters clusters( 8, 6, 12 );
+            clusters.setFrustum( 1.f, 0.75f, 0.5f, 100.f );
+
+            // Frustum from a perspective projection.
+            Matrix4 proj = Matrix4::Zero();
+            proj( 0, 0 ) = 1.f;
+            proj( 1, 1 ) = 1.f / 0.75f;
+            proj( 2, 2 ) = -( 100.f + 0.5f ) / ( 100.f - 0.5f );
+            proj( 2, 3 ) = -2.f * 100.f * 0.5f / ( 100.f - 0.5f );
+            proj( 3, 2 ) = -1.f;
+            LightClusters fromProj( 8, 6, 12 );
+            fromProj.setProjection( proj );
+            RA_UNIT_TEST( std::abs( fromProj.getNear() - 0.5f ) < 1e-3f && std::abs( fromProj.getFar() - 100.f ) < 1e-1f,
+                          "Near and far should be read from the projection" );
+
+            // Slices.
+            RA_UNIT_TEST( clusters.getSlice( 0.5f ) == 0 && clusters.getSlice( 100.f ) == 11,
+                          "Near and far depths should be in the first and last slices" );
+            RA_UNIT_TEST( clusters.getCluster( Vector3( 0.f, 0.f, 1.f ) ) == -1 &&
+                          clusters.getCluster( Vector3( 10.f, 0.f, -1.f ) ) == -1,
+                          "Points outside the frustum have no cluster" );
+
+            // Random lights, some outside of the frustum.
+            std::mt19937 rng( 13 );
+            std::uniform_real_distribution<Scalar> unit( 0.f, 1.f );
+            std::vector<LightClusters::Light> lights( 500 );
+            for ( auto& l : lights )
+            {
+                const Scalar depth = -2.f + 110.f * unit( rng );
+                l.m_center = Vector3( ( 2.f * unit( rng ) - 1.f ) * 1.2f * std::abs( depth ),
+                                      ( 2.f * unit( rng ) - 1.f ) * 0.9f * std::abs( depth ), -depth );
+                l.m_radius = 0.2f + 5.f * unit( rng );
+            }
+            lights[0].m_radius = 0.f;
+            clusters.build( lights );
+
+            // The lists should be sorted subsets of the lights intersecting the boxes of the clusters ( the boxes
+            // overlap the neighbour clusters, which the binning partly rejects ).
+            bool subset = ( clusters.getGrid().size() == 2 * clusters.getClusterSize() );
+            uint total = 0;
+            for ( uint z = 0; subset && z < clusters.getSliceZ(); ++z )
+            {
+                for ( uint y = 0; y < clusters.getTileY(); ++y )
+                {
+                    for ( uint x = 0; x < clusters.getTileX(); ++x )
+                    {
+                        const uint c = clusters.getCluster( x, y, z );
+                        const Ra::Core::Aabb box = clusters.getClusterAabb( x, y, z );
+                        std::vector<uint> expected;
+                        for ( uint l = 1; l < lights.size(); ++l )
+                        {
+                            const Scalar r = lights[l].m_radius;
+                            if ( box.squaredExteriorDistance( lights[l].m_center ) <= r * r )
+                            {
+                                expected.push_back( l );
+                            }
+                        }
+                        const uint* begin = clusters.getLights( c );
+                        const uint* end = begin + clusters.getLightSize( c );
+                        subset = subset && std::is_sorted( begin, end ) && std::adjacent_find( begin, end ) == end &&
+                                 std::includes( expected.begin(), expected.end(), begin, end );
+                        total += clusters.getLightSize( c );
+                    }
+                }
+            }
+            RA_UNIT_TEST( subset, "Cluster lists should be sorted and only list lights near the clusters" );
+            RA_UNIT_TEST( total == clusters.getIndices().size() && total > 0, "Index list should be compact" );
+
+            // A point lit by a light finds the light in its cluster.
+            bool lit = true;
+            for ( uint i = 0; i < 2000; ++i )
+            {
+                const Scalar depth = 0.5f + 99.f * unit( rng );
+                const Vector3 p( ( 2.f * unit( rng ) - 1.f ) * 0.99f * depth,
+                                 ( 2.f * unit( rng ) - 1.f ) * 0.74f * depth, -depth );
+                const int c = clusters.getCluster( p );
+                if ( c < 0 )
+                {
+                    lit = false;
+                    break;
+                }
+                const uint* begin = clusters.getLights( c );
+                const uint* end = begin + clusters.getLightSize( c );
+                for ( uint l = 1; l < lights.size(); ++l )
+                {
+                    if ( ( lights[l].m_center - p ).squaredNorm() < lights[l].m_radius * lights[l].m_radius )
+                    {
+                        lit = lit && std::find( begin, end, l ) != end;
+                    }
+                }
+            }
+            RA_UNIT_TEST( lit, "Lights reaching a point should be in its cluster" );
+
+            // Reuse.
+            clusters.build( std::vector<LightClusters::Light>() );
+            RA_UNIT_TEST( clusters.getIndices().empty() && clusters.getLightSize( 0 ) == 0, "No light" );
+        }
+    };
+    RA_TEST_CLASS( LightClustersTests );
+}
+
+#endif // RADIUM_LIGHTCLUSTERS_TESTS_HPP_
@@ -0,0 +1,147 @@
+#ifndef RADIUM_UNIFORMTABLE_TESTS_HPP_
+#define RADIUM_UNIFORMTABLE_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/UniformTable.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RaTests
+{
+    /// A fake program : its active uniforms and attributes, and the calls made by the table.
+    struct MockProgram
+    {
+        std::vector<std::pair<std::string, int>> m_uniforms;
+        std::vector<std::pair<std::string, int>> m_attributes;
+        uint m_locationQueries = 0;
+        uint m_uploads = 0;
+        int m_lastLocation = -1;
+        Ra::Core::UniformType m_lastType = Ra::Core::UniformType_COUNT;
+        int m_lastCount = 0;
+
+        static MockProgram& get()
+        {
+            static MockProgram program;
+            return program;
+        }
+
+        static Ra::Core::UniformFunctions functions()
+        {
+            Ra::Core::UniformFunctions f;
+            f.m_activeUniformSize = []( uint ) -> uint { return get().m_uniforms.size(); };
+            f.m_activeUniform = []( uint, uint i, std::string& name, int& location )
+            {
+                name = get().m_uniforms[i].first;
+                location = get().m_uniforms[i].second;
+            };
+            f.m_uniformLocation = []( uint, const char* name ) -> int
+            {
+                ++get().m_locationQueries;
+                // Array elements after the first one are not listed.
+                for ( const auto& u : get().m_uniforms )
+                {
+                    if ( u.first == "palette[0]" && std::string( name ) == "palette[3]" )
+                    {
+                        return u.second + 3;
+                    }
+                }
+                return -1;
+            };
+            f.m_activeAttributeSize = []( uint ) -> uint { return get().m_attributes.size(); };
+            f.m_activeAttribute = []( uint, uint i, std::string& name, int& location )
+            {
+                name = get().m_attributes[i].first;
+                location = get().m_attributes[i].second;
+            };
+            f.m_upload = []( int location, Ra::Core::UniformType type, int count, const void* )
+            {
+                ++get().m_uploads;
+                get().m_lastLocation = location;
+                get().m_lastType = type;
+                get().m_lastCount = count;
+            };
+            return f;
+        }
+    };
+
+    class UniformTableTests : public Test
+    {
+        void run() override
+        {
+            using namespace Ra::Core;
+            MockProgram& gl = MockProgram::get();
+            gl.m_uniforms = { { "transform.model", 0 }, { "transform.view", 1 }, { "palette[0]", 4 } };
+            for ( uint i = 0; i < 40; ++i )
+            {
+                gl.m_uniforms.push_back( { "light[" + std::to_string( i ) + "].color", 100 + int( i ) } );
+            }
+            gl.m_attributes = { { "in_position", 0 }, { "in_normal", 1 } };
+
+            UniformTable table( MockProgram::functions() );
+            table.reflect( 1 );
+            RA_UNIT_TEST( table.getUniformSize() == gl.m_uniforms.size() && gl.m_locationQueries == 0,
+                          "Active uniforms should be reflected without queries" );
+
+            // Lookups.
+            const UniformHandle model = table.getUniform( "transform.model" );
+            RA_UNIT_TEST( table.getLocation( model ) == 0, "Reflected location" );
+            RA_UNIT_TEST( table.getLocation( table.getUniform( "light[37].color" ) ) == 137,
+                          "Lookup in a grown table" );
+            RA_UNIT_TEST( table.getUniform( "palette" ).m_index == table.getUniform( "palette[0]" ).m_index &&
+                          table.getLocation( table.getUniform( "palette" ) ) == 4,
+                          "Arrays should be found with and without [0]" );
+            RA_UNIT_TEST( gl.m_locationQueries == 0, "Reflected names should not be queried" );
+
+            const UniformHandle element = table.getUniform( "palette[3]" );
+            const UniformHandle missing = table.getUniform( "unused" );
+            table.getUniform( "palette[3]" );
+            table.getUniform( "unused" );
+            RA_UNIT_TEST( gl.m_locationQueries == 2 && table.getLocation( element ) == 7 &&
+                          table.getLocation( missing ) == -1 && missing.isValid(),
+                          "Names which are not listed should be queried once" );
+
+            RA_UNIT_TEST( table.getAttributeLocation( "in_normal" ) == 1 && table.getAttributeLocation( "in_color" ) == -1,
+                          "Attributes should be reflected" );
+
+            // Redundancy filter.
+            Matrix4f m = Matrix4f::Identity();
+            RA_UNIT_TEST( table.set( model, UniformType_MAT4, m ) && gl.m_uploads == 1 && gl.m_lastLocation == 0 &&
+                          gl.m_lastType == UniformType_MAT4, "First value should be uploaded" );
+            RA_UNIT_TEST( !table.set( model, UniformType_MAT4, m ) && gl.m_uploads == 1, "Same value should be skipped" );
+            m( 0, 3 ) = 2.f;
+            RA_UNIT_TEST( table.set( model, UniformType_MAT4, m ) && gl.m_uploads == 2, "New value should be uploaded" );
+            RA_UNIT_TEST( !table.set( missing, UniformType_INT, 1 ) && gl.m_uploads == 2,
+                          "Inactive uniforms should be skipped" );
+
+            const UniformHandle flag = table.getUniform( "transform.view" );
+            RA_UNIT_TEST( table.set( flag, UniformType_INT, 1 ) && !table.set( flag, UniformType_INT, 1 ) &&
+                          table.set( flag, UniformType_FLOAT, 1 ), "Type changes should be uploaded" );
+
+            std::vector<Matrix4f> palette( 3, Matrix4f::Identity() );
+            const UniformHandle p = table.getUniform( "palette" );
+            table.set( p, UniformType_MAT4, palette.data(), palette.size() * sizeof( Matrix4f ), palette.size() );
+            palette.push_back( Matrix4f::Identity() );
+            RA_UNIT_TEST( table.set( p, UniformType_MAT4, palette.data(), palette.size() * sizeof( Matrix4f ), palette.size() ) &&
+                          gl.m_lastCount == 4, "Larger arrays should be uploaded" );
+            RA_UNIT_TEST( !table.set( p, UniformType_MAT4, palette.data(), palette.size() * sizeof( Matrix4f ), palette.size() ),
+                          "Same array should be skipped" );
+
+            // Relink : handles are kept, values are forgotten.
+            gl.m_uniforms = { { "transform.view", 3 }, { "transform.model", 2 } };
+            gl.m_locationQueries = 0;
+            const uint uploads = gl.m_uploads;
+            table.reflect( 1 );
+            RA_UNIT_TEST( table.getLocation( model ) == 2 && table.getLocation( p ) == -1 &&
+                          table.getUniform( "transform.model" ).m_index == model.m_index,
+                          "Handles should be kept after a relink" );
+            RA_UNIT_TEST( table.set( model, UniformType_MAT4, m ) && gl.m_uploads == uploads + 1 && gl.m_lastLocation == 2,
+                          "Values should be uploaded again after a relink" );
+        }
+    };
+    RA_TEST_CLASS( UniformTableTests );
+}
+
+#endif // RADIUM_UNIFORMTABLE_TESTS_HPP_
@@ -0,0 +1,55 @@
+#ifndef RADIUM_VERTEXLAYOUT_TESTS_HPP_
+#define RADIUM_VERTEXLAYOUT_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/VertexLayout.hpp>
+#include <Core/Containers/VectorArray.hpp>
+
+#include <vector>
+
+namespace RaTests
+{
+    class VertexLayoutTests : public Test
+    {
+        void run() override
+        {
+            using Ra::Core::VertexLayout;
+
+            const uint size = 100;
+            Ra::Core::Vector3Array positions, normals;
+            Ra::Core::Vector4Array colors;
+            for ( uint i = 0; i < size; ++i )
+            {
+                positions.push_back( Ra::Core::Vector3( i, i + 0.25f, i + 0.5f ) );
+                normals.push_back( Ra::Core::Vector3( -Scalar( i ), 1, 0 ) );
+                colors.push_back( Ra::Core::Vector4( 0, 0, 1, i ) );
+            }
+
+            VertexLayout layout;
+            layout.addAttribute( 0, positions );
+            layout.addAttribute( 1, normals );
+            layout.addAttribute( 5, colors );
+            RA_UNIT_TEST( layout.size() == 3 && layout.getStride() == 10, "Stride of the layout" );
+            RA_UNIT_TEST( layout[0].m_offset == 0 && layout[1].m_offset == 3 && layout[2].m_offset == 6 &&
+                          layout[2].m_index == 5 && layout[2].m_component == 4, "Offsets of the attributes" );
+
+            std::vector<Scalar> buffer;
+            layout.pack( size, buffer );
+            bool packed = ( buffer.size() == size * layout.getStride() );
+            for ( uint i = 0; packed && i < size; ++i )
+            {
+                const Scalar* v = buffer.data() + i * layout.getStride();
+                packed = Ra::Core::Vector3( v[0], v[1], v[2] ) == positions[i] &&
+                         Ra::Core::Vector3( v[3], v[4], v[5] ) == normals[i] &&
+                         Ra::Core::Vector4( v[6], v[7], v[8], v[9] ) == colors[i];
+            }
+            RA_UNIT_TEST( packed, "Attributes of a vertex should be consecutive" );
+
+            layout.clear();
+            RA_UNIT_TEST( layout.size() == 0 && layout.getStride() == 0, "Cleared layout" );
+        }
+    };
+    RA_TEST_CLASS( VertexLayoutTests );
+}
+
+#endif // RADIUM_VERTEXLAYOUT_TESTS_HPP_
@@ -1,8 +1,22 @@
 #include <Tests/CoreTests/Tests.hpp>
 
+#include <Tests/CoreTests/Algebra/AabbCacheTests.hpp>
 #include <Tests/CoreTests/Algebra/AlgebraTests.hpp>
+#include <Tests/CoreTests/Algorithm/DiffusionTests.hpp>
+#include <Tests/CoreTests/Animation/AnimationTests.hpp>
+#include <Tests/CoreTests/Animation/SkinningTests.hpp>
 #include <Tests/CoreTests/Geometry/GeometryTests.hpp>
+#include <Tests/CoreTests/Index/IndexMapTests.hpp>
+#include <Tests/CoreTests/Mesh/MeshUtilsTests.hpp>
 #include <Tests/CoreTests/RayCasts/RayCastTest.hpp>
+#include <Tests/CoreTests/Tasks/TaskQueueTests.hpp>
+#include <Tests/CoreTests/TreeStructures/BVHTests.hpp>
+#include <Tests/CoreTests/Utils/BlobFileTests.hpp>
+#include <Tests/CoreTests/Utils/DirtyRangesTests.hpp>
+#include <Tests/CoreTests/Utils/DrawListTests.hpp>
+#include <Tests/CoreTests/Utils/LightClustersTests.hpp>
+#include <Tests/CoreTests/Utils/UniformTableTests.hpp>
+#include <Tests/CoreTests/Utils/VertexLayoutTests.hpp>
 
 int main()
 {